@@ -393,6 +393,11 @@ class ChApi ChCollisionModel {
     /// </pre>
     virtual std::vector<double> GetShapeDimensions(int index) const = 0;
 
+    /// Return the geometric dimensions of the collision shape with specified index, i.e. the dimensions specified when
+    /// the shape was added, not enlarged by the collision envelope. These are reported in the same format as
+    /// GetShapeDimensions, which is used by the default implementation.
+    virtual std::vector<double> GetShapeGeometricDimensions(int index) const { return GetShapeDimensions(index); }
+
     /// Set the contact material for the collision shape with specified index.
     void SetShapeMaterial(int index, std::shared_ptr<ChMaterialSurface> mat);
 
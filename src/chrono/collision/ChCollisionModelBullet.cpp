@@ -19,6 +19,7 @@
 #include "chrono/collision/ChCollisionUtilsBullet.h"
 #include "chrono/collision/ChConvexDecomposition.h"
 #include "chrono/collision/ChCollisionModelBullet.h"
+#include "chrono/collision/bullet/BulletCollision/BroadphaseCollision/cbtDbvt.h"
 #include "chrono/collision/bullet/BulletCollision/CollisionShapes/cbt2DShape.h"
 #include "chrono/collision/bullet/BulletCollision/CollisionShapes/cbtBarrelShape.h"
 #include "chrono/collision/bullet/BulletCollision/CollisionShapes/cbtCEtriangleShape.h"
@@ -916,6 +917,33 @@ std::vector<double> ChCollisionModelBullet::GetShapeDimensions(int index) const
     return dims;
 }
 
+std::vector<double> ChCollisionModelBullet::GetShapeGeometricDimensions(int index) const {
+    assert(index < GetNumShapes());
+
+    auto shape = std::static_pointer_cast<ChCollisionShapeBullet>(m_shapes[index]);
+
+    // Spheres, boxes, and cylinders are created with their dimensions increased by the envelope
+    switch (m_shapes[index]->GetType()) {
+        case ChCollisionShape::Type::SPHERE: {
+            auto bt_sphere = static_cast<cbtSphereShape*>(shape->m_bt_shape);
+            auto radius = (double)bt_sphere->getImplicitShapeDimensions().getX() - model_envelope;
+            return {radius};
+        }
+        case ChCollisionShape::Type::BOX: {
+            auto bt_box = static_cast<cbtBoxShape*>(shape->m_bt_shape);
+            auto hdims = ChBulletToVect(bt_box->getHalfExtentsWithMargin());
+            return {hdims.x() - model_envelope, hdims.y() - model_envelope, hdims.z() - model_envelope};
+        }
+        case ChCollisionShape::Type::CYLINDER: {
+            auto bt_cyl = static_cast<cbtCylinderShapeZ*>(shape->m_bt_shape);
+            auto hdims = ChBulletToVect(bt_cyl->getHalfExtentsWithMargin());
+            return {hdims.x() - model_envelope, hdims.y() - model_envelope, hdims.z() - model_envelope};
+        }
+        default:
+            return GetShapeDimensions(index);
+    }
+}
+
 void ChCollisionModelBullet::ArchiveOut(ChArchiveOut& marchive) {
     //// RADU TODO
 }
@@ -1009,5 +1037,91 @@ void ChCollisionModelBullet::ArchiveIn(ChArchiveIn& marchive) {
 }
 */
 
+// -----------------------------------------------------------------------------
+// ChCollisionModelBulletGroup
+// -----------------------------------------------------------------------------
+
+// Compound shape whose local bounds can be set directly from the root of its BV hierarchy
+class cbtGroupCompoundShape : public cbtCompoundShape {
+  public:
+    cbtGroupCompoundShape() : cbtCompoundShape(true) {}
+
+    void setLocalAabb(const cbtVector3& aabb_min, const cbtVector3& aabb_max) {
+        m_localAabbMin = aabb_min;
+        m_localAabbMax = aabb_max;
+    }
+};
+
+// Recompute the bounds of the internal nodes of a BV hierarchy from those of their children
+static void RefitNode(cbtDbvtNode* node) {
+    if (node->isleaf())
+        return;
+    RefitNode(node->childs[0]);
+    RefitNode(node->childs[1]);
+    Merge(node->childs[0]->volume, node->childs[1]->volume, node->volume);
+}
+
+ChCollisionModelBulletGroup::ChCollisionModelBulletGroup() {
+    ClearModel();
+}
+
+int ChCollisionModelBulletGroup::ClearModel() {
+    m_members.clear();
+    bt_compound_shape = chrono_types::make_shared<cbtGroupCompoundShape>();
+    bt_compound_shape->setMargin(GetSuggestedFullMargin());
+    bt_collision_object->setCollisionShape(bt_compound_shape.get());
+    return 1;
+}
+
+void ChCollisionModelBulletGroup::AddModel(ChCollisionModelBullet* model) {
+    if (m_members.empty()) {
+        SetEnvelope(model->GetEnvelope());
+        SetSafeMargin(model->GetSafeMargin());
+        bt_compound_shape->setMargin(GetSuggestedFullMargin());
+    }
+
+    for (int i = 0; i < model->GetNumShapes(); i++) {
+        auto shape = std::static_pointer_cast<ChCollisionShapeBullet>(model->GetShape(i));
+        cbtTransform transform;
+        if (model->bt_compound_shape)
+            transform = model->bt_compound_shape->getChildTransform(i);
+        else
+            transform.setIdentity();
+        bt_compound_shape->addChildShape(transform, shape->m_bt_shape);
+        m_members.push_back({model, i});
+    }
+}
+
+int ChCollisionModelBulletGroup::BuildModel() {
+    // The hierarchy built by incremental insertion is rebuilt top-down, for better culling
+    Refit();
+    if (!m_members.empty())
+        bt_compound_shape->getDynamicAabbTree()->optimizeTopDown();
+    return ChCollisionModelBullet::BuildModel();
+}
+
+void ChCollisionModelBulletGroup::Refit(int nthreads) {
+    int nchildren = bt_compound_shape->getNumChildShapes();
+    if (nchildren == 0)
+        return;
+
+    // Leaf bounds, from the current shape bounds
+    cbtCompoundShapeChild* children = bt_compound_shape->getChildList();
+#pragma omp parallel for num_threads(nthreads) if (nthreads > 1)
+    for (int i = 0; i < nchildren; i++) {
+        cbtVector3 aabb_min;
+        cbtVector3 aabb_max;
+        children[i].m_childShape->getAabb(children[i].m_transform, aabb_min, aabb_max);
+        children[i].m_node->volume = cbtDbvtVolume::FromMM(aabb_min, aabb_max);
+    }
+
+    // Internal node bounds, bottom-up
+    cbtDbvtNode* root = bt_compound_shape->getDynamicAabbTree()->m_root;
+    RefitNode(root);
+
+    static_cast<cbtGroupCompoundShape*>(bt_compound_shape.get())->setLocalAabb(root->volume.Mins(),
+                                                                                root->volume.Maxs());
+}
+
 }  // end namespace collision
 }  // end namespace chrono
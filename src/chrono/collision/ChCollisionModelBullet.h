@@ -314,6 +314,8 @@ class ChApi ChCollisionModelBullet : public ChCollisionModel {
     virtual ChCoordsys<> GetShapePos(int index) const override;
 
     /// Return shape characteristic dimensions.
+    /// These are the dimensions of the underlying Bullet shapes: spheres, boxes, and cylinders are enlarged by the
+    /// collision envelope (see GetShapeGeometricDimensions).
     /// The following collision shapes are supported:
     /// <pre>
     /// SPHERE       radius
@@ -324,6 +326,10 @@ class ChApi ChCollisionModelBullet : public ChCollisionModel {
     /// </pre>
     virtual std::vector<double> GetShapeDimensions(int index) const override;
 
+    /// Return the geometric dimensions of the collision shape with specified index, i.e. without the collision
+    /// envelope. These are reported in the same format as GetShapeDimensions.
+    virtual std::vector<double> GetShapeGeometricDimensions(int index) const override;
+
     /// Method to allow serialization of transient data to archives.
     virtual void ArchiveOut(ChArchiveOut& marchive) override;
 
@@ -341,6 +347,53 @@ class ChApi ChCollisionModelBullet : public ChCollisionModel {
 
     friend class ChCollisionSystemBullet;
     friend class ChCollisionSystemBulletMulticore;
+    friend class ChCollisionModelBulletGroup;
+};
+
+/// Bullet collision model grouping the shapes of other Bullet collision models in a single collision object.
+/// Shapes are not copied: they are shared with the member models, which must outlive the group and must not be added
+/// to the collision system themselves. All shapes are assumed to be expressed in the frame of the group.
+/// The bounding volume hierarchy over the shapes is built when the group is constructed and is refitted bottom-up by
+/// Refit() as the shapes deform, without changing its topology. This makes a group suitable for deformable surfaces
+/// made of many small shapes (e.g. FEA contact meshes), which are then seen by the broadphase as a single object.
+/// Contacts are reported with the member model and shape which generated them. Contacts between shapes of the same
+/// group are not detected.
+class ChApi ChCollisionModelBulletGroup : public ChCollisionModelBullet {
+  public:
+    ChCollisionModelBulletGroup();
+    virtual ~ChCollisionModelBulletGroup() {}
+
+    /// Remove all member models.
+    /// The group must not be in the collision system when this function is called.
+    virtual int ClearModel() override;
+
+    /// Complete the construction of the group (rebuild the BV hierarchy for the current shape bounds).
+    virtual int BuildModel() override;
+
+    /// Add all shapes of the given model to this group.
+    /// The envelope and safe margin of the group are set from those of the first member model.
+    void AddModel(ChCollisionModelBullet* model);
+
+    /// Update the bounding volume hierarchy for the current shape bounds.
+    /// Must be called after the member shapes changed (e.g. after the FEA nodes moved).
+    void Refit(int nthreads = 1);
+
+    /// Get the number of shapes in the group.
+    int GetNumMembers() const { return (int)m_members.size(); }
+
+    /// Get the member model owning the specified shape of the group.
+    ChCollisionModelBullet* GetMemberModel(int index) const { return m_members[index].model; }
+
+    /// Get the index, in its member model, of the specified shape of the group.
+    int GetMemberShapeIndex(int index) const { return m_members[index].shape; }
+
+  private:
+    struct Member {
+        ChCollisionModelBullet* model;
+        int shape;
+    };
+
+    std::vector<Member> m_members;
 };
 
 /// @} collision_bullet
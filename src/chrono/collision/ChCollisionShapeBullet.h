@@ -36,6 +36,7 @@ class ChCollisionShapeBullet : public ChCollisionShape {
     cbtCollisionShape* m_bt_shape;
 
     friend class ChCollisionModelBullet;
+    friend class ChCollisionModelBulletGroup;
 };
 
 /// @} collision_bullet
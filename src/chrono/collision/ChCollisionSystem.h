@@ -15,6 +15,9 @@
 #ifndef CH_COLLISIONSYSTEM_H
 #define CH_COLLISIONSYSTEM_H
 
+#include <cassert>
+#include <vector>
+
 #include "chrono/collision/ChCollisionModel.h"
 #include "chrono/collision/ChCollisionInfo.h"
 #include "chrono/core/ChApiCE.h"
@@ -169,6 +172,25 @@ class ChApi ChCollisionSystem {
                         ChCollisionModel* model,
                         ChRayhitResult& result) const = 0;
 
+    /// Perform ray-hit tests with the collision models for a batch of rays (from 'from[i]' to 'to[i]').
+    /// The 'results' vector is resized to the number of rays. Return the number of rays that hit some model.
+    /// The default implementation calls RayHit() for each ray in turn; derived classes may process rays concurrently,
+    /// using 'nthreads' threads or, if 0, the number of collision threads (see SetNumThreads).
+    /// In either case, the collision system must not be modified during this call.
+    virtual int RayHitBatch(const std::vector<ChVector<>>& from,
+                            const std::vector<ChVector<>>& to,
+                            std::vector<ChRayhitResult>& results,
+                            int nthreads = 0) const {
+        assert(from.size() == to.size());
+        results.resize(from.size());
+        int num_hits = 0;
+        for (size_t i = 0; i < from.size(); i++) {
+            if (RayHit(from[i], to[i], results[i]))
+                num_hits++;
+        }
+        return num_hits;
+    }
+
     /// Class to be used as a callback interface for user-defined visualization of collision shapes.
     class ChApi VisualizationCallback {
       public:
@@ -12,6 +12,8 @@
 // Authors: Alessandro Tasora, Radu Serban
 // =============================================================================
 
+#include <algorithm>
+
 #include "chrono/physics/ChContactContainer.h"
 #include "chrono/physics/ChProximityContainer.h"
 #include "chrono/collision/ChCollisionSystemBullet.h"
@@ -20,6 +22,7 @@
 #include "chrono/collision/gimpact/GIMPACT/Bullet/cbtGImpactCollisionAlgorithm.h"
 #include "chrono/collision/bullet/BulletCollision/CollisionDispatch/cbtCollisionDispatcherMt.h"
 #include "chrono/collision/bullet/LinearMath/cbtIDebugDraw.h"
+#include "chrono/utils/ChTrace.h"
 
 extern cbtScalar gContactBreakingThreshold;
 
@@ -30,7 +33,7 @@ namespace collision {
 // dynamic creation and persistence
 CH_FACTORY_REGISTER(ChCollisionSystemBullet)
 
-ChCollisionSystemBullet::ChCollisionSystemBullet() : m_debug_drawer(nullptr) {
+ChCollisionSystemBullet::ChCollisionSystemBullet() : m_debug_drawer(nullptr), m_num_threads(1) {
     // cbtDefaultCollisionConstructionInfo conf_info(...); ***TODO***
     bt_collision_configuration = new cbtDefaultCollisionConfiguration();
 
@@ -119,6 +122,7 @@ ChCollisionSystemBullet::~ChCollisionSystemBullet() {
 }
 
 void ChCollisionSystemBullet::SetNumThreads(int nthreads) {
+    m_num_threads = std::max(1, nthreads);
 #ifdef BT_USE_OPENMP
     cbtGetOpenMPTaskScheduler()->setNumThreads(nthreads);
 #endif
@@ -196,6 +200,10 @@ void ChCollisionSystemBullet::ReportContacts(ChContactContainer* mcontactcontain
         icontact.modelA = (ChCollisionModel*)obA->getUserPointer();
         icontact.modelB = (ChCollisionModel*)obB->getUserPointer();
 
+        // Contacts on a group of models are reported with the member model owning the shape
+        auto groupA = dynamic_cast<ChCollisionModelBulletGroup*>(icontact.modelA);
+        auto groupB = dynamic_cast<ChCollisionModelBulletGroup*>(icontact.modelB);
+
         double envelopeA = icontact.modelA->GetEnvelope();
         double envelopeB = icontact.modelB->GetEnvelope();
 
@@ -239,6 +247,15 @@ void ChCollisionSystemBullet::ReportContacts(ChContactContainer* mcontactcontain
                     int indexA = compoundA ? pt.m_index0 : 0;
                     int indexB = compoundB ? pt.m_index1 : 0;
 
+                    if (groupA) {
+                        icontact.modelA = groupA->GetMemberModel(indexA);
+                        indexA = groupA->GetMemberShapeIndex(indexA);
+                    }
+                    if (groupB) {
+                        icontact.modelB = groupB->GetMemberModel(indexB);
+                        indexB = groupB->GetMemberShapeIndex(indexB);
+                    }
+
                     icontact.shapeA = icontact.modelA->GetShape(indexA).get();
                     icontact.shapeB = icontact.modelB->GetShape(indexB).get();
 
@@ -371,6 +388,31 @@ bool ChCollisionSystemBullet::RayHit(const ChVector<>& from,
     return true;
 }
 
+int ChCollisionSystemBullet::RayHitBatch(const std::vector<ChVector<>>& from,
+                                         const std::vector<ChVector<>>& to,
+                                         std::vector<ChRayhitResult>& results,
+                                         int nthreads) const {
+    assert(from.size() == to.size());
+    int num_rays = (int)from.size();
+    results.resize(num_rays);
+    if (nthreads <= 0)
+        nthreads = m_num_threads;
+
+    // Bullet ray tests only read the collision world (and use per-call traversal stacks), so they can run concurrently
+    int num_hits = 0;
+#pragma omp parallel num_threads(nthreads) reduction(+ : num_hits)
+    {
+        CH_TRACE("Ray cast batch");
+#pragma omp for schedule(dynamic, 64)
+        for (int i = 0; i < num_rays; i++) {
+            if (RayHit(from[i], to[i], results[i], cbtBroadphaseProxy::DefaultFilter, cbtBroadphaseProxy::AllFilter))
+                num_hits++;
+        }
+    }
+
+    return num_hits;
+}
+
 void ChCollisionSystemBullet::SetContactBreakingThreshold(double threshold) {
     gContactBreakingThreshold = (cbtScalar)threshold;
 }
@@ -17,9 +17,13 @@
 //
 // =============================================================================
 
+#include <algorithm>
+
 #include "chrono/physics/ChSystem.h"
 #include "chrono/collision/ChCollisionSystemChrono.h"
-#include "chrono/collision/chrono/ChRayTest.h"
+#include "chrono/collision/chrono/ChCollisionUtils.h"
+#include "chrono/utils/ChOpenMP.h"
+#include "chrono/utils/ChTrace.h"
 
 namespace chrono {
 namespace collision {
@@ -44,16 +48,30 @@ void ChCollisionSystemChrono::SetEnvelope(double envelope) {
 void ChCollisionSystemChrono::SetBroadphaseGridResolution(const ChVector<int>& num_bins) {
     broadphase.grid_resolution = vec3(num_bins.x(), num_bins.y(), num_bins.z());
     broadphase.grid_type = ChBroadphase::GridType::FIXED_RESOLUTION;
+    broadphase.method = ChBroadphase::Method::GRID;
 }
 
 void ChCollisionSystemChrono::SetBroadphaseGridSize(const ChVector<>& bin_size) {
     broadphase.bin_size = real3(bin_size.x(), bin_size.y(), bin_size.z());
     broadphase.grid_type = ChBroadphase::GridType::FIXED_RESOLUTION;
+    broadphase.method = ChBroadphase::Method::GRID;
 }
 
 void ChCollisionSystemChrono::SetBroadphaseGridDensity(double density) {
     broadphase.grid_density = real(density);
     broadphase.grid_type = ChBroadphase::GridType::FIXED_DENSITY;
+    broadphase.method = ChBroadphase::Method::GRID;
+}
+
+void ChCollisionSystemChrono::SetBroadphaseGridHierarchical() {
+    broadphase.grid_type = ChBroadphase::GridType::HIERARCHICAL;
+    broadphase.method = ChBroadphase::Method::GRID;
+}
+
+void ChCollisionSystemChrono::SetBroadphaseDynamicTree(double margin) {
+    broadphase.tree_margin = real(margin);
+    broadphase.method = ChBroadphase::Method::DYNAMIC_TREE;
+    broadphase.tree_reset = true;
 }
 
 void ChCollisionSystemChrono::SetNarrowphaseAlgorithm(ChNarrowphase::Algorithm algorithm) {
@@ -120,6 +138,16 @@ void ChCollisionSystemChrono::Add(ChCollisionModel* model) {
     // Shape index in the collision model
     int local_shape_index = 0;
 
+    // The broadphase tree is rebuilt for the new set of shapes
+    broadphase.tree_reset = true;
+
+    // Record the range of shapes of this model (the shape hierarchy is built on demand)
+    ModelShapes& mshapes = model_shapes[model];
+    mshapes.first_shape = cd_data->num_rigid_shapes;
+    mshapes.num_shapes = (uint)pmodel->GetNumShapes();
+    mshapes.built = false;
+    mshapes.bvh.Clear();
+
     for (auto s : pmodel->GetShapes()) {
         auto shape = std::static_pointer_cast<ChCollisionShapeChrono>(s);
         real3 obA = shape->A;
@@ -200,6 +228,9 @@ void ChCollisionSystemChrono::Add(ChCollisionModel* model) {
 #define ERASE_MACRO_LEN(x, y, z) x.erase(x.begin() + y, x.begin() + y + z);
 
 void ChCollisionSystemChrono::Remove(ChCollisionModel* model) {
+    model_shapes.erase(model);
+    broadphase.tree_reset = true;
+
     /*
     ChCollisionModelChrono* pmodel = static_cast<ChCollisionModelChrono*>(model);
     int body_id = pmodel->GetBody()->GetId();
@@ -360,15 +391,21 @@ void ChCollisionSystemChrono::Run() {
     }
 
     // Broadphase
-    m_timer_broad.start();
-    GenerateAABB();
-    broadphase.Process();
-    m_timer_broad.stop();
+    {
+        CH_TRACE("Broad-phase");
+        m_timer_broad.start();
+        GenerateAABB();
+        broadphase.Process();
+        m_timer_broad.stop();
+    }
 
     // Narrowphase
-    m_timer_narrow.start();
-    narrowphase.Process();
-    m_timer_narrow.stop();
+    {
+        CH_TRACE("Narrow-phase");
+        m_timer_narrow.start();
+        narrowphase.Process();
+        m_timer_narrow.stop();
+    }
 }
 
 // -----------------------------------------------------------------------------
@@ -502,15 +539,70 @@ static void ComputeAABBConvex(const real3* convex_points,
     }
 }
 
+// Compute the AABB of the specified shape, given the position and orientation of the body carrying it.
+static bool ComputeAABBShape(const shape_container& shape_data,
+                             int index,
+                             real envelope,
+                             const real3& position,
+                             const quaternion& body_rot,
+                             real3& temp_min,
+                             real3& temp_max) {
+    shape_type type = shape_data.typ_rigid[index];
+    real3 local_pos = shape_data.ObA_rigid[index];
+    quaternion rotation = Mult(body_rot, shape_data.ObR_rigid[index]);
+    int start = shape_data.start_rigid[index];
+
+    if (type == ChCollisionShape::Type::SPHERE) {
+        real radius = shape_data.sphere_rigid[start];
+        ComputeAABBSphere(radius + envelope, local_pos, position, body_rot, temp_min, temp_max);
+
+    } else if (type == ChCollisionShape::Type::ELLIPSOID || type == ChCollisionShape::Type::BOX ||
+               type == ChCollisionShape::Type::CYLINDER || type == ChCollisionShape::Type::CYLSHELL ||
+               type == ChCollisionShape::Type::CONE) {
+        real3 B = shape_data.box_like_rigid[start];
+        ComputeAABBBox(B + envelope, local_pos, position, rotation, body_rot, temp_min, temp_max);
+
+    } else if (type == ChCollisionShape::Type::ROUNDEDBOX || type == ChCollisionShape::Type::ROUNDEDCYL) {
+        real4 T = shape_data.rbox_like_rigid[start];
+        real3 B = real3(T.x, T.y, T.z) + T.w + envelope;
+        ComputeAABBBox(B, local_pos, position, rotation, body_rot, temp_min, temp_max);
+
+    } else if (type == ChCollisionShape::Type::CAPSULE) {
+        real2 T = shape_data.capsule_rigid[start];
+        real3 B = real3(T.x, T.x + T.y, T.x) + envelope;
+        ComputeAABBBox(B, local_pos, position, rotation, body_rot, temp_min, temp_max);
+
+    } else if (type == ChCollisionShape::Type::CONVEX) {
+        int length = shape_data.length_rigid[index];
+        ComputeAABBConvex(shape_data.convex_rigid.data(), start, length, local_pos, position, rotation, temp_min,
+                          temp_max);
+        temp_min -= envelope;
+        temp_max += envelope;
+
+    } else if (type == ChCollisionShape::Type::TRIANGLE) {
+        real3 A, B, C;
+
+        A = shape_data.triangle_rigid[start + 0];
+        B = shape_data.triangle_rigid[start + 1];
+        C = shape_data.triangle_rigid[start + 2];
+
+        A = Rotate(A, body_rot) + position;
+        B = Rotate(B, body_rot) + position;
+        C = Rotate(C, body_rot) + position;
+
+        ComputeAABBTriangle(A, B, C, temp_min, temp_max);
+
+    } else {
+        return false;
+    }
+
+    return true;
+}
+
 void ChCollisionSystemChrono::GenerateAABB() {
     if (cd_data->num_rigid_shapes > 0) {
         const real envelope = cd_data->collision_envelope;
-        const std::vector<shape_type>& typ_rigid = cd_data->shape_data.typ_rigid;
-        const std::vector<int>& start_rigid = cd_data->shape_data.start_rigid;
         const std::vector<uint>& id_rigid = cd_data->shape_data.id_rigid;
-        const std::vector<real3>& obj_data_A = cd_data->shape_data.ObA_rigid;
-        const std::vector<quaternion>& obj_data_R = cd_data->shape_data.ObR_rigid;
-        const std::vector<real3>& convex_rigid = cd_data->shape_data.convex_rigid;
 
         const std::vector<real3>& pos_rigid = *cd_data->state_data.pos_rigid;
         const std::vector<quaternion>& body_rot = *cd_data->state_data.rot_rigid;
@@ -525,68 +617,17 @@ void ChCollisionSystemChrono::GenerateAABB() {
 
 #pragma omp parallel for
         for (int index = 0; index < (signed)num_rigid_shapes; index++) {
-            // Shape data
-            shape_type type = typ_rigid[index];
-            real3 local_pos = obj_data_A[index];
-            quaternion local_rot = obj_data_R[index];
             uint id = id_rigid[index];  // The rigid body corresponding to this shape
-            int start = start_rigid[index];
-
-            // Body data
             if (id == UINT_MAX)
                 continue;
 
-            real3 position = pos_rigid[id];
-            quaternion rotation = Mult(body_rot[id], local_rot);
             real3 temp_min;
             real3 temp_max;
-
-            if (type == ChCollisionShape::Type::SPHERE) {
-                real radius = cd_data->shape_data.sphere_rigid[start];
-                ComputeAABBSphere(radius + envelope, local_pos, position, body_rot[id], temp_min, temp_max);
-
-            } else if (type == ChCollisionShape::Type::ELLIPSOID || type == ChCollisionShape::Type::BOX ||
-                       type == ChCollisionShape::Type::CYLINDER || type == ChCollisionShape::Type::CYLSHELL ||
-                       type == ChCollisionShape::Type::CONE) {
-                real3 B = cd_data->shape_data.box_like_rigid[start];
-                ComputeAABBBox(B + envelope, local_pos, position, rotation, body_rot[id], temp_min, temp_max);
-
-            } else if (type == ChCollisionShape::Type::ROUNDEDBOX || type == ChCollisionShape::Type::ROUNDEDCYL) {
-                real4 T = cd_data->shape_data.rbox_like_rigid[start];
-                real3 B = real3(T.x, T.y, T.z) + T.w + envelope;
-                ComputeAABBBox(B, local_pos, position, rotation, body_rot[id], temp_min, temp_max);
-
-            } else if (type == ChCollisionShape::Type::CAPSULE) {
-                real2 T = cd_data->shape_data.capsule_rigid[start];
-                real3 B = real3(T.x, T.x + T.y, T.x) + envelope;
-                ComputeAABBBox(B, local_pos, position, rotation, body_rot[id], temp_min, temp_max);
-
-            } else if (type == ChCollisionShape::Type::CONVEX) {
-                int length = cd_data->shape_data.length_rigid[index];
-                ComputeAABBConvex(convex_rigid.data(), start, length, local_pos, position, rotation, temp_min,
-                                  temp_max);
-                temp_min -= envelope;
-                temp_max += envelope;
-
-            } else if (type == ChCollisionShape::Type::TRIANGLE) {
-                real3 A, B, C;
-
-                A = cd_data->shape_data.triangle_rigid[start + 0];
-                B = cd_data->shape_data.triangle_rigid[start + 1];
-                C = cd_data->shape_data.triangle_rigid[start + 2];
-
-                A = Rotate(A, body_rot[id]) + position;
-                B = Rotate(B, body_rot[id]) + position;
-                C = Rotate(C, body_rot[id]) + position;
-
-                ComputeAABBTriangle(A, B, C, temp_min, temp_max);
-
-            } else {
-                continue;
+            if (ComputeAABBShape(cd_data->shape_data, index, envelope, pos_rigid[id], body_rot[id], temp_min,
+                                 temp_max)) {
+                aabb_min[index] = temp_min;
+                aabb_max[index] = temp_max;
             }
-
-            aabb_min[index] = temp_min;
-            aabb_max[index] = temp_max;
         }
     }
 }
@@ -628,18 +669,7 @@ bool ChCollisionSystemChrono::RayHit(const ChVector<>& from, const ChVector<>& t
     ChRayTest tester(cd_data);
     ChRayTest::RayHitInfo info;
     if (tester.Check(FromChVector(from), FromChVector(to), info)) {
-        // Hit point
-        result.hit = true;
-        result.abs_hitNormal = ToChVector(info.normal);
-        result.abs_hitPoint = ToChVector(info.point);
-        result.dist_factor = info.t;
-
-        // ID of the body carring the closest hit shape
-        uint bid = cd_data->shape_data.id_rigid[info.shapeID];
-
-        // Collision model of hit body
-        result.hitModel = m_system->Get_bodylist()[bid]->GetCollisionModel().get();
-
+        SetRayhitResult(info, result);
         return true;
     }
 
@@ -647,11 +677,131 @@ bool ChCollisionSystemChrono::RayHit(const ChVector<>& from, const ChVector<>& t
     return false;
 }
 
+int ChCollisionSystemChrono::RayHitBatch(const std::vector<ChVector<>>& from,
+                                         const std::vector<ChVector<>>& to,
+                                         std::vector<ChRayhitResult>& results,
+                                         int nthreads) const {
+    assert(from.size() == to.size());
+    int num_rays = (int)from.size();
+    results.resize(num_rays);
+    for (auto& result : results)
+        result.hit = false;
+    if (nthreads <= 0)
+        nthreads = ChOMP::GetMaxThreads();
+
+    if (cd_data->num_active_bins == 0 || num_rays == 0)
+        return 0;
+
+    // Order the rays by the grid bin containing their start point, so that consecutive rays (assigned to the same
+    // thread) visit the same bins and shapes.
+    const vec3& bins_per_axis = cd_data->bins_per_axis;
+    const real3& inv_bin_size = cd_data->inv_bin_size;
+    const real3& lbr = cd_data->min_bounding_point;
+
+    std::vector<std::pair<uint, int>> order(num_rays);
+#pragma omp parallel for num_threads(nthreads)
+    for (int i = 0; i < num_rays; i++) {
+        vec3 bin = Clamp(ch_utils::HashMin(FromChVector(from[i]) - lbr, inv_bin_size), vec3(0, 0, 0),
+                         bins_per_axis - vec3(1, 1, 1));
+        order[i] = std::make_pair(ch_utils::Hash_Index(bin, bins_per_axis), i);
+    }
+    std::sort(order.begin(), order.end());
+
+    // Test the rays concurrently, each thread with its own ray tester
+    int num_hits = 0;
+#pragma omp parallel num_threads(nthreads) reduction(+ : num_hits)
+    {
+        ChRayTest tester(cd_data);
+        ChRayTest::RayHitInfo info;
+#pragma omp for schedule(dynamic, 64)
+        for (int k = 0; k < num_rays; k++) {
+            int i = order[k].second;
+            if (tester.Check(FromChVector(from[i]), FromChVector(to[i]), info)) {
+                SetRayhitResult(info, results[i]);
+                num_hits++;
+            }
+        }
+    }
+
+    return num_hits;
+}
+
+void ChCollisionSystemChrono::SetRayhitResult(const ChRayTest::RayHitInfo& info, ChRayhitResult& result) const {
+    // Hit point
+    result.hit = true;
+    result.abs_hitNormal = ToChVector(info.normal);
+    result.abs_hitPoint = ToChVector(info.point);
+    result.dist_factor = info.t;
+
+    // ID of the body carring the closest hit shape
+    uint bid = cd_data->shape_data.id_rigid[info.shapeID];
+
+    // Collision model of hit body
+    result.hitModel = m_system->Get_bodylist()[bid]->GetCollisionModel().get();
+}
+
+const ChShapeBVH* ChCollisionSystemChrono::GetModelBVH(ChCollisionModel* model) const {
+    auto it = model_shapes.find(model);
+    if (it == model_shapes.end())
+        return nullptr;
+
+    ModelShapes& mshapes = it->second;
+    std::lock_guard<std::mutex> lock(model_shapes_mutex);
+    if (!mshapes.built) {
+        // Build the hierarchy over the shape AABBs in the body frame
+        std::vector<uint> shapes(mshapes.num_shapes);
+        std::vector<real3> aabb_min(mshapes.num_shapes);
+        std::vector<real3> aabb_max(mshapes.num_shapes);
+        int num_shapes = 0;
+        for (uint i = 0; i < mshapes.num_shapes; i++) {
+            uint index = mshapes.first_shape + i;
+            if (ComputeAABBShape(cd_data->shape_data, index, cd_data->collision_envelope, real3(0),
+                                 quaternion(1, 0, 0, 0), aabb_min[num_shapes], aabb_max[num_shapes])) {
+                shapes[num_shapes++] = index;
+            }
+        }
+        shapes.resize(num_shapes);
+        aabb_min.resize(num_shapes);
+        aabb_max.resize(num_shapes);
+        mshapes.bvh.Build(shapes, aabb_min, aabb_max);
+        mshapes.built = true;
+    }
+
+    return &mshapes.bvh;
+}
+
 bool ChCollisionSystemChrono::RayHit(const ChVector<>& from,
                                      const ChVector<>& to,
                                      ChCollisionModel* model,
                                      ChRayhitResult& result) const {
-    return false;
+    result.hit = false;
+
+    // Global shape data is available only after a collision detection pass with all current shapes
+    const auto& shape_data = cd_data->shape_data;
+    if (shape_data.obj_data_A_global.size() < cd_data->num_rigid_shapes)
+        return false;
+
+    const ChShapeBVH* bvh = GetModelBVH(model);
+    if (!bvh || bvh->IsEmpty())
+        return false;
+
+    // Current pose of the body carrying the model shapes
+    int bid = static_cast<ChCollisionModelChrono*>(model)->GetBody()->GetId();
+    const real3& pos = (*cd_data->state_data.pos_rigid)[bid];
+    const quaternion& rot = (*cd_data->state_data.rot_rigid)[bid];
+
+    ChRayTest tester(cd_data);
+    ChRayTest::RayHitInfo info;
+    if (!tester.Check(FromChVector(from), FromChVector(to), *bvh, pos, rot, info))
+        return false;
+
+    result.hit = true;
+    result.abs_hitNormal = ToChVector(info.normal);
+    result.abs_hitPoint = ToChVector(info.point);
+    result.dist_factor = info.t;
+    result.hitModel = model;
+
+    return true;
 }
 
 // -----------------------------------------------------------------------------
@@ -20,6 +20,9 @@
 #ifndef CH_COLLISION_SYSTEM_CHRONO_H
 #define CH_COLLISION_SYSTEM_CHRONO_H
 
+#include <mutex>
+#include <unordered_map>
+
 #include "chrono/core/ChTimer.h"
 
 #include "chrono/collision/ChCollisionSystem.h"
@@ -27,6 +30,8 @@
 #include "chrono/collision/chrono/ChCollisionData.h"
 #include "chrono/collision/chrono/ChBroadphase.h"
 #include "chrono/collision/chrono/ChNarrowphase.h"
+#include "chrono/collision/chrono/ChRayTest.h"
+#include "chrono/collision/chrono/ChShapeBVH.h"
 
 #include "chrono/multicore_math/ChMulticoreMath.h"
 
@@ -67,6 +72,18 @@ class ChApi ChCollisionSystemChrono : public ChCollisionSystem {
     /// By default, a fixed number of bins is used (see SetBroadphaseGridResolution).
     void SetBroadphaseGridDensity(double density);
 
+    /// Use a hierarchical broadphase grid, for scenes with collision shapes of widely different sizes.
+    /// Each shape is assigned to a grid level with bins matching the size of its AABB and is only tested against shapes
+    /// in the same or coarser levels. By default, a fixed number of bins is used (see SetBroadphaseGridResolution).
+    void SetBroadphaseGridHierarchical();
+
+    /// Use a dynamic AABB tree for broadphase collision detection, instead of a grid.
+    /// The tree stores shape AABBs enlarged by the specified margin (relative to the AABB size) and is updated
+    /// incrementally, together with the list of candidate shape pairs, only for shapes which moved outside their
+    /// enlarged AABB. This is beneficial for scenes in which most objects are at rest or move slowly. Any grid settings
+    /// are ignored while this option is enabled (except for systems with fluid particles, which require a grid).
+    void SetBroadphaseDynamicTree(double margin = 0.1);
+
     /// Set the narrowphase algorithm (default: ChNarrowphase::Algorithm::HYBRID).
     /// The Chrono collision detection system provides several analytical collision detection algorithms, for particular
     /// pairs of shapes (see ChNarrowphasePRIMS). For general convex shapes, the collision system relies on the
@@ -126,16 +143,26 @@ class ChApi ChCollisionSystemChrono : public ChCollisionSystem {
     virtual void ReportProximities(ChProximityContainer* mproximitycontainer) override {}
 
     /// Perform a ray-hit test with all collision models.
-    /// Currently not implemented.
     virtual bool RayHit(const ChVector<>& from, const ChVector<>& to, ChRayhitResult& result) const override;
 
     /// Perform a ray-hit test with the specified collision model.
-    /// Currently not implemented.
+    /// The shapes of the model are organized in a bounding volume hierarchy, expressed in the body frame and built on
+    /// the first query, so that the cost of a test grows only logarithmically with the number of shapes in the model
+    /// (e.g., for large triangular meshes).
     virtual bool RayHit(const ChVector<>& from,
                         const ChVector<>& to,
                         ChCollisionModel* model,
                         ChRayhitResult& result) const override;
 
+    /// Perform ray-hit tests with all collision models for a batch of rays.
+    /// Rays are sorted by the broadphase bin containing their start point, so that rays processed in sequence traverse
+    /// the same grid cells (e.g., bundles of parallel rays cast from a regular grid), and tested concurrently using the
+    /// given number of threads or, if 0, the number of threads specified through SetNumThreads().
+    virtual int RayHitBatch(const std::vector<ChVector<>>& from,
+                            const std::vector<ChVector<>>& to,
+                            std::vector<ChRayhitResult>& results,
+                            int nthreads = 0) const override;
+
     /// Method to trigger debug visualization of collision shapes.
     /// The 'flags' argument can be any of the VisualizationModes enums, or a combination thereof (using bit-wise
     /// operators). The calling program must invoke this function from within the simulation loop. No-op if a
@@ -146,12 +173,19 @@ class ChApi ChCollisionSystemChrono : public ChCollisionSystem {
     virtual std::vector<vec2> GetOverlappingPairs();
 
   protected:
+    /// Load the result of a ray-hit test from the information returned by the ray tester.
+    void SetRayhitResult(const ChRayTest::RayHitInfo& info, ChRayhitResult& result) const;
+
     /// Mark bodies whose AABB is contained within the specified box.
     virtual void GetOverlappingAABB(std::vector<char>& active_id, real3 Amin, real3 Amax);
 
     /// Generate the current axis-aligned bounding boxes of collision shapes.
     void GenerateAABB();
 
+    /// Return the shape hierarchy for the specified collision model, building it if needed.
+    /// Return nullptr if the model was not added to this collision system.
+    const ChShapeBVH* GetModelBVH(ChCollisionModel* model) const;
+
     /// Visualize collision shapes (wireframe).
     void VisualizeShapes();
 
@@ -174,6 +208,17 @@ class ChApi ChCollisionSystemChrono : public ChCollisionSystem {
 
     ChTimer m_timer_broad;
     ChTimer m_timer_narrow;
+
+    /// Collision shapes of a collision model, used for model-specific ray-hit tests.
+    struct ModelShapes {
+        uint first_shape;  ///< index of first shape of the model
+        uint num_shapes;   ///< number of shapes of the model
+        bool built;        ///< true if the hierarchy was built
+        ChShapeBVH bvh;    ///< hierarchy of the model shapes, in the body frame
+    };
+
+    mutable std::unordered_map<ChCollisionModel*, ModelShapes> model_shapes;  ///< shapes of each model in the system
+    mutable std::mutex model_shapes_mutex;                                     ///< guard for lazy hierarchy build
 };
 
 /// @} collision_mc
@@ -0,0 +1,166 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "chrono/collision/ChNeighborList.h"
+
+namespace chrono {
+namespace collision {
+
+// Largest cell coordinate which can be encoded in a Morton code
+static const uint32_t max_cell = (1u << 21) - 1;
+
+void ChNeighborList::SetCutoff(double cutoff) {
+    if (cutoff != m_cutoff)
+        m_valid = false;
+    m_cutoff = cutoff;
+}
+
+void ChNeighborList::SetSkin(double skin) {
+    if (skin != m_skin)
+        m_valid = false;
+    m_skin = skin;
+}
+
+bool ChNeighborList::Update(const std::vector<ChVector<>>& pos, int nthreads) {
+    if (!NeedsRebuild(pos, nthreads))
+        return false;
+
+    Rebuild(pos, nthreads);
+    return true;
+}
+
+bool ChNeighborList::NeedsRebuild(const std::vector<ChVector<>>& pos, int nthreads) const {
+    if (!m_valid || pos.size() != m_ref_pos.size())
+        return true;
+
+    // Pairs closer than the cutoff are still in the list as long as no point moved by more than half the skin
+    double max_disp2 = 0.25 * m_skin * m_skin;
+    int n = (int)pos.size();
+    bool moved = false;
+#pragma omp parallel for num_threads(nthreads) if (nthreads > 1) reduction(|| : moved)
+    for (int i = 0; i < n; i++) {
+        moved = moved || (pos[i] - m_ref_pos[i]).Length2() > max_disp2;
+    }
+
+    return moved;
+}
+
+uint64_t ChNeighborList::MortonCode(uint32_t ix, uint32_t iy, uint32_t iz) {
+    auto spread = [](uint64_t v) {
+        v &= 0x1fffff;
+        v = (v | v << 32) & 0x1f00000000ffffULL;
+        v = (v | v << 16) & 0x1f0000ff0000ffULL;
+        v = (v | v << 8) & 0x100f00f00f00f00fULL;
+        v = (v | v << 4) & 0x10c30c30c30c30c3ULL;
+        v = (v | v << 2) & 0x1249249249249249ULL;
+        return v;
+    };
+    return spread(ix) | (spread(iy) << 1) | (spread(iz) << 2);
+}
+
+void ChNeighborList::Rebuild(const std::vector<ChVector<>>& pos, int nthreads) {
+    int n = (int)pos.size();
+
+    m_ref_pos = pos;
+    m_valid = true;
+    m_num_rebuilds++;
+
+    m_order.resize(n);
+    m_codes.resize(n);
+    m_start.assign(n + 1, 0);
+    m_neighbors.clear();
+    if (n == 0)
+        return;
+
+    double range = m_cutoff + m_skin;
+    double range2 = range * range;
+    double inv_cell = range > 0 ? 1 / range : 1;
+
+    ChVector<> pmin = pos[0];
+    for (int i = 1; i < n; i++)
+        pmin = Vmin(pmin, pos[i]);
+
+    // Grid cell of a point; cells beyond the range of the Morton code are merged at the boundary, which does not
+    // affect the result since pairs are always checked by distance
+    auto cell_coord = [&](const ChVector<>& p, unsigned axis) {
+        double c = std::floor((p[axis] - pmin[axis]) * inv_cell);
+        return (uint32_t)std::min(std::max(c, 0.0), (double)max_cell);
+    };
+
+    // Sort points along the Morton curve
+    std::vector<std::pair<uint64_t, unsigned int>> keys(n);
+#pragma omp parallel for num_threads(nthreads) if (nthreads > 1)
+    for (int i = 0; i < n; i++) {
+        keys[i].first = MortonCode(cell_coord(pos[i], 0), cell_coord(pos[i], 1), cell_coord(pos[i], 2));
+        keys[i].second = (unsigned int)i;
+    }
+    std::sort(keys.begin(), keys.end());
+    for (int k = 0; k < n; k++) {
+        m_codes[k] = keys[k].first;
+        m_order[k] = keys[k].second;
+    }
+
+    // Visit all the neighbors of the k-th point in the 27 surrounding cells. Points in the same cell are contiguous in
+    // Morton order, so the points of a cell are found with a binary search on the sorted codes.
+    auto visit = [&](int k, unsigned int* out) {
+        unsigned int i = m_order[k];
+        const ChVector<>& p = pos[i];
+        int64_t cx = cell_coord(p, 0);
+        int64_t cy = cell_coord(p, 1);
+        int64_t cz = cell_coord(p, 2);
+        unsigned int count = 0;
+        for (int64_t ix = cx - 1; ix <= cx + 1; ix++) {
+            if (ix < 0 || ix > max_cell)
+                continue;
+            for (int64_t iy = cy - 1; iy <= cy + 1; iy++) {
+                if (iy < 0 || iy > max_cell)
+                    continue;
+                for (int64_t iz = cz - 1; iz <= cz + 1; iz++) {
+                    if (iz < 0 || iz > max_cell)
+                        continue;
+                    uint64_t code = MortonCode((uint32_t)ix, (uint32_t)iy, (uint32_t)iz);
+                    auto cell = std::equal_range(m_codes.begin(), m_codes.end(), code);
+                    for (auto it = cell.first; it != cell.second; ++it) {
+                        unsigned int j = m_order[it - m_codes.begin()];
+                        if (j == i || (pos[j] - p).Length2() >= range2)
+                            continue;
+                        if (out)
+                            out[count] = j;
+                        count++;
+                    }
+                }
+            }
+        }
+        return count;
+    };
+
+    // Two passes: count the neighbors of each point, then store them
+#pragma omp parallel for num_threads(nthreads) if (nthreads > 1)
+    for (int k = 0; k < n; k++) {
+        m_start[k + 1] = visit(k, nullptr);
+    }
+    for (int k = 0; k < n; k++)
+        m_start[k + 1] += m_start[k];
+
+    m_neighbors.resize(m_start[n]);
+#pragma omp parallel for num_threads(nthreads) if (nthreads > 1)
+    for (int k = 0; k < n; k++) {
+        visit(k, m_neighbors.data() + m_start[k]);
+    }
+}
+
+}  // end namespace collision
+}  // end namespace chrono
@@ -0,0 +1,98 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#ifndef CH_NEIGHBOR_LIST_H
+#define CH_NEIGHBOR_LIST_H
+
+#include <cstdint>
+#include <vector>
+
+#include "chrono/core/ChApiCE.h"
+#include "chrono/core/ChVector.h"
+
+namespace chrono {
+namespace collision {
+
+/// @addtogroup chrono_collision
+/// @{
+
+/// Persistent (Verlet) neighbor list for a set of points, built with a uniform cell grid.
+/// All pairs of points closer than the cutoff distance plus a skin distance are stored. The list is rebuilt only when
+/// some point moved by more than half the skin since the last build, so that between rebuilds it still contains all
+/// pairs closer than the cutoff distance; users must check the actual distance of the listed pairs.
+/// Points are sorted along a Morton (Z-order) curve of the grid cells: lists are stored, and should be traversed, in
+/// this order, so that points close in space are also close in memory. Each point lists all its neighbors (i.e., each
+/// pair appears twice), so that per-point quantities can be accumulated in parallel without synchronization.
+class ChApi ChNeighborList {
+  public:
+    ChNeighborList() : m_cutoff(0), m_skin(0), m_num_rebuilds(0), m_valid(false) {}
+
+    /// Set the cutoff distance.
+    void SetCutoff(double cutoff);
+    double GetCutoff() const { return m_cutoff; }
+
+    /// Set the skin distance (default: 0, i.e. the list is rebuilt at each update).
+    void SetSkin(double skin);
+    double GetSkin() const { return m_skin; }
+
+    /// Force a rebuild at the next update.
+    void Invalidate() { m_valid = false; }
+
+    /// Update the neighbor list for the given point positions, rebuilding it if needed.
+    /// Return true if the list was rebuilt.
+    bool Update(const std::vector<ChVector<>>& pos, int nthreads = 1);
+
+    /// Get the number of points in the list.
+    unsigned int GetNumPoints() const { return (unsigned int)m_order.size(); }
+
+    /// Get the index of the k-th point in Morton order.
+    unsigned int GetPoint(unsigned int k) const { return m_order[k]; }
+
+    /// Get the number of neighbors of the k-th point in Morton order.
+    unsigned int GetNumNeighbors(unsigned int k) const { return m_start[k + 1] - m_start[k]; }
+
+    /// Get the indices of the neighbors of the k-th point in Morton order.
+    const unsigned int* GetNeighbors(unsigned int k) const { return m_neighbors.data() + m_start[k]; }
+
+    /// Get the total number of (ordered) pairs in the list.
+    size_t GetNumPairs() const { return m_neighbors.size(); }
+
+    /// Get the number of times the list was rebuilt.
+    unsigned int GetNumRebuilds() const { return m_num_rebuilds; }
+
+  private:
+    /// Return true if the list must be rebuilt for the given positions.
+    bool NeedsRebuild(const std::vector<ChVector<>>& pos, int nthreads) const;
+
+    /// Sort the points in Morton order and build the neighbor lists.
+    void Rebuild(const std::vector<ChVector<>>& pos, int nthreads);
+
+    /// Interleave the bits of the given cell coordinates (21 bits each).
+    static uint64_t MortonCode(uint32_t ix, uint32_t iy, uint32_t iz);
+
+    double m_cutoff;                       ///< cutoff distance
+    double m_skin;                         ///< skin distance
+    unsigned int m_num_rebuilds;           ///< number of rebuilds so far
+    bool m_valid;                          ///< can the current list be reused?
+    std::vector<ChVector<>> m_ref_pos;     ///< point positions at last rebuild
+    std::vector<unsigned int> m_order;     ///< point indices in Morton order
+    std::vector<uint64_t> m_codes;         ///< Morton codes of the point cells, in Morton order
+    std::vector<unsigned int> m_start;     ///< start of the neighbors of each point, in Morton order (plus end marker)
+    std::vector<unsigned int> m_neighbors; ///< neighbor point indices
+};
+
+/// @} chrono_collision
+
+}  // end namespace collision
+}  // end namespace chrono
+
+#endif
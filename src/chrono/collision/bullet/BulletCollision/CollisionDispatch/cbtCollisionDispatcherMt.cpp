@@ -15,6 +15,7 @@ subject to the following restrictions:
 
 #include "cbtCollisionDispatcherMt.h"
 #include "LinearMath/cbtQuickprof.h"
+#include "chrono/utils/ChTrace.h"  // ***CHRONO***
 
 #include "BulletCollision/BroadphaseCollision/cbtCollisionAlgorithm.h"
 
@@ -111,6 +112,7 @@ struct CollisionDispatcherUpdater : public cbtIParallelForBody
 	}
 	void forLoop(int iBegin, int iEnd) const
 	{
+		CH_TRACE("Narrow-phase batch");  // ***CHRONO***
 		for (int i = iBegin; i < iEnd; ++i)
 		{
 			cbtBroadphasePair* pair = &mPairArray[i];
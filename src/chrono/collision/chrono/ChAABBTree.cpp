@@ -0,0 +1,354 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2021 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Dynamic AABB tree
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cassert>
+
+#include "chrono/collision/chrono/ChAABBTree.h"
+
+namespace chrono {
+namespace collision {
+
+// Surface area of an AABB.
+static inline real Area(const real3& aabb_min, const real3& aabb_max) {
+    real3 d = aabb_max - aabb_min;
+    return 2 * (d.x * d.y + d.y * d.z + d.z * d.x);
+}
+
+ChAABBTree::ChAABBTree() : m_root(-1), m_free(-1), m_num_leaves(0) {}
+
+void ChAABBTree::Clear() {
+    m_nodes.clear();
+    m_root = -1;
+    m_free = -1;
+    m_num_leaves = 0;
+}
+
+int ChAABBTree::AllocateNode() {
+    int inode;
+    if (m_free >= 0) {
+        inode = m_free;
+        m_free = m_nodes[inode].next;
+    } else {
+        inode = (int)m_nodes.size();
+        m_nodes.push_back(Node());
+    }
+
+    Node& node = m_nodes[inode];
+    node.parent = -1;
+    node.next = -1;
+    node.child1 = -1;
+    node.child2 = -1;
+    node.height = 0;
+    node.item = 0;
+    return inode;
+}
+
+void ChAABBTree::FreeNode(int inode) {
+    m_nodes[inode].next = m_free;
+    m_nodes[inode].height = -1;
+    m_free = inode;
+}
+
+int ChAABBTree::Insert(const real3& aabb_min, const real3& aabb_max, uint item) {
+    int leaf = AllocateNode();
+    m_nodes[leaf].aabb_min = aabb_min;
+    m_nodes[leaf].aabb_max = aabb_max;
+    m_nodes[leaf].item = item;
+
+    InsertLeaf(leaf);
+    m_num_leaves++;
+    return leaf;
+}
+
+void ChAABBTree::Remove(int proxy) {
+    assert(proxy >= 0 && proxy < (int)m_nodes.size() && m_nodes[proxy].IsLeaf());
+
+    RemoveLeaf(proxy);
+    FreeNode(proxy);
+    m_num_leaves--;
+}
+
+void ChAABBTree::Move(int proxy, const real3& aabb_min, const real3& aabb_max) {
+    assert(proxy >= 0 && proxy < (int)m_nodes.size() && m_nodes[proxy].IsLeaf());
+
+    RemoveLeaf(proxy);
+    m_nodes[proxy].aabb_min = aabb_min;
+    m_nodes[proxy].aabb_max = aabb_max;
+    InsertLeaf(proxy);
+}
+
+// Insert the leaf as sibling of the node found by descending from the root along the child which leads to the smallest
+// increase in total surface area (the area of all new or enlarged ancestors).
+void ChAABBTree::InsertLeaf(int leaf) {
+    if (m_root < 0) {
+        m_root = leaf;
+        m_nodes[leaf].parent = -1;
+        return;
+    }
+
+    real3 leaf_min = m_nodes[leaf].aabb_min;
+    real3 leaf_max = m_nodes[leaf].aabb_max;
+
+    // Find the best sibling
+    int index = m_root;
+    while (!m_nodes[index].IsLeaf()) {
+        const Node& node = m_nodes[index];
+        int child1 = node.child1;
+        int child2 = node.child2;
+
+        real area = Area(node.aabb_min, node.aabb_max);
+        real combined_area = Area(Min(node.aabb_min, leaf_min), Max(node.aabb_max, leaf_max));
+
+        // Cost of creating a new parent for this node and the new leaf
+        real cost = 2 * combined_area;
+
+        // Minimum cost of pushing the leaf further down the tree
+        real inheritance_cost = 2 * (combined_area - area);
+
+        auto descend_cost = [&](int ichild) {
+            const Node& child = m_nodes[ichild];
+            real new_area = Area(Min(child.aabb_min, leaf_min), Max(child.aabb_max, leaf_max));
+            if (child.IsLeaf())
+                return new_area + inheritance_cost;
+            return new_area - Area(child.aabb_min, child.aabb_max) + inheritance_cost;
+        };
+        real cost1 = descend_cost(child1);
+        real cost2 = descend_cost(child2);
+
+        if (cost < cost1 && cost < cost2)
+            break;
+
+        index = (cost1 < cost2) ? child1 : child2;
+    }
+
+    int sibling = index;
+
+    // Create a new parent for the sibling and the leaf
+    int old_parent = m_nodes[sibling].parent;
+    int new_parent = AllocateNode();
+    Node& parent = m_nodes[new_parent];
+    parent.parent = old_parent;
+    parent.aabb_min = Min(leaf_min, m_nodes[sibling].aabb_min);
+    parent.aabb_max = Max(leaf_max, m_nodes[sibling].aabb_max);
+    parent.height = m_nodes[sibling].height + 1;
+    parent.child1 = sibling;
+    parent.child2 = leaf;
+
+    if (old_parent >= 0) {
+        if (m_nodes[old_parent].child1 == sibling)
+            m_nodes[old_parent].child1 = new_parent;
+        else
+            m_nodes[old_parent].child2 = new_parent;
+    } else {
+        m_root = new_parent;
+    }
+    m_nodes[sibling].parent = new_parent;
+    m_nodes[leaf].parent = new_parent;
+
+    // Walk back up the tree fixing heights and AABBs
+    Refit(m_nodes[leaf].parent);
+}
+
+void ChAABBTree::RemoveLeaf(int leaf) {
+    if (leaf == m_root) {
+        m_root = -1;
+        return;
+    }
+
+    int parent = m_nodes[leaf].parent;
+    int grand_parent = m_nodes[parent].parent;
+    int sibling = (m_nodes[parent].child1 == leaf) ? m_nodes[parent].child2 : m_nodes[parent].child1;
+
+    if (grand_parent >= 0) {
+        // Destroy the parent and connect the sibling to the grand parent
+        if (m_nodes[grand_parent].child1 == parent)
+            m_nodes[grand_parent].child1 = sibling;
+        else
+            m_nodes[grand_parent].child2 = sibling;
+        m_nodes[sibling].parent = grand_parent;
+        FreeNode(parent);
+
+        Refit(grand_parent);
+    } else {
+        m_root = sibling;
+        m_nodes[sibling].parent = -1;
+        FreeNode(parent);
+    }
+
+    m_nodes[leaf].parent = -1;
+}
+
+// Rebalance and update heights and AABBs of all nodes from the given one up to the root.
+void ChAABBTree::Refit(int inode) {
+    while (inode >= 0) {
+        inode = Balance(inode);
+
+        Node& node = m_nodes[inode];
+        const Node& child1 = m_nodes[node.child1];
+        const Node& child2 = m_nodes[node.child2];
+        node.height = 1 + std::max(child1.height, child2.height);
+        node.aabb_min = Min(child1.aabb_min, child2.aabb_min);
+        node.aabb_max = Max(child1.aabb_max, child2.aabb_max);
+
+        inode = node.parent;
+    }
+}
+
+// Perform a left or right rotation if node A is imbalanced. Return the new root of the subtree.
+// Notation: A has children B and C; B has children D and E; C has children F and G.
+int ChAABBTree::Balance(int iA) {
+    Node& A = m_nodes[iA];
+    if (A.IsLeaf() || A.height < 2)
+        return iA;
+
+    int iB = A.child1;
+    int iC = A.child2;
+    Node& B = m_nodes[iB];
+    Node& C = m_nodes[iC];
+
+    int balance = C.height - B.height;
+
+    // Rotate C up
+    if (balance > 1) {
+        int iF = C.child1;
+        int iG = C.child2;
+        Node& F = m_nodes[iF];
+        Node& G = m_nodes[iG];
+
+        // Swap A and C
+        C.child1 = iA;
+        C.parent = A.parent;
+        A.parent = iC;
+
+        // A's old parent should point to C
+        if (C.parent >= 0) {
+            if (m_nodes[C.parent].child1 == iA)
+                m_nodes[C.parent].child1 = iC;
+            else
+                m_nodes[C.parent].child2 = iC;
+        } else {
+            m_root = iC;
+        }
+
+        // Rotate
+        if (F.height > G.height) {
+            C.child2 = iF;
+            A.child2 = iG;
+            G.parent = iA;
+            A.aabb_min = Min(B.aabb_min, G.aabb_min);
+            A.aabb_max = Max(B.aabb_max, G.aabb_max);
+            C.aabb_min = Min(A.aabb_min, F.aabb_min);
+            C.aabb_max = Max(A.aabb_max, F.aabb_max);
+            A.height = 1 + std::max(B.height, G.height);
+            C.height = 1 + std::max(A.height, F.height);
+        } else {
+            C.child2 = iG;
+            A.child2 = iF;
+            F.parent = iA;
+            A.aabb_min = Min(B.aabb_min, F.aabb_min);
+            A.aabb_max = Max(B.aabb_max, F.aabb_max);
+            C.aabb_min = Min(A.aabb_min, G.aabb_min);
+            C.aabb_max = Max(A.aabb_max, G.aabb_max);
+            A.height = 1 + std::max(B.height, F.height);
+            C.height = 1 + std::max(A.height, G.height);
+        }
+
+        return iC;
+    }
+
+    // Rotate B up
+    if (balance < -1) {
+        int iD = B.child1;
+        int iE = B.child2;
+        Node& D = m_nodes[iD];
+        Node& E = m_nodes[iE];
+
+        // Swap A and B
+        B.child1 = iA;
+        B.parent = A.parent;
+        A.parent = iB;
+
+        // A's old parent should point to B
+        if (B.parent >= 0) {
+            if (m_nodes[B.parent].child1 == iA)
+                m_nodes[B.parent].child1 = iB;
+            else
+                m_nodes[B.parent].child2 = iB;
+        } else {
+            m_root = iB;
+        }
+
+        // Rotate
+        if (D.height > E.height) {
+            B.child2 = iD;
+            A.child1 = iE;
+            E.parent = iA;
+            A.aabb_min = Min(C.aabb_min, E.aabb_min);
+            A.aabb_max = Max(C.aabb_max, E.aabb_max);
+            B.aabb_min = Min(A.aabb_min, D.aabb_min);
+            B.aabb_max = Max(A.aabb_max, D.aabb_max);
+            A.height = 1 + std::max(C.height, E.height);
+            B.height = 1 + std::max(A.height, D.height);
+        } else {
+            B.child2 = iE;
+            A.child1 = iD;
+            D.parent = iA;
+            A.aabb_min = Min(C.aabb_min, D.aabb_min);
+            A.aabb_max = Max(C.aabb_max, D.aabb_max);
+            B.aabb_min = Min(A.aabb_min, E.aabb_min);
+            B.aabb_max = Max(A.aabb_max, E.aabb_max);
+            A.height = 1 + std::max(C.height, D.height);
+            B.height = 1 + std::max(A.height, E.height);
+        }
+
+        return iB;
+    }
+
+    return iA;
+}
+
+bool ChAABBTree::Overlap(const Node& node, const real3& aabb_min, const real3& aabb_max) {
+    return (node.aabb_min.x <= aabb_max.x && aabb_min.x <= node.aabb_max.x) &&
+           (node.aabb_min.y <= aabb_max.y && aabb_min.y <= node.aabb_max.y) &&
+           (node.aabb_min.z <= aabb_max.z && aabb_min.z <= node.aabb_max.z);
+}
+
+bool ChAABBTree::RayAABB(const real3& start, const real3& ray, const Node& node, real t_max) {
+    real t0 = 0;
+    real t1 = t_max;
+    for (unsigned int i = 0; i < 3; i++) {
+        if (ray[i] == 0) {
+            // Segment parallel to slab: no intersection if it starts outside
+            if (start[i] < node.aabb_min[i] || start[i] > node.aabb_max[i])
+                return false;
+            continue;
+        }
+        real inv = 1 / ray[i];
+        real ta = (node.aabb_min[i] - start[i]) * inv;
+        real tb = (node.aabb_max[i] - start[i]) * inv;
+        if (ta > tb)
+            std::swap(ta, tb);
+        t0 = std::max(t0, ta);
+        t1 = std::min(t1, tb);
+        if (t0 > t1)
+            return false;
+    }
+    return true;
+}
+
+}  // end namespace collision
+}  // end namespace chrono
@@ -0,0 +1,164 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2021 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Dynamic AABB tree
+//
+// =============================================================================
+
+#pragma once
+
+#include <vector>
+
+#include "chrono/core/ChApiCE.h"
+#include "chrono/multicore_math/real3.h"
+
+namespace chrono {
+namespace collision {
+
+/// @addtogroup collision_mc
+/// @{
+
+/// Dynamic (incrementally updated) AABB tree.
+/// Leaves (proxies) can be inserted, removed, and moved individually; the tree is kept balanced with AVL-like rotations
+/// and new leaves are placed using a surface area heuristic. Typically, leaves store enlarged ("fat") AABBs, so that a
+/// proxy needs to be moved only when the object it represents leaves its fat AABB.
+class ChApi ChAABBTree {
+  public:
+    ChAABBTree();
+
+    /// Insert a new leaf with the given AABB, associated with the specified item. Return the proxy identifier.
+    int Insert(const real3& aabb_min, const real3& aabb_max, uint item);
+
+    /// Remove the specified leaf.
+    void Remove(int proxy);
+
+    /// Change the AABB of the specified leaf (the proxy identifier is preserved).
+    void Move(int proxy, const real3& aabb_min, const real3& aabb_max);
+
+    /// Delete all nodes.
+    void Clear();
+
+    /// Return the item associated with the specified leaf.
+    uint GetItem(int proxy) const { return m_nodes[proxy].item; }
+
+    /// Return the lower corner of the AABB of the specified leaf.
+    const real3& GetMin(int proxy) const { return m_nodes[proxy].aabb_min; }
+
+    /// Return the upper corner of the AABB of the specified leaf.
+    const real3& GetMax(int proxy) const { return m_nodes[proxy].aabb_max; }
+
+    /// Return the number of leaves in the tree.
+    int GetNumLeaves() const { return m_num_leaves; }
+
+    /// Return the height of the tree (0 for an empty tree or a tree with a single leaf).
+    int GetHeight() const { return m_root < 0 ? 0 : m_nodes[m_root].height; }
+
+    /// Invoke 'callback(item)' for all leaves with an AABB overlapping the given box.
+    template <typename Tfunc>
+    void Query(const real3& aabb_min, const real3& aabb_max, Tfunc&& callback) const;
+
+    /// Traverse the tree along the segment from 'start' to 'end'.
+    /// Nodes are skipped if the segment enters their AABB past the ray parameter 't_max'. For each leaf reached,
+    /// 'test(item)' is invoked; it must return the ray parameter (in [0,1]) of the closest intersection found so far,
+    /// which becomes the new 't_max'.
+    template <typename Tfunc>
+    void RayTraverse(const real3& start, const real3& end, real& t_max, Tfunc&& test) const;
+
+  private:
+    struct Node {
+        real3 aabb_min;  ///< lower corner of node AABB
+        real3 aabb_max;  ///< upper corner of node AABB
+        uint item;       ///< associated item (leaves only)
+        int parent;      ///< parent node (-1 for root)
+        int next;        ///< next node in free list
+        int child1;      ///< first child (-1 for leaves)
+        int child2;      ///< second child (-1 for leaves)
+        int height;      ///< height of subtree (0 for leaves, -1 for free nodes)
+        bool IsLeaf() const { return child1 < 0; }
+    };
+
+    int AllocateNode();
+    void FreeNode(int inode);
+    void InsertLeaf(int leaf);
+    void RemoveLeaf(int leaf);
+    int Balance(int iA);
+    void Refit(int inode);
+
+    static bool Overlap(const Node& node, const real3& aabb_min, const real3& aabb_max);
+    static bool RayAABB(const real3& start, const real3& ray, const Node& node, real t_max);
+
+    std::vector<Node> m_nodes;  ///< node storage (including free nodes)
+    int m_root;                 ///< root node (-1 if empty)
+    int m_free;                 ///< head of free list (-1 if none)
+    int m_num_leaves;           ///< number of leaves in the tree
+};
+
+/// @} collision_mc
+
+// -----------------------------------------------------------------------------
+
+template <typename Tfunc>
+void ChAABBTree::Query(const real3& aabb_min, const real3& aabb_max, Tfunc&& callback) const {
+    if (m_root < 0)
+        return;
+
+    std::vector<int> stack;
+    stack.reserve(64);
+    stack.push_back(m_root);
+
+    while (!stack.empty()) {
+        int inode = stack.back();
+        stack.pop_back();
+
+        const Node& node = m_nodes[inode];
+        if (!Overlap(node, aabb_min, aabb_max))
+            continue;
+
+        if (node.IsLeaf()) {
+            callback(node.item);
+        } else {
+            stack.push_back(node.child1);
+            stack.push_back(node.child2);
+        }
+    }
+}
+
+template <typename Tfunc>
+void ChAABBTree::RayTraverse(const real3& start, const real3& end, real& t_max, Tfunc&& test) const {
+    if (m_root < 0)
+        return;
+
+    real3 ray = end - start;
+
+    std::vector<int> stack;
+    stack.reserve(64);
+    stack.push_back(m_root);
+
+    while (!stack.empty()) {
+        int inode = stack.back();
+        stack.pop_back();
+
+        const Node& node = m_nodes[inode];
+        if (!RayAABB(start, ray, node, t_max))
+            continue;
+
+        if (node.IsLeaf()) {
+            t_max = test(node.item);
+        } else {
+            stack.push_back(node.child1);
+            stack.push_back(node.child2);
+        }
+    }
+}
+
+}  // end namespace collision
+}  // end namespace chrono
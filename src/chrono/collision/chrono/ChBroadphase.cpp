@@ -39,6 +39,9 @@ ChBroadphase::ChBroadphase()
       grid_resolution(vec3(10, 10, 10)),
       bin_size(real3(1, 1, 1)),
       grid_density(5),
+      method(Method::GRID),
+      tree_margin(real(0.1)),
+      tree_reset(true),
       cd_data(nullptr) {}
 
 // -----------------------------------------------------------------------------
@@ -197,6 +200,8 @@ void ChBroadphase::ComputeTopLevelResolution() {
             bins_per_axis.z = (int)std::ceil(diag.z / bin_size.z);
             break;
         case GridType::FIXED_DENSITY:
+        case GridType::HIERARCHICAL:
+            // For a hierarchical grid, this single-level grid is used only for rigid-fluid interaction
             bins_per_axis = Compute_Grid_Resolution(num_shapes, diag, grid_density);
     }
 
@@ -219,7 +224,15 @@ void ChBroadphase::Process() {
     ComputeTopLevelResolution();
 
     if (cd_data->num_rigid_shapes != 0) {
-        OneLevelBroadphase();
+        // Rigid-fluid collision detection requires a single-level grid
+        bool fluid = cd_data->state_data.num_fluid_bodies != 0;
+        cd_data->use_aabb_tree = (method == Method::DYNAMIC_TREE && !fluid);
+        if (cd_data->use_aabb_tree)
+            TreeBroadphase();
+        else if (grid_type == GridType::HIERARCHICAL && !fluid)
+            HierarchicalBroadphase();
+        else
+            OneLevelBroadphase();
         cd_data->num_rigid_contacts = cd_data->num_possible_collisions;
     }
     return;
@@ -253,6 +266,7 @@ void ChBroadphase::OneLevelBroadphase() {
     uint& num_possible_collisions = cd_data->num_possible_collisions;
 
     num_bins = bins_per_axis.x * bins_per_axis.y * bins_per_axis.z;
+    cd_data->num_grid_levels = 0;
 
     bin_intersections.resize(num_shapes + 1);
     bin_intersections[num_shapes] = 0;
@@ -344,5 +358,458 @@ void ChBroadphase::OneLevelBroadphase() {
     }
 }
 
+// -----------------------------------------------------------------------------
+
+// Assign each shape to the level of the hierarchical grid with the smallest bin size not smaller than its AABB.
+// The bin size at the finest level is the median AABB size; the bin size doubles at each coarser level, until a
+// single bin covers the entire domain. Shapes on inactive or non-colliding bodies are not placed in the grid.
+void ChBroadphase::AssignGridLevels() {
+    const std::vector<uint>& obj_data_id = cd_data->shape_data.id_rigid;
+    const std::vector<char>& obj_collide = *cd_data->state_data.collide_rigid;
+    const std::vector<real3>& aabb_min = cd_data->aabb_min;
+    const std::vector<real3>& aabb_max = cd_data->aabb_max;
+    const int num_shapes = cd_data->num_rigid_shapes;
+
+    std::vector<int>& shape_level = cd_data->shape_level;
+    shape_level.resize(num_shapes);
+
+    // Largest AABB dimension of each shape placed in the grid
+    std::vector<real> extent(num_shapes);
+    std::vector<real> sizes;
+    sizes.reserve(num_shapes);
+    for (int i = 0; i < num_shapes; i++) {
+        uint id = obj_data_id[i];
+        if (id == UINT_MAX || obj_collide[id] == 0) {
+            extent[i] = -1;
+            continue;
+        }
+        extent[i] = Max(aabb_max[i] - aabb_min[i]);
+        sizes.push_back(extent[i]);
+    }
+
+    cd_data->level_bin_size.clear();
+    cd_data->level_bins_per_axis.clear();
+    cd_data->level_num_shapes.clear();
+
+    if (sizes.empty()) {
+        cd_data->num_grid_levels = 0;
+        std::fill(shape_level.begin(), shape_level.end(), -1);
+        return;
+    }
+
+    std::nth_element(sizes.begin(), sizes.begin() + sizes.size() / 2, sizes.end());
+    real median = sizes[sizes.size() / 2];
+
+    // Limit the resolution of the finest level, so that cell keys do not overflow
+    real3 diag = Abs(cd_data->max_bounding_point - cd_data->global_origin);
+    real diag_max = Max(diag);
+    real size = Max(median, diag_max / (1 << 19));
+    if (!(size > 0))
+        size = (diag_max > 0) ? diag_max : real(1);
+
+    uint num_levels = 0;
+    while (true) {
+        cd_data->level_bin_size.push_back(size);
+        cd_data->level_bins_per_axis.push_back(vec3(Max(1, (int)std::ceil(diag.x / size)),
+                                                    Max(1, (int)std::ceil(diag.y / size)),
+                                                    Max(1, (int)std::ceil(diag.z / size))));
+        num_levels++;
+        if (size >= diag_max || num_levels == 32)
+            break;
+        size *= 2;
+    }
+
+    cd_data->num_grid_levels = num_levels;
+    cd_data->level_num_shapes.assign(num_levels, 0);
+
+    real base_size = cd_data->level_bin_size[0];
+    for (int i = 0; i < num_shapes; i++) {
+        if (extent[i] < 0) {
+            shape_level[i] = -1;
+            continue;
+        }
+        int level = 0;
+        if (extent[i] > base_size)
+            level = Min((int)std::ceil(std::log2(extent[i] / base_size)), (int)num_levels - 1);
+        // Guard against round-off in the logarithm
+        while (level < (int)num_levels - 1 && extent[i] > cd_data->level_bin_size[level])
+            level++;
+        shape_level[i] = level;
+        cd_data->level_num_shapes[level]++;
+    }
+}
+
+// Range of cells at given grid level intersected by the AABB with specified corners.
+// Both corners are hashed with HashMin, so that AABBs touching a cell boundary are also placed in the cell beyond.
+static inline void CellRange(const real3& min_p,
+                             const real3& max_p,
+                             real inv_size,
+                             const vec3& bins_per_axis,
+                             vec3& gmin,
+                             vec3& gmax) {
+    vec3 last = bins_per_axis - vec3(1, 1, 1);
+    gmin = Clamp(HashMin(min_p, real3(inv_size)), vec3(0, 0, 0), last);
+    gmax = Clamp(HashMin(max_p, real3(inv_size)), vec3(0, 0, 0), last);
+}
+
+// Visit all candidate pairs between the specified shape and shapes assigned to the same or coarser grid levels.
+// At the shape's own level, only pairs with a higher shape index are reported. Each pair is reported only once, in the
+// cell containing the lower corner of the intersection of the two AABBs.
+template <typename Tfunc>
+static void VisitHierarchicalPairs(uint shapeA, const ChCollisionData& data, Tfunc&& report) {
+    const std::vector<uint>& body_id = data.shape_data.id_rigid;
+    const std::vector<short2>& fam_data = data.shape_data.fam_rigid;
+    const std::vector<char>& body_active = *data.state_data.active_rigid;
+    const std::vector<char>& body_collide = *data.state_data.collide_rigid;
+    const std::vector<real3>& aabb_min = data.aabb_min;
+    const std::vector<real3>& aabb_max = data.aabb_max;
+    const std::vector<long long>& cell_active = data.cell_active;
+    const std::vector<uint>& bin_start_index = data.bin_start_index;
+    const std::vector<uint>& bin_aabb_number = data.bin_aabb_number;
+
+    int levelA = data.shape_level[shapeA];
+    if (levelA < 0)
+        return;
+
+    const real3& Amin = aabb_min[shapeA];
+    const real3& Amax = aabb_max[shapeA];
+    short2 famA = fam_data[shapeA];
+    uint bodyA = body_id[shapeA];
+
+    auto cells_begin = cell_active.begin();
+    auto cells_end = cell_active.begin() + data.num_active_bins;
+
+    for (int level = levelA; level < (int)data.num_grid_levels; level++) {
+        if (data.level_num_shapes[level] == 0)
+            continue;
+
+        real inv_size = 1 / data.level_bin_size[level];
+        const vec3& bins_per_axis = data.level_bins_per_axis[level];
+        vec3 gmin, gmax;
+        CellRange(Amin, Amax, inv_size, bins_per_axis, gmin, gmax);
+
+        for (int i = gmin.x; i <= gmax.x; i++) {
+            for (int j = gmin.y; j <= gmax.y; j++) {
+                for (int k = gmin.z; k <= gmax.z; k++) {
+                    vec3 cell(i, j, k);
+                    long long key = Hash_Index_Level(cell, bins_per_axis, level);
+                    auto it = std::lower_bound(cells_begin, cells_end, key);
+                    if (it == cells_end || *it != key)
+                        continue;
+                    auto icell = it - cells_begin;
+
+                    for (uint n = bin_start_index[icell]; n < bin_start_index[icell + 1]; n++) {
+                        uint shapeB = bin_aabb_number[n];
+                        if (level == levelA && shapeB <= shapeA)
+                            continue;
+                        uint bodyB = body_id[shapeB];
+                        if (bodyA == bodyB)
+                            continue;
+                        if (!body_active[bodyA] && !body_active[bodyB])
+                            continue;
+                        if (body_collide[bodyB] == 0)
+                            continue;
+                        if (!collide(famA, fam_data[shapeB]))
+                            continue;
+                        const real3& Bmin = aabb_min[shapeB];
+                        const real3& Bmax = aabb_max[shapeB];
+                        if (!overlap(Amin, Amax, Bmin, Bmax))
+                            continue;
+                        vec3 owner, dummy;
+                        CellRange(Max(Amin, Bmin), Max(Amin, Bmin), inv_size, bins_per_axis, owner, dummy);
+                        if (owner.x != i || owner.y != j || owner.z != k)
+                            continue;
+                        report(shapeA < shapeB ? ((long long)shapeA << 32 | (long long)shapeB)
+                                               : ((long long)shapeB << 32 | (long long)shapeA));
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Broadphase on a hierarchical grid. Each shape is placed in the (sparse) grid level matched to its size, where it
+// intersects at most 8 cells, and is tested only against shapes in cells of the same or coarser levels that its AABB
+// overlaps. Memory and work are therefore roughly linear in the number of shapes, regardless of the spread of shape
+// sizes.
+void ChBroadphase::HierarchicalBroadphase() {
+    const std::vector<real3>& aabb_min = cd_data->aabb_min;
+    const std::vector<real3>& aabb_max = cd_data->aabb_max;
+    std::vector<long long>& pair_shapeIDs = cd_data->pair_shapeIDs;
+    std::vector<uint>& bin_intersections = cd_data->bin_intersections;
+    std::vector<long long>& cell_number = cd_data->cell_number;
+    std::vector<long long>& cell_active = cd_data->cell_active;
+    std::vector<uint>& bin_aabb_number = cd_data->bin_aabb_number;
+    std::vector<uint>& bin_start_index = cd_data->bin_start_index;
+    std::vector<uint>& bin_num_contact = cd_data->bin_num_contact;
+    const std::vector<int>& shape_level = cd_data->shape_level;
+
+    const int num_shapes = cd_data->num_rigid_shapes;
+
+    uint& num_active_bins = cd_data->num_active_bins;
+    uint& num_bin_aabb_intersections = cd_data->num_bin_aabb_intersections;
+    uint& num_possible_collisions = cd_data->num_possible_collisions;
+
+    AssignGridLevels();
+
+    // The single-level grid data is not used with a hierarchical grid
+    cd_data->num_bins = 0;
+    cd_data->bin_active.clear();
+    cd_data->bin_start_index_ext.clear();
+
+    // Count the number of cells intersected by each shape AABB at its level -> bin_intersections
+    bin_intersections.resize(num_shapes + 1);
+    bin_intersections[num_shapes] = 0;
+
+#pragma omp parallel for
+    for (int i = 0; i < num_shapes; i++) {
+        int level = shape_level[i];
+        if (level < 0) {
+            bin_intersections[i] = 0;
+            continue;
+        }
+        vec3 gmin, gmax;
+        CellRange(aabb_min[i], aabb_max[i], 1 / cd_data->level_bin_size[level], cd_data->level_bins_per_axis[level],
+                  gmin, gmax);
+        bin_intersections[i] = (gmax.x - gmin.x + 1) * (gmax.y - gmin.y + 1) * (gmax.z - gmin.z + 1);
+    }
+
+    Thrust_Exclusive_Scan(bin_intersections);
+    num_bin_aabb_intersections = bin_intersections.back();
+
+    cell_number.resize(num_bin_aabb_intersections);
+    bin_aabb_number.resize(num_bin_aabb_intersections);
+    cell_active.resize(num_bin_aabb_intersections);
+    bin_start_index.resize(num_bin_aabb_intersections);
+
+    // For each shape, store the cell keys and the shape ID for intersections with this shape
+#pragma omp parallel for
+    for (int i = 0; i < num_shapes; i++) {
+        int level = shape_level[i];
+        if (level < 0)
+            continue;
+        const vec3& bins_per_axis = cd_data->level_bins_per_axis[level];
+        vec3 gmin, gmax;
+        CellRange(aabb_min[i], aabb_max[i], 1 / cd_data->level_bin_size[level], bins_per_axis, gmin, gmax);
+        uint count = bin_intersections[i];
+        for (int x = gmin.x; x <= gmax.x; x++) {
+            for (int y = gmin.y; y <= gmax.y; y++) {
+                for (int z = gmin.z; z <= gmax.z; z++) {
+                    cell_number[count] = Hash_Index_Level(vec3(x, y, z), bins_per_axis, level);
+                    bin_aabb_number[count] = i;
+                    count++;
+                }
+            }
+        }
+    }
+
+    // Find the active cells (sorted by level and cell index)
+    Thrust_Sort_By_Key(cell_number, bin_aabb_number);
+    num_active_bins = (uint)(Run_Length_Encode(cell_number, cell_active, bin_start_index));
+
+    if (num_active_bins <= 0) {
+        num_possible_collisions = 0;
+        pair_shapeIDs.clear();
+        return;
+    }
+
+    cell_active.resize(num_active_bins);
+    bin_start_index.resize(num_active_bins + 1);
+    bin_start_index[num_active_bins] = 0;
+    Thrust_Exclusive_Scan(bin_start_index);
+
+    // Count the number of candidate pairs reported by each shape -> bin_num_contact
+    bin_num_contact.resize(num_shapes + 1);
+    bin_num_contact[num_shapes] = 0;
+
+#pragma omp parallel for schedule(dynamic, 64)
+    for (int i = 0; i < num_shapes; i++) {
+        uint count = 0;
+        VisitHierarchicalPairs(i, *cd_data, [&count](long long) { count++; });
+        bin_num_contact[i] = count;
+    }
+
+    Thrust_Exclusive_Scan(bin_num_contact);
+    num_possible_collisions = bin_num_contact.back();
+    pair_shapeIDs.resize(num_possible_collisions);
+
+    // Store the list of shape pairs in potential collision
+#pragma omp parallel for schedule(dynamic, 64)
+    for (int i = 0; i < num_shapes; i++) {
+        uint offset = bin_num_contact[i];
+        VisitHierarchicalPairs(i, *cd_data, [&](long long pair) { pair_shapeIDs[offset++] = pair; });
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+// Check if the shapes in a candidate pair (with overlapping fat AABBs) are in potential collision.
+static inline bool TreePairFilter(uint shapeA, uint shapeB, const ChCollisionData& data) {
+    const std::vector<uint>& body_id = data.shape_data.id_rigid;
+    const std::vector<short2>& fam_data = data.shape_data.fam_rigid;
+    const std::vector<char>& body_active = *data.state_data.active_rigid;
+
+    uint bodyA = body_id[shapeA];
+    uint bodyB = body_id[shapeB];
+    if (bodyA == bodyB)
+        return false;
+    if (!body_active[bodyA] && !body_active[bodyB])
+        return false;
+    if (!collide(fam_data[shapeA], fam_data[shapeB]))
+        return false;
+    return overlap(data.aabb_min[shapeA], data.aabb_max[shapeA], data.aabb_min[shapeB], data.aabb_max[shapeB]);
+}
+
+// Broadphase with a dynamic AABB tree. The tree stores enlarged ("fat") shape AABBs, in absolute frame, and is updated
+// incrementally: only shapes whose AABB escaped their fat AABB are reinserted, and the persistent list of shape pairs
+// with overlapping fat AABBs is updated only for these shapes. The candidate pairs are then filtered with the actual
+// shape AABBs. For quasi-static scenes, the cost is therefore dominated by these two linear passes.
+void ChBroadphase::TreeBroadphase() {
+    const std::vector<uint>& obj_data_id = cd_data->shape_data.id_rigid;
+    const std::vector<char>& obj_collide = *cd_data->state_data.collide_rigid;
+    const std::vector<real3>& aabb_min = cd_data->aabb_min;
+    const std::vector<real3>& aabb_max = cd_data->aabb_max;
+    std::vector<long long>& pair_shapeIDs = cd_data->pair_shapeIDs;
+    std::vector<uint>& bin_num_contact = cd_data->bin_num_contact;
+    ChAABBTree& tree = cd_data->aabb_tree;
+
+    const int num_shapes = cd_data->num_rigid_shapes;
+    const real3 origin = cd_data->global_origin;  // AABBs were offset by the grid origin
+
+    // The grid data is not used with the dynamic tree
+    cd_data->num_grid_levels = 0;
+    cd_data->num_bins = 0;
+    cd_data->bin_active.clear();
+    cd_data->bin_start_index_ext.clear();
+
+    // Rebuild if shapes were added to or removed from the collision system, as shape indices may have changed
+    if (tree_reset || (int)tree_proxy.size() > num_shapes) {
+        tree.Clear();
+        tree_proxy.clear();
+        tree_pairs.clear();
+        tree_reset = false;
+    }
+    tree_proxy.resize(num_shapes, -1);
+    tree_pairs.resize(num_shapes);
+    tree_moved.resize(num_shapes);
+
+    // Identify shapes which must be inserted, moved, or removed from the tree
+#pragma omp parallel for
+    for (int i = 0; i < num_shapes; i++) {
+        uint id = obj_data_id[i];
+        int proxy = tree_proxy[i];
+        if (id == UINT_MAX || obj_collide[id] == 0) {
+            tree_moved[i] = (proxy >= 0) ? 2 : 0;
+            continue;
+        }
+        if (proxy < 0) {
+            tree_moved[i] = 1;
+            continue;
+        }
+        const real3& fat_min = tree.GetMin(proxy);
+        const real3& fat_max = tree.GetMax(proxy);
+        real3 tight_min = aabb_min[i] + origin;
+        real3 tight_max = aabb_max[i] + origin;
+        bool contained = fat_min.x <= tight_min.x && fat_min.y <= tight_min.y && fat_min.z <= tight_min.z &&
+                         fat_max.x >= tight_max.x && fat_max.y >= tight_max.y && fat_max.z >= tight_max.z;
+        tree_moved[i] = contained ? 0 : 1;
+    }
+
+    tree_moved_list.clear();
+    for (int i = 0; i < num_shapes; i++) {
+        if (tree_moved[i])
+            tree_moved_list.push_back(i);
+    }
+
+    if (!tree_moved_list.empty()) {
+        // Discard the candidate pairs of moved shapes
+        for (auto m : tree_moved_list) {
+            for (auto n : tree_pairs[m]) {
+                auto& list = tree_pairs[n];
+                auto it = std::find(list.begin(), list.end(), m);
+                if (it != list.end()) {
+                    *it = list.back();
+                    list.pop_back();
+                }
+            }
+            tree_pairs[m].clear();
+        }
+
+        // Update the tree
+        for (auto m : tree_moved_list) {
+            if (tree_moved[m] == 2) {
+                tree.Remove(tree_proxy[m]);
+                tree_proxy[m] = -1;
+                continue;
+            }
+            real3 tight_min = aabb_min[m] + origin;
+            real3 tight_max = aabb_max[m] + origin;
+            real margin = Max(tree_margin * Max(tight_max - tight_min), cd_data->collision_envelope);
+            if (tree_proxy[m] < 0)
+                tree_proxy[m] = tree.Insert(tight_min - margin, tight_max + margin, m);
+            else
+                tree.Move(tree_proxy[m], tight_min - margin, tight_max + margin);
+        }
+
+        // Find new candidate pairs for moved shapes. A pair of moved shapes is reported only by the one with the
+        // smaller index.
+        int num_moved = (int)tree_moved_list.size();
+        std::vector<std::vector<uint>> found(num_moved);
+#pragma omp parallel for schedule(dynamic, 16)
+        for (int k = 0; k < num_moved; k++) {
+            uint m = tree_moved_list[k];
+            if (tree_moved[m] != 1)
+                continue;
+            int proxy = tree_proxy[m];
+            tree.Query(tree.GetMin(proxy), tree.GetMax(proxy), [&](uint n) {
+                if (n == m || (tree_moved[n] == 1 && n < m))
+                    return;
+                found[k].push_back(n);
+            });
+        }
+
+        for (int k = 0; k < num_moved; k++) {
+            uint m = tree_moved_list[k];
+            for (auto n : found[k]) {
+                tree_pairs[m].push_back(n);
+                tree_pairs[n].push_back(m);
+            }
+        }
+    }
+
+    // Every leaf is reported as an active bin (used to check for available broadphase data)
+    cd_data->num_active_bins = tree.GetNumLeaves();
+    cd_data->num_bin_aabb_intersections = tree.GetNumLeaves();
+
+    // Filter the candidate pairs with the actual shape AABBs, counting the pairs reported by each shape
+    bin_num_contact.resize(num_shapes + 1);
+    bin_num_contact[num_shapes] = 0;
+
+#pragma omp parallel for
+    for (int i = 0; i < num_shapes; i++) {
+        uint count = 0;
+        for (auto n : tree_pairs[i]) {
+            if (n > (uint)i && TreePairFilter(i, n, *cd_data))
+                count++;
+        }
+        bin_num_contact[i] = count;
+    }
+
+    Thrust_Exclusive_Scan(bin_num_contact);
+    cd_data->num_possible_collisions = bin_num_contact.back();
+    pair_shapeIDs.resize(cd_data->num_possible_collisions);
+
+    // Store the list of shape pairs in potential collision, in increasing order
+#pragma omp parallel for
+    for (int i = 0; i < num_shapes; i++) {
+        uint offset = bin_num_contact[i];
+        for (auto n : tree_pairs[i]) {
+            if (n > (uint)i && TreePairFilter(i, n, *cd_data))
+                pair_shapeIDs[offset++] = ((long long)i << 32 | (long long)n);
+        }
+        std::sort(pair_shapeIDs.begin() + bin_num_contact[i], pair_shapeIDs.begin() + offset);
+    }
+}
+
 }  // end namespace collision
 }  // end namespace chrono
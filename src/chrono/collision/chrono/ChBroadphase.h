@@ -34,7 +34,14 @@ class ChApi ChBroadphase {
     enum class GridType {
         FIXED_RESOLUTION,  ///< user-specified number of bins in each direction
         FIXED_BIN_SIZE,    ///< user-specified grid bin dimension
-        FIXED_DENSITY      ///< user-specified density of shapes per bin
+        FIXED_DENSITY,     ///< user-specified density of shapes per bin
+        HIERARCHICAL       ///< multi-level grid, with each shape assigned to a level matching its AABB size
+    };
+
+    /// Broadphase algorithm
+    enum class Method {
+        GRID,         ///< spatial subdivision with a (single-level or hierarchical) grid, rebuilt at each call
+        DYNAMIC_TREE  ///< incrementally updated AABB tree with fattened AABBs and persistent candidate pairs
     };
 
     ChBroadphase();
@@ -45,6 +52,9 @@ class ChApi ChBroadphase {
 
   private:
     void OneLevelBroadphase();
+    void HierarchicalBroadphase();
+    void AssignGridLevels();
+    void TreeBroadphase();
     void DetermineBoundingBox();
     void OffsetAABB();
     void ComputeTopLevelResolution();
@@ -58,6 +68,15 @@ class ChApi ChBroadphase {
     real3 bin_size;        ///< (input) desired bin dimensions (used for GridType::FIXED_BIN_SIZE)
     real grid_density;     ///< (input) collision grid density (used for GridType::FIXED_DENSITY)
 
+    Method method;     ///< (input) broadphase algorithm
+    real tree_margin;  ///< (input) AABB enlargement, relative to AABB size (used for Method::DYNAMIC_TREE)
+
+    std::vector<int> tree_proxy;               ///< tree leaf of each shape (-1 if not in tree)
+    std::vector<std::vector<uint>> tree_pairs;  ///< shapes with fat AABB overlapping that of each shape
+    std::vector<char> tree_moved;              ///< shapes to be moved (1) or removed (2) from tree
+    std::vector<uint> tree_moved_list;         ///< list of shapes to be moved or removed from tree
+    bool tree_reset;                           ///< rebuild the tree at next call (set when the shape set changes)
+
     friend class ChCollisionSystemChrono;
     friend class ChCollisionSystemChronoMulticore;
 };
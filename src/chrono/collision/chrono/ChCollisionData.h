@@ -20,6 +20,7 @@
 #include <memory>
 
 #include "chrono/physics/ChContactContainer.h"
+#include "chrono/collision/chrono/ChAABBTree.h"
 
 #include "chrono/multicore_math/ChMulticoreMath.h"
 
@@ -108,6 +109,8 @@ class ChApi ChCollisionData {
           num_bin_aabb_intersections(0),
           num_active_bins(0),
           num_possible_collisions(0),
+          num_grid_levels(0),
+          use_aabb_tree(false),
           //
           rigid_min_bounding_point(real3(0)),
           rigid_max_bounding_point(real3(0)),
@@ -211,7 +214,20 @@ class ChApi ChCollisionData {
     std::vector<uint> bin_active;           ///< [num_active_bins] bin index of active bins (no duplicates)
     std::vector<uint> bin_start_index;      ///< [num_active_bins+1]
     std::vector<uint> bin_start_index_ext;  ///< [num_bins+1]
-    std::vector<uint> bin_num_contact;      ///< [num_active_bins+1]
+    std::vector<uint> bin_num_contact;      ///< [num_active_bins+1] ([num_rigid_shapes+1] for hierarchical grid or tree)
+
+    // Hierarchical grid data (used only with ChBroadphase::GridType::HIERARCHICAL)
+    uint num_grid_levels;                   ///< number of grid levels (0 if using a single-level grid)
+    std::vector<real> level_bin_size;       ///< [num_grid_levels] bin size (same in all directions) at each level
+    std::vector<vec3> level_bins_per_axis;  ///< [num_grid_levels] grid resolution at each level
+    std::vector<uint> level_num_shapes;     ///< [num_grid_levels] number of shapes assigned to each level
+    std::vector<int> shape_level;           ///< [num_rigid_shapes] grid level of each shape (-1 if not in grid)
+    std::vector<long long> cell_number;     ///< [num_bin_aabb_intersections] cell key for cell-shape AABB intersections
+    std::vector<long long> cell_active;     ///< [num_active_bins] cell key of active cells (sorted, no duplicates)
+
+    // Dynamic AABB tree data (used only with ChBroadphase::Method::DYNAMIC_TREE)
+    bool use_aabb_tree;    ///< true if the broadphase uses the dynamic AABB tree
+    ChAABBTree aabb_tree;  ///< tree of fattened shape AABBs (in absolute frame)
 
     // Indexing variables
     // ------------------
@@ -67,6 +67,13 @@ inline uint Hash_Index(const vec3& A, const vec3& bins_per_axis) {
     return ((A.z * bins_per_axis.y) * bins_per_axis.x) + (A.y * bins_per_axis.x) + A.x;
 }
 
+/// Convert bin coordinates at the specified level of a hierarchical grid into a unique cell key.
+/// The level is encoded in the top bits of the key, so that cells are sorted by level first.
+inline long long Hash_Index_Level(const vec3& A, const vec3& bins_per_axis, int level) {
+    return ((long long)level << 58) |
+           (((long long)A.z * bins_per_axis.y + A.y) * (long long)bins_per_axis.x + A.x);
+}
+
 /// Decode a bin index into its associated bin coordinates.
 inline vec3 Hash_Decode(uint hash, const vec3& bins_per_axis) {
     vec3 decoded_hash;
@@ -12,6 +12,8 @@
 // Authors: Radu Serban
 // =============================================================================
 
+#include <algorithm>
+
 #include "chrono/collision/chrono/ChRayTest.h"
 #include "chrono/collision/chrono/ChCollisionUtils.h"
 
@@ -378,6 +380,11 @@ bool triangle_ray(const real3& A,
 // Use a variant of the 3D Digital Differential Analyser (Akira Fujimoto, "ARTS: Accelerated Ray Tracing Systems", 1986)
 // to efficiently traverse the broadphase grid and analytical shape-ray intersection tests.
 bool ChRayTest::Check(const real3& start, const real3& end, RayHitInfo& info) {
+    if (cd_data->use_aabb_tree)
+        return CheckTree(start, end, info);
+    if (cd_data->num_grid_levels > 0)
+        return CheckHierarchical(start, end, info);
+
     // Readability replacements
     const vec3& bins_per_axis = cd_data->bins_per_axis;
     const real3& bin_size = cd_data->bin_size;
@@ -428,6 +435,7 @@ bool ChRayTest::Check(const real3& start, const real3& end, RayHitInfo& info) {
     ConvexShape shape(-1, &cd_data->shape_data);
     real mindist2 = C_REAL_MAX;
     bool hit = false;
+    uint hit_shape = 0;
 
     ////std::cout << "Ray start: [" << start.x << "," << start.y << "," << start.z << "]" << std::endl;
     ////std::cout << "Ray end:   [" << end.x << "," << end.y << "," << end.z << "]" << std::endl;
@@ -445,13 +453,15 @@ bool ChRayTest::Check(const real3& start, const real3& end, RayHitInfo& info) {
             num_shape_tests++;
             shape.index = bin_aabb_number[j];
             ////std::cout << "    Test SHAPE: " << shape.index << std::endl;
-            if (CheckShape(shape, start, end, info.normal, mindist2))
+            if (CheckShape(shape, start, end, info.normal, mindist2)) {
                 hit = true;
+                hit_shape = shape.index;
+            }
         }
 
         // If a shape in the current bin was hit, stop.
         if (hit) {
-            info.shapeID = shape.index;         // Identifier of closest hit shape
+            info.shapeID = hit_shape;           // Identifier of closest hit shape
             info.dist = Sqrt(mindist2);         // Distance from ray origin
             info.t = info.dist / Length(ray);   // Ray parameter at intersection with closest shape
             info.point = start + info.t * ray;  // Intersection point
@@ -471,6 +481,179 @@ bool ChRayTest::Check(const real3& start, const real3& end, RayHitInfo& info) {
     return hit;
 }
 
+// With a hierarchical grid, traverse each level with the DDA algorithm, looking up the (sparse) active cells. The
+// traversal of a level stops as soon as the ray enters a cell beyond the closest hit found so far.
+bool ChRayTest::CheckHierarchical(const real3& start, const real3& end, RayHitInfo& info) {
+    const real3& lbr = cd_data->min_bounding_point;
+    const real3& rtf = cd_data->max_bounding_point;
+    const std::vector<long long>& cell_active = cd_data->cell_active;
+    const std::vector<uint>& bin_start_index = cd_data->bin_start_index;
+    const std::vector<uint>& bin_aabb_number = cd_data->bin_aabb_number;
+
+    // Calculate ray parameter at intersection of overall AABB. Return now if no intersection
+    real3 center = 0.5 * (rtf + lbr), loc, normal;
+    real t_min;
+    if (!aabb_ray(0.5 * (rtf - lbr), start - center, end - center, t_min, loc, normal))
+        return false;
+
+    real3 ray = end - start;
+    real ray_len = Length(ray);
+    real3 entry = start + t_min * ray - lbr;  // ray entry point relative to grid LRB
+
+    auto cells_begin = cell_active.begin();
+    auto cells_end = cell_active.begin() + cd_data->num_active_bins;
+
+    ConvexShape shape(-1, &cd_data->shape_data);
+    real mindist2 = C_REAL_MAX;
+    real t_hit = 1;
+    bool hit = false;
+    uint hit_shape = 0;
+
+    for (int level = 0; level < (int)cd_data->num_grid_levels; level++) {
+        if (cd_data->level_num_shapes[level] == 0)
+            continue;
+
+        real size = cd_data->level_bin_size[level];
+        const vec3& bins_per_axis = cd_data->level_bins_per_axis[level];
+
+        // Entry cell and DDA increments (see Check)
+        auto bin = Clamp(HashMin(entry, real3(1 / size)), vec3(0, 0, 0), bins_per_axis - vec3(1, 1, 1));
+        real3 t_next(C_REAL_MAX);
+        real3 delta(0);
+        vec3 step;
+        vec3 exit;
+        for (int i = 0; i < 3; i++) {
+            if (ray[i] < 0) {
+                t_next[i] = t_min + (bin[i] * size - entry[i]) / ray[i];
+                delta[i] = -size / ray[i];
+                step[i] = -1;
+                exit[i] = -1;
+            }
+            if (ray[i] > 0) {
+                t_next[i] = t_min + ((bin[i] + 1) * size - entry[i]) / ray[i];
+                delta[i] = size / ray[i];
+                step[i] = +1;
+                exit[i] = bins_per_axis[i];
+            }
+        }
+
+        real t_cell = t_min;  // ray parameter at entry into current cell
+        while (t_cell <= t_hit) {
+            num_bin_tests++;
+
+            // Test ray against all shapes in current cell (if active)
+            long long key = Hash_Index_Level(bin, bins_per_axis, level);
+            auto it = std::lower_bound(cells_begin, cells_end, key);
+            if (it != cells_end && *it == key) {
+                auto icell = it - cells_begin;
+                for (uint j = bin_start_index[icell]; j < bin_start_index[icell + 1]; j++) {
+                    num_shape_tests++;
+                    shape.index = bin_aabb_number[j];
+                    if (CheckShape(shape, start, end, info.normal, mindist2)) {
+                        hit = true;
+                        hit_shape = shape.index;
+                        t_hit = Sqrt(mindist2) / ray_len;
+                    }
+                }
+            }
+
+            // Move to the next cell (the one with lowest t_next)
+            static const int map[8] = {2, 1, 2, 1, 2, 2, 0, 0};
+            int k = ((t_next[0] < t_next[1]) << 2) + ((t_next[0] < t_next[2]) << 1) + ((t_next[1] < t_next[2]));
+            int axis = map[k];
+            t_cell = t_next[axis];
+            bin[axis] += step[axis];
+            if (bin[axis] == exit[axis])
+                break;
+            t_next[axis] += delta[axis];
+        }
+    }
+
+    if (hit) {
+        info.shapeID = hit_shape;           // Identifier of closest hit shape
+        info.dist = Sqrt(mindist2);         // Distance from ray origin
+        info.t = info.dist / ray_len;       // Ray parameter at intersection with closest shape
+        info.point = start + info.t * ray;  // Intersection point
+    }
+
+    return hit;
+}
+
+// With a dynamic AABB tree, traverse the tree of (fat) shape AABBs, skipping subtrees entered beyond the closest hit.
+bool ChRayTest::CheckTree(const real3& start, const real3& end, RayHitInfo& info) {
+    real3 ray = end - start;
+    real ray_len = Length(ray);
+    if (ray_len == 0)
+        return false;
+
+    ConvexShape shape(-1, &cd_data->shape_data);
+    real mindist2 = C_REAL_MAX;
+    bool hit = false;
+    uint hit_shape = 0;
+    real t_max = 1;
+
+    cd_data->aabb_tree.RayTraverse(start, end, t_max, [&](uint index) {
+        num_shape_tests++;
+        shape.index = index;
+        if (CheckShape(shape, start, end, info.normal, mindist2)) {
+            hit = true;
+            hit_shape = index;
+        }
+        return hit ? Sqrt(mindist2) / ray_len : real(1);
+    });
+
+    if (hit) {
+        info.shapeID = hit_shape;           // Identifier of closest hit shape
+        info.dist = Sqrt(mindist2);         // Distance from ray origin
+        info.t = info.dist / ray_len;       // Ray parameter at intersection with closest shape
+        info.point = start + info.t * ray;  // Intersection point
+    }
+
+    return hit;
+}
+
+// Traverse the shape hierarchy with the ray expressed in the hierarchy frame, and test the shapes in visited leaves
+// (in absolute frame) with the analytical shape-ray intersection tests.
+bool ChRayTest::Check(const real3& start,
+                      const real3& end,
+                      const ChShapeBVH& bvh,
+                      const real3& pos,
+                      const quaternion& rot,
+                      RayHitInfo& info) {
+    real3 ray = end - start;
+    real len2 = Length2(ray);
+    if (len2 == 0)
+        return false;
+
+    real3 start_L = RotateT(start - pos, rot);
+    real3 end_L = RotateT(end - pos, rot);
+
+    ConvexShape shape(-1, &cd_data->shape_data);
+    real mindist2 = C_REAL_MAX;
+    bool hit = false;
+    uint hit_shape = 0;
+    real t_max = 1;
+
+    bvh.RayTraverse(start_L, end_L, t_max, [&](uint index) {
+        num_shape_tests++;
+        shape.index = index;
+        if (CheckShape(shape, start, end, info.normal, mindist2)) {
+            hit = true;
+            hit_shape = index;
+        }
+        return hit ? Sqrt(mindist2 / len2) : real(1);
+    });
+
+    if (hit) {
+        info.shapeID = hit_shape;           // Identifier of closest hit shape
+        info.dist = Sqrt(mindist2);         // Distance from ray origin
+        info.t = info.dist / Sqrt(len2);    // Ray parameter at intersection with closest shape
+        info.point = start + info.t * ray;  // Intersection point
+    }
+
+    return hit;
+}
+
 // Narrowphase dispatcher for ray intersection test.  It uses analytical formulaes for known primitive shapes with
 // fallback on a generic ray-convex intersection test.
 bool ChRayTest::CheckShape(const ConvexBase& shape,
@@ -20,6 +20,7 @@
 
 #include "chrono/collision/chrono/ChCollisionData.h"
 #include "chrono/collision/chrono/ChConvexShape.h"
+#include "chrono/collision/chrono/ChShapeBVH.h"
 
 namespace chrono {
 namespace collision {
@@ -49,6 +50,17 @@ class ChApi ChRayTest {
                RayHitInfo& info     ///< [output] test result info
     );
 
+    /// Check for intersection of the given ray with the collision shapes in the specified hierarchy.
+    /// The hierarchy is expressed in a frame with given position and orientation (typically the frame of the body
+    /// carrying the shapes). Only the shapes in leaves of the hierarchy crossed by the ray are tested.
+    bool Check(const real3& start,      ///< ray start point
+               const real3& end,        ///< ray end point
+               const ChShapeBVH& bvh,   ///< hierarchy of candidate shapes
+               const real3& pos,        ///< position of the hierarchy frame
+               const quaternion& rot,   ///< orientation of the hierarchy frame
+               RayHitInfo& info         ///< [output] test result info
+    );
+
     /// Return the number of bins visited by the DDA algorithm during the last ray test.
     uint GetNumBinTests() const { return num_bin_tests; }
 
@@ -56,6 +68,13 @@ class ChApi ChRayTest {
     uint GetNumShapeTests() const { return num_shape_tests; }
 
   private:
+    /// Ray intersection test with a hierarchical broadphase grid.
+    /// The 3D DDA traversal is performed separately at each non-empty grid level.
+    bool CheckHierarchical(const real3& start, const real3& end, RayHitInfo& info);
+
+    /// Ray intersection test with a dynamic AABB tree broadphase.
+    bool CheckTree(const real3& start, const real3& end, RayHitInfo& info);
+
     /// Dispatcher for analytic functions for ray intersection with primitive shapes.
     bool CheckShape(const ConvexBase& shape,  ///< candidate shape
                     const real3& start,       ///< ray start point
@@ -0,0 +1,146 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2021 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Bounding volume hierarchy over a set of collision shapes
+//
+// =============================================================================
+
+#include <algorithm>
+
+#include "chrono/collision/chrono/ChShapeBVH.h"
+
+namespace chrono {
+namespace collision {
+
+void ChShapeBVH::Build(const std::vector<uint>& shapes,
+                       const std::vector<real3>& aabb_min,
+                       const std::vector<real3>& aabb_max) {
+    Clear();
+
+    int num_shapes = (int)shapes.size();
+    if (num_shapes == 0)
+        return;
+
+    m_shapes = shapes;
+    m_min = aabb_min;
+    m_max = aabb_max;
+    m_center.resize(num_shapes);
+    for (int i = 0; i < num_shapes; i++)
+        m_center[i] = 0.5 * (aabb_min[i] + aabb_max[i]);
+
+    m_nodes.reserve(2 * (num_shapes / max_leaf_size + 1));
+    BuildNode(0, num_shapes, 0);
+
+    // Per-shape build data no longer needed
+    m_min = std::vector<real3>();
+    m_max = std::vector<real3>();
+    m_center = std::vector<real3>();
+}
+
+void ChShapeBVH::Clear() {
+    m_nodes.clear();
+    m_shapes.clear();
+}
+
+// Recursively build the subtree over the shapes in [first, first + count), splitting at the median of the shape
+// centers along the longest extent of their bounding box. Returns the index of the subtree root.
+int ChShapeBVH::BuildNode(int first, int count, int depth) {
+    int inode = (int)m_nodes.size();
+    m_nodes.push_back(Node());
+
+    real3 node_min = m_min[first];
+    real3 node_max = m_max[first];
+    real3 cmin = m_center[first];
+    real3 cmax = m_center[first];
+    for (int i = first + 1; i < first + count; i++) {
+        node_min = Min(node_min, m_min[i]);
+        node_max = Max(node_max, m_max[i]);
+        cmin = Min(cmin, m_center[i]);
+        cmax = Max(cmax, m_center[i]);
+    }
+    m_nodes[inode].aabb_min = node_min;
+    m_nodes[inode].aabb_max = node_max;
+
+    real3 extent = cmax - cmin;
+    if (count <= max_leaf_size || depth >= max_depth - 1 || (extent.x <= 0 && extent.y <= 0 && extent.z <= 0)) {
+        m_nodes[inode].first = first;
+        m_nodes[inode].count = count;
+        return inode;
+    }
+
+    int axis = 0;
+    if (extent.y > extent[axis])
+        axis = 1;
+    if (extent.z > extent[axis])
+        axis = 2;
+
+    // Partition the shapes (and their build data) about the median center along the split axis
+    std::vector<int> order(count);
+    for (int i = 0; i < count; i++)
+        order[i] = first + i;
+    int half = count / 2;
+    std::nth_element(order.begin(), order.begin() + half, order.end(),
+                     [this, axis](int a, int b) { return m_center[a][axis] < m_center[b][axis]; });
+
+    std::vector<uint> shapes(count);
+    std::vector<real3> smin(count), smax(count), scenter(count);
+    for (int i = 0; i < count; i++) {
+        shapes[i] = m_shapes[order[i]];
+        smin[i] = m_min[order[i]];
+        smax[i] = m_max[order[i]];
+        scenter[i] = m_center[order[i]];
+    }
+    std::copy(shapes.begin(), shapes.end(), m_shapes.begin() + first);
+    std::copy(smin.begin(), smin.end(), m_min.begin() + first);
+    std::copy(smax.begin(), smax.end(), m_max.begin() + first);
+    std::copy(scenter.begin(), scenter.end(), m_center.begin() + first);
+
+    // First child is stored right after this node, second child after the first subtree
+    BuildNode(first, half, depth + 1);
+    int second = BuildNode(first + half, count - half, depth + 1);
+
+    m_nodes[inode].first = second;
+    m_nodes[inode].count = 0;
+    return inode;
+}
+
+bool ChShapeBVH::RayAABB(const real3& start,
+                         const real3& ray,
+                         const real3& aabb_min,
+                         const real3& aabb_max,
+                         real t_max,
+                         real& t_entry) {
+    real t0 = 0;
+    real t1 = t_max;
+    for (unsigned int i = 0; i < 3; i++) {
+        if (ray[i] == 0) {
+            // Segment parallel to slab: no intersection if it starts outside
+            if (start[i] < aabb_min[i] || start[i] > aabb_max[i])
+                return false;
+            continue;
+        }
+        real inv = 1 / ray[i];
+        real ta = (aabb_min[i] - start[i]) * inv;
+        real tb = (aabb_max[i] - start[i]) * inv;
+        if (ta > tb)
+            std::swap(ta, tb);
+        t0 = Max(t0, ta);
+        t1 = Min(t1, tb);
+        if (t0 > t1)
+            return false;
+    }
+    t_entry = t0;
+    return true;
+}
+
+}  // end namespace collision
+}  // end namespace chrono
@@ -0,0 +1,149 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2021 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Bounding volume hierarchy over a set of collision shapes
+//
+// =============================================================================
+
+#pragma once
+
+#include <vector>
+
+#include "chrono/collision/chrono/ChCollisionData.h"
+
+namespace chrono {
+namespace collision {
+
+/// @addtogroup collision_mc
+/// @{
+
+/// Bounding volume hierarchy (binary AABB tree) over a set of collision shapes.
+/// The shape AABBs must be expressed in a common frame, typically the frame of the body carrying the shapes, so that
+/// the hierarchy remains valid as the body moves. Nodes are stored in depth-first order in a flat array.
+class ChApi ChShapeBVH {
+  public:
+    ChShapeBVH() {}
+
+    /// Build the hierarchy over the specified shapes.
+    /// The AABB of the shape shapes[i] is given by aabb_min[i] and aabb_max[i].
+    void Build(const std::vector<uint>& shapes,      ///< shape indices
+               const std::vector<real3>& aabb_min,  ///< lower corners of shape AABBs
+               const std::vector<real3>& aabb_max   ///< upper corners of shape AABBs
+    );
+
+    /// Delete the hierarchy.
+    void Clear();
+
+    /// Return true if the hierarchy contains no shapes.
+    bool IsEmpty() const { return m_nodes.empty(); }
+
+    /// Return the number of shapes in the hierarchy.
+    int GetNumShapes() const { return (int)m_shapes.size(); }
+
+    /// Return the number of nodes in the hierarchy.
+    int GetNumNodes() const { return (int)m_nodes.size(); }
+
+    /// Traverse the hierarchy along the segment from 'start' to 'end' (expressed in the frame of the hierarchy).
+    /// Nodes are visited front to back and skipped if the segment enters their AABB past the ray parameter 't_max'.
+    /// For each shape in a visited leaf, 'test(shape)' is invoked; it must return the ray parameter (in [0,1]) of the
+    /// closest intersection found so far, which becomes the new 't_max'.
+    template <typename Tfunc>
+    void RayTraverse(const real3& start, const real3& end, real& t_max, Tfunc&& test) const;
+
+  private:
+    struct Node {
+        real3 aabb_min;  ///< lower corner of node AABB
+        real3 aabb_max;  ///< upper corner of node AABB
+        int first;       ///< leaf: index of first shape; internal: index of second child (first child follows node)
+        int count;       ///< number of shapes in leaf (0 for internal nodes)
+    };
+
+    static const int max_leaf_size = 4;
+    static const int max_depth = 64;
+
+    int BuildNode(int first, int count, int depth);
+
+    /// Return true if the segment intersects the given AABB before the ray parameter 't_max'.
+    /// On success, 't_entry' is the ray parameter at which the segment enters the AABB.
+    static bool RayAABB(const real3& start,
+                        const real3& ray,
+                        const real3& aabb_min,
+                        const real3& aabb_max,
+                        real t_max,
+                        real& t_entry);
+
+    std::vector<Node> m_nodes;    ///< tree nodes (root first)
+    std::vector<uint> m_shapes;   ///< shape indices, sorted by leaf
+    std::vector<real3> m_min;     ///< shape AABB lower corners (build only)
+    std::vector<real3> m_max;     ///< shape AABB upper corners (build only)
+    std::vector<real3> m_center;  ///< shape AABB centers (build only)
+};
+
+/// @} collision_mc
+
+// -----------------------------------------------------------------------------
+
+template <typename Tfunc>
+void ChShapeBVH::RayTraverse(const real3& start, const real3& end, real& t_max, Tfunc&& test) const {
+    if (m_nodes.empty())
+        return;
+
+    real3 ray = end - start;
+    real t_entry;
+    if (!RayAABB(start, ray, m_nodes[0].aabb_min, m_nodes[0].aabb_max, t_max, t_entry))
+        return;
+
+    // Nodes pending traversal, with the ray parameter at their entry point
+    int stack[max_depth + 1];
+    real stack_t[max_depth + 1];
+    int top = 0;
+    stack[0] = 0;
+    stack_t[0] = t_entry;
+
+    while (top >= 0) {
+        int inode = stack[top];
+        real t_node = stack_t[top];
+        top--;
+
+        if (t_node > t_max)
+            continue;
+
+        const Node& node = m_nodes[inode];
+        if (node.count > 0) {
+            for (int i = node.first; i < node.first + node.count; i++)
+                t_max = test(m_shapes[i]);
+            continue;
+        }
+
+        // Push the children so that the one entered first is visited first
+        int child1 = inode + 1;
+        int child2 = node.first;
+        real t1, t2;
+        bool hit1 = RayAABB(start, ray, m_nodes[child1].aabb_min, m_nodes[child1].aabb_max, t_max, t1);
+        bool hit2 = RayAABB(start, ray, m_nodes[child2].aabb_min, m_nodes[child2].aabb_max, t_max, t2);
+        if (hit1 && hit2 && t2 < t1) {
+            std::swap(child1, child2);
+            std::swap(t1, t2);
+        }
+        if (hit2) {
+            stack[++top] = child2;
+            stack_t[top] = t2;
+        }
+        if (hit1) {
+            stack[++top] = child1;
+            stack_t[top] = t1;
+        }
+    }
+}
+
+}  // end namespace collision
+}  // end namespace chrono
@@ -1317,7 +1317,28 @@ unsigned int ChContactSurfaceMesh::GetNumVertices() const {
     return (unsigned int)(count + count_rot);
 }
 
+void ChContactSurfaceMesh::UseMeshCollisionModel(bool val) {
+    if (val && !m_mesh_model)
+        m_mesh_model = chrono_types::make_shared<collision::ChCollisionModelBulletGroup>();
+    else if (!val)
+        m_mesh_model.reset();
+}
+
 void ChContactSurfaceMesh::SurfaceSyncCollisionModels() {
+    if (m_mesh_model) {
+        // Nothing to do before the triangles are grouped (see SurfaceAddCollisionModelsToSystem)
+        if (m_mesh_model->GetNumMembers() == 0)
+            return;
+
+        // Triangle shapes use the absolute node positions, so only the grouping hierarchy must be updated
+        int nthreads = 1;
+        if (m_physics_item && m_physics_item->GetSystem())
+            nthreads = m_physics_item->GetSystem()->GetNumThreadsChrono();
+        m_mesh_model->SyncPosition();
+        m_mesh_model->Refit(nthreads);
+        return;
+    }
+
     for (unsigned int j = 0; j < vfaces.size(); j++) {
         vfaces[j]->GetCollisionModel()->SyncPosition();
     }
@@ -1328,6 +1349,28 @@ void ChContactSurfaceMesh::SurfaceSyncCollisionModels() {
 
 void ChContactSurfaceMesh::SurfaceAddCollisionModelsToSystem(ChSystem* msys) {
     assert(msys);
+
+    if (m_mesh_model) {
+        if (GetNumTriangles() == 0)
+            return;
+
+        // Group the current triangles (the contactable is only used for the identity frame of the model)
+        m_mesh_model->SetContactable(nullptr);
+        m_mesh_model->ClearModel();
+        for (auto& face : vfaces)
+            m_mesh_model->AddModel(static_cast<collision::ChCollisionModelBullet*>(face->GetCollisionModel()));
+        for (auto& face : vfaces_rot)
+            m_mesh_model->AddModel(static_cast<collision::ChCollisionModelBullet*>(face->GetCollisionModel()));
+        m_mesh_model->BuildModel();
+        if (!vfaces.empty())
+            m_mesh_model->SetContactable(vfaces[0].get());
+        else
+            m_mesh_model->SetContactable(vfaces_rot[0].get());
+
+        msys->GetCollisionSystem()->Add(m_mesh_model.get());
+        return;
+    }
+
     SurfaceSyncCollisionModels();
     for (unsigned int j = 0; j < vfaces.size(); j++) {
         msys->GetCollisionSystem()->Add(vfaces[j]->GetCollisionModel());
@@ -1339,6 +1382,12 @@ void ChContactSurfaceMesh::SurfaceAddCollisionModelsToSystem(ChSystem* msys) {
 
 void ChContactSurfaceMesh::SurfaceRemoveCollisionModelsFromSystem(ChSystem* msys) {
     assert(msys);
+
+    if (m_mesh_model) {
+        msys->GetCollisionSystem()->Remove(m_mesh_model.get());
+        return;
+    }
+
     for (unsigned int j = 0; j < vfaces.size(); j++) {
         msys->GetCollisionSystem()->Remove(vfaces[j]->GetCollisionModel());
     }
@@ -23,6 +23,11 @@
 #include "chrono/physics/ChLoaderUV.h"
 
 namespace chrono {
+
+namespace collision {
+class ChCollisionModelBulletGroup;
+}
+
 namespace fea {
 
 /// @addtogroup fea_contact
@@ -510,6 +515,19 @@ class ChApi ChContactSurfaceMesh : public ChContactSurface {
     /// Get the number of vertices.
     unsigned int GetNumVertices() const;
 
+    /// Enable/disable the use of a single collision model for the whole surface (default: false).
+    /// If enabled, the triangles are not added individually to the collision system, but are grouped in one collision
+    /// model whose bounding volume hierarchy is refitted as the mesh deforms. This reduces the broadphase cost for
+    /// surfaces with many triangles; however, contacts between triangles of the same surface are not detected.
+    /// The collision families of the individual triangles are then ignored: only the family of the grouping model is
+    /// used (see GetMeshCollisionModel).
+    /// This function must be called before the associated mesh is added to the system.
+    void UseMeshCollisionModel(bool val);
+
+    /// Get the collision model grouping all triangles of the surface (nullptr if not used).
+    /// Collision families must be set on this model when using a single collision model for the surface.
+    std::shared_ptr<collision::ChCollisionModelBulletGroup> GetMeshCollisionModel() const { return m_mesh_model; }
+
     // Functions to interface this with ChPhysicsItem container
     virtual void SurfaceSyncCollisionModels() override;
     virtual void SurfaceAddCollisionModelsToSystem(ChSystem* msys) override;
@@ -534,6 +552,7 @@ class ChApi ChContactSurfaceMesh : public ChContactSurface {
 
     std::vector<std::shared_ptr<ChContactTriangleXYZ>> vfaces;         ///< XYZ-node collision faces
     std::vector<std::shared_ptr<ChContactTriangleXYZROT>> vfaces_rot;  ///< XYWROT-node collision faces
+    std::shared_ptr<collision::ChCollisionModelBulletGroup> m_mesh_model;  ///< single collision model, if used
 };
 
 /// @} fea_contact
@@ -24,17 +24,14 @@ void ChElementGeneric::EleIntLoadResidual_F(ChVectorDynamic<>& R, const double c
     ComputeInternalForces(Fi);
     Fi *= c;
 
-    //// Attention: this is called from within a parallel OMP for loop.
-    //// Must use atomic increment when updating the global vector R.
+    //// Attention: this is called from within a parallel OMP for loop, but only concurrently with elements that
+    //// do not share nodes with this one (see ChMesh::ColorElements), so R can be updated without synchronization.
 
     int stride = 0;
     for (int in = 0; in < GetNnodes(); in++) {
         int node_dofs = GetNodeNdofs_active(in);
-        if (!GetNodeN(in)->IsFixed()) {
-            for (int j = 0; j < node_dofs; j++)
-#pragma omp atomic
-                R(GetNodeN(in)->NodeGetOffsetW() + j) += Fi(stride + j);
-        }
+        if (!GetNodeN(in)->IsFixed())
+            R.segment(GetNodeN(in)->NodeGetOffsetW(), node_dofs) += Fi.segment(stride, node_dofs);
         stride += GetNodeNdofs(in);
     }
     // GetLog() << "EleIntLoadResidual_F , R=" << R << "\n";
@@ -71,17 +68,14 @@ void ChElementGeneric::EleIntLoadResidual_F_gravity(ChVectorDynamic<>& R, const
     ComputeGravityForces(Fg, G_acc);
     Fg *= c;
 
-    //// Attention: this is called from within a parallel OMP for loop.
-    //// Must use atomic increment when updating the global vector R.
+    //// Attention: this is called from within a parallel OMP for loop, but only concurrently with elements that
+    //// do not share nodes with this one (see ChMesh::ColorElements), so R can be updated without synchronization.
 
     int stride = 0;
     for (int in = 0; in < GetNnodes(); in++) {
         int node_dofs = GetNodeNdofs_active(in);
-        if (!GetNodeN(in)->IsFixed()) {
-            for (int j = 0; j < node_dofs; j++)
-#pragma omp atomic
-                R(GetNodeN(in)->NodeGetOffsetW() + j) += Fg(stride + j);
-        }
+        if (!GetNodeN(in)->IsFixed())
+            R.segment(GetNodeN(in)->NodeGetOffsetW(), node_dofs) += Fg.segment(stride, node_dofs);
         stride += GetNodeNdofs(in);
     }
 }
@@ -18,6 +18,7 @@
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <unordered_map>
 
 #include "chrono/core/ChMath.h"
 #include "chrono/physics/ChLoad.h"
@@ -28,6 +29,7 @@
 #include "chrono/fea/ChMesh.h"
 #include "chrono/fea/ChNodeFEAxyz.h"
 #include "chrono/fea/ChNodeFEAxyzrot.h"
+#include "chrono/utils/ChTrace.h"
 
 namespace chrono {
 namespace fea {
@@ -45,6 +47,8 @@ ChMesh::ChMesh(const ChMesh& other) : ChIndexedNodes(other) {
     automatic_gravity_load = other.automatic_gravity_load;
     num_points_gravity = other.num_points_gravity;
 
+    element_colors_valid = false;
+
     ncalls_internal_forces = 0;
     ncalls_KRMload = 0;
 }
@@ -67,6 +71,9 @@ void ChMesh::SetupInitial() {
         // precompute matrices, such as the [Kl] local stiffness of each element, if needed, etc.
         velements[i]->SetupInitial(GetSystem());
     }
+
+    // element connectivity may have changed since the mesh was created
+    element_colors_valid = false;
 }
 
 void ChMesh::Relax() {
@@ -96,6 +103,7 @@ void ChMesh::AddNode(std::shared_ptr<ChNodeFEAbase> m_node) {
 
 void ChMesh::AddElement(std::shared_ptr<ChElementBase> m_elem) {
     velements.push_back(m_elem);
+    element_colors_valid = false;
 
     // If the mesh is already added to a system, mark the system uninitialized and out-of-date
     if (system) {
@@ -106,6 +114,7 @@ void ChMesh::AddElement(std::shared_ptr<ChElementBase> m_elem) {
 
 void ChMesh::ClearElements() {
     velements.clear();
+    element_colors_valid = false;
     vcontactsurfaces.clear();
 
     // If the mesh is already added to a system, mark the system out-of-date
@@ -116,6 +125,7 @@ void ChMesh::ClearElements() {
 
 void ChMesh::ClearNodes() {
     velements.clear();
+    element_colors_valid = false;
     vnodes.clear();
     vcontactsurfaces.clear();
 
@@ -155,6 +165,40 @@ void ChMesh::Setup() {
             n_dofs_w += vnodes[i]->GetNdofW_active();
         }
     }
+
+    if (!element_colors_valid)
+        ColorElements();
+}
+
+void ChMesh::ColorElements() {
+    element_colors.clear();
+
+    // colors already assigned to elements connected to each node
+    std::unordered_map<ChNodeFEAbase*, std::vector<unsigned int>> node_colors;
+    std::vector<bool> used;
+
+    for (unsigned int ie = 0; ie < velements.size(); ie++) {
+        auto& element = velements[ie];
+        int nnodes = element->GetNnodes();
+
+        // mark the colors of all elements sharing a node with this element
+        used.assign(element_colors.size(), false);
+        for (int in = 0; in < nnodes; in++) {
+            for (auto color : node_colors[element->GetNodeN(in).get()])
+                used[color] = true;
+        }
+
+        // pick the first free color, or create a new one
+        unsigned int color = (unsigned int)(std::find(used.begin(), used.end(), false) - used.begin());
+        if (color == element_colors.size())
+            element_colors.push_back(std::vector<unsigned int>());
+        element_colors[color].push_back(ie);
+
+        for (int in = 0; in < nnodes; in++)
+            node_colors[element->GetNodeN(in).get()].push_back(color);
+    }
+
+    element_colors_valid = true;
 }
 
 // Updates all time-dependant variables, if any...
@@ -295,23 +339,35 @@ void ChMesh::IntLoadResidual_F(const unsigned int off, ChVectorDynamic<>& R, con
     }
 
     int nthreads = GetSystem()->nthreads_chrono;
+    if (!element_colors_valid)
+        ColorElements();
 
     // elements internal forces
+    // Elements of the same color do not share nodes, so they can write to R concurrently.
+    // The work of each thread is traced, to expose load imbalance between threads.
     timer_internal_forces.start();
-    //***PARALLEL FOR***, must use omp atomic to avoid race condition in writing to R
-#pragma omp parallel for schedule(dynamic, 4) num_threads(nthreads)
-    for (int ie = 0; ie < velements.size(); ie++) {
-        velements[ie]->EleIntLoadResidual_F(R, c);
+    for (const auto& color : element_colors) {
+        int ncolor = (int)color.size();
+#pragma omp parallel num_threads(nthreads)
+        {
+            CH_TRACE("Mesh internal forces");
+#pragma omp for schedule(dynamic, 4)
+            for (int i = 0; i < ncolor; i++) {
+                velements[color[i]]->EleIntLoadResidual_F(R, c);
+            }
+        }
     }
     timer_internal_forces.stop();
     ncalls_internal_forces++;
 
     // elements gravity forces
     if (automatic_gravity_load) {
-        //***PARALLEL FOR***, must use omp atomic to avoid race condition in writing to R
+        for (const auto& color : element_colors) {
+            int ncolor = (int)color.size();
 #pragma omp parallel for schedule(dynamic, 4) num_threads(nthreads)
-        for (int ie = 0; ie < velements.size(); ie++) {
-            velements[ie]->EleIntLoadResidual_F_gravity(R, GetSystem()->Get_G_acc(), c);
+            for (int i = 0; i < ncolor; i++) {
+                velements[color[i]]->EleIntLoadResidual_F_gravity(R, GetSystem()->Get_G_acc(), c);
+            }
         }
     }
 
@@ -418,9 +474,13 @@ void ChMesh::KRMmatricesLoad(double Kfactor, double Rfactor, double Mfactor) {
     int nthreads = GetSystem()->nthreads_chrono;
 
     timer_KRMload.start();
-#pragma omp parallel for num_threads(nthreads)
-    for (int ie = 0; ie < velements.size(); ie++)
-        velements[ie]->KRMmatricesLoad(Kfactor, Rfactor, Mfactor);
+#pragma omp parallel num_threads(nthreads)
+    {
+        CH_TRACE("Mesh KRM load");
+#pragma omp for
+        for (int ie = 0; ie < velements.size(); ie++)
+            velements[ie]->KRMmatricesLoad(Kfactor, Rfactor, Mfactor);
+    }
     timer_KRMload.stop();
     ncalls_KRMload++;
 }
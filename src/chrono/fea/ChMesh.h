@@ -52,6 +52,9 @@ class ChApi ChMesh : public ChIndexedNodes {
     bool automatic_gravity_load;
     int num_points_gravity;
 
+    std::vector<std::vector<unsigned int>> element_colors;  ///< element indices, grouped by color
+    bool element_colors_valid;                              ///< false if elements changed since last coloring
+
     ChTimer timer_internal_forces;
     ChTimer timer_KRMload;
     int ncalls_internal_forces;
@@ -63,6 +66,7 @@ class ChApi ChMesh : public ChIndexedNodes {
           n_dofs_w(0),
           automatic_gravity_load(true),
           num_points_gravity(1),
+          element_colors_valid(false),
           ncalls_internal_forces(0),
           ncalls_KRMload(0) {}
     ChMesh(const ChMesh& other);
@@ -94,6 +98,12 @@ class ChApi ChMesh : public ChIndexedNodes {
     /// Get the number of elements in the mesh.
     unsigned int GetNelements() { return (unsigned int)velements.size(); }
 
+    /// Get the number of element colors.
+    /// Elements are partitioned in colors such that no two elements with the same color share a node; elements of
+    /// the same color can therefore load their forces concurrently, without synchronization. The coloring is
+    /// (re)computed in Setup() whenever elements were added or removed.
+    unsigned int GetNelementColors() const { return (unsigned int)element_colors.size(); }
+
     virtual int GetDOF() override { return n_dofs; }
     virtual int GetDOF_w() override { return n_dofs_w; }
 
@@ -291,6 +301,9 @@ class ChApi ChMesh : public ChIndexedNodes {
     /// </pre>
     virtual void SetupInitial() override;
 
+    /// Greedy coloring of the elements, such that elements with the same color do not share nodes.
+    void ColorElements();
+
     friend class chrono::ChSystem;
     friend class chrono::ChAssembly;
     friend class chrono::modal::ChModalAssembly;
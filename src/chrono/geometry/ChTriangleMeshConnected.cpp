@@ -21,10 +21,13 @@
 
 #include <algorithm>
 #include <cstdio>
+#include <cstring>
 #include <fstream>
 #include <map>
 
+#include "chrono/core/ChException.h"
 #include "chrono/geometry/ChTriangleMeshConnected.h"
+#include "chrono/utils/ChMappedFile.h"
 
 #include "chrono_thirdparty/filesystem/path.h"
 #include "chrono_thirdparty/tinyobjloader/tiny_obj_loader.h"
@@ -38,6 +41,8 @@ namespace geometry {
 // Register into the object factory, to enable run-time dynamic creation and persistence
 CH_FACTORY_REGISTER(ChTriangleMeshConnected)
 
+std::string ChTriangleMeshConnected::m_cache_dir;
+
 // -----------------------------------------------------------------------------
 
 ChTriangleMeshConnected::ChTriangleMeshConnected(const ChTriangleMeshConnected& source) {
@@ -62,6 +67,10 @@ ChTriangleMeshConnected::ChTriangleMeshConnected(const ChTriangleMeshConnected&
         this->m_properties_per_face[i] = source.m_properties_per_face[i]->clone();
 
     m_filename = source.m_filename;
+
+    m_adjacency = source.m_adjacency;
+    m_adjacency_pathological = source.m_adjacency_pathological;
+    m_adjacency_manifold = source.m_adjacency_manifold;
 }
 
 ChTriangleMeshConnected::~ChTriangleMeshConnected() {
@@ -79,6 +88,7 @@ void ChTriangleMeshConnected::addTriangle(const ChVector<>& vertex0,
     m_vertices.push_back(vertex1);
     m_vertices.push_back(vertex2);
     m_face_v_indices.push_back(ChVector<int>(base_v, base_v + 1, base_v + 2));
+    ClearAdjacency();
 }
 
 void ChTriangleMeshConnected::addTriangle(const ChTriangle& atriangle) {
@@ -87,6 +97,7 @@ void ChTriangleMeshConnected::addTriangle(const ChTriangle& atriangle) {
     m_vertices.push_back(atriangle.p2);
     m_vertices.push_back(atriangle.p3);
     m_face_v_indices.push_back(ChVector<int>(base_v, base_v + 1, base_v + 2));
+    ClearAdjacency();
 }
 
 void ChTriangleMeshConnected::Clear() {
@@ -107,6 +118,8 @@ void ChTriangleMeshConnected::Clear() {
     for (ChProperty* id : this->m_properties_per_face)
         delete (id);
     m_properties_per_vertex.clear();
+
+    ClearAdjacency();
 }
 
 ChGeometry::AABB ChTriangleMeshConnected::GetBoundingBox(const ChMatrix33<>& rot) const {
@@ -265,6 +278,24 @@ std::shared_ptr<ChTriangleMeshConnected> ChTriangleMeshConnected::CreateFromWave
 bool ChTriangleMeshConnected::LoadWavefrontMesh(const std::string& filename, bool load_normals, bool load_uv) {
     assert(filesystem::path(filename).is_file());
 
+    // Look for a cached copy of this mesh, keyed on file content and load options
+    std::string cache_file;
+    uint64_t cache_key = 0;
+    if (!m_cache_dir.empty()) {
+        uint64_t hash = ComputeFileHash(filename);
+        if (hash != 0) {
+            uint64_t options = (load_normals ? 1 : 0) | (load_uv ? 2 : 0);
+            cache_key = hash ^ ((options + 1) * 0x9E3779B97F4A7C15ULL);
+            char key_str[17];
+            std::snprintf(key_str, sizeof(key_str), "%016llx", (unsigned long long)cache_key);
+            cache_file = m_cache_dir + "/" + filesystem::path(filename).stem() + "_" + key_str + ".chmesh";
+            if (LoadCacheFile(cache_file, cache_key)) {
+                m_filename = filename;
+                return true;
+            }
+        }
+    }
+
     std::vector<tinyobj::shape_t> shapes;
     tinyobj::attrib_t att;
     std::vector<tinyobj::material_t> materials;
@@ -315,9 +346,256 @@ bool ChTriangleMeshConnected::LoadWavefrontMesh(const std::string& filename, boo
         }
     }
 
+    if (!cache_file.empty()) {
+        UpdateAdjacency();
+        if (!WriteCacheFile(cache_file, cache_key))
+            std::cerr << "Warning: cannot write mesh cache file " << cache_file << std::endl;
+    }
+
     return true;
 }
 
+// -----------------------------------------------------------------------------
+// Binary mesh cache
+//
+// A cache file stores the mesh arrays in the native binary layout, so that they can be copied from the
+// memory-mapped file without any parsing:
+//
+//   MeshCacheHeader                         (padded to 256 bytes)
+//   array 0 ... array N-1                   (each starting at a multiple of 8 bytes)
+//
+// The arrays are, in order: vertices, normals, UVs, colors, vertex/normal/UV/color indices of faces,
+// material indices of faces, and triangle adjacency map.
+// -----------------------------------------------------------------------------
+
+static const char mesh_cache_magic[8] = "CHMESH";
+static const uint32_t mesh_cache_version = 1;
+static const int mesh_cache_num_arrays = 10;
+static const size_t mesh_cache_header_size = 256;
+
+struct MeshCacheHeader {
+    char magic[8];                               ///< file identifier
+    uint32_t version;                            ///< file format version
+    uint32_t flags;                              ///< bit 0: pathological edges, bit 1: manifold adjacency
+    uint64_t key;                                ///< key of the cached mesh (source hash and load options)
+    uint64_t counts[mesh_cache_num_arrays];      ///< number of elements in each array
+    uint32_t elem_sizes[mesh_cache_num_arrays];  ///< size of the elements of each array (layout check)
+};
+
+static_assert(sizeof(MeshCacheHeader) <= mesh_cache_header_size, "Unexpected size of mesh cache header");
+
+static size_t MeshCacheAlign(size_t offset) {
+    return (offset + 7) & ~(size_t)7;
+}
+
+// Get the size in bytes of the cache file with given header
+static size_t MeshCacheSize(const MeshCacheHeader& header) {
+    size_t size = mesh_cache_header_size;
+    for (int i = 0; i < mesh_cache_num_arrays; i++)
+        size = MeshCacheAlign(size + header.counts[i] * header.elem_sizes[i]);
+    return size;
+}
+
+void ChTriangleMeshConnected::SetCacheDirectory(const std::string& dir) {
+    m_cache_dir = dir;
+    if (!dir.empty() && !filesystem::path(dir).is_directory())
+        filesystem::create_directory(filesystem::path(dir));
+}
+
+const std::string& ChTriangleMeshConnected::GetCacheDirectory() {
+    return m_cache_dir;
+}
+
+uint64_t ChTriangleMeshConnected::ComputeFileHash(const std::string& filename) {
+    utils::ChMappedFile file;
+    try {
+        file.OpenRead(filename);
+    } catch (const ChException&) {
+        return 0;
+    }
+
+    // 64-bit FNV-1a over 8-byte words, with an extra shift to fold high bits into low bits
+    const uint64_t prime = 0x100000001B3ULL;
+    const char* data = file.GetData();
+    size_t size = file.GetSize();
+    uint64_t hash = 0xCBF29CE484222325ULL ^ (uint64_t)size;
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, data + i, 8);
+        hash = (hash ^ word) * prime;
+        hash ^= hash >> 32;
+    }
+    for (; i < size; i++)
+        hash = (hash ^ (unsigned char)data[i]) * prime;
+
+    return hash != 0 ? hash : 1;
+}
+
+bool ChTriangleMeshConnected::WriteCacheFile(const std::string& filename, uint64_t key) const {
+    static_assert(sizeof(ChVector<double>) == 3 * sizeof(double), "Unexpected layout of ChVector");
+    static_assert(sizeof(ChVector<int>) == 3 * sizeof(int), "Unexpected layout of ChVector");
+    static_assert(sizeof(ChVector2<double>) == 2 * sizeof(double), "Unexpected layout of ChVector2");
+    static_assert(sizeof(std::array<int, 4>) == 4 * sizeof(int), "Unexpected layout of std::array");
+
+    // Use the stored triangle adjacency map if available, otherwise compute it
+    std::vector<std::array<int, 4>> tri_map_local;
+    const std::vector<std::array<int, 4>>* tri_map = &m_adjacency;
+    bool pathological = m_adjacency_pathological;
+    bool manifold = m_adjacency_manifold;
+    if (!HasAdjacency()) {
+        ChTriangleMeshConnected tmp;
+        tmp.m_face_v_indices = m_face_v_indices;
+        tmp.UpdateAdjacency();
+        tri_map_local = std::move(tmp.m_adjacency);
+        pathological = tmp.m_adjacency_pathological;
+        manifold = tmp.m_adjacency_manifold;
+        tri_map = &tri_map_local;
+    }
+
+    const void* arrays[mesh_cache_num_arrays] = {
+        m_vertices.data(),         m_normals.data(),          m_UV.data(),
+        m_colors.data(),           m_face_v_indices.data(),   m_face_n_indices.data(),
+        m_face_uv_indices.data(),  m_face_col_indices.data(), m_face_mat_indices.data(),
+        tri_map->data()};
+
+    MeshCacheHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, mesh_cache_magic, sizeof(header.magic));
+    header.version = mesh_cache_version;
+    header.flags = (pathological ? 1 : 0) | (manifold ? 2 : 0);
+    header.key = key;
+    header.counts[0] = m_vertices.size();
+    header.counts[1] = m_normals.size();
+    header.counts[2] = m_UV.size();
+    header.counts[3] = m_colors.size();
+    header.counts[4] = m_face_v_indices.size();
+    header.counts[5] = m_face_n_indices.size();
+    header.counts[6] = m_face_uv_indices.size();
+    header.counts[7] = m_face_col_indices.size();
+    header.counts[8] = m_face_mat_indices.size();
+    header.counts[9] = tri_map->size();
+    header.elem_sizes[0] = sizeof(ChVector<double>);
+    header.elem_sizes[1] = sizeof(ChVector<double>);
+    header.elem_sizes[2] = sizeof(ChVector2<double>);
+    header.elem_sizes[3] = sizeof(ChColor);
+    header.elem_sizes[4] = sizeof(ChVector<int>);
+    header.elem_sizes[5] = sizeof(ChVector<int>);
+    header.elem_sizes[6] = sizeof(ChVector<int>);
+    header.elem_sizes[7] = sizeof(ChVector<int>);
+    header.elem_sizes[8] = sizeof(int);
+    header.elem_sizes[9] = sizeof(std::array<int, 4>);
+
+    // Write to a temporary file, then move it in place, so that readers never see a partial cache file
+    std::string tmp_filename = filename + ".tmp";
+    try {
+        utils::ChMappedFile file;
+        file.OpenWrite(tmp_filename, MeshCacheSize(header));
+        char* data = file.GetData();
+        std::memcpy(data, &header, sizeof(header));
+        size_t offset = mesh_cache_header_size;
+        for (int i = 0; i < mesh_cache_num_arrays; i++) {
+            size_t bytes = header.counts[i] * header.elem_sizes[i];
+            if (bytes > 0)
+                std::memcpy(data + offset, arrays[i], bytes);
+            offset = MeshCacheAlign(offset + bytes);
+        }
+        file.Close();
+    } catch (const ChException&) {
+        std::remove(tmp_filename.c_str());
+        return false;
+    }
+
+#ifdef _WIN32
+    // rename does not replace an existing file on Windows
+    std::remove(filename.c_str());
+#endif
+    if (std::rename(tmp_filename.c_str(), filename.c_str()) != 0) {
+        std::remove(tmp_filename.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+// Copy an array from the memory-mapped cache file
+template <typename T>
+static void MeshCacheRead(const char* data, size_t& offset, uint64_t count, std::vector<T>& v) {
+    const T* src = reinterpret_cast<const T*>(data + offset);
+    v.assign(src, src + count);
+    offset = MeshCacheAlign(offset + count * sizeof(T));
+}
+
+bool ChTriangleMeshConnected::LoadCacheFile(const std::string& filename, uint64_t key) {
+    if (!filesystem::path(filename).is_file())
+        return false;
+
+    utils::ChMappedFile file;
+    try {
+        file.OpenRead(filename);
+    } catch (const ChException&) {
+        return false;
+    }
+
+    if (file.GetSize() < mesh_cache_header_size)
+        return false;
+
+    MeshCacheHeader header;
+    std::memcpy(&header, file.GetData(), sizeof(header));
+    if (std::memcmp(header.magic, mesh_cache_magic, sizeof(header.magic)) != 0 ||
+        header.version != mesh_cache_version || header.key != key)
+        return false;
+
+    const uint32_t elem_sizes[mesh_cache_num_arrays] = {
+        sizeof(ChVector<double>), sizeof(ChVector<double>), sizeof(ChVector2<double>), sizeof(ChColor),
+        sizeof(ChVector<int>),    sizeof(ChVector<int>),    sizeof(ChVector<int>),     sizeof(ChVector<int>),
+        sizeof(int),              sizeof(std::array<int, 4>)};
+    for (int i = 0; i < mesh_cache_num_arrays; i++) {
+        if (header.elem_sizes[i] != elem_sizes[i])
+            return false;
+    }
+    if (MeshCacheSize(header) != file.GetSize())
+        return false;
+
+    Clear();
+
+    const char* data = file.GetData();
+    size_t offset = mesh_cache_header_size;
+    MeshCacheRead(data, offset, header.counts[0], m_vertices);
+    MeshCacheRead(data, offset, header.counts[1], m_normals);
+    MeshCacheRead(data, offset, header.counts[2], m_UV);
+    MeshCacheRead(data, offset, header.counts[3], m_colors);
+    MeshCacheRead(data, offset, header.counts[4], m_face_v_indices);
+    MeshCacheRead(data, offset, header.counts[5], m_face_n_indices);
+    MeshCacheRead(data, offset, header.counts[6], m_face_uv_indices);
+    MeshCacheRead(data, offset, header.counts[7], m_face_col_indices);
+    MeshCacheRead(data, offset, header.counts[8], m_face_mat_indices);
+    MeshCacheRead(data, offset, header.counts[9], m_adjacency);
+    m_adjacency_pathological = (header.flags & 1) != 0;
+    m_adjacency_manifold = (header.flags & 2) != 0;
+
+    return true;
+}
+
+void ChTriangleMeshConnected::UpdateAdjacency() {
+    m_adjacency.clear();
+    m_adjacency_pathological = ComputeNeighbouringTriangleMap(m_adjacency);
+
+    m_adjacency_manifold = !m_adjacency_pathological;
+    for (const auto& f : m_face_v_indices) {
+        if (f.x() == f.y() || f.y() == f.z() || f.z() == f.x()) {
+            m_adjacency_manifold = false;
+            break;
+        }
+    }
+}
+
+void ChTriangleMeshConnected::ClearAdjacency() {
+    m_adjacency.clear();
+    m_adjacency_pathological = false;
+    m_adjacency_manifold = false;
+}
+
 std::shared_ptr<ChTriangleMeshConnected> ChTriangleMeshConnected::CreateFromSTLFile(const std::string& filename,
                                                                                     bool load_normals) {
     auto trimesh = chrono_types::make_shared<ChTriangleMeshConnected>();
@@ -346,6 +624,8 @@ bool ChTriangleMeshConnected::LoadSTLMesh(const std::string& filename, bool load
         return false;
     }
 
+    ClearAdjacency();
+
     m_vertices.resize(nverts);
     for (vertex_t i = 0, j = 0; i < nverts; i++) {
         m_vertices[i] = ChVector<>(verts[j], verts[j + 1], verts[j + 2]);
@@ -519,6 +799,11 @@ void ChTriangleMeshConnected::Transform(const ChVector<> displ, const ChMatrix33
 }
 
 bool ChTriangleMeshConnected::ComputeNeighbouringTriangleMap(std::vector<std::array<int, 4>>& tri_map) const {
+    if (HasAdjacency()) {
+        tri_map = m_adjacency;
+        return m_adjacency_pathological;
+    }
+
     bool pathological_edges = false;
 
     std::multimap<std::pair<int, int>, int> edge_map;
@@ -590,6 +875,26 @@ bool ChTriangleMeshConnected::ComputeNeighbouringTriangleMap(std::vector<std::ar
 
 bool ChTriangleMeshConnected::ComputeWingedEdges(std::map<std::pair<int, int>, std::pair<int, int>>& winged_edges,
                                                  bool allow_single_wing) const {
+    // With a stored adjacency map of a manifold mesh, each edge is shared by at most two triangles and
+    // the winged edges follow directly from the map (the first wing being the triangle with lower index)
+    if (HasAdjacency() && m_adjacency_manifold) {
+        for (int it = 0; it < (int)m_face_v_indices.size(); ++it) {
+            for (int ie = 0; ie < 3; ++ie) {
+                int va = m_face_v_indices[it][ie];
+                int vb = m_face_v_indices[it][(ie + 1) % 3];
+                std::pair<int, int> medge(std::min(va, vb), std::max(va, vb));
+                int itn = m_adjacency[it][ie + 1];
+                if (itn == -1) {
+                    if (allow_single_wing)
+                        winged_edges.insert({medge, {it, -1}});
+                } else if (it < itn) {
+                    winged_edges.insert({medge, {it, itn}});
+                }
+            }
+        }
+        return false;
+    }
+
     bool pathological_edges = false;
 
     std::multimap<std::pair<int, int>, int> edge_map;
@@ -677,6 +982,8 @@ int ChTriangleMeshConnected::RepairDuplicateVertexes(const double tolerance) {
         m_face_v_indices[i].z() = new_indexes[m_face_v_indices[i].z()];
     }
 
+    ClearAdjacency();
+
     return nmerged;
 }
 
@@ -827,6 +1134,8 @@ bool ChTriangleMeshConnected::SplitEdge(
         &m_face_col_indices  //
     };
 
+    ClearAdjacency();
+
     int iea = 0;
     int ieb = 0;
 
@@ -1269,6 +1578,8 @@ void ChTriangleMeshConnected::ArchiveIn(ChArchiveIn& marchive) {
     marchive >> CHNVP(m_filename);
     marchive >> CHNVP(m_properties_per_vertex);
     marchive >> CHNVP(m_properties_per_face);
+
+    ClearAdjacency();
 }
 
 }  // end namespace geometry
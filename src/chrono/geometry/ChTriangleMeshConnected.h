@@ -17,6 +17,7 @@
 
 #include <array>
 #include <cmath>
+#include <cstdint>
 #include <map>
 
 #include "chrono/assets/ChColor.h"
@@ -37,7 +38,7 @@ namespace geometry {
 /// otherwise per-face-corner
 class ChApi ChTriangleMeshConnected : public ChTriangleMesh {
   public:
-    ChTriangleMeshConnected() {}
+    ChTriangleMeshConnected() : m_adjacency_pathological(false), m_adjacency_manifold(false) {}
     ChTriangleMeshConnected(const ChTriangleMeshConnected& source);
     ~ChTriangleMeshConnected();
 
@@ -48,6 +49,8 @@ class ChApi ChTriangleMeshConnected : public ChTriangleMesh {
     std::vector<ChVector<double>>& getCoordsNormals() { return m_normals; }
     std::vector<ChVector2<double>>& getCoordsUV() { return m_UV; }
     std::vector<ChColor>& getCoordsColors() { return m_colors; }
+    /// Access the vertex indices of the triangles. If these are modified, call ClearAdjacency() so that a stored
+    /// triangle adjacency map (see ComputeNeighbouringTriangleMap) is not used.
     std::vector<ChVector<int>>& getIndicesVertexes() { return m_face_v_indices; }
     std::vector<ChVector<int>>& getIndicesNormals() { return m_face_n_indices; }
     std::vector<ChVector<int>>& getIndicesUV() { return m_face_uv_indices; }
@@ -82,8 +85,32 @@ class ChApi ChTriangleMeshConnected : public ChTriangleMesh {
                                                                             bool load_uv = false);
 
     /// Load a Wavefront OBJ file into this triangle mesh.
+    /// If a mesh cache directory was set (see SetCacheDirectory), the mesh is loaded from a binary cache file keyed
+    /// on the content of the OBJ file, if one exists; otherwise the OBJ file is parsed and a cache file is written.
     bool LoadWavefrontMesh(const std::string& filename, bool load_normals = true, bool load_uv = false);
 
+    /// Set the directory used to cache meshes loaded from Wavefront OBJ files (an empty string disables caching).
+    /// Cache files store the parsed mesh and its triangle adjacency map in a binary format which is memory mapped
+    /// on load. They are named after the source file and a hash of its content and load options, so that a modified
+    /// source file is parsed again. The directory is created if it does not exist. Caching is disabled by default.
+    static void SetCacheDirectory(const std::string& dir);
+
+    /// Get the directory used to cache meshes loaded from Wavefront OBJ files (empty if caching is disabled).
+    static const std::string& GetCacheDirectory();
+
+    /// Write this mesh and its triangle adjacency map to a binary cache file, tagged with the given key.
+    /// Cache files use the native byte order and are not meant to be portable across platforms.
+    /// Return false if the file could not be written.
+    bool WriteCacheFile(const std::string& filename, uint64_t key) const;
+
+    /// Load this mesh from a binary cache file written by WriteCacheFile.
+    /// Return false (and leave the mesh unchanged) if the file does not exist, is not a valid cache file of the
+    /// current version, or was written with a different key.
+    bool LoadCacheFile(const std::string& filename, uint64_t key);
+
+    /// Compute a 64-bit hash of the content of a file (0 if the file cannot be read).
+    static uint64_t ComputeFileHash(const std::string& filename);
+
     /// Create and return a ChTriangleMeshConnected from an STL file.
     /// If an error occurrs during loading, an empty shared pointer is returned.
     static std::shared_ptr<ChTriangleMeshConnected> CreateFromSTLFile(const std::string& filename,
@@ -138,12 +165,19 @@ class ChApi ChTriangleMeshConnected : public ChTriangleMesh {
     /// Create a map of neighboring triangles, vector [Ti TieA TieB TieC]
     /// (the free sides have triangle id = -1).
     /// Return false if some edge has more than 2 neighboring triangles
+    /// If the mesh was loaded from a cache file, the stored map is returned without recomputing it. The stored map is
+    /// discarded by all member functions that modify the mesh connectivity, but it becomes stale if the vertex indices
+    /// are modified in place (see getIndicesVertexes); call ClearAdjacency() after such changes.
     bool ComputeNeighbouringTriangleMap(std::vector<std::array<int, 4>>& tri_map) const;
 
+    /// Discard the stored triangle adjacency map, if any, so that it is recomputed when needed.
+    void ClearAdjacency();
+
     /// Create a winged edge structure, map of {key, value} as {{edgevertexA, edgevertexB}, {triangleA, triangleB}}.
     /// If allow_single_wing = false, only edges with at least 2 triangles are returned.
     /// Else, also boundary edges with 1 triangle (the free side has triangle id = -1).
     /// Return false if some edge has more than 2 neighboring triangles.
+    /// If the mesh was loaded from a cache file, the winged edges are obtained from the stored triangle adjacency map.
     bool ComputeWingedEdges(std::map<std::pair<int, int>, std::pair<int, int>>& winged_edges,
                             bool allow_single_wing = true) const;
 
@@ -253,6 +287,21 @@ class ChApi ChTriangleMeshConnected : public ChTriangleMesh {
 
     std::vector<ChVector<>> m_tmp_vectors;
     std::vector<ChColor> m_tmp_colors;
+
+  private:
+    /// Return true if the stored triangle adjacency map can be used.
+    /// Note that the map is discarded by all member functions that modify the mesh connectivity, but not if the face
+    /// indices are changed directly.
+    bool HasAdjacency() const { return !m_adjacency.empty() && m_adjacency.size() == m_face_v_indices.size(); }
+
+    /// Compute and store the triangle adjacency map.
+    void UpdateAdjacency();
+
+    std::vector<std::array<int, 4>> m_adjacency;  ///< triangle adjacency map (loaded from or written to cache)
+    bool m_adjacency_pathological;                ///< some edge is shared by more than 2 triangles
+    bool m_adjacency_manifold;                    ///< no pathological edges and no degenerate triangles
+
+    static std::string m_cache_dir;  ///< directory for cached OBJ meshes
 };
 
 }  // end namespace geometry
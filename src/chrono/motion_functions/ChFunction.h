@@ -15,6 +15,7 @@
 
 #include "chrono/motion_functions/ChFunction_Const.h"
 #include "chrono/motion_functions/ChFunction_BSpline.h"
+#include "chrono/motion_functions/ChFunction_Compiled.h"
 #include "chrono/motion_functions/ChFunction_ConstAcc.h"
 #include "chrono/motion_functions/ChFunction_Cycloidal.h"
 #include "chrono/motion_functions/ChFunction_Derive.h"
@@ -28,6 +28,9 @@
 
 namespace chrono {
 
+// Forward references
+class ChSnapshotBuffer;
+
 /// @addtogroup chrono_functions
 /// @{
 
@@ -88,6 +91,14 @@ class ChApi ChFunctionPosition {
     /// Update could be implemented by children classes, ex. to launch callbacks
     virtual void Update(const double t) {}
 
+    /// Append to the buffer the internal data of this function which may change during a simulation, such as the
+    /// values held by setpoint functions. Used by ChSystemSnapshot, through the physics items using this function;
+    /// the default implementation does nothing.
+    virtual void SnapshotOut(ChSnapshotBuffer& buffer) {}
+
+    /// Restore the internal data stored by SnapshotOut().
+    virtual void SnapshotIn(ChSnapshotBuffer& buffer) {}
+
    
     /// Method to allow serialization of transient data to archives
     virtual void ArchiveOut(ChArchiveOut& marchive);
@@ -15,6 +15,7 @@
 
 
 #include "chrono/motion_functions/ChFunctionPosition_XYZfunctions.h"
+#include "chrono/physics/ChSystemSnapshot.h"
 #include "chrono/motion_functions/ChFunction_Const.h"
 
 namespace chrono {
@@ -71,6 +72,18 @@ void ChFunctionPosition_XYZfunctions::Estimate_s_domain(double& smin, double& sm
 
 
 
+void ChFunctionPosition_XYZfunctions::SnapshotOut(ChSnapshotBuffer& buffer) {
+    buffer.WriteObject(px);
+    buffer.WriteObject(py);
+    buffer.WriteObject(pz);
+}
+
+void ChFunctionPosition_XYZfunctions::SnapshotIn(ChSnapshotBuffer& buffer) {
+    buffer.ReadObject(px);
+    buffer.ReadObject(py);
+    buffer.ReadObject(pz);
+}
+
 void ChFunctionPosition_XYZfunctions::ArchiveOut(ChArchiveOut& marchive) {
     // version number
     marchive.VersionWrite<ChFunctionPosition>();
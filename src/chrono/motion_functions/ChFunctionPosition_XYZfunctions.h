@@ -75,6 +75,12 @@ class ChApi ChFunctionPosition_XYZfunctions : public ChFunctionPosition {
 	virtual void Estimate_s_domain(double& smin, double& smax) const override;
 
    
+    /// Append to the buffer the internal data of the x, y, z functions.
+    virtual void SnapshotOut(ChSnapshotBuffer& buffer) override;
+
+    /// Restore the internal data stored by SnapshotOut().
+    virtual void SnapshotIn(ChSnapshotBuffer& buffer) override;
+
     /// Method to allow serialization of transient data to archives
     virtual void ArchiveOut(ChArchiveOut& marchive) override;
 
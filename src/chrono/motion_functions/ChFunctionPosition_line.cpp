@@ -15,6 +15,7 @@
 
 
 #include "chrono/motion_functions/ChFunctionPosition_line.h"
+#include "chrono/physics/ChSystemSnapshot.h"
 #include "chrono/motion_functions/ChFunction_Ramp.h"
 #include "chrono/geometry/ChLineSegment.h"
 
@@ -82,6 +83,14 @@ ChVector<> ChFunctionPosition_line::Get_p_dsds(double s) const {
 
 
 
+void ChFunctionPosition_line::SnapshotOut(ChSnapshotBuffer& buffer) {
+    buffer.WriteObject(space_fx);
+}
+
+void ChFunctionPosition_line::SnapshotIn(ChSnapshotBuffer& buffer) {
+    buffer.ReadObject(space_fx);
+}
+
 void ChFunctionPosition_line::ArchiveOut(ChArchiveOut& marchive) {
     // version number
     marchive.VersionWrite<ChFunctionPosition>();
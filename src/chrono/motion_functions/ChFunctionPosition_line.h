@@ -65,6 +65,12 @@ class ChApi ChFunctionPosition_line : public ChFunctionPosition {
     /// Return the ddp/dsds double derivative of the function, at s.
     virtual ChVector<> Get_p_dsds(double s) const override;
    
+    /// Append to the buffer the internal data of the space function.
+    virtual void SnapshotOut(ChSnapshotBuffer& buffer) override;
+
+    /// Restore the internal data stored by SnapshotOut().
+    virtual void SnapshotIn(ChSnapshotBuffer& buffer) override;
+
     /// Method to allow serialization of transient data to archives
     virtual void ArchiveOut(ChArchiveOut& marchive) override;
 
@@ -15,6 +15,7 @@
 
 
 #include "chrono/motion_functions/ChFunctionPosition_setpoint.h"
+#include "chrono/physics/ChSystemSnapshot.h"
 #include "chrono/motion_functions/ChFunction_Const.h"
 
 namespace chrono {
@@ -110,6 +111,32 @@ ChVector<> ChFunctionPosition_setpoint::Get_p_dsds(double s) const {
 
 
 
+void ChFunctionPosition_setpoint::SnapshotOut(ChSnapshotBuffer& buffer) {
+    buffer.Write(S);
+    buffer.Write(P.data(), 3);
+    buffer.Write(P_ds.data(), 3);
+    buffer.Write(P_dsds.data(), 3);
+    buffer.Write(last_s);
+    buffer.Write(last_P.data(), 3);
+    buffer.Write(last_P_ds.data(), 3);
+}
+
+void ChFunctionPosition_setpoint::SnapshotIn(ChSnapshotBuffer& buffer) {
+    double v[3];
+    S = buffer.Read<double>();
+    buffer.Read(v, 3);
+    P.Set(v[0], v[1], v[2]);
+    buffer.Read(v, 3);
+    P_ds.Set(v[0], v[1], v[2]);
+    buffer.Read(v, 3);
+    P_dsds.Set(v[0], v[1], v[2]);
+    last_s = buffer.Read<double>();
+    buffer.Read(v, 3);
+    last_P.Set(v[0], v[1], v[2]);
+    buffer.Read(v, 3);
+    last_P_ds.Set(v[0], v[1], v[2]);
+}
+
 void ChFunctionPosition_setpoint::ArchiveOut(ChArchiveOut& marchive) {
     // version number
     marchive.VersionWrite<ChFunctionPosition_setpoint>();
@@ -108,6 +108,12 @@ class ChApi ChFunctionPosition_setpoint : public ChFunctionPosition {
     virtual ChVector<> Get_p_dsds(double s) const override;
 
 
+    /// Append to the buffer the setpoint, its derivatives, and the last values used to differentiate it.
+    virtual void SnapshotOut(ChSnapshotBuffer& buffer) override;
+
+    /// Restore the internal data stored by SnapshotOut().
+    virtual void SnapshotIn(ChSnapshotBuffer& buffer) override;
+
     /// Method to allow serialization of transient data to archives
     virtual void ArchiveOut(ChArchiveOut& marchive) override;
 
@@ -15,6 +15,7 @@
 
 
 #include "chrono/motion_functions/ChFunctionRotation_ABCfunctions.h"
+#include "chrono/physics/ChSystemSnapshot.h"
 #include "chrono/motion_functions/ChFunction_Const.h"
 
 namespace chrono {
@@ -59,6 +60,18 @@ ChQuaternion<> ChFunctionRotation_ABCfunctions::Get_q(double s) const {
 
 
 
+void ChFunctionRotation_ABCfunctions::SnapshotOut(ChSnapshotBuffer& buffer) {
+    buffer.WriteObject(angleA);
+    buffer.WriteObject(angleB);
+    buffer.WriteObject(angleC);
+}
+
+void ChFunctionRotation_ABCfunctions::SnapshotIn(ChSnapshotBuffer& buffer) {
+    buffer.ReadObject(angleA);
+    buffer.ReadObject(angleB);
+    buffer.ReadObject(angleC);
+}
+
 void ChFunctionRotation_ABCfunctions::ArchiveOut(ChArchiveOut& marchive) {
     // version number
     marchive.VersionWrite<ChFunctionRotation_ABCfunctions>();
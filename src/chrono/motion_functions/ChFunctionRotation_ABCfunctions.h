@@ -84,6 +84,12 @@ class ChApi ChFunctionRotation_ABCfunctions : public ChFunctionRotation {
 	virtual ChQuaternion<> Get_q(double s) const override;
 
 
+    /// Append to the buffer the internal data of the angle functions.
+    virtual void SnapshotOut(ChSnapshotBuffer& buffer) override;
+
+    /// Restore the internal data stored by SnapshotOut().
+    virtual void SnapshotIn(ChSnapshotBuffer& buffer) override;
+
     /// Method to allow serialization of transient data to archives
     virtual void ArchiveOut(ChArchiveOut& marchive) override;
 
@@ -15,6 +15,7 @@
 
 
 #include "chrono/motion_functions/ChFunctionRotation_SQUAD.h"
+#include "chrono/physics/ChSystemSnapshot.h"
 #include "chrono/motion_functions/ChFunction_Const.h"
 #include "chrono/motion_functions/ChFunction_Ramp.h"
 #include "chrono/geometry/ChBasisToolsBspline.h"
@@ -203,6 +204,14 @@ void ChFunctionRotation_SQUAD::SetClosed(bool mc) {
 }
 
 
+void ChFunctionRotation_SQUAD::SnapshotOut(ChSnapshotBuffer& buffer) {
+    buffer.WriteObject(space_fx);
+}
+
+void ChFunctionRotation_SQUAD::SnapshotIn(ChSnapshotBuffer& buffer) {
+    buffer.ReadObject(space_fx);
+}
+
 void ChFunctionRotation_SQUAD::ArchiveOut(ChArchiveOut& marchive) {
     // version number
     marchive.VersionWrite<ChFunctionRotation_SQUAD>();
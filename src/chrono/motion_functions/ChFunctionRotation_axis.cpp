@@ -15,6 +15,7 @@
 
 
 #include "chrono/motion_functions/ChFunctionRotation_axis.h"
+#include "chrono/physics/ChSystemSnapshot.h"
 #include "chrono/motion_functions/ChFunction_Const.h"
 
 namespace chrono {
@@ -59,6 +60,14 @@ ChVector<> ChFunctionRotation_axis::Get_a_loc(double s) const {
 
 
 
+void ChFunctionRotation_axis::SnapshotOut(ChSnapshotBuffer& buffer) {
+    buffer.WriteObject(fangle);
+}
+
+void ChFunctionRotation_axis::SnapshotIn(ChSnapshotBuffer& buffer) {
+    buffer.ReadObject(fangle);
+}
+
 void ChFunctionRotation_axis::ArchiveOut(ChArchiveOut& marchive) {
     // version number
     marchive.VersionWrite<ChFunctionRotation_axis>();
@@ -68,6 +68,12 @@ class ChApi ChFunctionRotation_axis : public ChFunctionRotation {
 	virtual ChVector<> Get_a_loc(double s) const override;
 
 
+    /// Append to the buffer the internal data of the angle function.
+    virtual void SnapshotOut(ChSnapshotBuffer& buffer) override;
+
+    /// Restore the internal data stored by SnapshotOut().
+    virtual void SnapshotIn(ChSnapshotBuffer& buffer) override;
+
     /// Method to allow serialization of transient data to archives
     virtual void ArchiveOut(ChArchiveOut& marchive) override;
 
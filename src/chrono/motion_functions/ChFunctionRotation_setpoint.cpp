@@ -13,6 +13,7 @@
 // =============================================================================
 
 #include "chrono/motion_functions/ChFunctionRotation_setpoint.h"
+#include "chrono/physics/ChSystemSnapshot.h"
 #include "chrono/motion_functions/ChFunction_Const.h"
 
 namespace chrono {
@@ -106,6 +107,32 @@ ChVector<> ChFunctionRotation_setpoint::Get_a_loc(double s) const {
     return A;
 }
 
+void ChFunctionRotation_setpoint::SnapshotOut(ChSnapshotBuffer& buffer) {
+    buffer.Write(S);
+    buffer.Write(Q.data(), 4);
+    buffer.Write(W.data(), 3);
+    buffer.Write(A.data(), 3);
+    buffer.Write(last_S);
+    buffer.Write(last_Q.data(), 4);
+    buffer.Write(last_W.data(), 3);
+}
+
+void ChFunctionRotation_setpoint::SnapshotIn(ChSnapshotBuffer& buffer) {
+    double v[4];
+    S = buffer.Read<double>();
+    buffer.Read(v, 4);
+    Q.Set(v[0], v[1], v[2], v[3]);
+    buffer.Read(v, 3);
+    W.Set(v[0], v[1], v[2]);
+    buffer.Read(v, 3);
+    A.Set(v[0], v[1], v[2]);
+    last_S = buffer.Read<double>();
+    buffer.Read(v, 4);
+    last_Q.Set(v[0], v[1], v[2], v[3]);
+    buffer.Read(v, 3);
+    last_W.Set(v[0], v[1], v[2]);
+}
+
 void ChFunctionRotation_setpoint::ArchiveOut(ChArchiveOut& marchive) {
     // version number
     marchive.VersionWrite<ChFunctionRotation_setpoint>();
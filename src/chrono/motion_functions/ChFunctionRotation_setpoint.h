@@ -106,6 +106,12 @@ class ChApi ChFunctionRotation_setpoint : public ChFunctionRotation {
 	virtual ChVector<> Get_a_loc(double s) const override;
 
 
+    /// Append to the buffer the setpoint, its derivatives, and the last values used to differentiate it.
+    virtual void SnapshotOut(ChSnapshotBuffer& buffer) override;
+
+    /// Restore the internal data stored by SnapshotOut().
+    virtual void SnapshotIn(ChSnapshotBuffer& buffer) override;
+
     /// Method to allow serialization of transient data to archives
     virtual void ArchiveOut(ChArchiveOut& marchive) override;
 
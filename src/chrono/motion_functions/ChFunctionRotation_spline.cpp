@@ -15,6 +15,7 @@
 
 
 #include "chrono/motion_functions/ChFunctionRotation_spline.h"
+#include "chrono/physics/ChSystemSnapshot.h"
 #include "chrono/motion_functions/ChFunction_Const.h"
 #include "chrono/motion_functions/ChFunction_Ramp.h"
 #include "chrono/geometry/ChBasisToolsBspline.h"
@@ -165,6 +166,14 @@ void ChFunctionRotation_spline::SetClosed(bool mc) {
 }
 
 
+void ChFunctionRotation_spline::SnapshotOut(ChSnapshotBuffer& buffer) {
+    buffer.WriteObject(space_fx);
+}
+
+void ChFunctionRotation_spline::SnapshotIn(ChSnapshotBuffer& buffer) {
+    buffer.ReadObject(space_fx);
+}
+
 void ChFunctionRotation_spline::ArchiveOut(ChArchiveOut& marchive) {
     // version number
     marchive.VersionWrite<ChFunctionRotation_spline>();
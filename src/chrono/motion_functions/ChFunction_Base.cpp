@@ -26,6 +26,11 @@ namespace chrono {
 // Register into the object factory, to enable run-time dynamic creation and persistence
 // CH_FACTORY_REGISTER(ChFunction) // NO! this is an abstract class, rather use for children concrete classes.
 
+void ChFunction::Get_y_array(const double* x, double* y, size_t n) const {
+    for (size_t i = 0; i < n; i++)
+        y[i] = Get_y(x[i]);
+}
+
 double ChFunction::Get_y_dN(double x, int derivate) const {
     switch (derivate) {
         case 0:
@@ -28,6 +28,9 @@
 
 namespace chrono {
 
+// Forward references
+class ChSnapshotBuffer;
+
 /// @addtogroup chrono_functions
 /// @{
 
@@ -69,7 +72,8 @@ class ChApi ChFunction {
         FUNCT_LAMBDA,
         FUNCT_CYCLOIDAL,
         FUNCT_BSPLINE,
-        FUNCT_DOUBLES
+        FUNCT_DOUBLES,
+        FUNCT_COMPILED
     };
 
   public:
@@ -110,6 +114,11 @@ class ChApi ChFunction {
     /// is known, it may be better to implement a custom method).
     virtual double Get_y_dxdxdx(double x) const { return ((Get_y_dxdx(x + BDF_STEP_LOW) - Get_y_dxdx(x)) / BDF_STEP_LOW); };
 
+    /// Evaluate the function at n values of the argument, i.e. y[i] = Get_y(x[i]).
+    /// The base implementation simply loops over Get_y(); classes with cheap table-based
+    /// evaluation (e.g. ChFunction_Compiled) override this with a tight loop.
+    virtual void Get_y_array(const double* x, double* y, size_t n) const;
+
     /// Return the weight of the function (useful for
     /// applications where you need to mix different weighted ChFunctions)
     virtual double Get_weight(double x) const { return 1.0; };
@@ -132,6 +141,14 @@ class ChApi ChFunction {
     /// Update could be implemented by children classes, ex. to launch callbacks
     virtual void Update(const double x) {}
 
+    /// Append to the buffer the internal data of this function which may change during a simulation, such as the
+    /// values held by setpoint functions. Used by ChSystemSnapshot, through the physics items using this function;
+    /// the default implementation does nothing.
+    virtual void SnapshotOut(ChSnapshotBuffer& buffer) {}
+
+    /// Restore the internal data stored by SnapshotOut().
+    virtual void SnapshotIn(ChSnapshotBuffer& buffer) {}
+
     //
     // Some analysis functions. If derivate=0, they are applied on y(x), if derivate =1, on dy/dx, etc.
     //
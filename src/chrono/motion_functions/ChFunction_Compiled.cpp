@@ -0,0 +1,199 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+
+#include "chrono/core/ChException.h"
+#include "chrono/motion_functions/ChFunction_Compiled.h"
+
+namespace chrono {
+
+// Register into the object factory, to enable run-time dynamic creation and persistence
+CH_FACTORY_REGISTER(ChFunction_Compiled)
+
+ChFunction_Compiled::ChFunction_Compiled() : m_x({0, 0}), m_coeffs({0, 0, 0, 0}), m_uniform(false), m_inv_dx(0) {}
+
+ChFunction_Compiled::ChFunction_Compiled(const ChFunction& fun, double xmin, double xmax, int nsegments) {
+    Compile(fun, xmin, xmax, nsegments);
+}
+
+ChFunction_Compiled::ChFunction_Compiled(const ChFunction_Recorder& recorder) {
+    Compile(recorder);
+}
+
+ChFunction_Compiled::ChFunction_Compiled(const ChFunction_Compiled& other) {
+    m_x = other.m_x;
+    m_coeffs = other.m_coeffs;
+    m_uniform = other.m_uniform;
+    m_inv_dx = other.m_inv_dx;
+}
+
+void ChFunction_Compiled::Compile(const ChFunction& fun, double xmin, double xmax, int nsegments) {
+    if (nsegments < 1)
+        throw ChException("ChFunction_Compiled::Compile requires at least one segment.");
+    if (!(xmax > xmin))
+        throw ChException("ChFunction_Compiled::Compile requires xmax > xmin.");
+
+    size_t n = (size_t)nsegments;
+    double h = (xmax - xmin) / nsegments;
+
+    m_x.resize(n + 1);
+    std::vector<double> y(n + 1);
+    std::vector<double> d(n + 1);
+    for (size_t i = 0; i <= n; i++) {
+        m_x[i] = (i == n) ? xmax : xmin + i * h;
+        y[i] = fun.Get_y(m_x[i]);
+        d[i] = fun.Get_y_dx(m_x[i]);
+    }
+
+    // Cubic Hermite segments in powers of t = x - x_i
+    m_coeffs.resize(4 * n);
+    for (size_t i = 0; i < n; i++) {
+        double hi = m_x[i + 1] - m_x[i];
+        double s = (y[i + 1] - y[i]) / hi;
+        m_coeffs[4 * i + 0] = y[i];
+        m_coeffs[4 * i + 1] = d[i];
+        m_coeffs[4 * i + 2] = (3 * s - 2 * d[i] - d[i + 1]) / hi;
+        m_coeffs[4 * i + 3] = (d[i] + d[i + 1] - 2 * s) / (hi * hi);
+    }
+
+    SetupLookup();
+}
+
+void ChFunction_Compiled::Compile(const ChFunction_Recorder& recorder) {
+    const auto& points = recorder.GetPoints();
+
+    if (points.size() < 2) {
+        double y0 = points.empty() ? 0 : points.front().y;
+        double x0 = points.empty() ? 0 : points.front().x;
+        m_x = {x0, x0};
+        m_coeffs = {y0, 0, 0, 0};
+        m_uniform = false;
+        m_inv_dx = 0;
+        return;
+    }
+
+    size_t n = points.size() - 1;
+    m_x.resize(n + 1);
+    m_coeffs.resize(4 * n);
+    for (size_t i = 0; i <= n; i++)
+        m_x[i] = points[i].x;
+    for (size_t i = 0; i < n; i++) {
+        m_coeffs[4 * i + 0] = points[i].y;
+        m_coeffs[4 * i + 1] = (points[i + 1].y - points[i].y) / (points[i + 1].x - points[i].x);
+        m_coeffs[4 * i + 2] = 0;
+        m_coeffs[4 * i + 3] = 0;
+    }
+
+    SetupLookup();
+}
+
+void ChFunction_Compiled::SetupLookup() {
+    size_t n = m_x.size() - 1;
+    double h = (m_x[n] - m_x[0]) / n;
+
+    m_uniform = h > 0;
+    for (size_t i = 1; m_uniform && i <= n; i++) {
+        if (std::abs(m_x[i] - (m_x[0] + i * h)) > 1e-9 * h)
+            m_uniform = false;
+    }
+    m_inv_dx = m_uniform ? 1 / h : 0;
+}
+
+size_t ChFunction_Compiled::FindSegment(double x) const {
+    size_t n = m_x.size() - 1;
+
+    if (m_uniform)
+        return std::min((size_t)((x - m_x[0]) * m_inv_dx), n - 1);
+
+    auto iter = std::upper_bound(m_x.begin() + 1, m_x.end() - 1, x);
+    return (size_t)(iter - m_x.begin()) - 1;
+}
+
+double ChFunction_Compiled::Eval(double x, int derivate) const {
+    // Clamp outside the compiled range (end points use the adjacent segment)
+    if (x < m_x.front() || x > m_x.back()) {
+        if (derivate != 0)
+            return 0;
+        x = x < m_x.front() ? m_x.front() : m_x.back();
+    }
+
+    size_t i = FindSegment(x);
+    double t = x - m_x[i];
+    const double* c = &m_coeffs[4 * i];
+
+    switch (derivate) {
+        case 0:
+            return c[0] + t * (c[1] + t * (c[2] + t * c[3]));
+        case 1:
+            return c[1] + t * (2 * c[2] + t * 3 * c[3]);
+        case 2:
+            return 2 * c[2] + 6 * c[3] * t;
+        case 3:
+            return 6 * c[3];
+        default:
+            return c[0] + t * (c[1] + t * (c[2] + t * c[3]));
+    }
+}
+
+void ChFunction_Compiled::Get_y_array(const double* x, double* y, size_t n) const {
+    const double x_lo = m_x.front();
+    const double x_hi = m_x.back();
+    const double y_lo = Eval(x_lo, 0);
+    const double y_hi = Eval(x_hi, 0);
+    const size_t last = m_x.size() - 2;
+
+    for (size_t k = 0; k < n; k++) {
+        double xk = x[k];
+        if (xk <= x_lo) {
+            y[k] = y_lo;
+        } else if (xk >= x_hi) {
+            y[k] = y_hi;
+        } else {
+            size_t i = m_uniform ? std::min((size_t)((xk - x_lo) * m_inv_dx), last) : FindSegment(xk);
+            double t = xk - m_x[i];
+            const double* c = &m_coeffs[4 * i];
+            y[k] = c[0] + t * (c[1] + t * (c[2] + t * c[3]));
+        }
+    }
+}
+
+void ChFunction_Compiled::Estimate_x_range(double& xmin, double& xmax) const {
+    xmin = m_x.front();
+    xmax = m_x.back();
+    if (xmin == xmax)
+        xmax = xmin + 0.5;
+}
+
+void ChFunction_Compiled::ArchiveOut(ChArchiveOut& marchive) {
+    // version number
+    marchive.VersionWrite<ChFunction_Compiled>();
+    // serialize parent class
+    ChFunction::ArchiveOut(marchive);
+    // serialize all member data:
+    marchive << CHNVP(m_x);
+    marchive << CHNVP(m_coeffs);
+}
+
+void ChFunction_Compiled::ArchiveIn(ChArchiveIn& marchive) {
+    // version number
+    /*int version =*/ marchive.VersionRead<ChFunction_Compiled>();
+    // deserialize parent class
+    ChFunction::ArchiveIn(marchive);
+    // stream in all member data:
+    marchive >> CHNVP(m_x);
+    marchive >> CHNVP(m_coeffs);
+    SetupLookup();
+}
+
+}  // end namespace chrono
@@ -0,0 +1,102 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#ifndef CHFUNCT_COMPILED_H
+#define CHFUNCT_COMPILED_H
+
+#include <vector>
+
+#include "chrono/motion_functions/ChFunction_Base.h"
+#include "chrono/motion_functions/ChFunction_Recorder.h"
+
+namespace chrono {
+
+/// @addtogroup chrono_functions
+/// @{
+
+/// Compiled function:
+///
+/// y = piecewise cubic polynomial stored in a flat table.
+///
+/// A compiled function is a lookup-table snapshot of another function, typically a tree of
+/// ChFunction_Operation, ChFunction_Sequence, ChFunction_Mirror, etc. or a ChFunction_Recorder.
+/// Evaluation requires no virtual dispatch into the original tree: the segment is found in O(1)
+/// for uniformly spaced breakpoints (or by binary search otherwise) and a cubic is evaluated.
+/// - Compile(fun, xmin, xmax, n) samples y and dy/dx of 'fun' at n+1 equally spaced points and
+///   builds a C1 cubic Hermite interpolant. The approximation error is O(h^4) for smooth functions;
+///   discontinuities in the source are smeared over one segment.
+/// - Compile(recorder) reproduces the piecewise linear recorder exactly.
+/// Outside the compiled range the function is clamped to its end values (zero derivatives),
+/// consistent with ChFunction_Recorder.
+class ChApi ChFunction_Compiled : public ChFunction {
+  public:
+    ChFunction_Compiled();
+    ChFunction_Compiled(const ChFunction& fun, double xmin, double xmax, int nsegments);
+    ChFunction_Compiled(const ChFunction_Recorder& recorder);
+    ChFunction_Compiled(const ChFunction_Compiled& other);
+    ~ChFunction_Compiled() {}
+
+    /// "Virtual" copy constructor (covariant return type).
+    virtual ChFunction_Compiled* Clone() const override { return new ChFunction_Compiled(*this); }
+
+    virtual FunctionType Get_Type() const override { return FUNCT_COMPILED; }
+
+    /// Sample the given function on [xmin, xmax] with 'nsegments' cubic Hermite segments.
+    void Compile(const ChFunction& fun, double xmin, double xmax, int nsegments);
+
+    /// Build a piecewise linear table from the points of the given recorder.
+    void Compile(const ChFunction_Recorder& recorder);
+
+    /// Return the number of polynomial segments in the table.
+    int GetNumSegments() const { return (int)(m_x.size() - 1); }
+
+    /// Return true if the breakpoints are equally spaced (O(1) segment lookup).
+    bool IsUniform() const { return m_uniform; }
+
+    virtual double Get_y(double x) const override { return Eval(x, 0); }
+    virtual double Get_y_dx(double x) const override { return Eval(x, 1); }
+    virtual double Get_y_dxdx(double x) const override { return Eval(x, 2); }
+    virtual double Get_y_dxdxdx(double x) const override { return Eval(x, 3); }
+
+    virtual void Get_y_array(const double* x, double* y, size_t n) const override;
+
+    virtual void Estimate_x_range(double& xmin, double& xmax) const override;
+
+    /// Method to allow serialization of transient data to archives.
+    virtual void ArchiveOut(ChArchiveOut& marchive) override;
+
+    /// Method to allow de-serialization of transient data from archives.
+    virtual void ArchiveIn(ChArchiveIn& marchive) override;
+
+  private:
+    /// Evaluate the derivative of given order (0 to 3) at x.
+    double Eval(double x, int derivate) const;
+
+    /// Return the index of the segment containing x (x in the compiled range).
+    size_t FindSegment(double x) const;
+
+    /// Detect equally spaced breakpoints and set up O(1) lookup.
+    void SetupLookup();
+
+    std::vector<double> m_x;       ///< breakpoints (n+1)
+    std::vector<double> m_coeffs;  ///< polynomial coefficients, 4 per segment, in powers of (x - x_i)
+    bool m_uniform;                ///< true if breakpoints are equally spaced
+    double m_inv_dx;               ///< inverse of segment length (uniform case only)
+};
+
+/// @} chrono_functions
+
+CH_CLASS_VERSION(ChFunction_Compiled, 0)
+
+}  // end namespace chrono
+
+#endif
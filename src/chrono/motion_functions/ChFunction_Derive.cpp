@@ -13,6 +13,7 @@
 // =============================================================================
 
 #include "chrono/motion_functions/ChFunction_Derive.h"
+#include "chrono/physics/ChSystemSnapshot.h"
 
 namespace chrono {
 
@@ -33,6 +34,14 @@ void ChFunction_Derive::Estimate_x_range(double& xmin, double& xmax) const {
     fa->Estimate_x_range(xmin, xmax);
 }
 
+void ChFunction_Derive::SnapshotOut(ChSnapshotBuffer& buffer) {
+    buffer.WriteObject(fa);
+}
+
+void ChFunction_Derive::SnapshotIn(ChSnapshotBuffer& buffer) {
+    buffer.ReadObject(fa);
+}
+
 void ChFunction_Derive::ArchiveOut(ChArchiveOut& marchive) {
     // version number
     marchive.VersionWrite<ChFunction_Derive>();
@@ -52,6 +52,12 @@ class ChApi ChFunction_Derive : public ChFunction {
 
     virtual void Estimate_x_range(double& xmin, double& xmax) const override;
 
+    /// Append to the buffer the internal data of the derived function.
+    virtual void SnapshotOut(ChSnapshotBuffer& buffer) override;
+
+    /// Restore the internal data stored by SnapshotOut().
+    virtual void SnapshotIn(ChSnapshotBuffer& buffer) override;
+
     /// Method to allow serialization of transient data to archives.
     virtual void ArchiveOut(ChArchiveOut& marchive) override;
 
@@ -13,6 +13,7 @@
 // =============================================================================
 
 #include "chrono/motion_functions/ChFunction_Integrate.h"
+#include "chrono/physics/ChSystemSnapshot.h"
 #include "chrono/motion_functions/ChFunction_Const.h"
 
 namespace chrono {
@@ -80,6 +81,14 @@ void ChFunction_Integrate::Estimate_x_range(double& xmin, double& xmax) const {
     xmax = x_end;
 }
 
+void ChFunction_Integrate::SnapshotOut(ChSnapshotBuffer& buffer) {
+    buffer.WriteObject(fa);
+}
+
+void ChFunction_Integrate::SnapshotIn(ChSnapshotBuffer& buffer) {
+    buffer.ReadObject(fa);
+}
+
 void ChFunction_Integrate::ArchiveOut(ChArchiveOut& marchive) {
     // version number
     marchive.VersionWrite<ChFunction_Integrate>();
@@ -13,6 +13,7 @@
 // =============================================================================
 
 #include "chrono/motion_functions/ChFunction_Operation.h"
+#include "chrono/physics/ChSystemSnapshot.h"
 
 namespace chrono {
 
@@ -94,6 +95,16 @@ void ChFunction_Operation::Estimate_x_range(double& xmin, double& xmax) const {
     xmax = ChMax(amax, bmax);
 }
 
+void ChFunction_Operation::SnapshotOut(ChSnapshotBuffer& buffer) {
+    buffer.WriteObject(fa);
+    buffer.WriteObject(fb);
+}
+
+void ChFunction_Operation::SnapshotIn(ChSnapshotBuffer& buffer) {
+    buffer.ReadObject(fa);
+    buffer.ReadObject(fb);
+}
+
 void ChFunction_Operation::ArchiveOut(ChArchiveOut& marchive) {
     // version number
     marchive.VersionWrite<ChFunction_Operation>();
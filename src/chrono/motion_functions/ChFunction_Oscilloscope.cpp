@@ -13,6 +13,7 @@
 // =============================================================================
 
 #include "chrono/motion_functions/ChFunction_Oscilloscope.h"
+#include "chrono/physics/ChSystemSnapshot.h"
 
 namespace chrono {
 
@@ -80,6 +81,21 @@ double ChFunction_Oscilloscope::Get_y(double x) const {
     return y;
 }
 
+void ChFunction_Oscilloscope::SnapshotOut(ChSnapshotBuffer& buffer) {
+    buffer.Write(end_x);
+    buffer.Write(amount);
+    for (double val : values)
+        buffer.Write(val);
+}
+
+void ChFunction_Oscilloscope::SnapshotIn(ChSnapshotBuffer& buffer) {
+    end_x = buffer.Read<double>();
+    amount = buffer.Read<int>();
+    values.resize(amount);
+    for (double& val : values)
+        val = buffer.Read<double>();
+}
+
 void ChFunction_Oscilloscope::ArchiveOut(ChArchiveOut& marchive) {
     // version number
     marchive.VersionWrite<ChFunction_Oscilloscope>();
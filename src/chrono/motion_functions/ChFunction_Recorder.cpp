@@ -12,6 +12,7 @@
 // Authors: Alessandro Tasora, Radu Serban
 // =============================================================================
 
+#include <algorithm>
 #include <cmath>
 #include <limits>
 
@@ -24,7 +25,7 @@ CH_FACTORY_REGISTER(ChFunction_Recorder)
 
 ChFunction_Recorder::ChFunction_Recorder(const ChFunction_Recorder& other) {
     m_points = other.m_points;
-    m_last = m_points.end();
+    m_last = 0;
 }
 
 void ChFunction_Recorder::Estimate_x_range(double& xmin, double& xmax) const {
@@ -41,28 +42,49 @@ void ChFunction_Recorder::Estimate_x_range(double& xmin, double& xmax) const {
 }
 
 void ChFunction_Recorder::AddPoint(double mx, double my, double mw) {
-    for (auto iter = m_points.rbegin(); iter != m_points.rend(); ++iter) {
-        double dist = mx - iter->x;
-        if (std::abs(dist) < std::numeric_limits<double>::epsilon()) {
-            // Overwrite current iterator
-            iter->x = mx;
-            iter->y = my;
-            iter->w = mw;
-            return;
-        } else if (dist > 0) {
-            // Insert before current iterator
-            ChRecPoint rec(mx, my, mw);
-            m_points.insert(iter.base(), rec);
+    // Fast path: points are usually recorded with increasing x
+    if (m_points.empty() || mx - m_points.back().x >= std::numeric_limits<double>::epsilon()) {
+        m_points.push_back(ChRecPoint(mx, my, mw));
+        return;
+    }
+
+    // Locate the first point with x > mx and check its predecessor for a duplicate
+    auto iter = std::upper_bound(m_points.begin(), m_points.end(), mx,
+                                 [](double val, const ChRecPoint& p) { return val < p.x; });
+    if (iter != m_points.begin()) {
+        auto prev = iter - 1;
+        if (std::abs(mx - prev->x) < std::numeric_limits<double>::epsilon()) {
+            // Overwrite existing point
+            prev->x = mx;
+            prev->y = my;
+            prev->w = mw;
             return;
         }
     }
 
-    // Insert in front of list
-    m_points.push_front(ChRecPoint(mx, my, mw));
+    m_points.insert(iter, ChRecPoint(mx, my, mw));
 }
 
-double Interpolate_y(double x, const ChRecPoint& p1, const ChRecPoint& p2) {
-    return ((x - p1.x) * p2.y + (p2.x - x) * p1.y) / (p2.x - p1.x);
+size_t ChFunction_Recorder::FindInterval(double x) const {
+    size_t n = m_points.size();
+
+    // Try the last used interval and its immediate neighbors
+    if (m_last + 1 < n) {
+        if (x >= m_points[m_last].x) {
+            if (x <= m_points[m_last + 1].x)
+                return m_last;
+            if (m_last + 2 < n && x <= m_points[m_last + 2].x)
+                return ++m_last;
+        } else if (m_last > 0 && x >= m_points[m_last - 1].x) {
+            return --m_last;
+        }
+    }
+
+    // Binary search for the first point with x > value (guaranteed to be in [1, n-1])
+    auto iter = std::upper_bound(m_points.begin() + 1, m_points.end() - 1, x,
+                                 [](double val, const ChRecPoint& p) { return val < p.x; });
+    m_last = (size_t)(iter - m_points.begin()) - 1;
+    return m_last;
 }
 
 double ChFunction_Recorder::Get_y(double x) const {
@@ -79,31 +101,11 @@ double ChFunction_Recorder::Get_y(double x) const {
     }
 
     // At this point we are guaranteed that there are at least two records.
+    size_t i = FindInterval(x);
+    const ChRecPoint& p1 = m_points[i];
+    const ChRecPoint& p2 = m_points[i + 1];
 
-    if (m_last == m_points.end()) {
-        m_last = m_points.begin();
-    }
-
-    if (x > m_last->x) {
-        // Search to the right
-        for (auto iter = m_last; iter != m_points.end(); ++iter) {
-            if (x <= iter->x) {
-                return Interpolate_y(x, *m_last, *iter);
-            }
-            m_last = iter;
-        }
-    } else {
-        // Search to the left
-        for (auto iter = m_last; iter != m_points.begin();) {
-            --iter;
-            if (x >= iter->x) {
-                return Interpolate_y(x, *iter, *m_last);
-            }
-            m_last = iter;
-        }
-    }
-
-    return 0;
+    return ((x - p1.x) * p2.y + (p2.x - x) * p1.y) / (p2.x - p1.x);
 }
 
 double ChFunction_Recorder::Get_y_dx(double x) const {
@@ -121,8 +123,8 @@ void ChFunction_Recorder::ArchiveOut(ChArchiveOut& marchive) {
     marchive.VersionWrite<ChFunction_Recorder>();
     // serialize parent class
     ChFunction::ArchiveOut(marchive);
-    // serialize all member data: copy to vector and store
-    std::vector<ChRecPoint> tmpvect{std::begin(m_points), std::end(m_points)};
+    // serialize all member data:
+    std::vector<ChRecPoint> tmpvect = m_points;
     marchive << CHNVP(tmpvect);
 }
 
@@ -131,11 +133,11 @@ void ChFunction_Recorder::ArchiveIn(ChArchiveIn& marchive) {
     /*int version =*/ marchive.VersionRead<ChFunction_Recorder>();
     // deserialize parent class
     ChFunction::ArchiveIn(marchive);
-    // stream in all member data: load vector of points and copy to list
+    // stream in all member data:
     std::vector<ChRecPoint> tmpvect;
     marchive >> CHNVP(tmpvect);
-    m_points.clear();
-    std::copy(tmpvect.begin(), tmpvect.end(), std::back_inserter(m_points));
+    m_points = tmpvect;
+    m_last = 0;
 }
 
 }  // end namespace chrono
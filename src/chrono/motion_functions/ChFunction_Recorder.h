@@ -15,8 +15,7 @@
 #ifndef CHFUNCT_RECORDER_H
 #define CHFUNCT_RECORDER_H
 
-#include <iterator>
-#include <list>
+#include <vector>
 
 #include "chrono/motion_functions/ChFunction_Base.h"
 
@@ -51,13 +50,21 @@ class ChApi ChRecPoint {
 ///
 /// y = interpolation of array of (x,y) data,
 ///     where (x,y) points can be inserted randomly.
+///
+/// Points are kept sorted in a contiguous array. Evaluation first checks the interval
+/// used by the previous call (and its neighbors) and otherwise falls back to a binary
+/// search, so both sequential and random access patterns are O(log n) at worst.
 class ChApi ChFunction_Recorder : public ChFunction {
   private:
-    std::list<ChRecPoint> m_points;  ///< the list of points
-    mutable std::list<ChRecPoint>::const_iterator m_last;
+    /// Return the index i of the interval [x_i, x_{i+1}] containing x.
+    /// Assumes at least two points and x strictly inside the recorded range.
+    size_t FindInterval(double x) const;
+
+    std::vector<ChRecPoint> m_points;  ///< the sorted array of points
+    mutable size_t m_last;             ///< index of the left end of the last interval used
 
   public:
-    ChFunction_Recorder() : m_last(m_points.end()) {}
+    ChFunction_Recorder() : m_last(0) {}
     ChFunction_Recorder(const ChFunction_Recorder& other);
     ~ChFunction_Recorder() {}
 
@@ -74,11 +81,13 @@ class ChApi ChFunction_Recorder : public ChFunction {
 
     void Reset() {
         m_points.clear();
-        m_last = m_points.end();
+        m_last = 0;
     }
 
-    const std::list<ChRecPoint>& GetPoints() const { return m_points; }
-    std::list<ChRecPoint>& GetPoints() { return m_points; }
+    /// Access the recorded points, sorted by increasing x.
+    /// If the array is modified directly, points must be kept sorted.
+    const std::vector<ChRecPoint>& GetPoints() const { return m_points; }
+    std::vector<ChRecPoint>& GetPoints() { return m_points; }
 
     virtual void Estimate_x_range(double& xmin, double& xmax) const override;
 
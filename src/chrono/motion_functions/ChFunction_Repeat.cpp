@@ -13,6 +13,7 @@
 // =============================================================================
 
 #include "chrono/motion_functions/ChFunction_Repeat.h"
+#include "chrono/physics/ChSystemSnapshot.h"
 
 namespace chrono {
 
@@ -38,6 +39,14 @@ void ChFunction_Repeat::Estimate_x_range(double& xmin, double& xmax) const {
     fa->Estimate_x_range(xmin, xmax);
 }
 
+void ChFunction_Repeat::SnapshotOut(ChSnapshotBuffer& buffer) {
+    buffer.WriteObject(fa);
+}
+
+void ChFunction_Repeat::SnapshotIn(ChSnapshotBuffer& buffer) {
+    buffer.ReadObject(fa);
+}
+
 void ChFunction_Repeat::ArchiveOut(ChArchiveOut& marchive) {
     // version number
     marchive.VersionWrite<ChFunction_Repeat>();
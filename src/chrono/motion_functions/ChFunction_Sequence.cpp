@@ -13,6 +13,7 @@
 // =============================================================================
 
 #include "chrono/motion_functions/ChFunction_Sequence.h"
+#include "chrono/physics/ChSystemSnapshot.h"
 #include "chrono/motion_functions/ChFunction_Const.h"
 #include "chrono/motion_functions/ChFunction_Fillet3.h"
 
@@ -333,6 +334,19 @@ bool ChFunction_Sequence::HandleAccess(int handle_id, double mx, double my, bool
     return false;
 }
 
+void ChFunction_Sequence::SnapshotOut(ChSnapshotBuffer& buffer) {
+    buffer.Write((uint32_t)functions.size());
+    for (auto& node : functions)
+        buffer.WriteObject(node.fx);
+}
+
+void ChFunction_Sequence::SnapshotIn(ChSnapshotBuffer& buffer) {
+    if (buffer.Read<uint32_t>() != (uint32_t)functions.size())
+        throw ChException("The function sequence changed since the snapshot was taken.");
+    for (auto& node : functions)
+        buffer.ReadObject(node.fx);
+}
+
 void ChFunction_Sequence::ArchiveOut(ChArchiveOut& marchive) {
     // version number
     marchive.VersionWrite<ChFunction_Sequence>();
@@ -145,6 +145,12 @@ class ChApi ChFunction_Sequence : public ChFunction {
     virtual int HandleNumber() const override;
     virtual bool HandleAccess(int handle_id, double mx, double my, bool set_mode) override;
 
+    /// Append to the buffer the internal data of the functions in the sequence.
+    virtual void SnapshotOut(ChSnapshotBuffer& buffer) override;
+
+    /// Restore the internal data stored by SnapshotOut().
+    virtual void SnapshotIn(ChSnapshotBuffer& buffer) override;
+
     /// Method to allow serialization of transient data to archives.
     virtual void ArchiveOut(ChArchiveOut& marchive) override;
 
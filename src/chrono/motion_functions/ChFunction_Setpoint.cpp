@@ -13,6 +13,7 @@
 // =============================================================================
 
 #include "chrono/motion_functions/ChFunction_Setpoint.h"
+#include "chrono/physics/ChSystemSnapshot.h"
 
 namespace chrono {
 
@@ -31,6 +32,22 @@ void ChFunction_Setpoint::SetSetpoint(double setpoint, double x) {
     last_Y_dx = Y_dx;
 }
 
+void ChFunction_Setpoint::SnapshotOut(ChSnapshotBuffer& buffer) {
+    double data[6] = {Y, Y_dx, Y_dxdx, last_x, last_Y, last_Y_dx};
+    buffer.Write(data, 6);
+}
+
+void ChFunction_Setpoint::SnapshotIn(ChSnapshotBuffer& buffer) {
+    double data[6];
+    buffer.Read(data, 6);
+    Y = data[0];
+    Y_dx = data[1];
+    Y_dxdx = data[2];
+    last_x = data[3];
+    last_Y = data[4];
+    last_Y_dx = data[5];
+}
+
 void ChFunction_Setpoint::ArchiveOut(ChArchiveOut& marchive) {
     // version number
     marchive.VersionWrite<ChFunction_Setpoint>();
@@ -86,6 +86,12 @@ class ChApi ChFunction_Setpoint : public ChFunction {
     /// Update could be implemented by children classes, ex. to launch callbacks
     virtual void Update(const double x) override {}
 
+    /// Append to the buffer the setpoint, its derivatives, and the last values used to differentiate it.
+    virtual void SnapshotOut(ChSnapshotBuffer& buffer) override;
+
+    /// Restore the internal data stored by SnapshotOut().
+    virtual void SnapshotIn(ChSnapshotBuffer& buffer) override;
+
     /// Method to allow serialization of transient data to archives.
     virtual void ArchiveOut(ChArchiveOut& marchive) override;
 
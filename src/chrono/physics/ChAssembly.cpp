@@ -14,11 +14,13 @@
 
 #include <algorithm>
 #include <cstdlib>
+#include <functional>
 
 #include "chrono/core/ChGlobal.h"
 #include "chrono/core/ChTransform.h"
 #include "chrono/physics/ChAssembly.h"
 #include "chrono/physics/ChSystem.h"
+#include "chrono/physics/ChSystemSnapshot.h"
 
 namespace chrono {
 
@@ -47,8 +49,9 @@ ChAssembly::ChAssembly()
       nsysvars_w(0),
       ndof(0),
       ndoc_w_C(0),
-      ndoc_w_D(0)
-       {}
+      ndoc_w_D(0),
+      topology_revision(0),
+      topology_hash(0) {}
 
 ChAssembly::ChAssembly(const ChAssembly& other) : ChPhysicsItem(other) {
     nbodies = other.nbodies;
@@ -69,6 +72,8 @@ ChAssembly::ChAssembly(const ChAssembly& other) : ChPhysicsItem(other) {
     ndof = other.ndof;
     nsysvars = other.nsysvars;
     nsysvars_w = other.nsysvars_w;
+    topology_revision = other.topology_revision;
+    topology_hash = other.topology_hash;
 
     //// RADU
     //// TODO:  deep copy of the object lists (bodylist, shaftlist, linklist, meshlist,  otherphysicslist)
@@ -110,6 +115,8 @@ void swap(ChAssembly& first, ChAssembly& second) {
     swap(first.ndof, second.ndof);
     swap(first.nsysvars, second.nsysvars);
     swap(first.nsysvars_w, second.nsysvars_w);
+    swap(first.topology_revision, second.topology_revision);
+    swap(first.topology_hash, second.topology_hash);
 
     //// RADU
     //// TODO: deal with all other member variables...
@@ -154,6 +161,7 @@ void ChAssembly::AddBody(std::shared_ptr<ChBody> body) {
     bodylist.push_back(body);
 
 	////system->is_initialized = false;  // Not needed, unless/until ChBody::SetupInitial does something
+    topology_revision++;
 	system->is_updated = false;
 }
 
@@ -164,6 +172,7 @@ void ChAssembly::RemoveBody(std::shared_ptr<ChBody> body) {
     bodylist.erase(itr);
     body->SetSystem(nullptr);
 
+    topology_revision++;
     system->is_updated = false;
 }
 
@@ -175,6 +184,7 @@ void ChAssembly::AddShaft(std::shared_ptr<ChShaft> shaft) {
     shaftlist.push_back(shaft);
 
     ////system->is_initialized = false;  // Not needed, unless/until ChShaft::SetupInitial does something
+    topology_revision++;
     system->is_updated = false;
 }
 
@@ -185,6 +195,7 @@ void ChAssembly::RemoveShaft(std::shared_ptr<ChShaft> shaft) {
     shaftlist.erase(itr);
     shaft->SetSystem(nullptr);
 
+    topology_revision++;
     system->is_updated = false;
 }
 
@@ -195,6 +206,7 @@ void ChAssembly::AddLink(std::shared_ptr<ChLinkBase> link) {
     linklist.push_back(link);
 
 	////system->is_initialized = false;  // Not needed, unless/until ChLink::SetupInitial does something
+    topology_revision++;
     system->is_updated = false;
 }
 
@@ -205,6 +217,7 @@ void ChAssembly::RemoveLink(std::shared_ptr<ChLinkBase> link) {
     linklist.erase(itr);
     link->SetSystem(nullptr);
 
+    topology_revision++;
     system->is_updated = false;
 }
 
@@ -215,6 +228,7 @@ void ChAssembly::AddMesh(std::shared_ptr<fea::ChMesh> mesh) {
     meshlist.push_back(mesh);
 
 	system->is_initialized = false;
+    topology_revision++;
     system->is_updated = false;
 }
 
@@ -225,6 +239,7 @@ void ChAssembly::RemoveMesh(std::shared_ptr<fea::ChMesh> mesh) {
     meshlist.erase(itr);
     mesh->SetSystem(nullptr);
 
+    topology_revision++;
     system->is_updated = false;
 }
 
@@ -240,6 +255,7 @@ void ChAssembly::AddOtherPhysicsItem(std::shared_ptr<ChPhysicsItem> item) {
     otherphysicslist.push_back(item);
 
 	////system->is_initialized = false;  // Not needed, unless/until ChPhysicsItem::SetupInitial does something
+    topology_revision++;
     system->is_updated = false;
 }
 
@@ -250,6 +266,7 @@ void ChAssembly::RemoveOtherPhysicsItem(std::shared_ptr<ChPhysicsItem> item) {
     otherphysicslist.erase(itr);
     item->SetSystem(nullptr);
 
+    topology_revision++;
     system->is_updated = false;
 }
 
@@ -320,6 +337,7 @@ void ChAssembly::RemoveAllBodies() {
         body->SetSystem(nullptr);
     }
     bodylist.clear();
+    topology_revision++;
 
     if (system)
         system->is_updated = false;
@@ -330,6 +348,7 @@ void ChAssembly::RemoveAllShafts() {
         shaft->SetSystem(nullptr);
     }
     shaftlist.clear();
+    topology_revision++;
 
     if (system)
         system->is_updated = false;
@@ -340,6 +359,7 @@ void ChAssembly::RemoveAllLinks() {
         link->SetSystem(nullptr);
     }
     linklist.clear();
+    topology_revision++;
 
     if (system)
         system->is_updated = false;
@@ -350,6 +370,7 @@ void ChAssembly::RemoveAllMeshes() {
         mesh->SetSystem(nullptr);
     }
     meshlist.clear();
+    topology_revision++;
 
     if (system)
         system->is_updated = false;
@@ -360,6 +381,7 @@ void ChAssembly::RemoveAllOtherPhysicsItems() {
         item->SetSystem(nullptr);
     }
     otherphysicslist.clear();
+    topology_revision++;
 
     if (system)
         system->is_updated = false;
@@ -462,9 +484,20 @@ void ChAssembly::SetSystem(ChSystem* m_system) {
     }
 }
 
+// Minimum number of items in a list for a per-item pass to be executed in parallel.
+static const size_t min_items_parallel = 256;
+
+int ChAssembly::GetNumItemThreads(size_t nitems) const {
+    if (!system || system->deterministic_ordering || nitems < min_items_parallel)
+        return 1;
+    return system->nthreads_chrono;
+}
+
 void ChAssembly::SyncCollisionModels() {
-    for (auto& body : bodylist) {
-        body->SyncCollisionModels();
+    int nthreads = GetNumItemThreads(bodylist.size());
+#pragma omp parallel for num_threads(nthreads) if (nthreads > 1)
+    for (int ip = 0; ip < (int)bodylist.size(); ++ip) {
+        bodylist[ip]->SyncCollisionModels();
     }
     for (auto& shaft : shaftlist) {
         shaft->SyncCollisionModels();
@@ -501,8 +534,14 @@ void ChAssembly::SetupInitial() {
     }
 }
 
+// Mix the given value into a hash.
+static inline void HashCombine(size_t& seed, size_t value) {
+    seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
 // Count all bodies, links, meshes, and other physics items.
 // Set counters (DOF, num constraints, etc) and offsets.
+// Also compute a signature of the assembly topology, used to detect when the descriptor must be fully rebuilt.
 void ChAssembly::Setup() {
     nbodies = 0;
     nbodies_sleep = 0;
@@ -519,11 +558,17 @@ void ChAssembly::Setup() {
     nlinks = 0;
     nmeshes = 0;
     nphysicsitems = 0;
+    topology_hash = 0;
 
     // Add any items queued for insertion in the assembly's lists.
     this->FlushBatch();
 
+    // Item addresses alone do not identify the topology, as new items may reuse the memory of removed ones
+    HashCombine(topology_hash, topology_revision);
+
     for (auto& body : bodylist) {
+        HashCombine(topology_hash, std::hash<void*>()(body.get()));
+        HashCombine(topology_hash, body->IsActive());
         if (body->GetBodyFixed())
             nbodies_fixed++;
         else if (body->GetSleeping())
@@ -546,6 +591,8 @@ void ChAssembly::Setup() {
     }
 
     for (auto& shaft : shaftlist) {
+        HashCombine(topology_hash, std::hash<void*>()(shaft.get()));
+        HashCombine(topology_hash, shaft->IsActive());
         if (shaft->GetShaftFixed())
             nshafts_fixed++;
         else if (shaft->GetSleeping())
@@ -568,6 +615,8 @@ void ChAssembly::Setup() {
     }
 
     for (auto& link : linklist) {
+        HashCombine(topology_hash, std::hash<void*>()(link.get()));
+        HashCombine(topology_hash, link->IsActive());
         if (link->IsActive()) {
             nlinks++;
 
@@ -576,6 +625,7 @@ void ChAssembly::Setup() {
             link->SetOffset_L(this->offset_L + ndoc_w);
 
             link->Setup();  // compute DOFs etc. and sets the offsets also in child items, if any
+            HashCombine(topology_hash, link->GetDOF_w());
 
             ncoords += link->GetDOF();
             ncoords_w += link->GetDOF_w();
@@ -593,6 +643,12 @@ void ChAssembly::Setup() {
         mesh->SetOffset_L(this->offset_L + ndoc_w);
 
         mesh->Setup();  // compute DOFs and iteratively call Setup for child items
+        HashCombine(topology_hash, std::hash<void*>()(mesh.get()));
+        HashCombine(topology_hash, mesh->GetDOF_w());
+        HashCombine(topology_hash, mesh->GetNnodes());
+        HashCombine(topology_hash, mesh->GetNelements());
+        for (const auto& node : mesh->GetNodes())
+            HashCombine(topology_hash, std::hash<void*>()(node.get()));
 
         ncoords += mesh->GetDOF();
         ncoords_w += mesh->GetDOF_w();
@@ -637,17 +693,24 @@ void ChAssembly::Update(double mytime, bool update_assets) {
 // Update all physical items (bodies, links, meshes, etc), including their auxiliary variables.
 // Updates all forces (automatic, as children of bodies)
 // Updates all markers (automatic, as children of bodies).
+// Bodies, shafts, and links only modify their own data when updated (links read the state of the connected objects,
+// which are updated in a previous pass), so each list can be processed in parallel.
 void ChAssembly::Update(bool update_assets) {
-    //// NOTE: do not switch these to range for loops (may want to use OMP for)
+    int nthreads = GetNumItemThreads(bodylist.size());
+#pragma omp parallel for num_threads(nthreads) if (nthreads > 1)
     for (int ip = 0; ip < (int)bodylist.size(); ++ip) {
         bodylist[ip]->Update(ChTime, update_assets);
     }
+    nthreads = GetNumItemThreads(shaftlist.size());
+#pragma omp parallel for num_threads(nthreads) if (nthreads > 1)
     for (int ip = 0; ip < (int)shaftlist.size(); ++ip) {
         shaftlist[ip]->Update(ChTime, update_assets);
     }
     for (int ip = 0; ip < (int)otherphysicslist.size(); ++ip) {
         otherphysicslist[ip]->Update(ChTime, update_assets);
     }
+    nthreads = GetNumItemThreads(linklist.size());
+#pragma omp parallel for num_threads(nthreads) if (nthreads > 1)
     for (int ip = 0; ip < (int)linklist.size(); ++ip) {
         linklist[ip]->Update(ChTime, update_assets);
     }
@@ -682,17 +745,29 @@ void ChAssembly::IntStateGather(const unsigned int off_x,
     unsigned int displ_x = off_x - this->offset_x;
     unsigned int displ_v = off_v - this->offset_w;
 
-    for (auto& body : bodylist) {
+    // Items write to disjoint segments of x and v, so each list can be processed in parallel.
+    // Items also return the current time, which is set below, so they are passed a thread-private placeholder.
+    double Ti;
+    int nthreads = GetNumItemThreads(bodylist.size());
+#pragma omp parallel for num_threads(nthreads) if (nthreads > 1) private(Ti)
+    for (int ip = 0; ip < (int)bodylist.size(); ++ip) {
+        auto& body = bodylist[ip];
         if (body->IsActive())
-            body->IntStateGather(displ_x + body->GetOffset_x(), x, displ_v + body->GetOffset_w(), v, T);
+            body->IntStateGather(displ_x + body->GetOffset_x(), x, displ_v + body->GetOffset_w(), v, Ti);
     }
-    for (auto& shaft : shaftlist) {
+    nthreads = GetNumItemThreads(shaftlist.size());
+#pragma omp parallel for num_threads(nthreads) if (nthreads > 1) private(Ti)
+    for (int ip = 0; ip < (int)shaftlist.size(); ++ip) {
+        auto& shaft = shaftlist[ip];
         if (shaft->IsActive())
-            shaft->IntStateGather(displ_x + shaft->GetOffset_x(), x, displ_v + shaft->GetOffset_w(), v, T);
+            shaft->IntStateGather(displ_x + shaft->GetOffset_x(), x, displ_v + shaft->GetOffset_w(), v, Ti);
     }
-    for (auto& link : linklist) {
+    nthreads = GetNumItemThreads(linklist.size());
+#pragma omp parallel for num_threads(nthreads) if (nthreads > 1) private(Ti)
+    for (int ip = 0; ip < (int)linklist.size(); ++ip) {
+        auto& link = linklist[ip];
         if (link->IsActive())
-            link->IntStateGather(displ_x + link->GetOffset_x(), x, displ_v + link->GetOffset_w(), v, T);
+            link->IntStateGather(displ_x + link->GetOffset_x(), x, displ_v + link->GetOffset_w(), v, Ti);
     }
     for (auto& mesh : meshlist) {
         mesh->IntStateGather(displ_x + mesh->GetOffset_x(), x, displ_v + mesh->GetOffset_w(), v, T);
@@ -721,13 +796,21 @@ void ChAssembly::IntStateScatter(const unsigned int off_x,
     unsigned int displ_x = off_x - this->offset_x;
     unsigned int displ_v = off_v - this->offset_w;
 
-    for (auto& body : bodylist) {
+    // Bodies and meshes must be processed before links (see above), but items in each list can be processed in
+    // parallel, as they write to their own data only.
+    int nthreads = GetNumItemThreads(bodylist.size());
+#pragma omp parallel for num_threads(nthreads) if (nthreads > 1)
+    for (int ip = 0; ip < (int)bodylist.size(); ++ip) {
+        auto& body = bodylist[ip];
         if (body->IsActive())
             body->IntStateScatter(displ_x + body->GetOffset_x(), x, displ_v + body->GetOffset_w(), v, T, full_update);
         else
             body->Update(T, full_update);
     }
-    for (auto& shaft : shaftlist) {
+    nthreads = GetNumItemThreads(shaftlist.size());
+#pragma omp parallel for num_threads(nthreads) if (nthreads > 1)
+    for (int ip = 0; ip < (int)shaftlist.size(); ++ip) {
+        auto& shaft = shaftlist[ip];
         if (shaft->IsActive())
             shaft->IntStateScatter(displ_x + shaft->GetOffset_x(), x, displ_v + shaft->GetOffset_w(), v, T, full_update);
         else
@@ -736,7 +819,10 @@ void ChAssembly::IntStateScatter(const unsigned int off_x,
     for (auto& mesh : meshlist) {
         mesh->IntStateScatter(displ_x + mesh->GetOffset_x(), x, displ_v + mesh->GetOffset_w(), v, T, full_update);
     }
-    for (auto& link : linklist) {
+    nthreads = GetNumItemThreads(linklist.size());
+#pragma omp parallel for num_threads(nthreads) if (nthreads > 1)
+    for (int ip = 0; ip < (int)linklist.size(); ++ip) {
+        auto& link = linklist[ip];
         if (link->IsActive())
             link->IntStateScatter(displ_x + link->GetOffset_x(), x, displ_v + link->GetOffset_w(), v, T, full_update);
         else
@@ -752,15 +838,25 @@ void ChAssembly::IntStateScatter(const unsigned int off_x,
 void ChAssembly::IntStateGatherAcceleration(const unsigned int off_a, ChStateDelta& a) {
     unsigned int displ_a = off_a - this->offset_w;
 
-    for (auto& body : bodylist) {
+    // Items write to disjoint segments of a, so each list can be processed in parallel.
+    int nthreads = GetNumItemThreads(bodylist.size());
+#pragma omp parallel for num_threads(nthreads) if (nthreads > 1)
+    for (int ip = 0; ip < (int)bodylist.size(); ++ip) {
+        auto& body = bodylist[ip];
         if (body->IsActive())
             body->IntStateGatherAcceleration(displ_a + body->GetOffset_w(), a);
     }
-    for (auto& shaft : shaftlist) {
+    nthreads = GetNumItemThreads(shaftlist.size());
+#pragma omp parallel for num_threads(nthreads) if (nthreads > 1)
+    for (int ip = 0; ip < (int)shaftlist.size(); ++ip) {
+        auto& shaft = shaftlist[ip];
         if (shaft->IsActive())
             shaft->IntStateGatherAcceleration(displ_a + shaft->GetOffset_w(), a);
     }
-    for (auto& link : linklist) {
+    nthreads = GetNumItemThreads(linklist.size());
+#pragma omp parallel for num_threads(nthreads) if (nthreads > 1)
+    for (int ip = 0; ip < (int)linklist.size(); ++ip) {
+        auto& link = linklist[ip];
         if (link->IsActive())
             link->IntStateGatherAcceleration(displ_a + link->GetOffset_w(), a);
     }
@@ -777,15 +873,25 @@ void ChAssembly::IntStateGatherAcceleration(const unsigned int off_a, ChStateDel
 void ChAssembly::IntStateScatterAcceleration(const unsigned int off_a, const ChStateDelta& a) {
     unsigned int displ_a = off_a - this->offset_w;
 
-    for (auto& body : bodylist) {
+    // Items only modify their own data, so each list can be processed in parallel.
+    int nthreads = GetNumItemThreads(bodylist.size());
+#pragma omp parallel for num_threads(nthreads) if (nthreads > 1)
+    for (int ip = 0; ip < (int)bodylist.size(); ++ip) {
+        auto& body = bodylist[ip];
         if (body->IsActive())
             body->IntStateScatterAcceleration(displ_a + body->GetOffset_w(), a);
     }
-    for (auto& shaft : shaftlist) {
+    nthreads = GetNumItemThreads(shaftlist.size());
+#pragma omp parallel for num_threads(nthreads) if (nthreads > 1)
+    for (int ip = 0; ip < (int)shaftlist.size(); ++ip) {
+        auto& shaft = shaftlist[ip];
         if (shaft->IsActive())
             shaft->IntStateScatterAcceleration(displ_a + shaft->GetOffset_w(), a);
     }
-    for (auto& link : linklist) {
+    nthreads = GetNumItemThreads(linklist.size());
+#pragma omp parallel for num_threads(nthreads) if (nthreads > 1)
+    for (int ip = 0; ip < (int)linklist.size(); ++ip) {
+        auto& link = linklist[ip];
         if (link->IsActive())
             link->IntStateScatterAcceleration(displ_a + link->GetOffset_w(), a);
     }
@@ -920,11 +1026,19 @@ void ChAssembly::IntLoadResidual_F(const unsigned int off,  ///< offset in R res
 {
     unsigned int displ_v = off - this->offset_w;
 
-    for (auto& body : bodylist) {
+    // Bodies and shafts only load forces on their own variables, so they can be processed in parallel. This is not
+    // the case for links, which load forces on the variables of the connected objects.
+    int nthreads = GetNumItemThreads(bodylist.size());
+#pragma omp parallel for num_threads(nthreads) if (nthreads > 1)
+    for (int ip = 0; ip < (int)bodylist.size(); ++ip) {
+        auto& body = bodylist[ip];
         if (body->IsActive())
             body->IntLoadResidual_F(displ_v + body->GetOffset_w(), R, c);
     }
-    for (auto& shaft : shaftlist) {
+    nthreads = GetNumItemThreads(shaftlist.size());
+#pragma omp parallel for num_threads(nthreads) if (nthreads > 1)
+    for (int ip = 0; ip < (int)shaftlist.size(); ++ip) {
+        auto& shaft = shaftlist[ip];
         if (shaft->IsActive())
             shaft->IntLoadResidual_F(displ_v + shaft->GetOffset_w(), R, c);
     }
@@ -948,11 +1062,18 @@ void ChAssembly::IntLoadResidual_Mv(const unsigned int off,      ///< offset in
 ) {
     unsigned int displ_v = off - this->offset_w;
 
-    for (auto& body : bodylist) {
+    // Bodies and shafts only load terms on their own variables, so they can be processed in parallel.
+    int nthreads = GetNumItemThreads(bodylist.size());
+#pragma omp parallel for num_threads(nthreads) if (nthreads > 1)
+    for (int ip = 0; ip < (int)bodylist.size(); ++ip) {
+        auto& body = bodylist[ip];
         if (body->IsActive())
             body->IntLoadResidual_Mv(displ_v + body->GetOffset_w(), R, w, c);
     }
-    for (auto& shaft : shaftlist) {
+    nthreads = GetNumItemThreads(shaftlist.size());
+#pragma omp parallel for num_threads(nthreads) if (nthreads > 1)
+    for (int ip = 0; ip < (int)shaftlist.size(); ++ip) {
+        auto& shaft = shaftlist[ip];
         if (shaft->IsActive())
             shaft->IntLoadResidual_Mv(displ_v + shaft->GetOffset_w(), R, w, c);
     }
@@ -1427,6 +1548,41 @@ void ChAssembly::KRMmatricesLoad(double Kfactor, double Rfactor, double Mfactor)
     }
 }
 
+// -----------------------------------------------------------------------------
+//  SNAPSHOTS
+
+// Store the number of items in a list, followed by the internal data of each item
+template <class T>
+static void SnapshotListOut(ChSnapshotBuffer& buffer, const std::vector<std::shared_ptr<T>>& list) {
+    buffer.Write((uint32_t)list.size());
+    for (auto& item : list)
+        item->SnapshotOut(buffer);
+}
+
+template <class T>
+static void SnapshotListIn(ChSnapshotBuffer& buffer, const std::vector<std::shared_ptr<T>>& list) {
+    if (buffer.Read<uint32_t>() != (uint32_t)list.size())
+        throw ChException("The system structure changed since the snapshot was taken.");
+    for (auto& item : list)
+        item->SnapshotIn(buffer);
+}
+
+void ChAssembly::SnapshotOut(ChSnapshotBuffer& buffer) {
+    SnapshotListOut(buffer, bodylist);
+    SnapshotListOut(buffer, shaftlist);
+    SnapshotListOut(buffer, linklist);
+    SnapshotListOut(buffer, meshlist);
+    SnapshotListOut(buffer, otherphysicslist);
+}
+
+void ChAssembly::SnapshotIn(ChSnapshotBuffer& buffer) {
+    SnapshotListIn(buffer, bodylist);
+    SnapshotListIn(buffer, shaftlist);
+    SnapshotListIn(buffer, linklist);
+    SnapshotListIn(buffer, meshlist);
+    SnapshotListIn(buffer, otherphysicslist);
+}
+
 // -----------------------------------------------------------------------------
 //  STREAMING - FILE HANDLING
 
@@ -185,6 +185,12 @@ class ChApi ChAssembly : public ChPhysicsItem {
     /// Get the number of system variables (coordinates plus the constraint multipliers).
     int GetNsysvars_w() const { return nsysvars_w; }
 
+    /// Get a signature of the topology of this assembly, as computed at the last call to Setup().
+    /// The signature changes whenever bodies, shafts, links, or meshes are added or removed, or when any of them
+    /// changes its number of states or its active status (e.g., a body that is fixed or put to sleep).
+    /// Other physics items are not taken into account.
+    size_t GetTopologyHash() const { return topology_hash; }
+
     //
     // PHYSICS ITEM INTERFACE
     //
@@ -297,6 +303,14 @@ class ChApi ChAssembly : public ChPhysicsItem {
     virtual void ConstraintsFbLoadForces(double factor = 1) override;
     virtual void ConstraintsFetch_react(double factor = 1) override;
 
+    // SNAPSHOTS
+
+    /// Append to the buffer the internal data of all contained items which is not part of the state vectors.
+    virtual void SnapshotOut(ChSnapshotBuffer& buffer) override;
+
+    /// Restore the internal data stored by SnapshotOut().
+    virtual void SnapshotIn(ChSnapshotBuffer& buffer) override;
+
     //
     // SERIALIZATION
     //
@@ -321,6 +335,10 @@ class ChApi ChAssembly : public ChPhysicsItem {
   protected:
     virtual void SetupInitial() override;
 
+    /// Return the number of threads for a per-item pass over a list with the given number of items.
+    /// Returns 1 (serial, in-order processing) for short lists, or if deterministic ordering was requested.
+    int GetNumItemThreads(size_t nitems) const;
+
     std::vector<std::shared_ptr<ChBody>> bodylist;                 ///< list of rigid bodies
     std::vector<std::shared_ptr<ChShaft>> shaftlist;               ///< list of 1-D shafts
     std::vector<std::shared_ptr<ChLinkBase>> linklist;             ///< list of joints (links)
@@ -349,6 +367,9 @@ class ChApi ChAssembly : public ChPhysicsItem {
     int ndoc_w_C;    ///< number of scalar constraints C, when using 3 rot. dof. per body (excluding unilaterals)
     int ndoc_w_D;    ///< number of scalar constraints D, when using 3 rot. dof. per body (only unilaterals)
 
+    size_t topology_revision;  ///< counter of item insertions and removals
+    size_t topology_hash;      ///< signature of the bodies, shafts, links, and meshes, and of their states (see Setup)
+
     friend class ChSystem;
     friend class ChSystemMulticore;
     friend class ChSystemDistributed;
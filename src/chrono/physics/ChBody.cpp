@@ -21,6 +21,7 @@
 #include "chrono/physics/ChForce.h"
 #include "chrono/physics/ChMarker.h"
 #include "chrono/physics/ChSystem.h"
+#include "chrono/physics/ChSystemSnapshot.h"
 
 #include "chrono/collision/ChCollisionModelBullet.h"
 #ifdef CHRONO_COLLISION
@@ -1073,6 +1074,19 @@ void ChBody::ComputeNF(
     detJ = 1;  // not needed because not used in quadrature.
 }
 
+// ---------------------------------------------------------------------------
+// SNAPSHOTS
+
+void ChBody::SnapshotOut(ChSnapshotBuffer& buffer) {
+    buffer.Write((uint8_t)BFlagGet(BodyFlag::SLEEPING));
+    buffer.Write(sleep_starttime);
+}
+
+void ChBody::SnapshotIn(ChSnapshotBuffer& buffer) {
+    BFlagSet(BodyFlag::SLEEPING, buffer.Read<uint8_t>() != 0);
+    sleep_starttime = buffer.Read<float>();
+}
+
 // ---------------------------------------------------------------------------
 // FILE I/O
 
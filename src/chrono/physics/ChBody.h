@@ -435,6 +435,14 @@ class ChApi ChBody : public ChPhysicsItem, public ChBodyFrame, public ChContacta
     /// This is only for backward compatibility
     virtual ChPhysicsItem* GetPhysicsItem() override { return this; }
 
+    // SNAPSHOTS
+
+    /// Append to the buffer the internal data of the body (sleeping state) which is not part of the state vectors.
+    virtual void SnapshotOut(ChSnapshotBuffer& buffer) override;
+
+    /// Restore the internal data stored by SnapshotOut().
+    virtual void SnapshotIn(ChSnapshotBuffer& buffer) override;
+
     // SERIALIZATION
 
     /// Method to allow serialization of transient data to archives.
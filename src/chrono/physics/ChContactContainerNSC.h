@@ -15,17 +15,17 @@
 #ifndef CH_CONTACTCONTAINER_NSC_H
 #define CH_CONTACTCONTAINER_NSC_H
 
-#include <list>
-
 #include "chrono/physics/ChContactContainer.h"
+#include "chrono/physics/ChContactPool.h"
 #include "chrono/physics/ChContactNSC.h"
 #include "chrono/physics/ChContactNSCrolling.h"
+#include "chrono/physics/ChContactPairCache.h"
 #include "chrono/physics/ChContactable.h"
 
 namespace chrono {
 
 /// Class representing a container of many non-smooth contacts.
-/// Implemented using linked lists of ChContactNSC objects (that is, contacts between two ChContactable objects, with 3
+/// Implemented using pools of ChContactNSC objects (that is, contacts between two ChContactable objects, with 3
 /// reactions). It might also contain ChContactNSCrolling objects (extended versions of ChContactNSC, with 6 reactions,
 /// that account also for rolling and spinning resistance), but also for '6dof vs 6dof' contactables.
 class ChApi ChContactContainerNSC : public ChContactContainer {
@@ -44,46 +44,29 @@ class ChApi ChContactContainerNSC : public ChContactContainer {
     typedef ChContactNSCrolling<ChContactable_1vars<6>, ChContactable_1vars<6> > ChContactNSCrolling_6_6;
 
   protected:
-    std::list<ChContactNSC_6_6*> contactlist_6_6;
-    std::list<ChContactNSC_6_3*> contactlist_6_3;
-    std::list<ChContactNSC_3_3*> contactlist_3_3;
-    std::list<ChContactNSC_333_3*> contactlist_333_3;
-    std::list<ChContactNSC_333_6*> contactlist_333_6;
-    std::list<ChContactNSC_333_333*> contactlist_333_333;
-    std::list<ChContactNSC_666_3*> contactlist_666_3;
-    std::list<ChContactNSC_666_6*> contactlist_666_6;
-    std::list<ChContactNSC_666_333*> contactlist_666_333;
-    std::list<ChContactNSC_666_666*> contactlist_666_666;
-
-    std::list<ChContactNSCrolling_6_6*> contactlist_6_6_rolling;
-
-    int n_added_6_6;
-    int n_added_6_3;
-    int n_added_3_3;
-    int n_added_333_3;
-    int n_added_333_6;
-    int n_added_333_333;
-    int n_added_666_3;
-    int n_added_666_6;
-    int n_added_666_333;
-    int n_added_666_666;
-    int n_added_6_6_rolling;
-
-    std::list<ChContactNSC_6_6*>::iterator lastcontact_6_6;
-    std::list<ChContactNSC_6_3*>::iterator lastcontact_6_3;
-    std::list<ChContactNSC_3_3*>::iterator lastcontact_3_3;
-    std::list<ChContactNSC_333_3*>::iterator lastcontact_333_3;
-    std::list<ChContactNSC_333_6*>::iterator lastcontact_333_6;
-    std::list<ChContactNSC_333_333*>::iterator lastcontact_333_333;
-    std::list<ChContactNSC_666_3*>::iterator lastcontact_666_3;
-    std::list<ChContactNSC_666_6*>::iterator lastcontact_666_6;
-    std::list<ChContactNSC_666_333*>::iterator lastcontact_666_333;
-    std::list<ChContactNSC_666_666*>::iterator lastcontact_666_666;
-
-    std::list<ChContactNSCrolling_6_6*>::iterator lastcontact_6_6_rolling;
+    ChContactPool<ChContactNSC_6_6> contactlist_6_6;
+    ChContactPool<ChContactNSC_6_3> contactlist_6_3;
+    ChContactPool<ChContactNSC_3_3> contactlist_3_3;
+    ChContactPool<ChContactNSC_333_3> contactlist_333_3;
+    ChContactPool<ChContactNSC_333_6> contactlist_333_6;
+    ChContactPool<ChContactNSC_333_333> contactlist_333_333;
+    ChContactPool<ChContactNSC_666_3> contactlist_666_3;
+    ChContactPool<ChContactNSC_666_6> contactlist_666_6;
+    ChContactPool<ChContactNSC_666_333> contactlist_666_333;
+    ChContactPool<ChContactNSC_666_666> contactlist_666_666;
+
+    ChContactPool<ChContactNSCrolling_6_6> contactlist_6_6_rolling;
 
     std::unordered_map<ChContactable*, ForceTorque> contact_forces;
 
+    /// Persistent N,U,V (and rolling) reactions, used for warm starting contacts that survive between steps.
+    struct ReactionCache {
+        float reactions[6] = {0, 0, 0, 0, 0, 0};
+    };
+
+    bool use_contact_cache;                           ///< maintain persistent reactions for warm starting
+    ChContactPairCache<ReactionCache> contact_cache;  ///< reactions cached per pair of colliding shapes
+
   public:
     ChContactContainerNSC();
     ChContactContainerNSC(const ChContactContainerNSC& other);
@@ -94,17 +77,27 @@ class ChApi ChContactContainerNSC : public ChContactContainer {
 
     /// Report the number of added contacts.
     virtual int GetNcontacts() const override {
-        return n_added_3_3 + n_added_6_3 + n_added_6_6 + n_added_333_3 + n_added_333_6 + n_added_333_333 +
-               n_added_666_3 + n_added_666_6 + n_added_666_333 + n_added_666_666 + n_added_6_6_rolling;
+        return contactlist_3_3.size() + contactlist_6_3.size() + contactlist_6_6.size() + contactlist_333_3.size() +
+               contactlist_333_6.size() + contactlist_333_333.size() + contactlist_666_3.size() + contactlist_666_6.size() +
+               contactlist_666_333.size() + contactlist_666_666.size() + contactlist_6_6_rolling.size();
     }
 
+    /// Enable/disable the persistent contact cache (default: true).
+    /// If enabled, the reactions of a contact that survives between two successive collision detection passes (same
+    /// pair of collision shapes, contact point at nearly the same location) are carried over to the new contact and
+    /// used to warm start the solver. This cache is only used for contacts for which the collision system does not
+    /// already provide a persistent reaction cache (e.g., the Bullet persistent manifolds).
+    void EnableContactCache(bool val) { use_contact_cache = val; }
+
+    /// Return true if the persistent contact cache is enabled.
+    bool IsContactCacheEnabled() const { return use_contact_cache; }
+
     /// Remove (delete) all contained contact data.
     virtual void RemoveAllContacts() override;
 
     /// The collision system will call BeginAddContact() before adding all contacts (for example with AddContact() or
-    /// similar). Instead of simply deleting all list of the previous contacts, this optimized implementation rewinds
-    /// the link iterator to begin and tries to reuse previous contact objects until possible, to avoid too much
-    /// allocation/deallocation.
+    /// similar). Instead of simply deleting all the previous contacts, this optimized implementation rewinds the
+    /// contact pools and reuses previous contact objects until possible, to avoid too much allocation/deallocation.
     virtual void BeginAddContact() override;
 
     /// Add a contact between two collision shapes, storing it into this container.
@@ -120,7 +113,8 @@ class ChApi ChContactContainerNSC : public ChContactContainer {
     virtual void AddContact(const collision::ChCollisionInfo& cinfo) override;
 
     /// The collision system will call BeginAddContact() after adding all contacts (for example with AddContact() or
-    /// similar). This optimized version purges the end of the list of contacts that were not reused (if any).
+    /// similar). This optimized version releases the contacts that were not reused, if the pools are much larger than
+    /// currently needed.
     virtual void EndAddContact() override;
 
     /// Scan all the contacts and for each contact executes the OnReportContact() function of the provided callback
@@ -159,9 +153,10 @@ class ChApi ChContactContainerNSC : public ChContactContainer {
     /// Report the number of scalar unilateral constraints.
     /// Note: friction constraints aren't exactly unilaterals, but they are still counted.
     virtual int GetDOC_d() override {
-        return 3 * (n_added_3_3 + n_added_6_3 + n_added_6_6 + n_added_333_3 + n_added_333_6 + n_added_333_333 +
-                    n_added_666_3 + n_added_666_6 + n_added_666_333 + n_added_666_666) +
-               6 * (n_added_6_6_rolling);
+        return 3 * (contactlist_3_3.size() + contactlist_6_3.size() + contactlist_6_6.size() + contactlist_333_3.size() +
+                    contactlist_333_6.size() + contactlist_333_333.size() + contactlist_666_3.size() +
+                    contactlist_666_6.size() + contactlist_666_333.size() + contactlist_666_666.size()) +
+               6 * (contactlist_6_6_rolling.size());
     }
 
     /// Update state of this contact container: compute jacobians, violations, etc.
@@ -214,6 +209,17 @@ class ChApi ChContactContainerNSC : public ChContactContainer {
     virtual void ConstraintsLoadJacobians() override;
     virtual void ConstraintsFetch_react(double factor = 1) override;
 
+    //
+    // SNAPSHOTS
+    //
+
+    /// Append to the buffer the persistent contact reactions.
+    /// Current contacts are not stored: they are regenerated at the next collision detection pass.
+    virtual void SnapshotOut(ChSnapshotBuffer& buffer) override;
+
+    /// Restore the persistent contact reactions stored by SnapshotOut(), removing all current contacts.
+    virtual void SnapshotIn(ChSnapshotBuffer& buffer) override;
+
     //
     // SERIALIZATION
     //
@@ -14,6 +14,7 @@
 
 #include "chrono/physics/ChContactContainerSMC.h"
 #include "chrono/physics/ChSystemSMC.h"
+#include "chrono/physics/ChSystemSnapshot.h"
 
 namespace chrono {
 
@@ -23,30 +24,10 @@ using namespace geometry;
 // Register into the object factory, to enable run-time dynamic creation and persistence
 CH_FACTORY_REGISTER(ChContactContainerSMC)
 
-ChContactContainerSMC::ChContactContainerSMC()
-    : n_added_3_3(0),
-      n_added_6_3(0),
-      n_added_6_6(0),
-      n_added_333_3(0),
-      n_added_333_6(0),
-      n_added_333_333(0),
-      n_added_666_3(0),
-      n_added_666_6(0),
-      n_added_666_333(0),
-      n_added_666_666(0) {}
-
-ChContactContainerSMC::ChContactContainerSMC(const ChContactContainerSMC& other) : ChContactContainer(other) {
-    n_added_3_3 = 0;
-    n_added_6_3 = 0;
-    n_added_6_6 = 0;
-    n_added_333_3 = 0;
-    n_added_333_6 = 0;
-    n_added_333_333 = 0;
-    n_added_666_3 = 0;
-    n_added_666_6 = 0;
-    n_added_666_333 = 0;
-    n_added_666_666 = 0;
-}
+ChContactContainerSMC::ChContactContainerSMC() : defer_evaluation(false) {}
+
+ChContactContainerSMC::ChContactContainerSMC(const ChContactContainerSMC& other)
+    : ChContactContainer(other), defer_evaluation(false) {}
 
 ChContactContainerSMC::~ChContactContainerSMC() {
     RemoveAllContacts();
@@ -57,138 +38,111 @@ void ChContactContainerSMC::Update(double mytime, bool update_assets) {
     ChContactContainer::Update(mytime, update_assets);
 }
 
-template <class Tcont, class Titer>
-void _RemoveAllContacts(std::list<Tcont*>& contactlist, Titer& lastcontact, int& n_added) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
-    while (itercontact != contactlist.end()) {
-        delete (*itercontact);
-        (*itercontact) = 0;
-        ++itercontact;
-    }
-    contactlist.clear();
-    lastcontact = contactlist.begin();
-    n_added = 0;
-}
-
 void ChContactContainerSMC::RemoveAllContacts() {
-    _RemoveAllContacts(contactlist_3_3, lastcontact_3_3, n_added_3_3);
-    _RemoveAllContacts(contactlist_6_3, lastcontact_6_3, n_added_6_3);
-    _RemoveAllContacts(contactlist_6_6, lastcontact_6_6, n_added_6_6);
-    _RemoveAllContacts(contactlist_333_3, lastcontact_333_3, n_added_333_3);
-    _RemoveAllContacts(contactlist_333_6, lastcontact_333_6, n_added_333_6);
-    _RemoveAllContacts(contactlist_333_333, lastcontact_333_333, n_added_333_333);
-    _RemoveAllContacts(contactlist_666_3, lastcontact_666_3, n_added_666_3);
-    _RemoveAllContacts(contactlist_666_6, lastcontact_666_6, n_added_666_6);
-    _RemoveAllContacts(contactlist_666_333, lastcontact_666_333, n_added_666_333);
-    _RemoveAllContacts(contactlist_666_666, lastcontact_666_666, n_added_666_666);
+    contactlist_3_3.Clear();
+    contactlist_6_3.Clear();
+    contactlist_6_6.Clear();
+    contactlist_333_3.Clear();
+    contactlist_333_6.Clear();
+    contactlist_333_333.Clear();
+    contactlist_666_3.Clear();
+    contactlist_666_6.Clear();
+    contactlist_666_333.Clear();
+    contactlist_666_666.Clear();
     //**TODO*** cont. roll.
+    history_cache.Clear();
 }
 
 void ChContactContainerSMC::BeginAddContact() {
-    lastcontact_3_3 = contactlist_3_3.begin();
-    n_added_3_3 = 0;
-
-    lastcontact_6_3 = contactlist_6_3.begin();
-    n_added_6_3 = 0;
-
-    lastcontact_6_6 = contactlist_6_6.begin();
-    n_added_6_6 = 0;
-
-    lastcontact_333_3 = contactlist_333_3.begin();
-    n_added_333_3 = 0;
-
-    lastcontact_333_6 = contactlist_333_6.begin();
-    n_added_333_6 = 0;
-
-    lastcontact_333_333 = contactlist_333_333.begin();
-    n_added_333_333 = 0;
-
-    lastcontact_666_3 = contactlist_666_3.begin();
-    n_added_666_3 = 0;
-
-    lastcontact_666_6 = contactlist_666_6.begin();
-    n_added_666_6 = 0;
-
-    lastcontact_666_333 = contactlist_666_333.begin();
-    n_added_666_333 = 0;
-
-    lastcontact_666_666 = contactlist_666_666.begin();
-    n_added_666_666 = 0;
+    // Existing contacts may still point into the cache storage, so it can only be released before they are reused
+    auto sys = static_cast<ChSystemSMC*>(GetSystem());
+    if (sys->GetTangentialDisplacementModel() == ChSystemSMC::MultiStep)
+        history_cache.Begin();
+    else
+        history_cache.Clear();
+
+    contactlist_3_3.Rewind();
+    contactlist_6_3.Rewind();
+    contactlist_6_6.Rewind();
+    contactlist_333_3.Rewind();
+    contactlist_333_6.Rewind();
+    contactlist_333_333.Rewind();
+    contactlist_666_3.Rewind();
+    contactlist_666_6.Rewind();
+    contactlist_666_333.Rewind();
+    contactlist_666_666.Rewind();
+    // contactlist_roll.Rewind();
+
+    defer_evaluation = true;
+}
 
-    // lastcontact_roll = contactlist_roll.begin();
-    // n_added_roll = 0;
+// Evaluate forces and Jacobians of all contacts in the given pool.
+// Number of threads used to process the contacts of the given SMC system (see ChSystemSMC::SetParallelContacts).
+static int _NumContactThreads(const ChSystem* sys) {
+    auto sys_smc = static_cast<const ChSystemSMC*>(sys);
+    return sys_smc->GetParallelContacts() ? sys_smc->GetNumThreadsChrono() : 1;
 }
 
-void ChContactContainerSMC::EndAddContact() {
-    // remove contacts that are beyond last contact
-    while (lastcontact_3_3 != contactlist_3_3.end()) {
-        delete (*lastcontact_3_3);
-        lastcontact_3_3 = contactlist_3_3.erase(lastcontact_3_3);
-    }
-    while (lastcontact_6_3 != contactlist_6_3.end()) {
-        delete (*lastcontact_6_3);
-        lastcontact_6_3 = contactlist_6_3.erase(lastcontact_6_3);
-    }
-    while (lastcontact_6_6 != contactlist_6_6.end()) {
-        delete (*lastcontact_6_6);
-        lastcontact_6_6 = contactlist_6_6.erase(lastcontact_6_6);
-    }
-    while (lastcontact_333_3 != contactlist_333_3.end()) {
-        delete (*lastcontact_333_3);
-        lastcontact_333_3 = contactlist_333_3.erase(lastcontact_333_3);
-    }
-    while (lastcontact_333_6 != contactlist_333_6.end()) {
-        delete (*lastcontact_333_6);
-        lastcontact_333_6 = contactlist_333_6.erase(lastcontact_333_6);
-    }
-    while (lastcontact_333_333 != contactlist_333_333.end()) {
-        delete (*lastcontact_333_333);
-        lastcontact_333_333 = contactlist_333_333.erase(lastcontact_333_333);
-    }
-    while (lastcontact_666_3 != contactlist_666_3.end()) {
-        delete (*lastcontact_666_3);
-        lastcontact_666_3 = contactlist_666_3.erase(lastcontact_666_3);
-    }
-    while (lastcontact_666_6 != contactlist_666_6.end()) {
-        delete (*lastcontact_666_6);
-        lastcontact_666_6 = contactlist_666_6.erase(lastcontact_666_6);
-    }
-    while (lastcontact_666_333 != contactlist_666_333.end()) {
-        delete (*lastcontact_666_333);
-        lastcontact_666_333 = contactlist_666_333.erase(lastcontact_666_333);
-    }
-    while (lastcontact_666_666 != contactlist_666_666.end()) {
-        delete (*lastcontact_666_666);
-        lastcontact_666_666 = contactlist_666_666.erase(lastcontact_666_666);
+// Each contact only writes its own data, so the evaluation order does not affect the results.
+// With the default force algorithm, the forces are calculated in blocks of contacts by the force kernel of the system.
+// A user-provided force algorithm is always called serially, in contact order, as it need not be thread-safe.
+template <class Tcont>
+void _EvaluateContacts(ChContactPool<Tcont>& contactlist, const ChSystemSMC& sys, int nthreads) {
+    int ncontacts = contactlist.size();
+
+    if (!sys.UsingDefaultContactForceAlgorithm()) {
+        for (int i = 0; i < ncontacts; i++) {
+            contactlist[i].Evaluate();
+        }
+        return;
     }
 
-    // while (lastcontact_roll != contactlist_roll.end()) {
-    //    delete (*lastcontact_roll);
-    //    lastcontact_roll = contactlist_roll.erase(lastcontact_roll);
-    //}
+    const int block_size = 64;
+    int nblocks = (ncontacts + block_size - 1) / block_size;
+#pragma omp parallel for schedule(dynamic, 1) num_threads(nthreads) if (nblocks > 1)
+    for (int k = 0; k < nblocks; k++) {
+        ChSystemSMC::ContactForceInput input[block_size];
+        ChVector<> force[block_size];
+        int start = k * block_size;
+        int n = std::min(block_size, ncontacts - start);
+        for (int i = 0; i < n; i++)
+            contactlist[start + i].GetForceInput(input[i]);
+        sys.CalculateContactForces(input, force, n);
+        for (int i = 0; i < n; i++)
+            contactlist[start + i].Evaluate(force[i]);
+    }
 }
 
-template <class Tcont, class Titer, class Ta, class Tb>
-void _OptimalContactInsert(std::list<Tcont*>& contactlist,           // contact list
-                           Titer& lastcontact,                       // last contact acquired
-                           int& n_added,                             // number of contacts inserted
-                           ChContactContainer* container,            // contact container
-                           Ta* objA,                                 // collidable object A
-                           Tb* objB,                                 // collidable object B
-                           const collision::ChCollisionInfo& cinfo,  // collision information
-                           const ChMaterialCompositeSMC& cmat        // composite material
-) {
-    if (lastcontact != contactlist.end()) {
-        // reuse old contacts
-        (*lastcontact)->Reset(objA, objB, cinfo, cmat);
-        lastcontact++;
-    } else {
-        // add new contact
-        Tcont* mc = new Tcont(container, objA, objB, cinfo, cmat);
-        contactlist.push_back(mc);
-        lastcontact = contactlist.end();
-    }
-    n_added++;
+void ChContactContainerSMC::EndAddContact() {
+    // release unused contacts if the pools are much larger than needed
+    contactlist_3_3.Trim();
+    contactlist_6_3.Trim();
+    contactlist_6_6.Trim();
+    contactlist_333_3.Trim();
+    contactlist_333_6.Trim();
+    contactlist_333_333.Trim();
+    contactlist_666_3.Trim();
+    contactlist_666_6.Trim();
+    contactlist_666_333.Trim();
+    contactlist_666_666.Trim();
+
+    // contactlist_roll.Trim();
+
+    // evaluate the contacts added during this collision detection pass
+    auto sys = static_cast<ChSystemSMC*>(GetSystem());
+    int nthreads = _NumContactThreads(sys);
+    _EvaluateContacts(contactlist_3_3, *sys, nthreads);
+    _EvaluateContacts(contactlist_6_3, *sys, nthreads);
+    _EvaluateContacts(contactlist_6_6, *sys, nthreads);
+    _EvaluateContacts(contactlist_333_3, *sys, nthreads);
+    _EvaluateContacts(contactlist_333_6, *sys, nthreads);
+    _EvaluateContacts(contactlist_333_333, *sys, nthreads);
+    _EvaluateContacts(contactlist_666_3, *sys, nthreads);
+    _EvaluateContacts(contactlist_666_6, *sys, nthreads);
+    _EvaluateContacts(contactlist_666_333, *sys, nthreads);
+    _EvaluateContacts(contactlist_666_666, *sys, nthreads);
+
+    defer_evaluation = false;
 }
 
 void ChContactContainerSMC::AddContact(const collision::ChCollisionInfo& cinfo,
@@ -255,9 +209,22 @@ void ChContactContainerSMC::AddContact(const collision::ChCollisionInfo& cinfo)
     InsertContact(cinfo, cmat);
 }
 
-void ChContactContainerSMC::InsertContact(const collision::ChCollisionInfo& cinfo, const ChMaterialCompositeSMC& cmat) {
-    auto contactableA = cinfo.modelA->GetContactable();
-    auto contactableB = cinfo.modelB->GetContactable();
+void ChContactContainerSMC::InsertContact(const collision::ChCollisionInfo& cinfo_in, const ChMaterialCompositeSMC& cmat) {
+    auto contactableA = cinfo_in.modelA->GetContactable();
+    auto contactableB = cinfo_in.modelB->GetContactable();
+
+    // With the MultiStep model, if the collision system does not maintain persistent contact data, attach the cached
+    // tangential displacement of the matching contact at the previous step (if any). Since the SMC envelope is
+    // usually zero, contact points are matched within the effective radius of curvature at contact.
+    collision::ChCollisionInfo cinfo(cinfo_in);
+    if (!cinfo.reaction_cache &&
+        static_cast<ChSystemSMC*>(GetSystem())->GetTangentialDisplacementModel() == ChSystemSMC::MultiStep) {
+        const void* keyA = cinfo.shapeA ? (const void*)cinfo.shapeA : (const void*)cinfo.modelA;
+        const void* keyB = cinfo.shapeB ? (const void*)cinfo.shapeB : (const void*)cinfo.modelB;
+        auto pos = contactableA->GetCsysForCollisionModel().TransformPointParentToLocal(cinfo.vpA);
+        double tolerance = cinfo.modelA->GetEnvelope() + cinfo.modelB->GetEnvelope() + cinfo.eff_radius;
+        cinfo.reaction_cache = history_cache.Acquire(keyA, keyB, pos, tolerance)->tdispl;
+    }
 
     // CREATE THE CONTACTS
     //
@@ -270,28 +237,35 @@ void ChContactContainerSMC::InsertContact(const collision::ChCollisionInfo& cinf
     // 1. this was formerly implemented using dynamic casting and introduced a performance bottleneck.
     // 2. use a switch only for the outer level (nested switch negatively affects performance)
 
+    // Contacts reported by the collision system are evaluated all together in EndAddContact(). Contacts added outside
+    // a collision detection pass (e.g., from a custom collision callback) are evaluated right away.
+    auto evaluate = [this](auto* contact) {
+        if (!defer_evaluation)
+            contact->Evaluate();
+    };
+
     switch (contactableA->GetContactableType()) {
         case ChContactable::CONTACTABLE_3: {
             auto objA = static_cast<ChContactable_1vars<3>*>(contactableA);
             if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_3) {
                 auto objB = static_cast<ChContactable_1vars<3>*>(contactableB);
                 // 3_3
-                _OptimalContactInsert(contactlist_3_3, lastcontact_3_3, n_added_3_3, this, objA, objB, cinfo, cmat);
+                evaluate(contactlist_3_3.Add(this, objA, objB, cinfo, cmat));
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_6) {
                 auto objB = static_cast<ChContactable_1vars<6>*>(contactableB);
                 // 3_6 -> 6_3
                 collision::ChCollisionInfo swapped_cinfo(cinfo, true);
-                _OptimalContactInsert(contactlist_6_3, lastcontact_6_3, n_added_6_3, this, objB, objA, swapped_cinfo, cmat);
+                evaluate(contactlist_6_3.Add(this, objB, objA, swapped_cinfo, cmat));
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_333) {
                 auto objB = static_cast<ChContactable_3vars<3, 3, 3>*>(contactableB);
                 // 3_333 -> 333_3
                 collision::ChCollisionInfo swapped_cinfo(cinfo, true);
-                _OptimalContactInsert(contactlist_333_3, lastcontact_333_3, n_added_333_3, this, objB, objA, swapped_cinfo, cmat);
+                evaluate(contactlist_333_3.Add(this, objB, objA, swapped_cinfo, cmat));
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_666) {
                 auto objB = static_cast<ChContactable_3vars<6, 6, 6>*>(contactableB);
                 // 3_666 -> 666_3
                 collision::ChCollisionInfo swapped_cinfo(cinfo, true);
-                _OptimalContactInsert(contactlist_666_3, lastcontact_666_3, n_added_666_3, this, objB, objA, swapped_cinfo, cmat);
+                evaluate(contactlist_666_3.Add(this, objB, objA, swapped_cinfo, cmat));
             }
         } break;
 
@@ -300,21 +274,21 @@ void ChContactContainerSMC::InsertContact(const collision::ChCollisionInfo& cinf
             if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_3) {
                 auto objB = static_cast<ChContactable_1vars<3>*>(contactableB);
                 // 6_3
-                _OptimalContactInsert(contactlist_6_3, lastcontact_6_3, n_added_6_3, this, objA, objB, cinfo, cmat);
+                evaluate(contactlist_6_3.Add(this, objA, objB, cinfo, cmat));
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_6) {
                 auto objB = static_cast<ChContactable_1vars<6>*>(contactableB);
                 // 6_6
-                _OptimalContactInsert(contactlist_6_6, lastcontact_6_6, n_added_6_6, this, objA, objB, cinfo, cmat);
+                evaluate(contactlist_6_6.Add(this, objA, objB, cinfo, cmat));
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_333) {
                 auto objB = static_cast<ChContactable_3vars<3, 3, 3>*>(contactableB);
                 // 6_333 -> 333_6
                 collision::ChCollisionInfo swapped_cinfo(cinfo, true);
-                _OptimalContactInsert(contactlist_333_6, lastcontact_333_6, n_added_333_6, this, objB, objA, swapped_cinfo, cmat);
+                evaluate(contactlist_333_6.Add(this, objB, objA, swapped_cinfo, cmat));
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_666) {
                 auto objB = static_cast<ChContactable_3vars<6, 6, 6>*>(contactableB);
                 // 6_666 -> 666_6
                 collision::ChCollisionInfo swapped_cinfo(cinfo, true);
-                _OptimalContactInsert(contactlist_666_6, lastcontact_666_6, n_added_666_6, this, objB, objA, swapped_cinfo, cmat);
+                evaluate(contactlist_666_6.Add(this, objB, objA, swapped_cinfo, cmat));
             }
         } break;
 
@@ -323,20 +297,20 @@ void ChContactContainerSMC::InsertContact(const collision::ChCollisionInfo& cinf
             if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_3) {
                 auto objB = static_cast<ChContactable_1vars<3>*>(contactableB);
                 // 333_3
-                _OptimalContactInsert(contactlist_333_3, lastcontact_333_3, n_added_333_3, this, objA, objB, cinfo, cmat);
+                evaluate(contactlist_333_3.Add(this, objA, objB, cinfo, cmat));
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_6) {
                 auto objB = static_cast<ChContactable_1vars<6>*>(contactableB);
                 // 333_6
-                _OptimalContactInsert(contactlist_333_6, lastcontact_333_6, n_added_333_6, this, objA, objB, cinfo, cmat);
+                evaluate(contactlist_333_6.Add(this, objA, objB, cinfo, cmat));
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_333) {
                 auto objB = static_cast<ChContactable_3vars<3, 3, 3>*>(contactableB);
                 // 333_333
-                _OptimalContactInsert(contactlist_333_333, lastcontact_333_333, n_added_333_333, this, objA, objB, cinfo, cmat);
+                evaluate(contactlist_333_333.Add(this, objA, objB, cinfo, cmat));
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_666) {
                 auto objB = static_cast<ChContactable_3vars<6, 6, 6>*>(contactableB);
                 // 333_666 -> 666_333
                 collision::ChCollisionInfo swapped_cinfo(cinfo, true);
-                _OptimalContactInsert(contactlist_666_333, lastcontact_666_333, n_added_666_333, this, objB, objA, swapped_cinfo, cmat);
+                evaluate(contactlist_666_333.Add(this, objB, objA, swapped_cinfo, cmat));
             }
         } break;
 
@@ -345,19 +319,19 @@ void ChContactContainerSMC::InsertContact(const collision::ChCollisionInfo& cinf
             if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_3) {
                 auto objB = static_cast<ChContactable_1vars<3>*>(contactableB);
                 // 666_3
-                _OptimalContactInsert(contactlist_666_3, lastcontact_666_3, n_added_666_3, this, objA, objB, cinfo, cmat);
+                evaluate(contactlist_666_3.Add(this, objA, objB, cinfo, cmat));
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_6) {
                 auto objB = static_cast<ChContactable_1vars<6>*>(contactableB);
                 // 666_6
-                _OptimalContactInsert(contactlist_666_6, lastcontact_666_6, n_added_666_6, this, objA, objB, cinfo, cmat);
+                evaluate(contactlist_666_6.Add(this, objA, objB, cinfo, cmat));
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_333) {
                 auto objB = static_cast<ChContactable_3vars<3, 3, 3>*>(contactableB);
                 // 666_333
-                _OptimalContactInsert(contactlist_666_333, lastcontact_666_333, n_added_666_333, this, objA, objB, cinfo, cmat);
+                evaluate(contactlist_666_333.Add(this, objA, objB, cinfo, cmat));
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_666) {
                 auto objB = static_cast<ChContactable_3vars<6, 6, 6>*>(contactableB);
                 // 666_666
-                _OptimalContactInsert(contactlist_666_666, lastcontact_666_666, n_added_666_666, this, objA, objB, cinfo, cmat);
+                evaluate(contactlist_666_666.Add(this, objA, objB, cinfo, cmat));
             }
         } break;
 
@@ -368,18 +342,64 @@ void ChContactContainerSMC::InsertContact(const collision::ChCollisionInfo& cinf
     }  // switch(contactableA->GetContactableType())
 }
 
+// Accumulate forces of the contacts in the i-th of n equal ranges of the given pool.
+template <class Tcont>
+void ChContactContainerSMC::SumContactForcesRange(ChContactPool<Tcont>& contactlist,
+                                                  int ithread,
+                                                  int nthreads,
+                                                  std::unordered_map<ChContactable*, ForceTorque>& contactforces) {
+    int ncontacts = contactlist.size();
+    int start = (int)((long long)ncontacts * ithread / nthreads);
+    int end = (int)((long long)ncontacts * (ithread + 1) / nthreads);
+    SumAllContactForces(contactlist, start, end, contactforces);
+}
+
 void ChContactContainerSMC::ComputeContactForces() {
     contact_forces.clear();
-    SumAllContactForces(contactlist_3_3, contact_forces);
-    SumAllContactForces(contactlist_6_3, contact_forces);
-    SumAllContactForces(contactlist_6_6, contact_forces);
-    SumAllContactForces(contactlist_333_3, contact_forces);
-    SumAllContactForces(contactlist_333_6, contact_forces);
-    SumAllContactForces(contactlist_333_333, contact_forces);
-    SumAllContactForces(contactlist_666_3, contact_forces);
-    SumAllContactForces(contactlist_666_6, contact_forces);
-    SumAllContactForces(contactlist_666_333, contact_forces);
-    SumAllContactForces(contactlist_666_666, contact_forces);
+
+    int nthreads = _NumContactThreads(GetSystem());
+    if (nthreads < 2 || GetNcontacts() < 1024) {
+        SumAllContactForces(contactlist_3_3, contact_forces);
+        SumAllContactForces(contactlist_6_3, contact_forces);
+        SumAllContactForces(contactlist_6_6, contact_forces);
+        SumAllContactForces(contactlist_333_3, contact_forces);
+        SumAllContactForces(contactlist_333_6, contact_forces);
+        SumAllContactForces(contactlist_333_333, contact_forces);
+        SumAllContactForces(contactlist_666_3, contact_forces);
+        SumAllContactForces(contactlist_666_6, contact_forces);
+        SumAllContactForces(contactlist_666_333, contact_forces);
+        SumAllContactForces(contactlist_666_666, contact_forces);
+        return;
+    }
+
+    thread_forces.resize(nthreads);
+
+#pragma omp parallel for schedule(static, 1) num_threads(nthreads)
+    for (int it = 0; it < nthreads; it++) {
+        auto& forces = thread_forces[it];
+        forces.clear();
+        SumContactForcesRange(contactlist_3_3, it, nthreads, forces);
+        SumContactForcesRange(contactlist_6_3, it, nthreads, forces);
+        SumContactForcesRange(contactlist_6_6, it, nthreads, forces);
+        SumContactForcesRange(contactlist_333_3, it, nthreads, forces);
+        SumContactForcesRange(contactlist_333_6, it, nthreads, forces);
+        SumContactForcesRange(contactlist_333_333, it, nthreads, forces);
+        SumContactForcesRange(contactlist_666_3, it, nthreads, forces);
+        SumContactForcesRange(contactlist_666_6, it, nthreads, forces);
+        SumContactForcesRange(contactlist_666_333, it, nthreads, forces);
+        SumContactForcesRange(contactlist_666_666, it, nthreads, forces);
+    }
+
+    // Merge in thread order (the order of the entries within each map does not matter)
+    for (int it = 0; it < nthreads; it++) {
+        for (const auto& entry : thread_forces[it]) {
+            auto res = contact_forces.insert(entry);
+            if (!res.second) {
+                res.first->second.force += entry.second.force;
+                res.first->second.torque += entry.second.torque;
+            }
+        }
+    }
 }
 
 ChVector<> ChContactContainerSMC::GetContactableForce(ChContactable* contactable) {
@@ -399,8 +419,8 @@ ChVector<> ChContactContainerSMC::GetContactableTorque(ChContactable* contactabl
 }
 
 template <class Tcont>
-void _ReportAllContacts(std::list<Tcont*>& contactlist, ChContactContainer::ReportContactCallback* mcallback) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
+void _ReportAllContacts(ChContactPool<Tcont>& contactlist, ChContactContainer::ReportContactCallback* mcallback) {
+    auto itercontact = contactlist.begin();
     while (itercontact != contactlist.end()) {
         bool proceed = mcallback->OnReportContact(
             (*itercontact)->GetContactP1(), (*itercontact)->GetContactP2(), (*itercontact)->GetContactPlane(),
@@ -428,31 +448,82 @@ void ChContactContainerSMC::ReportAllContacts(std::shared_ptr<ReportContactCallb
 
 // STATE INTERFACE
 
+// Load into R the forces of the contacts in the i-th of n equal ranges of the given pool.
 template <class Tcont>
-void _IntLoadResidual_F(std::list<Tcont*>& contactlist, ChVectorDynamic<>& R, const double c) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
-    while (itercontact != contactlist.end()) {
-        (*itercontact)->ContIntLoadResidual_F(R, c);
-        ++itercontact;
+void _IntLoadResidual_F(ChContactPool<Tcont>& contactlist,
+                        ChVectorDynamic<>& R,
+                        const double c,
+                        int ithread,
+                        int nthreads) {
+    int ncontacts = contactlist.size();
+    int start = (int)((long long)ncontacts * ithread / nthreads);
+    int end = (int)((long long)ncontacts * (ithread + 1) / nthreads);
+    for (int i = start; i < end; i++) {
+        contactlist[i].ContIntLoadResidual_F(R, c);
     }
 }
 
 void ChContactContainerSMC::IntLoadResidual_F(const unsigned int off, ChVectorDynamic<>& R, const double c) {
-    _IntLoadResidual_F(contactlist_3_3, R, c);
-    _IntLoadResidual_F(contactlist_6_3, R, c);
-    _IntLoadResidual_F(contactlist_6_6, R, c);
-    _IntLoadResidual_F(contactlist_333_3, R, c);
-    _IntLoadResidual_F(contactlist_333_6, R, c);
-    _IntLoadResidual_F(contactlist_333_333, R, c);
-    _IntLoadResidual_F(contactlist_666_3, R, c);
-    _IntLoadResidual_F(contactlist_666_6, R, c);
-    _IntLoadResidual_F(contactlist_666_333, R, c);
-    _IntLoadResidual_F(contactlist_666_666, R, c);
+    // The reduction of the per-thread buffers visits nthreads*R.size() entries, while each contact writes at most 12
+    // entries (two 6-dof objects). Only use the parallel path if loading the contacts dominates the reduction.
+    int nthreads = _NumContactThreads(GetSystem());
+    int ncontacts = GetNcontacts();
+    if (nthreads < 2 || ncontacts < 1024 ||
+        12 * (long long)ncontacts < (long long)nthreads * R.size()) {
+        _IntLoadResidual_F(contactlist_3_3, R, c, 0, 1);
+        _IntLoadResidual_F(contactlist_6_3, R, c, 0, 1);
+        _IntLoadResidual_F(contactlist_6_6, R, c, 0, 1);
+        _IntLoadResidual_F(contactlist_333_3, R, c, 0, 1);
+        _IntLoadResidual_F(contactlist_333_6, R, c, 0, 1);
+        _IntLoadResidual_F(contactlist_333_333, R, c, 0, 1);
+        _IntLoadResidual_F(contactlist_666_3, R, c, 0, 1);
+        _IntLoadResidual_F(contactlist_666_6, R, c, 0, 1);
+        _IntLoadResidual_F(contactlist_666_333, R, c, 0, 1);
+        _IntLoadResidual_F(contactlist_666_666, R, c, 0, 1);
+        return;
+    }
+
+    // Different contacts may act on the same objects, so each thread loads its range of contacts in its own buffer.
+    // Note that the range assigned to each buffer only depends on the number of threads.
+    // The buffers are persistent and are left zeroed by the reduction below, so they are only reset when resized.
+    if ((int)thread_R.size() != nthreads)
+        thread_R.resize(nthreads);
+    for (auto& Rt : thread_R) {
+        if (Rt.size() != R.size())
+            Rt.setZero(R.size());
+    }
+
+#pragma omp parallel for schedule(static, 1) num_threads(nthreads)
+    for (int it = 0; it < nthreads; it++) {
+        auto& Rt = thread_R[it];
+        _IntLoadResidual_F(contactlist_3_3, Rt, c, it, nthreads);
+        _IntLoadResidual_F(contactlist_6_3, Rt, c, it, nthreads);
+        _IntLoadResidual_F(contactlist_6_6, Rt, c, it, nthreads);
+        _IntLoadResidual_F(contactlist_333_3, Rt, c, it, nthreads);
+        _IntLoadResidual_F(contactlist_333_6, Rt, c, it, nthreads);
+        _IntLoadResidual_F(contactlist_333_333, Rt, c, it, nthreads);
+        _IntLoadResidual_F(contactlist_666_3, Rt, c, it, nthreads);
+        _IntLoadResidual_F(contactlist_666_6, Rt, c, it, nthreads);
+        _IntLoadResidual_F(contactlist_666_333, Rt, c, it, nthreads);
+        _IntLoadResidual_F(contactlist_666_666, Rt, c, it, nthreads);
+    }
+
+    // Reduce the per-thread buffers, always in the same order, and clear them for the next call
+    int n = (int)R.size();
+#pragma omp parallel for schedule(static) num_threads(nthreads)
+    for (int i = 0; i < n; i++) {
+        double sum = 0;
+        for (int it = 0; it < nthreads; it++) {
+            sum += thread_R[it](i);
+            thread_R[it](i) = 0;
+        }
+        R(i) += sum;
+    }
 }
 
 template <class Tcont>
-void _KRMmatricesLoad(std::list<Tcont*> contactlist, double Kfactor, double Rfactor) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
+void _KRMmatricesLoad(ChContactPool<Tcont>& contactlist, double Kfactor, double Rfactor) {
+    auto itercontact = contactlist.begin();
     while (itercontact != contactlist.end()) {
         (*itercontact)->ContKRMmatricesLoad(Kfactor, Rfactor);
         ++itercontact;
@@ -473,8 +544,8 @@ void ChContactContainerSMC::KRMmatricesLoad(double Kfactor, double Rfactor, doub
 }
 
 template <class Tcont>
-void _InjectKRMmatrices(std::list<Tcont*> contactlist, ChSystemDescriptor& mdescriptor) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
+void _InjectKRMmatrices(ChContactPool<Tcont>& contactlist, ChSystemDescriptor& mdescriptor) {
+    auto itercontact = contactlist.begin();
     while (itercontact != contactlist.end()) {
         (*itercontact)->ContInjectKRMmatrices(mdescriptor);
         ++itercontact;
@@ -499,6 +570,48 @@ void ChContactContainerSMC::ConstraintsFbLoadForces(double factor) {
     GetLog() << "ChContactContainerSMC::ConstraintsFbLoadForces OBSOLETE - use new bookkeeping! \n";
 }
 
+void ChContactContainerSMC::SnapshotOut(ChSnapshotBuffer& buffer) {
+    // Collision shapes (or models) are stored by their key index, so that the data can be restored in another system.
+    // Entries for unregistered objects are dropped.
+    uint64_t num_entries = 0;
+    history_cache.ForEachEntry(
+        [&buffer, &num_entries](const void* keyA, const void* keyB, const ChVector<>& pos, const TangentialHistory& data) {
+            if (buffer.GetKeyIndex(keyA) != ChSnapshotBuffer::NoKey &&
+                buffer.GetKeyIndex(keyB) != ChSnapshotBuffer::NoKey)
+                num_entries++;
+        });
+    buffer.Write(num_entries);
+    history_cache.ForEachEntry(
+        [&buffer](const void* keyA, const void* keyB, const ChVector<>& pos, const TangentialHistory& data) {
+            uint64_t indexA = buffer.GetKeyIndex(keyA);
+            uint64_t indexB = buffer.GetKeyIndex(keyB);
+            if (indexA == ChSnapshotBuffer::NoKey || indexB == ChSnapshotBuffer::NoKey)
+                return;
+            buffer.Write(indexA);
+            buffer.Write(indexB);
+            buffer.Write(pos.data(), 3);
+            buffer.Write(data.tdispl, 3);
+        });
+}
+
+void ChContactContainerSMC::SnapshotIn(ChSnapshotBuffer& buffer) {
+    // Current contacts point into the cache storage, so they must be discarded before the cache is rebuilt
+    RemoveAllContacts();
+
+    uint64_t num_entries = buffer.Read<uint64_t>();
+    for (uint64_t i = 0; i < num_entries; i++) {
+        const void* keyA = buffer.GetKey(buffer.Read<uint64_t>());
+        const void* keyB = buffer.GetKey(buffer.Read<uint64_t>());
+        double pos[3];
+        buffer.Read(pos, 3);
+        TangentialHistory data;
+        buffer.Read(data.tdispl, 3);
+        if (!keyA || !keyB)
+            throw ChException("Snapshot contact data does not match the system.");
+        history_cache.Insert(keyA, keyB, ChVector<>(pos[0], pos[1], pos[2]), data);
+    }
+}
+
 void ChContactContainerSMC::ArchiveOut(ChArchiveOut& marchive) {
     // version number
     marchive.VersionWrite<ChContactContainerSMC>();
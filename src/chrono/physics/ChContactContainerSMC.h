@@ -17,16 +17,18 @@
 
 #include <algorithm>
 #include <cmath>
-#include <list>
+#include <vector>
 
 #include "chrono/physics/ChContactContainer.h"
+#include "chrono/physics/ChContactPairCache.h"
+#include "chrono/physics/ChContactPool.h"
 #include "chrono/physics/ChContactSMC.h"
 #include "chrono/physics/ChContactable.h"
 
 namespace chrono {
 
 /// Class representing a container of many smooth (penalty) contacts.
-/// Implemented using linked lists of ChContactSMC objects (that is, contacts between two ChContactable objects).
+/// Implemented using pools of ChContactSMC objects (that is, contacts between two ChContactable objects).
 class ChApi ChContactContainerSMC : public ChContactContainer {
   public:
     typedef ChContactSMC<ChContactable_1vars<3>, ChContactable_1vars<3> > ChContactSMC_3_3;
@@ -41,41 +43,32 @@ class ChApi ChContactContainerSMC : public ChContactContainer {
     typedef ChContactSMC<ChContactable_3vars<6, 6, 6>, ChContactable_3vars<6, 6, 6> > ChContactSMC_666_666;
 
   protected:
-    std::list<ChContactSMC_3_3*> contactlist_3_3;
-    std::list<ChContactSMC_6_3*> contactlist_6_3;
-    std::list<ChContactSMC_6_6*> contactlist_6_6;
-    std::list<ChContactSMC_333_3*> contactlist_333_3;
-    std::list<ChContactSMC_333_6*> contactlist_333_6;
-    std::list<ChContactSMC_333_333*> contactlist_333_333;
-    std::list<ChContactSMC_666_3*> contactlist_666_3;
-    std::list<ChContactSMC_666_6*> contactlist_666_6;
-    std::list<ChContactSMC_666_333*> contactlist_666_333;
-    std::list<ChContactSMC_666_666*> contactlist_666_666;
-
-    int n_added_3_3;
-    int n_added_6_3;
-    int n_added_6_6;
-    int n_added_333_3;
-    int n_added_333_6;
-    int n_added_333_333;
-    int n_added_666_3;
-    int n_added_666_6;
-    int n_added_666_333;
-    int n_added_666_666;
-
-    std::list<ChContactSMC_3_3*>::iterator lastcontact_3_3;
-    std::list<ChContactSMC_6_3*>::iterator lastcontact_6_3;
-    std::list<ChContactSMC_6_6*>::iterator lastcontact_6_6;
-    std::list<ChContactSMC_333_3*>::iterator lastcontact_333_3;
-    std::list<ChContactSMC_333_6*>::iterator lastcontact_333_6;
-    std::list<ChContactSMC_333_333*>::iterator lastcontact_333_333;
-    std::list<ChContactSMC_666_3*>::iterator lastcontact_666_3;
-    std::list<ChContactSMC_666_6*>::iterator lastcontact_666_6;
-    std::list<ChContactSMC_666_333*>::iterator lastcontact_666_333;
-    std::list<ChContactSMC_666_666*>::iterator lastcontact_666_666;
+    ChContactPool<ChContactSMC_3_3> contactlist_3_3;
+    ChContactPool<ChContactSMC_6_3> contactlist_6_3;
+    ChContactPool<ChContactSMC_6_6> contactlist_6_6;
+    ChContactPool<ChContactSMC_333_3> contactlist_333_3;
+    ChContactPool<ChContactSMC_333_6> contactlist_333_6;
+    ChContactPool<ChContactSMC_333_333> contactlist_333_333;
+    ChContactPool<ChContactSMC_666_3> contactlist_666_3;
+    ChContactPool<ChContactSMC_666_6> contactlist_666_6;
+    ChContactPool<ChContactSMC_666_333> contactlist_666_333;
+    ChContactPool<ChContactSMC_666_666> contactlist_666_666;
 
     std::unordered_map<ChContactable*, ForceTorque> contact_forces;
 
+    bool defer_evaluation;  ///< evaluate new contacts at the end of the collision detection pass
+
+    /// Persistent tangential displacement (MultiStep model), for contacts without persistent data from the collision
+    /// system.
+    struct TangentialHistory {
+        float tdispl[3] = {0, 0, 0};
+    };
+
+    ChContactPairCache<TangentialHistory> history_cache;  ///< tangential displacements per pair of colliding shapes
+
+    std::vector<ChVectorDynamic<>> thread_R;                                      ///< per-thread residual buffers
+    std::vector<std::unordered_map<ChContactable*, ForceTorque>> thread_forces;  ///< per-thread contact forces
+
   public:
     ChContactContainerSMC();
     ChContactContainerSMC(const ChContactContainerSMC& other);
@@ -86,17 +79,17 @@ class ChApi ChContactContainerSMC : public ChContactContainer {
 
     /// Report the number of added contacts.
     virtual int GetNcontacts() const override {
-        return n_added_3_3 + n_added_6_3 + n_added_6_6 + n_added_333_3 + n_added_333_6 + n_added_333_333 +
-               n_added_666_3 + n_added_666_6 + n_added_666_333 + n_added_666_666;
+        return contactlist_3_3.size() + contactlist_6_3.size() + contactlist_6_6.size() + contactlist_333_3.size() +
+               contactlist_333_6.size() + contactlist_333_333.size() + contactlist_666_3.size() + contactlist_666_6.size() +
+               contactlist_666_333.size() + contactlist_666_666.size();
     }
 
     /// Remove (delete) all contained contact data.
     virtual void RemoveAllContacts() override;
 
     /// The collision system will call BeginAddContact() before adding all contacts (for example with AddContact() or
-    /// similar). Instead of simply deleting all list of the previous contacts, this optimized implementation rewinds
-    /// the link iterator to begin and tries to reuse previous contact objects until possible, to avoid too much
-    /// allocation/deallocation.
+    /// similar). Instead of simply deleting all the previous contacts, this optimized implementation rewinds the
+    /// contact pools and reuses previous contact objects until possible, to avoid too much allocation/deallocation.
     virtual void BeginAddContact() override;
 
     /// Add a contact between two collision shapes, storing it into this container.
@@ -112,7 +105,14 @@ class ChApi ChContactContainerSMC : public ChContactContainer {
     virtual void AddContact(const collision::ChCollisionInfo& cinfo) override;
 
     /// The collision system will call BeginAddContact() after adding all contacts (for example with AddContact() or
-    /// similar). This optimized version purges the end of the list of contacts that were not reused (if any).
+    /// similar). This optimized version releases the contacts that were not reused, if the pools are much larger than
+    /// currently needed.
+    /// The forces (and, for stiff contact, the Jacobians) of all contacts added since BeginAddContact() are evaluated
+    /// here. With the default force algorithm, this is done in parallel over the number of threads set through
+    /// ChSystem::SetNumThreads (num_threads_chrono), unless disabled with ChSystemSMC::SetParallelContacts.
+    /// A user-provided force algorithm (ChSystemSMC::SetContactForceAlgorithm) is always called serially.
+    /// Contacts added outside a collision detection pass (e.g., from a custom collision callback) are evaluated
+    /// immediately.
     virtual void EndAddContact() override;
 
     /// Scan all the contacts and for each contact executes the OnReportContact() function of the provided callback
@@ -125,6 +125,9 @@ class ChApi ChContactContainerSMC : public ChContactContainer {
 
     /// Compute contact forces on all contactable objects in this container.
     /// This function caches contact forces in a map.
+    /// With more than one Chrono thread, contacts are split in fixed ranges accumulated in per-thread maps, which are
+    /// then merged in thread order, so that results are reproducible for a given number of threads.
+    /// Contacts are processed serially if disabled with ChSystemSMC::SetParallelContacts.
     virtual void ComputeContactForces() override;
 
     /// Return the resultant contact force acting on the specified contactable object.
@@ -135,6 +138,10 @@ class ChApi ChContactContainerSMC : public ChContactContainer {
 
     // STATE FUNCTIONS
 
+    /// Add the contact forces to the residual R += c*F.
+    /// With more than one Chrono thread and a number of contacts large relative to the system size, contact forces are
+    /// loaded in parallel in persistent per-thread buffers (each processing a fixed range of contacts), then summed in
+    /// thread order. Contacts are processed serially if disabled with ChSystemSMC::SetParallelContacts.
     virtual void IntLoadResidual_F(const unsigned int off, ChVectorDynamic<>& R, const double c) override;
     virtual void KRMmatricesLoad(double Kfactor, double Rfactor, double Mfactor) override;
     virtual void InjectKRMmatrices(ChSystemDescriptor& mdescriptor) override;
@@ -143,6 +150,15 @@ class ChApi ChContactContainerSMC : public ChContactContainer {
 
     virtual void ConstraintsFbLoadForces(double factor) override;
 
+    // SNAPSHOTS
+
+    /// Append to the buffer the persistent tangential displacements kept by this container.
+    /// Current contacts are not stored: they are regenerated at the next collision detection pass.
+    virtual void SnapshotOut(ChSnapshotBuffer& buffer) override;
+
+    /// Restore the persistent tangential displacements stored by SnapshotOut(), removing all current contacts.
+    virtual void SnapshotIn(ChSnapshotBuffer& buffer) override;
+
     // SERIALIZATION
 
     /// Method to allow serialization of transient data to archives.
@@ -153,6 +169,12 @@ class ChApi ChContactContainerSMC : public ChContactContainer {
 
   private:
     void InsertContact(const collision::ChCollisionInfo& cinfo, const ChMaterialCompositeSMC& cmat);
+
+    template <class Tcont>
+    void SumContactForcesRange(ChContactPool<Tcont>& contactlist,
+                               int ithread,
+                               int nthreads,
+                               std::unordered_map<ChContactable*, ForceTorque>& contactforces);
 };
 
 CH_CLASS_VERSION(ChContactContainerSMC, 0)
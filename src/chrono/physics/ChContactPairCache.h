@@ -0,0 +1,154 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#ifndef CH_CONTACT_PAIR_CACHE_H
+#define CH_CONTACT_PAIR_CACHE_H
+
+#include <deque>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+#include "chrono/core/ChVector.h"
+
+namespace chrono {
+
+/// Persistent per-contact data, carried over between successive collision detection passes.
+/// Entries are keyed on the pair of colliding features (typically the two collision shapes) and, since a shape pair
+/// can generate more than one contact point, on the location of the contact point expressed in a frame attached to
+/// the first object. At each pass, a new contact inherits the data of the closest contact reported for the same pair
+/// at the previous pass (within a given tolerance), or a default-constructed T otherwise.
+/// The storage returned by Acquire() is stable (not relocated) until the next call to Begin().
+template <class T>
+class ChContactPairCache {
+  public:
+    ChContactPairCache() {}
+
+    /// Start a new collision pass.
+    /// Entries acquired during the previous pass become candidates for matching; older entries are discarded.
+    void Begin() {
+        std::swap(m_current, m_previous);
+        std::swap(m_current_heads, m_previous_heads);
+        m_current.clear();
+        m_current_heads.clear();
+    }
+
+    /// Return persistent storage for the contact between features A and B at the given location.
+    /// If a contact between the same features was reported at the previous pass within a distance 'tolerance' of
+    /// 'pos', its data is copied into the returned storage (each previous entry can be inherited only once).
+    T* Acquire(const void* keyA, const void* keyB, const ChVector<>& pos, double tolerance) {
+        Key key(keyA, keyB);
+
+        m_current.emplace_back();
+        Entry& entry = m_current.back();
+        entry.pos = pos;
+        entry.data = T();
+        entry.claimed = false;
+
+        // Search for the closest unclaimed contact between the same features at previous pass
+        auto prev = m_previous_heads.find(key);
+        if (prev != m_previous_heads.end()) {
+            Entry* best = nullptr;
+            double best_dist2 = tolerance * tolerance;
+            for (int i = prev->second; i >= 0; i = m_previous[i].next) {
+                Entry& candidate = m_previous[i];
+                if (candidate.claimed)
+                    continue;
+                double dist2 = (candidate.pos - pos).Length2();
+                if (dist2 <= best_dist2) {
+                    best_dist2 = dist2;
+                    best = &candidate;
+                }
+            }
+            if (best) {
+                best->claimed = true;
+                entry.data = best->data;
+            }
+        }
+
+        // Chain the new entry with other contacts between the same features
+        auto head = m_current_heads.insert(std::make_pair(key, -1)).first;
+        entry.next = head->second;
+        head->second = (int)m_current.size() - 1;
+
+        return &entry.data;
+    }
+
+    /// Append an entry to the current pass, without matching it against the previous pass.
+    /// Used to rebuild a cache from saved data (see ForEachEntry()).
+    T* Insert(const void* keyA, const void* keyB, const ChVector<>& pos, const T& data) {
+        m_current.emplace_back();
+        Entry& entry = m_current.back();
+        entry.pos = pos;
+        entry.data = data;
+        entry.claimed = false;
+
+        auto head = m_current_heads.insert(std::make_pair(Key(keyA, keyB), -1)).first;
+        entry.next = head->second;
+        head->second = (int)m_current.size() - 1;
+
+        return &entry.data;
+    }
+
+    /// Call func(keyA, keyB, pos, data) for each entry acquired since the last call to Begin().
+    /// Entries of the same pair of features are visited in acquisition order, so that inserting them again in the
+    /// same order with Insert() reproduces the cache.
+    template <class F>
+    void ForEachEntry(F func) const {
+        std::vector<int> chain;
+        for (const auto& head : m_current_heads) {
+            chain.clear();
+            for (int i = head.second; i >= 0; i = m_current[i].next)
+                chain.push_back(i);
+            for (auto i = chain.rbegin(); i != chain.rend(); ++i)
+                func(head.first.first, head.first.second, m_current[*i].pos, m_current[*i].data);
+        }
+    }
+
+    /// Discard all cached data.
+    void Clear() {
+        m_current.clear();
+        m_previous.clear();
+        m_current_heads.clear();
+        m_previous_heads.clear();
+    }
+
+    /// Return the number of entries acquired since the last call to Begin().
+    size_t GetNumEntries() const { return m_current.size(); }
+
+  private:
+    typedef std::pair<const void*, const void*> Key;
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const {
+            size_t h1 = std::hash<const void*>()(key.first);
+            size_t h2 = std::hash<const void*>()(key.second);
+            return h1 ^ (h2 + 0x9e3779b9 + (h1 << 6) + (h1 >> 2));
+        }
+    };
+
+    struct Entry {
+        ChVector<> pos;  ///< contact location, in a frame attached to the first object
+        T data;          ///< persistent contact data
+        int next;        ///< next entry for the same pair of features (-1 if last)
+        bool claimed;    ///< already inherited by a contact at the current pass
+    };
+
+    std::deque<Entry> m_current;
+    std::deque<Entry> m_previous;
+    std::unordered_map<Key, int, KeyHash> m_current_heads;
+    std::unordered_map<Key, int, KeyHash> m_previous_heads;
+};
+
+}  // end namespace chrono
+
+#endif
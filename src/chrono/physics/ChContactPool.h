@@ -0,0 +1,131 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#ifndef CH_CONTACT_POOL_H
+#define CH_CONTACT_POOL_H
+
+#include <cstddef>
+#include <deque>
+#include <iterator>
+
+#include "chrono/collision/ChCollisionInfo.h"
+
+namespace chrono {
+
+class ChContactContainer;
+
+/// Pooled storage for contacts of a given type (a ChContactTuple-derived class).
+/// Contact objects are stored by value in contiguous chunks and are recycled between successive collision detection
+/// passes: Rewind() marks all contacts as unused and Add() reinitializes the next unused contact, constructing a new
+/// one in place only if the pool is exhausted. This avoids a heap allocation per contact and allows traversing the
+/// active contacts in insertion order, with good memory locality.
+/// Contacts are never relocated, so pointers to them (and to their constraints) remain valid until Trim() or Clear().
+/// Iteration yields pointers to the active contacts, as with the std::list<Tcont*> lists previously used by the contact
+/// containers, so that existing traversals written as (*iter)->... remain valid.
+template <class Tcont>
+class ChContactPool {
+  public:
+    /// Forward iterator over the active contacts, dereferencing to a pointer to the contact.
+    template <class Titer, class Tptr>
+    class pointer_iterator {
+      public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef Tptr value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const Tptr* pointer;
+        typedef Tptr reference;
+
+        pointer_iterator() {}
+        explicit pointer_iterator(Titer it) : m_it(it) {}
+
+        Tptr operator*() const { return &(*m_it); }
+        pointer_iterator& operator++() {
+            ++m_it;
+            return *this;
+        }
+        pointer_iterator operator++(int) {
+            pointer_iterator tmp = *this;
+            ++m_it;
+            return tmp;
+        }
+        bool operator==(const pointer_iterator& other) const { return m_it == other.m_it; }
+        bool operator!=(const pointer_iterator& other) const { return m_it != other.m_it; }
+
+      private:
+        Titer m_it;
+    };
+
+    typedef pointer_iterator<typename std::deque<Tcont>::iterator, Tcont*> iterator;
+    typedef pointer_iterator<typename std::deque<Tcont>::const_iterator, const Tcont*> const_iterator;
+
+    ChContactPool() : m_size(0) {}
+
+    /// Return the number of active contacts.
+    int size() const { return m_size; }
+
+    /// Return true if there are no active contacts.
+    bool empty() const { return m_size == 0; }
+
+    /// Return the number of contact objects currently allocated in the pool (active or not).
+    int capacity() const { return (int)m_pool.size(); }
+
+    /// Access the i-th active contact.
+    Tcont& operator[](int i) { return m_pool[i]; }
+    const Tcont& operator[](int i) const { return m_pool[i]; }
+
+    /// Iterators over the active contacts (dereferencing to contact pointers).
+    iterator begin() { return iterator(m_pool.begin()); }
+    iterator end() { return iterator(m_pool.begin() + m_size); }
+    const_iterator begin() const { return const_iterator(m_pool.begin()); }
+    const_iterator end() const { return const_iterator(m_pool.begin() + m_size); }
+
+    /// Mark all contacts as unused (without releasing them).
+    void Rewind() { m_size = 0; }
+
+    /// Activate a contact between the two given objects, reusing a previously allocated contact if possible.
+    template <class Ta, class Tb, class Tmat>
+    Tcont* Add(ChContactContainer* container,            ///< contact container
+               Ta* objA,                                 ///< collidable object A
+               Tb* objB,                                 ///< collidable object B
+               const collision::ChCollisionInfo& cinfo,  ///< collision information
+               const Tmat& cmat                          ///< composite material
+    ) {
+        if (m_size < (int)m_pool.size())
+            m_pool[m_size].Reset(objA, objB, cinfo, cmat);
+        else
+            m_pool.emplace_back(container, objA, objB, cinfo, cmat);
+        return &m_pool[m_size++];
+    }
+
+    /// Release unused contacts if less than a quarter of the pool is currently in use.
+    /// The pool is shrunk to twice the number of active contacts, to avoid reallocations in case of oscillations.
+    void Trim() {
+        if (m_size >= (int)m_pool.size() / 4)
+            return;
+        while ((int)m_pool.size() > 2 * m_size)
+            m_pool.pop_back();
+    }
+
+    /// Release all contacts.
+    void Clear() {
+        m_pool.clear();
+        m_size = 0;
+    }
+
+  private:
+    std::deque<Tcont> m_pool;  ///< contact objects, active ones first
+    int m_size;                ///< number of active contacts
+};
+
+}  // end namespace chrono
+
+#endif
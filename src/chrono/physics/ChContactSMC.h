@@ -41,7 +41,8 @@ class ChDefaultContactForceSMC : public ChSystemSMC::ChContactForceSMC {
   public:
     /// Default SMC force calculation algorithm.
     /// This implementation depends on various settings specified at the ChSystemSMC level (such as normal force model,
-    /// tangential force model, use of material physical properties, etc).
+    /// tangential force model, use of material physical properties, etc). The force is calculated with the kernel
+    /// selected by the system for these settings (see ChSystemSMC::CalculateContactForces).
     virtual ChVector<> CalculateForce(
         const ChSystemSMC& sys,             ///< containing system
         const ChVector<>& normal_dir,       ///< normal contact direction (expressed in global frame)
@@ -55,168 +56,20 @@ class ChDefaultContactForceSMC : public ChSystemSMC::ChContactForceSMC {
         double mass1,                       ///< mass of obj1
         double mass2                        ///< mass of obj2
         ) const override {
-        // Set contact force to zero if no penetration.
-        if (delta <= 0) {
-            return ChVector<>(0, 0, 0);
-        }
-
-        // Extract parameters from containing system
-        double dT = sys.GetStep();
-        bool use_mat_props = sys.UsingMaterialProperties();
-        ChSystemSMC::ContactForceModel contact_model = sys.GetContactForceModel();
-        ChSystemSMC::AdhesionForceModel adhesion_model = sys.GetAdhesionForceModel();
-        ChSystemSMC::TangentialDisplacementModel tdispl_model = sys.GetTangentialDisplacementModel();
-
-        // Relative velocity at contact
-        ChVector<> relvel = vel2 - vel1;
-        double relvel_n_mag = relvel.Dot(normal_dir);
-        ChVector<> relvel_n = relvel_n_mag * normal_dir;
-        ChVector<> relvel_t = relvel - relvel_n;
-        double relvel_t_mag = relvel_t.Length();
-
-        // Calculate effective mass
-        double eff_mass = mass1 * mass2 / (mass1 + mass2);
-
-        // Calculate stiffness and viscous damping coefficients.
-        // All models use the following formulas for normal and tangential forces:
-        //     Fn = kn * delta_n - gn * v_n
-        //     Ft = kt * delta_t - gt * v_t
-        double kn = 0;
-        double kt = 0;
-        double gn = 0;
-        double gt = 0;
-
-        double eps = std::numeric_limits<double>::epsilon();
-
-        switch (contact_model) {
-            case ChSystemSMC::Flores:
-                // Currently not implemented.  Fall through to Hooke.
-            case ChSystemSMC::Hooke:
-                if (use_mat_props) {
-                    double tmp_k = (16.0 / 15) * std::sqrt(eff_radius) * mat.E_eff;
-                    double v2 = sys.GetCharacteristicImpactVelocity() * sys.GetCharacteristicImpactVelocity();
-                    double loge = (mat.cr_eff < eps) ? std::log(eps) : std::log(mat.cr_eff);
-                    loge = (mat.cr_eff > 1 - eps) ? std::log(1 - eps) : loge;
-                    double tmp_g = 1 + std::pow(CH_C_PI / loge, 2);
-                    kn = tmp_k * std::pow(eff_mass * v2 / tmp_k, 1.0 / 5);
-                    kt = kn;
-                    gn = std::sqrt(4 * eff_mass * kn / tmp_g);
-                    gt = gn;
-                } else {
-                    kn = mat.kn;
-                    kt = mat.kt;
-                    gn = eff_mass * mat.gn;
-                    gt = eff_mass * mat.gt;
-                }
-
-                break;
-
-            case ChSystemSMC::Hertz:
-                if (use_mat_props) {
-                    double sqrt_Rd = std::sqrt(eff_radius * delta);
-                    double Sn = 2 * mat.E_eff * sqrt_Rd;
-                    double St = 8 * mat.G_eff * sqrt_Rd;
-                    double loge = (mat.cr_eff < eps) ? std::log(eps) : std::log(mat.cr_eff);
-                    double beta = loge / std::sqrt(loge * loge + CH_C_PI * CH_C_PI);
-                    kn = (2.0 / 3) * Sn;
-                    kt = St;
-                    gn = -2 * std::sqrt(5.0 / 6) * beta * std::sqrt(Sn * eff_mass);
-                    gt = -2 * std::sqrt(5.0 / 6) * beta * std::sqrt(St * eff_mass);
-                } else {
-                    double tmp = eff_radius * std::sqrt(delta);
-                    kn = tmp * mat.kn;
-                    kt = tmp * mat.kt;
-                    gn = tmp * eff_mass * mat.gn;
-                    gt = tmp * eff_mass * mat.gt;
-                }
-
-                break;
-
-            case ChSystemSMC::PlainCoulomb:
-                if (use_mat_props) {
-                    double sqrt_Rd = std::sqrt(delta);
-                    double Sn = 2 * mat.E_eff * sqrt_Rd;
-                    double loge = (mat.cr_eff < eps) ? std::log(eps) : std::log(mat.cr_eff);
-                    double beta = loge / std::sqrt(loge * loge + CH_C_PI * CH_C_PI);
-                    kn = (2.0 / 3) * Sn;
-                    gn = -2 * std::sqrt(5.0 / 6) * beta * std::sqrt(Sn * eff_mass);
-                } else {
-                    double tmp = std::sqrt(delta);
-                    kn = tmp * mat.kn;
-                    gn = tmp * mat.gn;
-                }
-
-                kt = 0;
-                gt = 0;
-
-                {
-                    double forceN = kn * delta - gn * relvel_n_mag;
-                    if (forceN < 0)
-                        forceN = 0;
-                    double forceT = mat.mu_eff * std::tanh(5.0 * relvel_t_mag) * forceN;
-                    switch (adhesion_model) {
-                        case ChSystemSMC::AdhesionForceModel::Perko:
-                            // Currently not implemented.  Fall through to Constant.
-                        case ChSystemSMC::AdhesionForceModel::Constant:
-                            forceN -= mat.adhesion_eff;
-                            break;
-                        case ChSystemSMC::AdhesionForceModel::DMT:
-                            forceN -= mat.adhesionMultDMT_eff * sqrt(eff_radius);
-                            break;
-                    }
-                    ChVector<> force = forceN * normal_dir;
-                    if (relvel_t_mag >= sys.GetSlipVelocityThreshold())
-                        force -= (forceT / relvel_t_mag) * relvel_t;
-
-                    return force;
-                }
-        }
-
-        // Tangential displacement (magnitude)
-        double delta_t = 0;
-        switch (tdispl_model) {
-            case ChSystemSMC::OneStep:
-                delta_t = relvel_t_mag * dT;
-                break;
-            case ChSystemSMC::MultiStep:
-                //// TODO: implement proper MultiStep mode
-                delta_t = relvel_t_mag * dT;
-                break;
-            default:
-                break;
-        }
-
-        // Calculate the magnitudes of the normal and tangential contact forces
-        double forceN = kn * delta - gn * relvel_n_mag;
-        double forceT = kt * delta_t + gt * relvel_t_mag;
-
-        // If the resulting normal contact force is negative, the two shapes are moving
-        // away from each other so fast that no contact force is generated.
-        if (forceN < 0) {
-            forceN = 0;
-            forceT = 0;
-        }
-
-        // Include adhesion force
-        switch (adhesion_model) {
-            case ChSystemSMC::AdhesionForceModel::Perko:
-                // Currently not implemented.  Fall through to Constant.
-            case ChSystemSMC::AdhesionForceModel::Constant:
-                forceN -= mat.adhesion_eff;
-                break;
-            case ChSystemSMC::AdhesionForceModel::DMT:
-                forceN -= mat.adhesionMultDMT_eff * sqrt(eff_radius);
-                break;
-        }
-
-        // Coulomb law
-        forceT = std::min<double>(forceT, mat.mu_eff * std::abs(forceN));
-
-        // Accumulate normal and tangential forces
-        ChVector<> force = forceN * normal_dir;
-        if (relvel_t_mag >= sys.GetSlipVelocityThreshold())
-            force -= (forceT / relvel_t_mag) * relvel_t;
-
+        ChSystemSMC::ContactForceInput input;
+        input.normal_dir = normal_dir;
+        input.vel1 = vel1;
+        input.vel2 = vel2;
+        input.mat = &mat;
+        input.tdispl = nullptr;
+        input.tdispl_out = nullptr;
+        input.delta = delta;
+        input.eff_radius = eff_radius;
+        input.mass1 = mass1;
+        input.mass2 = mass2;
+
+        ChVector<> force;
+        sys.CalculateContactForces(&input, &force, 1);
         return force;
     }
 };
@@ -236,11 +89,14 @@ class ChContactSMC : public ChContactTuple<Ta, Tb> {
         ChMatrixDynamic<double> m_R;  ///< R = dQ/dv
     };
 
-    ChVector<> m_force;        ///< contact force on objB
-    ChContactJacobian* m_Jac;  ///< contact Jacobian data
+    ChVector<> m_force;            ///< contact force on objB
+    ChContactJacobian* m_Jac;      ///< contact Jacobian data
+    ChMaterialCompositeSMC m_mat;  ///< composite material for contact pair
+    float m_tdispl[3];             ///< tangential displacement at the previous step (MultiStep model)
+    float* m_tdispl_cache;         ///< persistent storage of the tangential displacement (may be null)
 
   public:
-    ChContactSMC() : m_Jac(NULL) {}
+    ChContactSMC() : m_Jac(NULL), m_tdispl_cache(NULL) {}
 
     ChContactSMC(ChContactContainer* mcontainer,           ///< contact container
                  Ta* mobjA,                                ///< collidable object A
@@ -269,6 +125,8 @@ class ChContactSMC : public ChContactTuple<Ta, Tb> {
     const ChMatrixDynamic<double>* GetJacobianR() const { return m_Jac ? &(m_Jac->m_R) : NULL; }
 
     /// Reinitialize this contact for reuse.
+    /// Only the contact geometry and material are set here; the contact force (and, for stiff contact, its Jacobians)
+    /// is calculated by a subsequent call to Evaluate().
     void Reset(Ta* mobjA,                                ///< collidable object A
                Tb* mobjB,                                ///< collidable object B
                const collision::ChCollisionInfo& cinfo,  ///< data for the collision pair
@@ -280,18 +138,49 @@ class ChContactSMC : public ChContactTuple<Ta, Tb> {
         // Note: cinfo.distance is the same as this->norm_dist.
         assert(cinfo.distance < 0);
 
+        m_mat = mat;
+        m_force = VNULL;
+
+        // Tangential displacement history, carried by the persistent contact data
+        m_tdispl_cache = cinfo.reaction_cache;
+        for (int i = 0; i < 3; i++)
+            m_tdispl[i] = m_tdispl_cache ? m_tdispl_cache[i] : 0;
+    }
+
+    /// Calculate the contact force and, if stiff contact is enabled, the contact Jacobians.
+    /// This function only reads the states of the two contactable objects and only writes data owned by this contact,
+    /// so that different contacts can be evaluated concurrently.
+    void Evaluate() {
+        // With the default algorithm, calculate the contact force through the force kernel of the system, which also
+        // updates the tangential displacement history.
+        ChSystemSMC* sys = static_cast<ChSystemSMC*>(this->container->GetSystem());
+        if (sys->UsingDefaultContactForceAlgorithm()) {
+            ChSystemSMC::ContactForceInput input;
+            GetForceInput(input);
+            ChVector<> force;
+            sys->CalculateContactForces(&input, &force, 1);
+            Evaluate(force);
+            return;
+        }
+
         // Calculate contact force.
-        m_force = CalculateForce(-this->norm_dist,                            // overlap (here, always positive)
-                                 this->normal,                                // normal contact direction
-                                 this->objA->GetContactPointSpeed(this->p1),  // velocity of contact point on objA
-                                 this->objB->GetContactPointSpeed(this->p2),  // velocity of contact point on objB
-                                 mat                                          // composite material for contact pair
-        );
+        Evaluate(CalculateForce(-this->norm_dist,                            // overlap (here, always positive)
+                                this->normal,                                // normal contact direction
+                                this->objA->GetContactPointSpeed(this->p1),  // velocity of contact point on objA
+                                this->objB->GetContactPointSpeed(this->p2),  // velocity of contact point on objB
+                                m_mat                                        // composite material for contact pair
+                                ));
+    }
+
+    /// Set the contact force (e.g. as calculated by the system for the data from GetForceInput) and, if stiff contact
+    /// is enabled, calculate the contact Jacobians.
+    void Evaluate(const ChVector<>& force) {
+        m_force = force;
 
         // Set up and compute Jacobian matrices.
         if (static_cast<ChSystemSMC*>(this->container->GetSystem())->GetStiffContact()) {
             CreateJacobians();
-            CalculateJacobians(mat);
+            CalculateJacobians(m_mat);
         }
     }
 
@@ -308,8 +197,17 @@ class ChContactSMC : public ChContactTuple<Ta, Tb> {
             return ChVector<>(0, 0, 0);
         }
 
-        // Use current SMC algorithm to calculate the force
+        // Use current SMC algorithm to calculate the force.
+        // The default algorithm is called directly through the force kernel of the system.
         ChSystemSMC* sys = static_cast<ChSystemSMC*>(this->container->GetSystem());
+        if (sys->UsingDefaultContactForceAlgorithm()) {
+            ChSystemSMC::ContactForceInput input;
+            GetForceInput(delta, normal_dir, vel1, vel2, mat, input);
+            ChVector<> force;
+            sys->CalculateContactForces(&input, &force, 1);
+            return force;
+        }
+
         return sys->GetContactForceAlgorithm().CalculateForce(*sys,                                        //
                                                               normal_dir, this->p1, this->p2, vel1, vel2,  //
                                                               mat,                                         //
@@ -317,169 +215,35 @@ class ChContactSMC : public ChContactTuple<Ta, Tb> {
                                                               this->objA->GetContactableMass(),            //
                                                               this->objB->GetContactableMass()             //
         );
+    }
 
-        /*
-        // Extract parameters from containing system
-        ChSystemSMC* sys = static_cast<ChSystemSMC*>(this->container->GetSystem());
-        double dT = sys->GetStep();
-        bool use_mat_props = sys->UsingMaterialProperties();
-        ChSystemSMC::ContactForceModel contact_model = sys->GetContactForceModel();
-        ChSystemSMC::AdhesionForceModel adhesion_model = sys->GetAdhesionForceModel();
-        ChSystemSMC::TangentialDisplacementModel tdispl_model = sys->GetTangentialDisplacementModel();
-
-        // Relative velocity at contact
-        ChVector<> relvel = vel2 - vel1;
-        double relvel_n_mag = relvel.Dot(normal_dir);
-        ChVector<> relvel_n = relvel_n_mag * normal_dir;
-        ChVector<> relvel_t = relvel - relvel_n;
-        double relvel_t_mag = relvel_t.Length();
-
-        // Calculate effective mass
-        double eff_mass = this->objA->GetContactableMass() * this->objB->GetContactableMass() /
-                          (this->objA->GetContactableMass() + this->objB->GetContactableMass());
-
-        // Calculate stiffness and viscous damping coefficients.
-        // All models use the following formulas for normal and tangential forces:
-        //     Fn = kn * delta_n - gn * v_n
-        //     Ft = kt * delta_t - gt * v_t
-        double kn = 0;
-        double kt = 0;
-        double gn = 0;
-        double gt = 0;
-
-        double eps = std::numeric_limits<double>::epsilon();
-
-        switch (contact_model) {
-            case ChSystemSMC::Flores:
-                // Currently not implemented.  Fall through to Hooke.
-            case ChSystemSMC::Hooke:
-                if (use_mat_props) {
-                    double tmp_k = (16.0 / 15) * std::sqrt(this->eff_radius) * mat.E_eff;
-                    double v2 = sys->GetCharacteristicImpactVelocity() * sys->GetCharacteristicImpactVelocity();
-                    double loge = (mat.cr_eff < eps) ? std::log(eps) : std::log(mat.cr_eff);
-                    loge = (mat.cr_eff > 1 - eps) ? std::log(1 - eps) : loge;
-                    double tmp_g = 1 + std::pow(CH_C_PI / loge, 2);
-                    kn = tmp_k * std::pow(eff_mass * v2 / tmp_k, 1.0 / 5);
-                    kt = kn;
-                    gn = std::sqrt(4 * eff_mass * kn / tmp_g);
-                    gt = gn;
-                } else {
-                    kn = mat.kn;
-                    kt = mat.kt;
-                    gn = eff_mass * mat.gn;
-                    gt = eff_mass * mat.gt;
-                }
-
-                break;
-
-            case ChSystemSMC::Hertz:
-                if (use_mat_props) {
-                    double sqrt_Rd = std::sqrt(this->eff_radius * delta);
-                    double Sn = 2 * mat.E_eff * sqrt_Rd;
-                    double St = 8 * mat.G_eff * sqrt_Rd;
-                    double loge = (mat.cr_eff < eps) ? std::log(eps) : std::log(mat.cr_eff);
-                    double beta = loge / std::sqrt(loge * loge + CH_C_PI * CH_C_PI);
-                    kn = (2.0 / 3) * Sn;
-                    kt = St;
-                    gn = -2 * std::sqrt(5.0 / 6) * beta * std::sqrt(Sn * eff_mass);
-                    gt = -2 * std::sqrt(5.0 / 6) * beta * std::sqrt(St * eff_mass);
-                } else {
-                    double tmp = this->eff_radius * std::sqrt(delta);
-                    kn = tmp * mat.kn;
-                    kt = tmp * mat.kt;
-                    gn = tmp * eff_mass * mat.gn;
-                    gt = tmp * eff_mass * mat.gt;
-                }
-
-                break;
-
-            case ChSystemSMC::PlainCoulomb:
-                if (use_mat_props) {
-                    double sqrt_Rd = std::sqrt(delta);
-                    double Sn = 2 * mat.E_eff * sqrt_Rd;
-                    double loge = (mat.cr_eff < eps) ? std::log(eps) : std::log(mat.cr_eff);
-                    double beta = loge / std::sqrt(loge * loge + CH_C_PI * CH_C_PI);
-                    kn = (2.0 / 3) * Sn;
-                    gn = -2 * std::sqrt(5.0 / 6) * beta * std::sqrt(Sn * eff_mass);
-                } else {
-                    double tmp = std::sqrt(delta);
-                    kn = tmp * mat.kn;
-                    gn = tmp * mat.gn;
-                }
-
-                kt = 0;
-                gt = 0;
-
-                {
-                    double forceN = kn * delta - gn * relvel_n_mag;
-                    if (forceN < 0)
-                        forceN = 0;
-                    double forceT = mat.mu_eff * std::tanh(5.0 * relvel_t_mag) * forceN;
-                    switch (adhesion_model) {
-                        case ChSystemSMC::AdhesionForceModel::Perko:
-                            // Currently not implemented.  Fall through to Constant.
-                        case ChSystemSMC::AdhesionForceModel::Constant:
-                            forceN -= mat.adhesion_eff;
-                            break;
-                        case ChSystemSMC::AdhesionForceModel::DMT:
-                            forceN -= mat.adhesionMultDMT_eff * sqrt(this->eff_radius);
-                            break;
-                    }
-                    ChVector<> force = forceN * normal_dir;
-                    if (relvel_t_mag >= sys->GetSlipVelocityThreshold())
-                        force -= (forceT / relvel_t_mag) * relvel_t;
-
-                    return force;
-                }
-        }
-
-        // Tangential displacement (magnitude)
-        double delta_t = 0;
-        switch (tdispl_model) {
-            case ChSystemSMC::OneStep:
-                delta_t = relvel_t_mag * dT;
-                break;
-            case ChSystemSMC::MultiStep:
-                //// TODO: implement proper MultiStep mode
-                delta_t = relvel_t_mag * dT;
-                break;
-            default:
-                break;
-        }
-
-        // Calculate the magnitudes of the normal and tangential contact forces
-        double forceN = kn * delta - gn * relvel_n_mag;
-        double forceT = kt * delta_t + gt * relvel_t_mag;
-
-        // If the resulting normal contact force is negative, the two shapes are moving
-        // away from each other so fast that no contact force is generated.
-        if (forceN < 0) {
-            forceN = 0;
-            forceT = 0;
-        }
-
-        // Include adhesion force
-        switch (adhesion_model) {
-            case ChSystemSMC::AdhesionForceModel::Perko:
-                // Currently not implemented.  Fall through to Constant.
-            case ChSystemSMC::AdhesionForceModel::Constant:
-                forceN -= mat.adhesion_eff;
-                break;
-            case ChSystemSMC::AdhesionForceModel::DMT:
-                forceN -= mat.adhesionMultDMT_eff * sqrt(this->eff_radius);
-                break;
-        }
-
-        // Coulomb law
-        forceT = std::min<double>(forceT, mat.mu_eff * std::abs(forceN));
-
-        // Accumulate normal and tangential forces
-        ChVector<> force = forceN * normal_dir;
-        if (relvel_t_mag >= sys->GetSlipVelocityThreshold())
-            force -= (forceT / relvel_t_mag) * relvel_t;
+    /// Fill the input data for the default contact force calculation, at the current contact configuration.
+    /// The updated tangential displacement is stored in the persistent contact data.
+    void GetForceInput(ChSystemSMC::ContactForceInput& input) {
+        GetForceInput(-this->norm_dist, this->normal, this->objA->GetContactPointSpeed(this->p1),
+                      this->objB->GetContactPointSpeed(this->p2), m_mat, input);
+        input.tdispl_out = m_tdispl_cache;
+    }
 
-        return force;
-        */
+    /// Fill the input data for the default contact force calculation.
+    /// The tangential displacement history is read but not updated (e.g., for finite-difference Jacobians).
+    void GetForceInput(double delta,                          ///< overlap in normal direction
+                       const ChVector<>& normal_dir,          ///< normal contact direction (global frame)
+                       const ChVector<>& vel1,                ///< velocity of contact point on objA (global frame)
+                       const ChVector<>& vel2,                ///< velocity of contact point on objB (global frame)
+                       const ChMaterialCompositeSMC& mat,     ///< composite material for contact pair
+                       ChSystemSMC::ContactForceInput& input  ///< resulting force input data
+    ) const {
+        input.normal_dir = normal_dir;
+        input.vel1 = vel1;
+        input.vel2 = vel2;
+        input.mat = &mat;
+        input.tdispl = m_tdispl;
+        input.tdispl_out = nullptr;
+        input.delta = delta;
+        input.eff_radius = this->eff_radius;
+        input.mass1 = this->objA->GetContactableMass();
+        input.mass2 = this->objB->GetContactableMass();
     }
 
     /// Compute all forces in a contiguous array.
@@ -534,8 +298,8 @@ class ChContactSMC : public ChContactTuple<Ta, Tb> {
     /// Create the Jacobian matrices.
     /// These matrices are created/resized as needed.
     void CreateJacobians() {
-        delete m_Jac;
-        m_Jac = new ChContactJacobian;
+        if (!m_Jac)
+            m_Jac = new ChContactJacobian;
 
         // Set variables and resize Jacobian matrices.
         // NOTE: currently, only contactable objects derived from ChContactable_1vars<6>,
@@ -13,6 +13,7 @@
 // =============================================================================
 
 #include "chrono/physics/ChLinkLinActuator.h"
+#include "chrono/physics/ChSystemSnapshot.h"
 
 namespace chrono {
 
@@ -89,6 +90,16 @@ void ChLinkLinActuator::UpdateTime(double mytime) {
     deltaC_dtdt.rot = QNULL;
 }
 
+void ChLinkLinActuator::SnapshotOut(ChSnapshotBuffer& buffer) {
+    ChLinkLockLock::SnapshotOut(buffer);
+    buffer.WriteObject(dist_funct);
+}
+
+void ChLinkLinActuator::SnapshotIn(ChSnapshotBuffer& buffer) {
+    ChLinkLockLock::SnapshotIn(buffer);
+    buffer.ReadObject(dist_funct);
+}
+
 void ChLinkLinActuator::ArchiveOut(ChArchiveOut& marchive) {
     // version number
     marchive.VersionWrite<ChLinkLinActuator>();
@@ -45,6 +45,12 @@ class ChApi ChLinkLinActuator : public ChLinkLockLock {
     /// Get the value of the distance offset.
     double GetDistanceOffset() const { return offset; }
 
+    /// Append to the buffer the internal data of the distance function.
+    virtual void SnapshotOut(ChSnapshotBuffer& buffer) override;
+
+    /// Restore the internal data stored by SnapshotOut().
+    virtual void SnapshotIn(ChSnapshotBuffer& buffer) override;
+
     /// Method to allow serialization of transient data to archives.
     virtual void ArchiveOut(ChArchiveOut& marchive) override;
 
@@ -18,6 +18,7 @@
 
 #include "chrono/physics/ChSystem.h"
 #include "chrono/physics/ChLinkLock.h"
+#include "chrono/physics/ChSystemSnapshot.h"
 
 namespace chrono {
 
@@ -2422,6 +2423,26 @@ class my_enum_mappers_angles : public ChLinkLockLock {
     CH_ENUM_MAPPER_END(AngleSet);
 };
 
+void ChLinkLockLock::SnapshotOut(ChSnapshotBuffer& buffer) {
+    ChLinkLock::SnapshotOut(buffer);
+    buffer.WriteObject(motion_X);
+    buffer.WriteObject(motion_Y);
+    buffer.WriteObject(motion_Z);
+    buffer.WriteObject(motion_ang);
+    buffer.WriteObject(motion_ang2);
+    buffer.WriteObject(motion_ang3);
+}
+
+void ChLinkLockLock::SnapshotIn(ChSnapshotBuffer& buffer) {
+    ChLinkLock::SnapshotIn(buffer);
+    buffer.ReadObject(motion_X);
+    buffer.ReadObject(motion_Y);
+    buffer.ReadObject(motion_Z);
+    buffer.ReadObject(motion_ang);
+    buffer.ReadObject(motion_ang2);
+    buffer.ReadObject(motion_ang3);
+}
+
 void ChLinkLockLock::ArchiveOut(ChArchiveOut& marchive) {
     // version number
     marchive.VersionWrite<ChLinkLockLock>();
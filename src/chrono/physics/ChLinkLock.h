@@ -334,6 +334,12 @@ class ChApi ChLinkLockLock : public ChLinkLock {
     /// Get second time derivative of constraint violations in pos/rot coordinates.
     const Coordsys& GetRelC_dtdt() const { return relC_dtdt; }
 
+    /// Append to the buffer the internal data of the imposed motion functions.
+    virtual void SnapshotOut(ChSnapshotBuffer& buffer) override;
+
+    /// Restore the internal data stored by SnapshotOut().
+    virtual void SnapshotIn(ChSnapshotBuffer& buffer) override;
+
     /// Method to allow serialization of transient data to archives.
     virtual void ArchiveOut(ChArchiveOut& marchive) override;
 
@@ -13,6 +13,7 @@
 // =============================================================================
 
 #include "chrono/physics/ChLinkMotionImposed.h"
+#include "chrono/physics/ChSystemSnapshot.h"
 #include "chrono/motion_functions/ChFunctionRotation_ABCfunctions.h"
 #include "chrono/motion_functions/ChFunctionPosition_XYZfunctions.h"
 
@@ -268,6 +269,18 @@ void ChLinkMotionImposed::ConstraintsBiLoad_Ct(double factor) {
     }
 }
 
+void ChLinkMotionImposed::SnapshotOut(ChSnapshotBuffer& buffer) {
+    ChLinkMateGeneric::SnapshotOut(buffer);
+    buffer.WriteObject(position_function);
+    buffer.WriteObject(rotation_function);
+}
+
+void ChLinkMotionImposed::SnapshotIn(ChSnapshotBuffer& buffer) {
+    ChLinkMateGeneric::SnapshotIn(buffer);
+    buffer.ReadObject(position_function);
+    buffer.ReadObject(rotation_function);
+}
+
 void ChLinkMotionImposed::ArchiveOut(ChArchiveOut& marchive) {
     // version number
     marchive.VersionWrite<ChLinkMotionImposed>();
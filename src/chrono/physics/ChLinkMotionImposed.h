@@ -100,6 +100,12 @@ class ChApi ChLinkMotionImposed : public ChLinkMateGeneric {
     /// The K matrices are load with scaling values Kfactor.
     virtual void KRMmatricesLoad(double Kfactor, double Rfactor, double Mfactor) override;
 
+    /// Append to the buffer the internal data of the position and rotation functions.
+    virtual void SnapshotOut(ChSnapshotBuffer& buffer) override;
+
+    /// Restore the internal data stored by SnapshotOut().
+    virtual void SnapshotIn(ChSnapshotBuffer& buffer) override;
+
     /// Method to allow serialization of transient data to archives.
     virtual void ArchiveOut(ChArchiveOut& marchive) override;
 
@@ -13,6 +13,7 @@
 // =============================================================================
 
 #include "chrono/physics/ChLinkMotor.h"
+#include "chrono/physics/ChSystemSnapshot.h"
 
 namespace chrono {
 
@@ -34,6 +35,16 @@ void ChLinkMotor::Update(double mytime, bool update_assets) {
     m_func->Update(mytime);
 }
 
+void ChLinkMotor::SnapshotOut(ChSnapshotBuffer& buffer) {
+    ChLinkMateGeneric::SnapshotOut(buffer);
+    buffer.WriteObject(m_func);
+}
+
+void ChLinkMotor::SnapshotIn(ChSnapshotBuffer& buffer) {
+    ChLinkMateGeneric::SnapshotIn(buffer);
+    buffer.ReadObject(m_func);
+}
+
 void ChLinkMotor::ArchiveOut(ChArchiveOut& marchive) {
     // version number
     marchive.VersionWrite<ChLinkMotor>();
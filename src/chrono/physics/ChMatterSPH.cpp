@@ -202,12 +202,14 @@ void ChContinuumSPH::ArchiveIn(ChArchiveIn& marchive) {
 // Register into the object factory, to enable run-time dynamic creation and persistence
 CH_FACTORY_REGISTER(ChMatterSPH)
 
-ChMatterSPH::ChMatterSPH() : do_collide(false) {
+ChMatterSPH::ChMatterSPH() : do_collide(false), use_neighbor_list(true), neighbor_skin(0.2) {
     matsurface = chrono_types::make_shared<ChMaterialSurfaceNSC>();
 }
 
 ChMatterSPH::ChMatterSPH(const ChMatterSPH& other) : ChIndexedNodes(other) {
     do_collide = other.do_collide;
+    use_neighbor_list = other.use_neighbor_list;
+    neighbor_skin = other.neighbor_skin;
 
     material = other.material;
     matsurface = other.matsurface;
@@ -364,50 +366,10 @@ void ChMatterSPH::IntLoadResidual_F(
 ) {
     // COMPUTE THE SPH FORCES HERE
 
-    // First, find if any ChProximityContainerSPH object is present
-    // in the system,
-
-    std::shared_ptr<ChProximityContainerSPH> edges;
-    for (auto otherphysics : GetSystem()->Get_otherphysicslist()) {
-        if ((edges = std::dynamic_pointer_cast<ChProximityContainerSPH>(otherphysics)))
-            break;
-    }
-    assert(edges);  // If using a ChMatterSPH, you must add also a ChProximityContainerSPH.
-    if (!edges)
+    if (!ComputeForces())
         return;
 
-    // 1- Per-node initialization
-
-    for (unsigned int j = 0; j < nodes.size(); j++) {
-        nodes[j]->UserForce = VNULL;
-        nodes[j]->density = 0;
-    }
-
-    // 2- Per-edge initialization and accumulation of particles's density
-
-    edges->AccumulateStep1();
-
-    // 3- Per-node volume and pressure computation
-
-    for (unsigned int j = 0; j < nodes.size(); j++) {
-        std::shared_ptr<ChNodeSPH> mnode(nodes[j]);
-        assert(mnode);
-
-        // node volume is v=mass/density
-        if (mnode->density)
-            mnode->volume = mnode->GetMass() / mnode->density;
-        else
-            mnode->volume = 0;
-
-        // node pressure = k(dens - dens_0);
-        mnode->pressure = material.Get_pressure_stiffness() * (mnode->density - material.Get_density());
-    }
-
-    // 4- Per-edge forces computation and accumulation
-
-    edges->AccumulateStep2();
-
-    // 5- Per-node load forces
+    // Per-node load forces
 
     for (unsigned int j = 0; j < nodes.size(); j++) {
         // particle gyroscopic force:
@@ -475,49 +437,10 @@ void ChMatterSPH::VariablesFbReset() {
 void ChMatterSPH::VariablesFbLoadForces(double factor) {
     // COMPUTE THE SPH FORCES HERE
 
-    // First, find if any ChProximityContainerSPH object is present in the system
-
-    std::shared_ptr<ChProximityContainerSPH> edges;
-    for (auto otherphysics : GetSystem()->Get_otherphysicslist()) {
-        if ((edges = std::dynamic_pointer_cast<ChProximityContainerSPH>(otherphysics)))
-            break;
-    }
-    assert(edges);  // If using a ChMatterSPH, you must add also a ChProximityContainerSPH.
-    if (!edges)
+    if (!ComputeForces())
         return;
 
-    // 1- Per-node initialization
-
-    for (unsigned int j = 0; j < nodes.size(); j++) {
-        nodes[j]->UserForce = VNULL;
-        nodes[j]->density = 0;
-    }
-
-    // 2- Per-edge initialization and accumulation of particles's density
-
-    edges->AccumulateStep1();
-
-    // 3- Per-node volume and pressure computation
-
-    for (unsigned int j = 0; j < nodes.size(); j++) {
-        std::shared_ptr<ChNodeSPH> mnode(nodes[j]);
-        assert(mnode);
-
-        // node volume is v=mass/density
-        if (mnode->density)
-            mnode->volume = mnode->GetMass() / mnode->density;
-        else
-            mnode->volume = 0;
-
-        // node pressure = k(dens - dens_0);
-        mnode->pressure = material.Get_pressure_stiffness() * (mnode->density - material.Get_density());
-    }
-
-    // 4- Per-edge forces computation and accumulation
-
-    edges->AccumulateStep2();
-
-    // 5- Per-node load forces
+    // Per-node load forces
 
     for (unsigned int j = 0; j < nodes.size(); j++) {
         // particle gyroscopic force:
@@ -596,6 +519,153 @@ void ChMatterSPH::Update(double mytime, bool update_assets) {
     // ClampSpeed();     // Apply limits (if in speed clamping mode) to speeds.
 }
 
+// SPH FORCES
+
+// Return the first ChProximityContainerSPH in the given system, if any
+static std::shared_ptr<ChProximityContainerSPH> FindProximityContainer(ChSystem* sys) {
+    for (auto& otherphysics : sys->Get_otherphysicslist()) {
+        if (auto edges = std::dynamic_pointer_cast<ChProximityContainerSPH>(otherphysics))
+            return edges;
+    }
+    return nullptr;
+}
+
+bool ChMatterSPH::ComputeForces() {
+    // A proximity container also provides the pairs of nodes of different clusters, so it takes precedence
+    auto edges = FindProximityContainer(GetSystem());
+    if (use_neighbor_list && !edges) {
+        ComputeForcesNeighborList();
+        return true;
+    }
+    return ComputeForcesProximity(edges);
+}
+
+bool ChMatterSPH::ComputeForcesProximity(std::shared_ptr<ChProximityContainerSPH> edges) {
+    assert(edges);  // If the internal neighbor search is disabled, you must add also a ChProximityContainerSPH.
+    if (!edges)
+        return false;
+
+    // 1- Per-node initialization
+
+    for (unsigned int j = 0; j < nodes.size(); j++) {
+        nodes[j]->UserForce = VNULL;
+        nodes[j]->density = 0;
+    }
+
+    // 2- Per-edge initialization and accumulation of particles's density
+
+    edges->AccumulateStep1();
+
+    // 3- Per-node volume and pressure computation
+
+    for (unsigned int j = 0; j < nodes.size(); j++) {
+        std::shared_ptr<ChNodeSPH> mnode(nodes[j]);
+        assert(mnode);
+
+        // node volume is v=mass/density
+        if (mnode->density)
+            mnode->volume = mnode->GetMass() / mnode->density;
+        else
+            mnode->volume = 0;
+
+        // node pressure = k(dens - dens_0);
+        mnode->pressure = material.Get_pressure_stiffness() * (mnode->density - material.Get_density());
+    }
+
+    // 4- Per-edge forces computation and accumulation
+
+    edges->AccumulateStep2();
+
+    return true;
+}
+
+void ChMatterSPH::ComputeForcesNeighborList() {
+    int nthreads = GetSystem()->GetNumThreadsChrono();
+    int n = (int)nodes.size();
+
+    // Gather the node data in contiguous arrays
+    node_pos.resize(n);
+    node_vel.resize(n);
+    node_mass.resize(n);
+    node_volume.resize(n);
+    node_pressure.resize(n);
+    double max_h = 0;
+    for (int j = 0; j < n; j++) {
+        node_pos[j] = nodes[j]->pos;
+        node_vel[j] = nodes[j]->pos_dt;
+        node_mass[j] = nodes[j]->GetMass();
+        max_h = std::max(max_h, nodes[j]->GetKernelRadius());
+    }
+
+    // Update the neighbor lists (rebuilt only if some node moved more than half the skin)
+    neighbor_list.SetCutoff(max_h);
+    neighbor_list.SetSkin(neighbor_skin * max_h);
+    neighbor_list.Update(node_pos, nthreads);
+
+    double dens_0 = material.Get_density();
+    double stiffness = material.Get_pressure_stiffness();
+    double viscosity = material.Get_viscosity();
+
+    // Density, volume and pressure of each node (nodes are visited in Morton order)
+#pragma omp parallel for num_threads(nthreads) if (nthreads > 1)
+    for (int k = 0; k < n; k++) {
+        unsigned int i = neighbor_list.GetPoint(k);
+        const ChVector<>& x_i = node_pos[i];
+        double h = nodes[i]->GetKernelRadius();
+        double h2 = h * h;
+        double c_poly6 = 315.0 / (64.0 * CH_C_PI * std::pow(h, 9));
+
+        double density = 0;
+        const unsigned int* nbr = neighbor_list.GetNeighbors(k);
+        for (unsigned int m = 0; m < neighbor_list.GetNumNeighbors(k); m++) {
+            unsigned int j = nbr[m];
+            double r2 = (node_pos[j] - x_i).Length2();
+            if (r2 < h2) {
+                double d = h2 - r2;
+                density += node_mass[j] * c_poly6 * d * d * d;
+            }
+        }
+
+        // node volume is v=mass/density, node pressure = k(dens - dens_0)
+        node_volume[i] = density ? node_mass[i] / density : 0;
+        node_pressure[i] = stiffness * (density - dens_0);
+
+        nodes[i]->density = density;
+        nodes[i]->volume = node_volume[i];
+        nodes[i]->pressure = node_pressure[i];
+    }
+
+    // Pressure and viscous forces on each node
+#pragma omp parallel for num_threads(nthreads) if (nthreads > 1)
+    for (int k = 0; k < n; k++) {
+        unsigned int i = neighbor_list.GetPoint(k);
+        const ChVector<>& x_i = node_pos[i];
+        const ChVector<>& v_i = node_vel[i];
+        double h = nodes[i]->GetKernelRadius();
+        double c_grad = 45.0 / (CH_C_PI * std::pow(h, 6));
+
+        ChVector<> force(0);
+        const unsigned int* nbr = neighbor_list.GetNeighbors(k);
+        for (unsigned int m = 0; m < neighbor_list.GetNumNeighbors(k); m++) {
+            unsigned int j = nbr[m];
+            ChVector<> r_ji = node_pos[j] - x_i;
+            double dist = r_ji.Length();
+            if (dist >= h)
+                continue;
+
+            double vol_ij = node_volume[i] * node_volume[j];
+            double avg_press = 0.5 * (node_pressure[i] + node_pressure[j]);
+            double W_press = -c_grad * (h - dist) * (h - dist);
+            double W_visc = c_grad * (h - dist);
+
+            force += r_ji * (W_press * vol_ij * avg_press);
+            force += (node_vel[j] - v_i) * (vol_ij * viscosity * W_visc);
+        }
+
+        nodes[i]->UserForce = force;
+    }
+}
+
 // collision stuff
 void ChMatterSPH::SetCollide(bool mcoll) {
     if (mcoll == do_collide)
@@ -18,6 +18,7 @@
 #include <cmath>
 
 #include "chrono/collision/ChCollisionModel.h"
+#include "chrono/collision/ChNeighborList.h"
 #include "chrono/physics/ChIndexedNodes.h"
 #include "chrono/physics/ChNodeXYZ.h"
 #include "chrono/fea/ChContinuumMaterial.h"
@@ -28,6 +29,7 @@ namespace chrono {
 // Forward references (for parent hierarchy pointer)
 class ChSystem;
 class ChMatterSPH;
+class ChProximityContainerSPH;
 
 /// Class for a single node in the SPH cluster.
 /// Does not define mass, inertia and shape because those are shared among them.
@@ -221,6 +223,11 @@ class ChApi ChContinuumSPH : public fea::ChContinuumMaterial {
 /// Class for clusters of point nodes that can simulate a fluid or an elastic/plastic
 /// solid with the Smooth Particle Hydrodynamics (SPH) approach, that is with a
 /// 'meshless' FEA approach.
+/// The pairs of interacting nodes are provided by the collision system through a
+/// ChProximityContainerSPH, if one is added to the same system. Otherwise, they are found
+/// with an internal cell-list neighbor search, and the SPH density and force kernels run in
+/// parallel (see SetNeighborSearch()). The internal search only finds pairs of nodes of the
+/// same cluster: a ChProximityContainerSPH is required if several clusters must interact.
 
 class ChApi ChMatterSPH : public ChIndexedNodes {
 
@@ -230,6 +237,15 @@ class ChApi ChMatterSPH : public ChIndexedNodes {
     std::shared_ptr<ChMaterialSurface> matsurface;  ///< data for surface contact and impact
     bool do_collide;                                    ///< flag indicating whether or not nodes collide
 
+    bool use_neighbor_list;                         ///< use the internal neighbor search?
+    double neighbor_skin;                           ///< skin of the neighbor list, as a fraction of the kernel radius
+    collision::ChNeighborList neighbor_list;        ///< persistent neighbor list
+    std::vector<ChVector<> > node_pos;              ///< node positions, gathered for the SPH kernels
+    std::vector<ChVector<> > node_vel;              ///< node velocities, gathered for the SPH kernels
+    std::vector<double> node_mass;                  ///< node masses, gathered for the SPH kernels
+    std::vector<double> node_volume;                ///< node volumes computed by the SPH kernels
+    std::vector<double> node_pressure;              ///< node pressures computed by the SPH kernels
+
   public:
     /// Build a cluster of nodes for SPH and meshless FEM.
     /// By default the cluster will contain 0 particles.
@@ -270,6 +286,23 @@ class ChApi ChMatterSPH : public ChIndexedNodes {
     /// vector as initial position.
     void AddNode(ChVector<double> initial_state);
 
+    /// Enable/disable the internal neighbor search (default: true).
+    /// If enabled, and if the system does not contain a ChProximityContainerSPH, interacting node pairs
+    /// are found with a uniform cell grid and stored in persistent neighbor lists. These only contain
+    /// nodes of this cluster. If the system contains a ChProximityContainerSPH, the pairs are taken from
+    /// it, including pairs with nodes of other clusters. If disabled, the container must be present.
+    void SetNeighborSearch(bool val) { use_neighbor_list = val; }
+    bool GetNeighborSearch() const { return use_neighbor_list; }
+
+    /// Set the skin distance of the neighbor lists, as a fraction of the largest kernel radius (default: 0.2).
+    /// Lists are rebuilt only when a node moved by more than half the skin: larger values mean fewer
+    /// rebuilds but more candidate pairs.
+    void SetNeighborSkin(double factor) { neighbor_skin = factor; }
+    double GetNeighborSkin() const { return neighbor_skin; }
+
+    /// Access the neighbor list used by the internal neighbor search.
+    const collision::ChNeighborList& GetNeighborList() const { return neighbor_list; }
+
     /// Set the material surface for 'boundary contact'
     void SetMaterialSurface(const std::shared_ptr<ChMaterialSurface>& mnewsurf) { matsurface = mnewsurf; }
 
@@ -397,6 +430,17 @@ class ChApi ChMatterSPH : public ChIndexedNodes {
 
     virtual void ArchiveOut(ChArchiveOut& marchive) override;
     virtual void ArchiveIn(ChArchiveIn& marchive) override;
+
+  private:
+    /// Compute the SPH density, pressure and forces of all nodes (stored in the nodes UserForce).
+    /// Return false if the forces could not be computed.
+    bool ComputeForces();
+
+    /// Compute the SPH forces using the internal neighbor lists.
+    void ComputeForcesNeighborList();
+
+    /// Compute the SPH forces using the pairs of the given ChProximityContainerSPH.
+    bool ComputeForcesProximity(std::shared_ptr<ChProximityContainerSPH> edges);
 };
 
 }  // end namespace chrono
@@ -0,0 +1,836 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+
+#include "chrono/collision/ChCollisionModel.h"
+#include "chrono/physics/ChBody.h"
+#include "chrono/physics/ChParticleCloudSoA.h"
+#include "chrono/physics/ChSystem.h"
+#include "chrono/utils/ChOpenMP.h"
+
+namespace chrono {
+
+// Register into the object factory, to enable run-time dynamic creation and persistence
+CH_FACTORY_REGISTER(ChParticleCloudSoA)
+
+ChParticleCloudSoA::ChParticleCloudSoA()
+    : m_mass_dirty(true),
+      m_density(1000),
+      m_fixed(false),
+      m_contacts(true),
+      m_num_contacts(0),
+      m_cell_size(0),
+      m_bucket_mask(0) {
+    m_material = chrono_types::make_shared<ChMaterialSurfaceSMC>();
+}
+
+ChParticleCloudSoA::ChParticleCloudSoA(const ChParticleCloudSoA& other) : ChPhysicsItem(other) {
+    m_pos = other.m_pos;
+    m_rot = other.m_rot;
+    m_vel = other.m_vel;
+    m_wvel = other.m_wvel;
+    m_acc = other.m_acc;
+    m_wacc = other.m_wacc;
+    m_radius = other.m_radius;
+    m_mass = other.m_mass;
+    m_cforce = other.m_cforce;
+    m_ctorque = other.m_ctorque;
+    m_mass_dirty = true;
+
+    m_density = other.m_density;
+    m_fixed = other.m_fixed;
+
+    m_contacts = other.m_contacts;
+    m_material = other.m_material;
+    m_plane_points = other.m_plane_points;
+    m_plane_normals = other.m_plane_normals;
+    m_num_contacts = other.m_num_contacts;
+
+    m_cell_size = 0;
+    m_bucket_mask = 0;
+}
+
+unsigned int ChParticleCloudSoA::AddParticle(const ChVector<>& pos, double radius, const ChVector<>& vel) {
+    m_pos.push_back(pos);
+    m_rot.push_back(QUNIT);
+    m_vel.push_back(vel);
+    m_wvel.push_back(VNULL);
+    m_acc.push_back(VNULL);
+    m_wacc.push_back(VNULL);
+    m_radius.push_back(radius);
+    m_mass.push_back(m_density * (4.0 / 3.0) * CH_C_PI * radius * radius * radius);
+    m_cforce.push_back(VNULL);
+    m_ctorque.push_back(VNULL);
+
+    // The solver variables are resized at the next call to Setup
+    m_mass_dirty = true;
+
+    return GetNparticles() - 1;
+}
+
+void ChParticleCloudSoA::ClearParticles() {
+    m_pos.clear();
+    m_rot.clear();
+    m_vel.clear();
+    m_wvel.clear();
+    m_acc.clear();
+    m_wacc.clear();
+    m_radius.clear();
+    m_mass.clear();
+    m_cforce.clear();
+    m_ctorque.clear();
+    m_mass_dirty = true;
+}
+
+void ChParticleCloudSoA::SetDensity(double density) {
+    m_density = density;
+    for (unsigned int j = 0; j < GetNparticles(); j++)
+        m_mass[j] = m_density * (4.0 / 3.0) * CH_C_PI * m_radius[j] * m_radius[j] * m_radius[j];
+    m_mass_dirty = true;
+}
+
+void ChParticleCloudSoA::AddPlane(const ChVector<>& point, const ChVector<>& normal) {
+    m_plane_points.push_back(point);
+    m_plane_normals.push_back(normal.GetNormalized());
+}
+
+void ChParticleCloudSoA::ClearPlanes() {
+    m_plane_points.clear();
+    m_plane_normals.clear();
+}
+
+ChVector<> ChParticleCloudSoA::GetBodyContactForce(const ChBody* body) const {
+    for (size_t b = 0; b < m_contact_bodies.size(); b++) {
+        if (m_contact_bodies[b] == body)
+            return m_body_force[b];
+    }
+    return VNULL;
+}
+
+void ChParticleCloudSoA::GetTotalAABB(ChVector<>& bbmin, ChVector<>& bbmax) {
+    if (m_pos.empty()) {
+        ChPhysicsItem::GetTotalAABB(bbmin, bbmax);
+        return;
+    }
+
+    bbmin.Set(+1e200, +1e200, +1e200);
+    bbmax.Set(-1e200, -1e200, -1e200);
+    for (unsigned int j = 0; j < GetNparticles(); j++) {
+        ChVector<> r(m_radius[j]);
+        bbmin = Vmin(bbmin, m_pos[j] - r);
+        bbmax = Vmax(bbmax, m_pos[j] + r);
+    }
+}
+
+void ChParticleCloudSoA::SetSystem(ChSystem* m_system) {
+    if (m_system && m_system->GetContactMethod() != ChContactMethod::SMC)
+        throw ChException("ChParticleCloudSoA can only be used in a system with SMC contact method.");
+    ChPhysicsItem::SetSystem(m_system);
+}
+
+void ChParticleCloudSoA::Setup() {
+    int ndof = 6 * (int)GetNparticles();
+
+    // ChVariablesGenericDiagonalMass cannot be resized in place
+    if (!m_variables || m_variables->Get_ndof() != ndof) {
+        m_variables.reset(new ChVariablesGenericDiagonalMass(ndof));
+        m_mass_dirty = true;
+    }
+
+    if (!m_mass_dirty)
+        return;
+
+    // Diagonal mass matrix: mass and (isotropic) moment of inertia of each sphere
+    ChVectorDynamic<>& diag = m_variables->GetMassDiagonal();
+    for (unsigned int j = 0; j < GetNparticles(); j++) {
+        double inertia = 0.4 * m_mass[j] * m_radius[j] * m_radius[j];
+        diag.segment(6 * j + 0, 3).setConstant(m_mass[j]);
+        diag.segment(6 * j + 3, 3).setConstant(inertia);
+    }
+    m_mass_dirty = false;
+}
+
+// -----------------------------------------------------------------------------
+// CONTACT FORCES
+// -----------------------------------------------------------------------------
+
+size_t ChParticleCloudSoA::CellBucket(long long ix, long long iy, long long iz) const {
+    unsigned long long h = ((unsigned long long)ix * 73856093ULL) ^ ((unsigned long long)iy * 19349663ULL) ^
+                           ((unsigned long long)iz * 83492791ULL);
+    return (size_t)(h & m_bucket_mask);
+}
+
+void ChParticleCloudSoA::UpdateGrid() {
+    int np = (int)GetNparticles();
+
+    double max_radius = 0;
+    for (int j = 0; j < np; j++)
+        max_radius = std::max(max_radius, m_radius[j]);
+    m_cell_size = max_radius > 0 ? 2 * max_radius : 1;
+
+    // Number of buckets: power of 2, at least twice the number of particles
+    size_t nbuckets = 1;
+    while (nbuckets < 2 * (size_t)np)
+        nbuckets <<= 1;
+    m_bucket_mask = nbuckets - 1;
+
+    int nthreads = GetSystem() ? GetSystem()->GetNumThreadsChrono() : 1;
+    double inv_size = 1 / m_cell_size;
+    m_bucket.resize(np);
+#pragma omp parallel for num_threads(nthreads) if (nthreads > 1)
+    for (int j = 0; j < np; j++) {
+        m_bucket[j] = CellBucket((long long)std::floor(m_pos[j].x() * inv_size),
+                                 (long long)std::floor(m_pos[j].y() * inv_size),
+                                 (long long)std::floor(m_pos[j].z() * inv_size));
+    }
+
+    // Counting sort of the particles by bucket
+    m_start.assign(nbuckets + 1, 0);
+    for (int j = 0; j < np; j++)
+        m_start[m_bucket[j] + 1]++;
+    for (size_t b = 0; b < nbuckets; b++)
+        m_start[b + 1] += m_start[b];
+    m_sorted.resize(np);
+    std::vector<unsigned int> next(m_start.begin(), m_start.end() - 1);
+    for (int j = 0; j < np; j++)
+        m_sorted[next[m_bucket[j]]++] = j;
+}
+
+// Get the dimensions of a sphere (radius), box (half-dimensions), or cylinder (radius and half-length, along the Z
+// axis) collision shape. Return false for other shapes.
+static bool GetShapeDimensions(collision::ChCollisionModel& model, int index, int type, ChVector<>& dims) {
+    std::vector<double> d = model.GetShapeGeometricDimensions(index);
+
+    switch (type) {
+        case collision::ChCollisionShape::Type::SPHERE:
+            if (d.size() < 1)
+                return false;
+            dims = ChVector<>(d[0], 0, 0);
+            return true;
+        case collision::ChCollisionShape::Type::BOX:
+            if (d.size() < 3)
+                return false;
+            dims = ChVector<>(d[0], d[1], d[2]);
+            return true;
+        case collision::ChCollisionShape::Type::CYLINDER:
+            if (d.size() < 3)
+                return false;
+            // The half-length is reported last by Bullet models and second by Chrono models
+            dims = ChVector<>(d[0], model.GetType() == collision::ChCollisionSystemType::BULLET ? d[2] : d[1], 0);
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Material composition strategy of a system. The composite material constructor takes a non-const pointer, although
+// the strategy is only used through its const functions.
+static ChMaterialCompositionStrategy* CompositionStrategy(const ChSystem* sys) {
+    return const_cast<ChMaterialCompositionStrategy*>(&sys->GetMaterialCompositionStrategy());
+}
+
+void ChParticleCloudSoA::UpdateBodyShapes() {
+    m_contact_bodies.clear();
+    m_body_shapes.clear();
+    if (!GetSystem())
+        return;
+
+    ChMaterialCompositionStrategy* strategy = CompositionStrategy(GetSystem());
+
+    ChVector<> bbmin;
+    ChVector<> bbmax;
+    GetTotalAABB(bbmin, bbmax);
+
+    for (auto& body : GetSystem()->Get_bodylist()) {
+        auto model = body->GetCollisionModel();
+        if (!body->GetCollide() || !model)
+            continue;
+
+        // Frame of the collision model (accessed through the contactable interface)
+        ChFrame<> model_frame(static_cast<ChContactable*>(body.get())->GetCsysForCollisionModel());
+
+        bool added = false;
+        for (int k = 0; k < model->GetNumShapes(); k++) {
+            BodyShape shape;
+            shape.type = model->GetShape(k)->GetType();
+            if (!GetShapeDimensions(*model, k, shape.type, shape.dims))
+                continue;
+
+            // Shapes of an SMC system have SMC materials (checked by the contact container as well)
+            auto shape_mat = std::dynamic_pointer_cast<ChMaterialSurfaceSMC>(model->GetShape(k)->GetMaterial());
+            if (!shape_mat)
+                continue;
+            shape.material = ChMaterialCompositeSMC(strategy, m_material, shape_mat);
+
+            model_frame.TransformLocalToParent(ChFrame<>(model->GetShapePos(k)), shape.frame);
+            shape.center = shape.frame.GetPos();
+            switch (shape.type) {
+                case collision::ChCollisionShape::Type::SPHERE:
+                    shape.radius = shape.dims.x();
+                    break;
+                case collision::ChCollisionShape::Type::BOX:
+                    shape.radius = shape.dims.Length();
+                    break;
+                default:
+                    shape.radius = std::sqrt(shape.dims.x() * shape.dims.x() + shape.dims.y() * shape.dims.y());
+                    break;
+            }
+
+            // Skip shapes whose bounding sphere does not overlap the bounding box of the particles
+            bool separated = false;
+            for (int i = 0; i < 3; i++)
+                separated |= shape.center[i] - shape.radius > bbmax[i] || shape.center[i] + shape.radius < bbmin[i];
+            if (separated)
+                continue;
+
+            if (!added) {
+                m_contact_bodies.push_back(body.get());
+                added = true;
+            }
+            shape.body = (unsigned int)m_contact_bodies.size() - 1;
+            m_body_shapes.push_back(shape);
+        }
+    }
+}
+
+// Find the contact between a sphere and a body collision shape. On contact, return true and set the normal (from the
+// shape toward the sphere) and the penetration.
+static bool ShapeContact(int type,
+                         const ChFrame<>& frame,
+                         const ChVector<>& dims,
+                         const ChVector<>& pos,
+                         double radius,
+                         ChVector<>& normal,
+                         double& delta) {
+    // Position of the sphere center in the shape frame
+    ChVector<> p = frame.TransformPointParentToLocal(pos);
+
+    ChVector<> q;     // closest point on the shape (local frame)
+    ChVector<> n;     // contact normal (local frame)
+    double dist = 0;  // signed distance of the center from the shape surface
+
+    switch (type) {
+        case collision::ChCollisionShape::Type::SPHERE: {
+            double len = p.Length();
+            if (len == 0)
+                return false;
+            n = p / len;
+            dist = len - dims.x();
+            break;
+        }
+        case collision::ChCollisionShape::Type::BOX: {
+            q = Vmax(-dims, Vmin(dims, p));
+            if (q != p) {
+                // Center outside the box
+                ChVector<> d = p - q;
+                dist = d.Length();
+                n = d / dist;
+            } else {
+                // Center inside the box: push out through the closest face
+                int axis = 0;
+                double depth = dims.x() - std::abs(p.x());
+                for (int i = 1; i < 3; i++) {
+                    if (dims[i] - std::abs(p[i]) < depth) {
+                        depth = dims[i] - std::abs(p[i]);
+                        axis = i;
+                    }
+                }
+                n = VNULL;
+                n[axis] = p[axis] >= 0 ? 1 : -1;
+                dist = -depth;
+            }
+            break;
+        }
+        default: {
+            // Cylinder along the Z axis
+            double rho = std::sqrt(p.x() * p.x() + p.y() * p.y());
+            ChVector<> radial = rho > 0 ? ChVector<>(p.x() / rho, p.y() / rho, 0) : ChVector<>(1, 0, 0);
+            double side = rho - dims.x();            // distance from the lateral surface (positive outside)
+            double cap = std::abs(p.z()) - dims.y();  // distance from the closest cap plane (positive outside)
+            ChVector<> axial(0, 0, p.z() >= 0 ? 1 : -1);
+            if (side > 0 && cap > 0) {
+                // Closest to the rim
+                ChVector<> d = side * radial + cap * axial;
+                dist = d.Length();
+                n = d / dist;
+            } else if (side > cap) {
+                dist = side;
+                n = radial;
+            } else {
+                dist = cap;
+                n = axial;
+            }
+            break;
+        }
+    }
+
+    delta = radius - dist;
+    if (delta <= 0)
+        return false;
+    normal = frame.TransformDirectionLocalToParent(n);
+    return true;
+}
+
+void ChParticleCloudSoA::ComputeBodyForces() {
+    size_t nbodies = m_contact_bodies.size();
+    m_body_force.assign(nbodies, VNULL);
+    m_body_torque.assign(nbodies, VNULL);
+
+    // Serial reduction, in thread order, of the contacts found by each thread
+    m_body_contacts.clear();
+    for (auto& contacts : m_thread_contacts) {
+        m_body_contacts.insert(m_body_contacts.end(), contacts.begin(), contacts.end());
+        contacts.clear();
+    }
+
+    for (const auto& contact : m_body_contacts) {
+        ChBody* body = m_contact_bodies[contact.body];
+        m_body_force[contact.body] += contact.force;
+        m_body_torque[contact.body] += Vcross(contact.point - body->GetPos(), contact.force);
+    }
+    for (size_t b = 0; b < nbodies; b++)
+        m_body_torque[b] = m_contact_bodies[b]->TransformDirectionParentToLocal(m_body_torque[b]);
+}
+
+void ChParticleCloudSoA::ComputeContactForces() {
+    int np = (int)GetNparticles();
+    int nplanes = (int)m_plane_points.size();
+
+    if (!m_contacts || np == 0) {
+        std::fill(m_cforce.begin(), m_cforce.end(), VNULL);
+        std::fill(m_ctorque.begin(), m_ctorque.end(), VNULL);
+        m_num_contacts = 0;
+        m_contact_bodies.clear();
+        m_body_shapes.clear();
+        m_body_contacts.clear();
+        m_body_force.clear();
+        m_body_torque.clear();
+        return;
+    }
+
+    UpdateGrid();
+    UpdateBodyShapes();
+    int nshapes = (int)m_body_shapes.size();
+
+    int nthreads = GetSystem() ? GetSystem()->GetNumThreadsChrono() : 1;
+    if ((int)m_thread_contacts.size() < nthreads)
+        m_thread_contacts.resize(nthreads);
+    double inv_size = 1 / m_cell_size;
+    unsigned int num_contacts = 0;
+
+    // Material for particle-particle and particle-plane contacts
+    ChMaterialCompositionStrategy default_strategy;
+    auto strategy = GetSystem() ? CompositionStrategy(GetSystem()) : &default_strategy;
+    ChMaterialCompositeSMC mat_self(strategy, m_material, m_material);
+
+    // Each particle accumulates the forces from all its contacts, so that no synchronization is needed
+#pragma omp parallel for num_threads(nthreads) if (nthreads > 1) reduction(+ : num_contacts)
+    for (int i = 0; i < np; i++) {
+        const ChVector<>& pos_i = m_pos[i];
+        double rad_i = m_radius[i];
+        ChVector<> w_i = m_rot[i].Rotate(m_wvel[i]);
+
+        ChVector<> force(0);
+        ChVector<> torque(0);
+
+        // Penalty force for a contact with given normal (pointing toward particle i), penetration, velocity of the
+        // other object at the contact point, and composite material. Return the force applied to the particle.
+        auto add_contact = [&](const ChVector<>& normal, double delta, const ChVector<>& vel_other,
+                               const ChMaterialCompositeSMC& mat) {
+            ChVector<> arm = -rad_i * normal;
+            ChVector<> vrel = m_vel[i] + Vcross(w_i, arm) - vel_other;
+            double vn = Vdot(vrel, normal);
+            ChVector<> vt = vrel - vn * normal;
+
+            double fn = std::max(mat.kn * delta - mat.gn * vn, 0.0);
+            ChVector<> ft(0);
+            double vt_len = vt.Length();
+            if (vt_len > 0)
+                ft = -(std::min(mat.gt * vt_len, mat.mu_eff * fn) / vt_len) * vt;
+
+            force += fn * normal + ft;
+            torque += Vcross(arm, ft);
+            return fn * normal + ft;
+        };
+
+        // Candidate neighbors are in the 27 cells around the particle; distinct cells may map to the same bucket
+        long long ix = (long long)std::floor(pos_i.x() * inv_size);
+        long long iy = (long long)std::floor(pos_i.y() * inv_size);
+        long long iz = (long long)std::floor(pos_i.z() * inv_size);
+        size_t buckets[27];
+        int nb = 0;
+        for (int dx = -1; dx <= 1; dx++)
+            for (int dy = -1; dy <= 1; dy++)
+                for (int dz = -1; dz <= 1; dz++)
+                    buckets[nb++] = CellBucket(ix + dx, iy + dy, iz + dz);
+        std::sort(buckets, buckets + nb);
+        nb = (int)(std::unique(buckets, buckets + nb) - buckets);
+
+        for (int b = 0; b < nb; b++) {
+            for (unsigned int k = m_start[buckets[b]]; k < m_start[buckets[b] + 1]; k++) {
+                int j = m_sorted[k];
+                if (j == i)
+                    continue;
+                ChVector<> d = pos_i - m_pos[j];
+                double dist2 = d.Length2();
+                double rsum = rad_i + m_radius[j];
+                if (dist2 >= rsum * rsum || dist2 == 0)
+                    continue;
+                double dist = std::sqrt(dist2);
+                ChVector<> normal = d / dist;
+                ChVector<> vel_j = m_vel[j] + Vcross(m_rot[j].Rotate(m_wvel[j]), m_radius[j] * normal);
+                add_contact(normal, rsum - dist, vel_j, mat_self);
+                if (i < j)
+                    num_contacts++;
+            }
+        }
+
+        for (int s = 0; s < nshapes; s++) {
+            const BodyShape& shape = m_body_shapes[s];
+            double reach = shape.radius + rad_i;
+            if ((pos_i - shape.center).Length2() >= reach * reach)
+                continue;
+            ChVector<> normal;
+            double delta;
+            if (!ShapeContact(shape.type, shape.frame, shape.dims, pos_i, rad_i, normal, delta))
+                continue;
+            ChBody* body = m_contact_bodies[shape.body];
+            ChVector<> point = pos_i - rad_i * normal;
+            ChVector<> vel_body = body->GetPos_dt() + Vcross(body->GetWvel_par(), point - body->GetPos());
+            ChVector<> f = add_contact(normal, delta, vel_body, shape.material);
+            m_thread_contacts[ChOMP::GetThreadNum()].push_back({shape.body, point, -f});
+            num_contacts++;
+        }
+
+        for (int p = 0; p < nplanes; p++) {
+            double delta = rad_i - Vdot(pos_i - m_plane_points[p], m_plane_normals[p]);
+            if (delta <= 0)
+                continue;
+            add_contact(m_plane_normals[p], delta, VNULL, mat_self);
+            num_contacts++;
+        }
+
+        m_cforce[i] = force;
+        m_ctorque[i] = m_rot[i].RotateBack(torque);
+    }
+
+    m_num_contacts = num_contacts;
+
+    ComputeBodyForces();
+}
+
+void ChParticleCloudSoA::Update(bool update_assets) {
+    ChParticleCloudSoA::Update(GetChTime(), update_assets);
+}
+
+void ChParticleCloudSoA::Update(double mytime, bool update_assets) {
+    ChPhysicsItem::Update(mytime, update_assets);
+
+    ComputeContactForces();
+}
+
+// -----------------------------------------------------------------------------
+// STATE BOOKKEEPING FUNCTIONS
+// -----------------------------------------------------------------------------
+
+void ChParticleCloudSoA::IntStateGather(const unsigned int off_x,  // offset in x state vector
+                                        ChState& x,                // state vector, position part
+                                        const unsigned int off_v,  // offset in v state vector
+                                        ChStateDelta& v,           // state vector, speed part
+                                        double& T                  // time
+) {
+    for (unsigned int j = 0; j < GetNparticles(); j++) {
+        x.segment(off_x + 7 * j + 0, 3) = m_pos[j].eigen();
+        x.segment(off_x + 7 * j + 3, 4) = m_rot[j].eigen();
+
+        v.segment(off_v + 6 * j + 0, 3) = m_vel[j].eigen();
+        v.segment(off_v + 6 * j + 3, 3) = m_wvel[j].eigen();
+    }
+    T = GetChTime();
+}
+
+void ChParticleCloudSoA::IntStateScatter(const unsigned int off_x,  // offset in x state vector
+                                         const ChState& x,          // state vector, position part
+                                         const unsigned int off_v,  // offset in v state vector
+                                         const ChStateDelta& v,     // state vector, speed part
+                                         const double T,            // time
+                                         bool full_update           // perform complete update
+) {
+    for (unsigned int j = 0; j < GetNparticles(); j++) {
+        m_pos[j] = x.segment(off_x + 7 * j + 0, 3);
+        m_rot[j] = x.segment(off_x + 7 * j + 3, 4);
+
+        m_vel[j] = v.segment(off_v + 6 * j + 0, 3);
+        m_wvel[j] = v.segment(off_v + 6 * j + 3, 3);
+    }
+    SetChTime(T);
+    Update(T, full_update);
+}
+
+void ChParticleCloudSoA::IntStateGatherAcceleration(const unsigned int off_a, ChStateDelta& a) {
+    for (unsigned int j = 0; j < GetNparticles(); j++) {
+        a.segment(off_a + 6 * j + 0, 3) = m_acc[j].eigen();
+        a.segment(off_a + 6 * j + 3, 3) = m_wacc[j].eigen();
+    }
+}
+
+void ChParticleCloudSoA::IntStateScatterAcceleration(const unsigned int off_a, const ChStateDelta& a) {
+    for (unsigned int j = 0; j < GetNparticles(); j++) {
+        m_acc[j] = a.segment(off_a + 6 * j + 0, 3);
+        m_wacc[j] = a.segment(off_a + 6 * j + 3, 3);
+    }
+}
+
+void ChParticleCloudSoA::IntStateIncrement(const unsigned int off_x,  // offset in x state vector
+                                           ChState& x_new,            // state vector, position part, incremented result
+                                           const ChState& x,          // state vector, initial position part
+                                           const unsigned int off_v,  // offset in v state vector
+                                           const ChStateDelta& Dv     // state vector, increment
+) {
+    for (unsigned int j = 0; j < GetNparticles(); j++) {
+        // ADVANCE POSITION:
+        x_new.segment(off_x + 7 * j, 3) = x.segment(off_x + 7 * j, 3) + Dv.segment(off_v + 6 * j, 3);
+
+        // ADVANCE ROTATION: q_new = q_old * Dq_loc
+        ChQuaternion<> q_old(x.segment(off_x + 7 * j + 3, 4));
+        ChQuaternion<> rel_q;
+        rel_q.Q_from_Rotv(Dv.segment(off_v + 6 * j + 3, 3));
+        x_new.segment(off_x + 7 * j + 3, 4) = (q_old * rel_q).eigen();
+    }
+}
+
+void ChParticleCloudSoA::IntStateGetIncrement(const unsigned int off_x,  // offset in x state vector
+                                              const ChState& x_new,      // state vector, position part, incremented
+                                              const ChState& x,          // state vector, initial position part
+                                              const unsigned int off_v,  // offset in v state vector
+                                              ChStateDelta& Dv           // state vector, increment
+) {
+    for (unsigned int j = 0; j < GetNparticles(); j++) {
+        // POSITION:
+        Dv.segment(off_v + 6 * j, 3) = x_new.segment(off_x + 7 * j, 3) - x.segment(off_x + 7 * j, 3);
+
+        // ROTATION (quaternions): Dq_loc = q_old^-1 * q_new
+        ChQuaternion<> q_old(x.segment(off_x + 7 * j + 3, 4));
+        ChQuaternion<> q_new(x_new.segment(off_x + 7 * j + 3, 4));
+        ChQuaternion<> rel_q = q_old.GetConjugate() % q_new;
+        Dv.segment(off_v + 6 * j + 3, 3) = rel_q.Q_to_Rotv().eigen();
+    }
+}
+
+void ChParticleCloudSoA::IntLoadResidual_F(const unsigned int off,  // offset in R residual
+                                           ChVectorDynamic<>& R,    // result: the R residual, R += c*F
+                                           const double c           // a scaling factor
+) {
+    ChVector<> G_acc = GetSystem() ? GetSystem()->Get_G_acc() : VNULL;
+
+    // Spheres have isotropic inertia, hence no gyroscopic torque
+    for (unsigned int j = 0; j < GetNparticles(); j++) {
+        R.segment(off + 6 * j + 0, 3) += c * (m_cforce[j] + m_mass[j] * G_acc).eigen();
+        R.segment(off + 6 * j + 3, 3) += c * m_ctorque[j].eigen();
+    }
+
+    // Reactions of the particle contacts on the bodies
+    for (size_t b = 0; b < m_contact_bodies.size(); b++) {
+        ChBody* body = m_contact_bodies[b];
+        if (!body->IsActive())
+            continue;
+        R.segment(body->GetOffset_w() + 0, 3) += c * m_body_force[b].eigen();
+        R.segment(body->GetOffset_w() + 3, 3) += c * m_body_torque[b].eigen();
+    }
+}
+
+void ChParticleCloudSoA::IntLoadResidual_Mv(const unsigned int off,      // offset in R residual
+                                            ChVectorDynamic<>& R,        // result: the R residual, R += c*M*v
+                                            const ChVectorDynamic<>& w,  // the w vector
+                                            const double c               // a scaling factor
+) {
+    for (unsigned int j = 0; j < GetNparticles(); j++) {
+        double inertia = 0.4 * m_mass[j] * m_radius[j] * m_radius[j];
+        R.segment(off + 6 * j + 0, 3) += (c * m_mass[j]) * w.segment(off + 6 * j + 0, 3);
+        R.segment(off + 6 * j + 3, 3) += (c * inertia) * w.segment(off + 6 * j + 3, 3);
+    }
+}
+
+void ChParticleCloudSoA::IntToDescriptor(const unsigned int off_v,  // offset in v, R
+                                         const ChStateDelta& v,
+                                         const ChVectorDynamic<>& R,
+                                         const unsigned int off_L,  // offset in L, Qc
+                                         const ChVectorDynamic<>& L,
+                                         const ChVectorDynamic<>& Qc) {
+    if (!m_variables)
+        return;
+    m_variables->Get_qb() = v.segment(off_v, GetDOF_w());
+    m_variables->Get_fb() = R.segment(off_v, GetDOF_w());
+}
+
+void ChParticleCloudSoA::IntFromDescriptor(const unsigned int off_v,  // offset in v
+                                           ChStateDelta& v,
+                                           const unsigned int off_L,  // offset in L
+                                           ChVectorDynamic<>& L) {
+    if (!m_variables)
+        return;
+    v.segment(off_v, GetDOF_w()) = m_variables->Get_qb();
+}
+
+// -----------------------------------------------------------------------------
+// SOLVER FUNCTIONS
+// -----------------------------------------------------------------------------
+
+void ChParticleCloudSoA::InjectVariables(ChSystemDescriptor& mdescriptor) {
+    if (!m_variables || GetNparticles() == 0)
+        return;
+    m_variables->SetDisabled(!IsActive());
+    mdescriptor.InsertVariables(m_variables.get());
+}
+
+void ChParticleCloudSoA::VariablesFbReset() {
+    if (m_variables)
+        m_variables->Get_fb().setZero();
+}
+
+void ChParticleCloudSoA::VariablesFbLoadForces(double factor) {
+    if (!m_variables)
+        return;
+    ChVector<> G_acc = GetSystem() ? GetSystem()->Get_G_acc() : VNULL;
+    for (unsigned int j = 0; j < GetNparticles(); j++) {
+        m_variables->Get_fb().segment(6 * j + 0, 3) += factor * (m_cforce[j] + m_mass[j] * G_acc).eigen();
+        m_variables->Get_fb().segment(6 * j + 3, 3) += factor * m_ctorque[j].eigen();
+    }
+
+    // Reactions of the particle contacts on the bodies
+    for (size_t b = 0; b < m_contact_bodies.size(); b++) {
+        ChBody* body = m_contact_bodies[b];
+        if (!body->IsActive())
+            continue;
+        body->Variables().Get_fb().segment(0, 3) += factor * m_body_force[b].eigen();
+        body->Variables().Get_fb().segment(3, 3) += factor * m_body_torque[b].eigen();
+    }
+}
+
+void ChParticleCloudSoA::VariablesQbLoadSpeed() {
+    if (!m_variables)
+        return;
+    for (unsigned int j = 0; j < GetNparticles(); j++) {
+        m_variables->Get_qb().segment(6 * j + 0, 3) = m_vel[j].eigen();
+        m_variables->Get_qb().segment(6 * j + 3, 3) = m_wvel[j].eigen();
+    }
+}
+
+void ChParticleCloudSoA::VariablesFbIncrementMq() {
+    if (m_variables)
+        m_variables->Compute_inc_Mb_v(m_variables->Get_fb(), m_variables->Get_qb());
+}
+
+void ChParticleCloudSoA::VariablesQbSetSpeed(double step) {
+    if (!m_variables)
+        return;
+    for (unsigned int j = 0; j < GetNparticles(); j++) {
+        ChVector<> old_vel = m_vel[j];
+        ChVector<> old_wvel = m_wvel[j];
+
+        m_vel[j] = m_variables->Get_qb().segment(6 * j + 0, 3);
+        m_wvel[j] = m_variables->Get_qb().segment(6 * j + 3, 3);
+
+        // Compute accelerations by BDF (approximate by differentiation)
+        if (step) {
+            m_acc[j] = (m_vel[j] - old_vel) / step;
+            m_wacc[j] = (m_wvel[j] - old_wvel) / step;
+        }
+    }
+}
+
+void ChParticleCloudSoA::VariablesQbIncrementPosition(double dt_step) {
+    if (!IsActive() || !m_variables)
+        return;
+
+    for (unsigned int j = 0; j < GetNparticles(); j++) {
+        ChVector<> newspeed(m_variables->Get_qb().segment(6 * j + 0, 3));
+        ChVector<> newwel(m_variables->Get_qb().segment(6 * j + 3, 3));
+
+        // ADVANCE POSITION: pos' = pos + dt * vel
+        m_pos[j] += newspeed * dt_step;
+
+        // ADVANCE ROTATION: rot' = [dt*wwel]%rot  (use quaternion for delta rotation)
+        ChVector<> newwel_abs = m_rot[j].Rotate(newwel);
+        double mangle = newwel_abs.Length() * dt_step;
+        if (mangle == 0)
+            continue;
+        ChQuaternion<> mdeltarot;
+        mdeltarot.Q_from_AngAxis(mangle, newwel_abs.GetNormalized());
+        m_rot[j] = mdeltarot % m_rot[j];
+    }
+}
+
+void ChParticleCloudSoA::SetNoSpeedNoAcceleration() {
+    std::fill(m_vel.begin(), m_vel.end(), VNULL);
+    std::fill(m_wvel.begin(), m_wvel.end(), VNULL);
+    std::fill(m_acc.begin(), m_acc.end(), VNULL);
+    std::fill(m_wacc.begin(), m_wacc.end(), VNULL);
+}
+
+// -----------------------------------------------------------------------------
+// FILE I/O
+// -----------------------------------------------------------------------------
+
+void ChParticleCloudSoA::ArchiveOut(ChArchiveOut& marchive) {
+    // version number
+    marchive.VersionWrite<ChParticleCloudSoA>();
+
+    // serialize parent class
+    ChPhysicsItem::ArchiveOut(marchive);
+
+    // serialize all member data:
+    marchive << CHNVP(m_pos);
+    marchive << CHNVP(m_rot);
+    marchive << CHNVP(m_vel);
+    marchive << CHNVP(m_wvel);
+    marchive << CHNVP(m_radius);
+    marchive << CHNVP(m_density);
+    marchive << CHNVP(m_fixed);
+    marchive << CHNVP(m_contacts);
+    marchive << CHNVP(m_material);
+    marchive << CHNVP(m_plane_points);
+    marchive << CHNVP(m_plane_normals);
+}
+
+void ChParticleCloudSoA::ArchiveIn(ChArchiveIn& marchive) {
+    // version number
+    /*int version =*/marchive.VersionRead<ChParticleCloudSoA>();
+
+    // deserialize parent class:
+    ChPhysicsItem::ArchiveIn(marchive);
+
+    // deserialize all member data:
+    marchive >> CHNVP(m_pos);
+    marchive >> CHNVP(m_rot);
+    marchive >> CHNVP(m_vel);
+    marchive >> CHNVP(m_wvel);
+    marchive >> CHNVP(m_radius);
+    marchive >> CHNVP(m_density);
+    marchive >> CHNVP(m_fixed);
+    marchive >> CHNVP(m_contacts);
+    marchive >> CHNVP(m_material);
+    marchive >> CHNVP(m_plane_points);
+    marchive >> CHNVP(m_plane_normals);
+
+    size_t np = m_pos.size();
+    m_acc.assign(np, VNULL);
+    m_wacc.assign(np, VNULL);
+    m_cforce.assign(np, VNULL);
+    m_ctorque.assign(np, VNULL);
+    m_mass.resize(np);
+    SetDensity(m_density);
+}
+
+}  // end namespace chrono
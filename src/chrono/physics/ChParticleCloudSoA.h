@@ -0,0 +1,301 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#ifndef CHPARTICLECLOUDSOA_H
+#define CHPARTICLECLOUDSOA_H
+
+#include <memory>
+#include <vector>
+
+#include "chrono/physics/ChMaterialSurfaceSMC.h"
+#include "chrono/physics/ChPhysicsItem.h"
+#include "chrono/solver/ChVariablesGenericDiagonalMass.h"
+
+namespace chrono {
+
+// Forward references
+class ChBody;
+
+/// Cluster of spherical particles stored as a structure of arrays.
+/// This is a lightweight alternative to ChParticleCloud for very large granular systems: positions, rotations,
+/// velocities, accelerations and radii of all particles are kept in contiguous arrays, and a single ChVariables object
+/// (with 6 DOFs per particle and a diagonal mass matrix) represents the whole cluster in the system descriptor.
+/// No per-particle object is allocated; in particular, particles do not have collision models. Contacts between
+/// particles, between particles and the collision shapes of the bodies of the system, and between particles and a set
+/// of fixed boundary planes, are resolved internally with a penalty (spring-damper) model and a regularized Coulomb
+/// friction. The resulting forces are applied as external forces on the particles, and the opposite forces are
+/// applied to the bodies. The contact coefficients are taken from an SMC contact material (see SetMaterialSurface), so
+/// the cluster can only be used in a system with SMC contact method.
+/// Particle candidate pairs are found with a hashed uniform grid whose cell size is the largest particle diameter.
+/// Body collision shapes are tested against all particles within their bounding sphere; only spheres, boxes and
+/// cylinders are supported, other shapes are ignored.
+class ChApi ChParticleCloudSoA : public ChPhysicsItem {
+  public:
+    ChParticleCloudSoA();
+    ChParticleCloudSoA(const ChParticleCloudSoA& other);
+    ~ChParticleCloudSoA() {}
+
+    /// "Virtual" copy constructor (covariant return type).
+    virtual ChParticleCloudSoA* Clone() const override { return new ChParticleCloudSoA(*this); }
+
+    /// Add a spherical particle with given initial position, radius, and linear velocity.
+    /// Return the index of the new particle.
+    unsigned int AddParticle(const ChVector<>& pos, double radius, const ChVector<>& vel = VNULL);
+
+    /// Remove all particles.
+    void ClearParticles();
+
+    /// Get the number of particles.
+    unsigned int GetNparticles() const { return (unsigned int)m_pos.size(); }
+
+    /// Set the density of the particle material (default: 1000).
+    void SetDensity(double density);
+    double GetDensity() const { return m_density; }
+
+    /// Set the state of all particles in the cluster to 'fixed' (default: false).
+    void SetFixed(bool state) { m_fixed = state; }
+    bool IsFixed() const { return m_fixed; }
+
+    /// Return true if the particle cluster is currently active and therefore included into the system solver.
+    virtual bool IsActive() const override { return !m_fixed; }
+
+    /// Enable/disable the internal contact model (default: true).
+    /// This applies to contacts between particles, with body collision shapes, and with boundary planes.
+    void SetContacts(bool val) { m_contacts = val; }
+    bool GetContacts() const { return m_contacts; }
+
+    /// Set the contact material of the particles (default: a ChMaterialSurfaceSMC with default properties).
+    /// The contact model uses the normal stiffness (kn) and damping (gn), the tangential damping (gt, used to
+    /// regularize the Coulomb friction law), and the friction coefficient of the material, regardless of the contact
+    /// force model of the system. For particle-body contacts, these are combined with the material of the body
+    /// collision shape, using the composition strategy of the system.
+    void SetMaterialSurface(std::shared_ptr<ChMaterialSurfaceSMC> material) { m_material = material; }
+
+    /// Get the contact material of the particles.
+    std::shared_ptr<ChMaterialSurfaceSMC> GetMaterialSurface() const { return m_material; }
+
+    /// Add a fixed boundary plane, given a point on the plane and the normal pointing toward the particles.
+    void AddPlane(const ChVector<>& point, const ChVector<>& normal);
+
+    /// Remove all boundary planes.
+    void ClearPlanes();
+
+    /// Get the number of particle-particle, particle-body, and particle-plane contacts found at the last update.
+    unsigned int GetNumContacts() const { return m_num_contacts; }
+
+    /// Get the number of particle-body contacts found at the last update.
+    unsigned int GetNumBodyContacts() const { return (unsigned int)m_body_contacts.size(); }
+
+    /// Get the total force exerted by the particles on the specified body (absolute frame), as of the last update.
+    ChVector<> GetBodyContactForce(const ChBody* body) const;
+
+    // Per-particle access
+
+    const ChVector<>& GetPos(unsigned int n) const { return m_pos[n]; }
+    const ChQuaternion<>& GetRot(unsigned int n) const { return m_rot[n]; }
+    const ChVector<>& GetPos_dt(unsigned int n) const { return m_vel[n]; }
+    const ChVector<>& GetWvel_loc(unsigned int n) const { return m_wvel[n]; }
+    const ChVector<>& GetPos_dtdt(unsigned int n) const { return m_acc[n]; }
+    const ChVector<>& GetWacc_loc(unsigned int n) const { return m_wacc[n]; }
+    double GetRadius(unsigned int n) const { return m_radius[n]; }
+    double GetMass(unsigned int n) const { return m_mass[n]; }
+
+    void SetPos(unsigned int n, const ChVector<>& pos) { m_pos[n] = pos; }
+    void SetRot(unsigned int n, const ChQuaternion<>& rot) { m_rot[n] = rot; }
+    void SetPos_dt(unsigned int n, const ChVector<>& vel) { m_vel[n] = vel; }
+    void SetWvel_loc(unsigned int n, const ChVector<>& wvel) { m_wvel[n] = wvel; }
+
+    /// Get the contact force acting on the specified particle (absolute frame), as of the last update.
+    const ChVector<>& GetContactForce(unsigned int n) const { return m_cforce[n]; }
+    /// Get the contact torque acting on the specified particle (particle local frame), as of the last update.
+    const ChVector<>& GetContactTorque(unsigned int n) const { return m_ctorque[n]; }
+
+    // Contiguous array access
+
+    const std::vector<ChVector<>>& GetPositions() const { return m_pos; }
+    const std::vector<ChQuaternion<>>& GetRotations() const { return m_rot; }
+    const std::vector<ChVector<>>& GetVelocities() const { return m_vel; }
+    const std::vector<ChVector<>>& GetAngularVelocities() const { return m_wvel; }
+    const std::vector<double>& GetRadii() const { return m_radius; }
+
+    /// Return the frame of the specified particle. The visual model of the cluster is instanced once per particle.
+    virtual ChFrame<> GetVisualModelFrame(unsigned int nclone = 0) override {
+        return ChFrame<>(m_pos[nclone], m_rot[nclone]);
+    }
+
+    /// Return the number of clones of the visual model (one per particle).
+    virtual unsigned int GetNumVisualModelClones() const override { return GetNparticles(); }
+
+    /// Get the entire AABB for the particle cluster.
+    virtual void GetTotalAABB(ChVector<>& bbmin, ChVector<>& bbmax) override;
+
+    /// Number of coordinates of the particle cluster, 7 per particle (position and quaternion).
+    virtual int GetDOF() override { return 7 * GetNparticles(); }
+
+    /// Number of coordinates of the particle cluster, 6 per particle (linear and angular velocity).
+    virtual int GetDOF_w() override { return 6 * GetNparticles(); }
+
+    // STATE FUNCTIONS
+
+    // (override/implement interfaces for global state vectors, see ChPhysicsItem for comments.)
+    virtual void IntStateGather(const unsigned int off_x,
+                                ChState& x,
+                                const unsigned int off_v,
+                                ChStateDelta& v,
+                                double& T) override;
+    virtual void IntStateScatter(const unsigned int off_x,
+                                 const ChState& x,
+                                 const unsigned int off_v,
+                                 const ChStateDelta& v,
+                                 const double T,
+                                 bool full_update) override;
+    virtual void IntStateGatherAcceleration(const unsigned int off_a, ChStateDelta& a) override;
+    virtual void IntStateScatterAcceleration(const unsigned int off_a, const ChStateDelta& a) override;
+    virtual void IntStateIncrement(const unsigned int off_x,
+                                   ChState& x_new,
+                                   const ChState& x,
+                                   const unsigned int off_v,
+                                   const ChStateDelta& Dv) override;
+    virtual void IntStateGetIncrement(const unsigned int off_x,
+                                      const ChState& x_new,
+                                      const ChState& x,
+                                      const unsigned int off_v,
+                                      ChStateDelta& Dv) override;
+    virtual void IntLoadResidual_F(const unsigned int off, ChVectorDynamic<>& R, const double c) override;
+    virtual void IntLoadResidual_Mv(const unsigned int off,
+                                    ChVectorDynamic<>& R,
+                                    const ChVectorDynamic<>& w,
+                                    const double c) override;
+    virtual void IntToDescriptor(const unsigned int off_v,
+                                 const ChStateDelta& v,
+                                 const ChVectorDynamic<>& R,
+                                 const unsigned int off_L,
+                                 const ChVectorDynamic<>& L,
+                                 const ChVectorDynamic<>& Qc) override;
+    virtual void IntFromDescriptor(const unsigned int off_v,
+                                   ChStateDelta& v,
+                                   const unsigned int off_L,
+                                   ChVectorDynamic<>& L) override;
+
+    // SOLVER FUNCTIONS
+
+    // Override/implement solver system functions of ChPhysicsItem
+    // (to assemble/manage data for system solver)
+
+    virtual void VariablesFbReset() override;
+    virtual void VariablesFbLoadForces(double factor = 1) override;
+    virtual void VariablesQbLoadSpeed() override;
+    virtual void VariablesFbIncrementMq() override;
+    virtual void VariablesQbSetSpeed(double step = 0) override;
+    virtual void VariablesQbIncrementPosition(double step) override;
+    virtual void InjectVariables(ChSystemDescriptor& mdescriptor) override;
+
+    /// Set no speed and no accelerations for all particles.
+    virtual void SetNoSpeedNoAcceleration() override;
+
+    /// Set the system which the particle cluster belongs to.
+    /// Throw a ChException if the system does not use the SMC contact method.
+    virtual void SetSystem(ChSystem* m_system) override;
+
+    /// Resize the solver variables and update the particle masses, if needed.
+    virtual void Setup() override;
+
+    /// Update the contact forces acting on the particles.
+    virtual void Update(double mytime, bool update_assets = true) override;
+
+    /// Update the contact forces acting on the particles.
+    virtual void Update(bool update_assets = true) override;
+
+    // SERIALIZATION
+
+    /// Method to allow serialization of transient data to archives.
+    virtual void ArchiveOut(ChArchiveOut& marchive) override;
+
+    /// Method to allow deserialization of transient data from archives.
+    virtual void ArchiveIn(ChArchiveIn& marchive) override;
+
+  private:
+    /// Collision shape of a body, as tested against the particles.
+    struct BodyShape {
+        unsigned int body;                ///< index of the body in m_contact_bodies
+        int type;                         ///< shape type (see ChCollisionShape::Type)
+        ChFrame<> frame;                  ///< shape frame (absolute)
+        ChVector<> dims;                  ///< sphere radius, box half-dimensions, or cylinder radius and half-length
+        ChVector<> center;                ///< center of the bounding sphere (absolute)
+        double radius;                    ///< radius of the bounding sphere
+        ChMaterialCompositeSMC material;  ///< composite of the particle material and the shape material
+    };
+
+    /// Contact between a particle and a body.
+    struct BodyContact {
+        unsigned int body;  ///< index of the body in m_contact_bodies
+        ChVector<> point;   ///< contact point on the particle surface (absolute)
+        ChVector<> force;   ///< force applied to the body (absolute)
+    };
+
+    /// Sort the particles in the cells of the hashed grid.
+    void UpdateGrid();
+
+    /// Collect the supported collision shapes of the system bodies near the particles.
+    void UpdateBodyShapes();
+
+    /// Accumulate the particle forces on each body.
+    void ComputeBodyForces();
+
+    /// Compute the contact force and torque on all particles.
+    void ComputeContactForces();
+
+    /// Return the grid bucket of the cell with given integer coordinates.
+    size_t CellBucket(long long ix, long long iy, long long iz) const;
+
+    std::vector<ChVector<>> m_pos;       ///< particle positions
+    std::vector<ChQuaternion<>> m_rot;   ///< particle rotations
+    std::vector<ChVector<>> m_vel;       ///< particle linear velocities (absolute frame)
+    std::vector<ChVector<>> m_wvel;      ///< particle angular velocities (local frame)
+    std::vector<ChVector<>> m_acc;       ///< particle linear accelerations (absolute frame)
+    std::vector<ChVector<>> m_wacc;      ///< particle angular accelerations (local frame)
+    std::vector<double> m_radius;        ///< particle radii
+    std::vector<double> m_mass;          ///< particle masses
+    std::vector<ChVector<>> m_cforce;    ///< contact forces (absolute frame)
+    std::vector<ChVector<>> m_ctorque;   ///< contact torques (local frame)
+
+    std::unique_ptr<ChVariablesGenericDiagonalMass> m_variables;  ///< solver variables of all particles
+    bool m_mass_dirty;                                           ///< particle masses must be recomputed
+
+    double m_density;  ///< particle material density
+    bool m_fixed;      ///< are all particles fixed?
+
+    bool m_contacts;                                   ///< is the internal contact model enabled?
+    std::shared_ptr<ChMaterialSurfaceSMC> m_material;  ///< contact material of the particles
+    std::vector<ChVector<>> m_plane_points;   ///< points on the boundary planes
+    std::vector<ChVector<>> m_plane_normals;  ///< unit normals of the boundary planes
+    unsigned int m_num_contacts;              ///< number of contacts at last update
+
+    std::vector<ChBody*> m_contact_bodies;                    ///< bodies with shapes near the particles
+    std::vector<BodyShape> m_body_shapes;                     ///< shapes of these bodies near the particles
+    std::vector<std::vector<BodyContact>> m_thread_contacts;  ///< particle-body contacts found by each thread
+    std::vector<BodyContact> m_body_contacts;                 ///< particle-body contacts at last update
+    std::vector<ChVector<>> m_body_force;                     ///< force on each body (absolute frame)
+    std::vector<ChVector<>> m_body_torque;                    ///< torque on each body (body local frame)
+
+    double m_cell_size;                  ///< grid cell size
+    size_t m_bucket_mask;                ///< number of grid buckets minus one (power of 2)
+    std::vector<unsigned int> m_start;   ///< start of each bucket in the sorted particle list (plus end marker)
+    std::vector<unsigned int> m_sorted;  ///< particle indices sorted by bucket
+    std::vector<size_t> m_bucket;        ///< bucket of each particle
+};
+
+CH_CLASS_VERSION(ChParticleCloudSoA, 0)
+
+}  // end namespace chrono
+
+#endif
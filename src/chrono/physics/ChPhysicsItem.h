@@ -27,6 +27,7 @@ namespace chrono {
 
 // Forward references
 class ChSystem;
+class ChSnapshotBuffer;
 namespace modal {
 class ChModalAssembly;
 }
@@ -420,6 +421,16 @@ class ChApi ChPhysicsItem : public ChObj {
     /// NOTE: signs are flipped respect to the ChTimestepper dF/dx terms:  K = -dF/dq, R = -dF/dv
     virtual void KRMmatricesLoad(double Kfactor, double Rfactor, double Mfactor) {}
 
+    // SNAPSHOTS
+
+    /// Append to the buffer the internal data of this item which is not part of the state vectors.
+    /// Used by ChSystemSnapshot; the default implementation does nothing.
+    virtual void SnapshotOut(ChSnapshotBuffer& buffer) {}
+
+    /// Restore the internal data stored by SnapshotOut().
+    /// Used by ChSystemSnapshot; the default implementation does nothing.
+    virtual void SnapshotIn(ChSnapshotBuffer& buffer) {}
+
     // SERIALIZATION
 
     /// Method to allow serialization of transient data to archives.
@@ -12,8 +12,6 @@
 // Authors: Alessandro Tasora, Radu Serban
 // =============================================================================
 
-#include <list>
-
 #include "chrono/physics/ChBody.h"
 #include "chrono/physics/ChMatterSPH.h"
 #include "chrono/physics/ChProximityContainerSPH.h"
@@ -27,56 +25,28 @@ using namespace geometry;
 // Register into the object factory, to enable run-time dynamic creation and persistence
 CH_FACTORY_REGISTER(ChProximityContainerSPH)
 
-ChProximityContainerSPH::ChProximityContainerSPH() : n_added(0) {
-    lastproximity = proximitylist.begin();
-}
+ChProximityContainerSPH::ChProximityContainerSPH() : n_added(0) {}
 
 ChProximityContainerSPH::ChProximityContainerSPH(const ChProximityContainerSPH& other)
     : ChProximityContainer(other) {
     n_added = other.n_added;
     proximitylist = other.proximitylist;
-    lastproximity = proximitylist.begin();
 }
 
-ChProximityContainerSPH::~ChProximityContainerSPH() {
-    std::list<ChProximitySPH*>::iterator iterproximity = proximitylist.begin();
-    while (iterproximity != proximitylist.end()) {
-        delete (*iterproximity);
-        (*iterproximity) = 0;
-        ++iterproximity;
-        // proximitylist.erase(iterproximity); //no! do later with clear(), all together
-    }
-    proximitylist.clear();
-
-    lastproximity = proximitylist.begin();
-    n_added = 0;
-}
+ChProximityContainerSPH::~ChProximityContainerSPH() {}
 
 void ChProximityContainerSPH::RemoveAllProximities() {
-    std::list<ChProximitySPH*>::iterator iterproximity = proximitylist.begin();
-    while (iterproximity != proximitylist.end()) {
-        delete (*iterproximity);
-        (*iterproximity) = 0;
-        ++iterproximity;
-        // proximitylist.erase(iterproximity); //no! do later with clear(), all together
-    }
     proximitylist.clear();
-
-    lastproximity = proximitylist.begin();
     n_added = 0;
 }
 
 void ChProximityContainerSPH::BeginAddProximities() {
-    lastproximity = proximitylist.begin();
     n_added = 0;
 }
 
 void ChProximityContainerSPH::EndAddProximities() {
     // remove proximities that are beyond last proximity
-    while (lastproximity != proximitylist.end()) {
-        delete (*lastproximity);
-        lastproximity = proximitylist.erase(lastproximity);
-    }
+    proximitylist.erase(proximitylist.begin() + n_added, proximitylist.end());
 }
 
 void ChProximityContainerSPH::AddProximity(collision::ChCollisionModel* modA, collision::ChCollisionModel* modB) {
@@ -96,28 +66,21 @@ void ChProximityContainerSPH::AddProximity(collision::ChCollisionModel* modA, co
 
     // %%%%%%% Create and add a ChProximitySPH object
 
-    if (lastproximity != proximitylist.end()) {
+    if (n_added < (int)proximitylist.size()) {
         // reuse old proximity pairs
-        (*lastproximity)->Reset(modA, modB);
-
-        lastproximity++;
+        proximitylist[n_added].Reset(modA, modB);
     } else {
         // add new proximity
-        ChProximitySPH* mp = new ChProximitySPH(modA, modB);
-
-        proximitylist.push_back(mp);
-        lastproximity = proximitylist.end();
+        proximitylist.push_back(ChProximitySPH(modA, modB));
     }
     n_added++;
 }
 
 void ChProximityContainerSPH::ReportAllProximities(ReportProximityCallback* mcallback) {
-    std::list<ChProximitySPH*>::iterator iterproximity = proximitylist.begin();
-    while (iterproximity != proximitylist.end()) {
-        bool proceed = mcallback->OnReportProximity((*iterproximity)->GetModelA(), (*iterproximity)->GetModelB());
+    for (int ip = 0; ip < n_added; ip++) {
+        bool proceed = mcallback->OnReportProximity(proximitylist[ip].GetModelA(), proximitylist[ip].GetModelB());
         if (!proceed)
             break;
-        ++iterproximity;
     }
 }
 
@@ -147,10 +110,10 @@ static void W_gr_press(ChVector<>& Wresult, const ChVector<>& r, const double r_
 
 void ChProximityContainerSPH::AccumulateStep1() {
     // Per-edge data computation
-    std::list<ChProximitySPH*>::iterator iterproximity = proximitylist.begin();
-    while (iterproximity != proximitylist.end()) {
-        ChNodeSPH* mnodeA = dynamic_cast<ChNodeSPH*>((*iterproximity)->GetModelA()->GetContactable());
-        ChNodeSPH* mnodeB = dynamic_cast<ChNodeSPH*>((*iterproximity)->GetModelB()->GetContactable());
+    for (int ip = 0; ip < n_added; ip++) {
+        // AddProximity only accepts pairs of SPH nodes
+        ChNodeSPH* mnodeA = static_cast<ChNodeSPH*>(proximitylist[ip].GetModelA()->GetContactable());
+        ChNodeSPH* mnodeB = static_cast<ChNodeSPH*>(proximitylist[ip].GetModelB()->GetContactable());
 
         ChVector<> x_A = mnodeA->GetPos();
         ChVector<> x_B = mnodeB->GetPos();
@@ -164,17 +127,15 @@ void ChProximityContainerSPH::AccumulateStep1() {
 
         mnodeA->density += mnodeB->GetMass() * W_k_poly6;
         mnodeB->density += mnodeA->GetMass() * W_k_poly6;
-
-        ++iterproximity;
     }
 }
 
 void ChProximityContainerSPH::AccumulateStep2() {
     // Per-edge data computation (transfer stress to forces)
-    std::list<ChProximitySPH*>::iterator iterproximity = proximitylist.begin();
-    while (iterproximity != proximitylist.end()) {
-        ChNodeSPH* mnodeA = dynamic_cast<ChNodeSPH*>((*iterproximity)->GetModelA()->GetContactable());
-        ChNodeSPH* mnodeB = dynamic_cast<ChNodeSPH*>((*iterproximity)->GetModelB()->GetContactable());
+    for (int ip = 0; ip < n_added; ip++) {
+        // AddProximity only accepts pairs of SPH nodes
+        ChNodeSPH* mnodeA = static_cast<ChNodeSPH*>(proximitylist[ip].GetModelA()->GetContactable());
+        ChNodeSPH* mnodeB = static_cast<ChNodeSPH*>(proximitylist[ip].GetModelB()->GetContactable());
 
         ChVector<> x_A = mnodeA->GetPos();
         ChVector<> x_B = mnodeB->GetPos();
@@ -206,8 +167,6 @@ void ChProximityContainerSPH::AccumulateStep2() {
         ChVector<> viscforceBA = velBA * (mnodeA->volume * avg_viscosity * mnodeB->volume * W_k_visc);
         mnodeA->UserForce += viscforceBA;
         mnodeB->UserForce -= viscforceBA;
-
-        ++iterproximity;
     }
 }
 
@@ -15,7 +15,7 @@
 #ifndef CHPROXIMITYCONTAINERSPH_H
 #define CHPROXIMITYCONTAINERSPH_H
 
-#include <list>
+#include <vector>
 
 #include "chrono/physics/ChProximityContainer.h"
 
@@ -58,13 +58,14 @@ class ChApi ChProximitySPH {
 
 /// Class for container of many proximity pairs for SPH (Smooth
 /// Particle Hydrodynamics and similar meshless force computations),
-/// as CPU typical linked list of ChProximitySPH objects.
+/// as a contiguous array of ChProximitySPH objects.
+/// Note that a ChMatterSPH uses the pairs of this container only if its internal
+/// neighbor search is disabled (see ChMatterSPH::SetNeighborSearch()).
 
 class ChApi ChProximityContainerSPH : public ChProximityContainer {
 
   protected:
-    std::list<ChProximitySPH*> proximitylist;
-    std::list<ChProximitySPH*>::iterator lastproximity;
+    std::vector<ChProximitySPH> proximitylist;  ///< proximity pairs (the first n_added are in use)
     int n_added;
 
   public:
@@ -83,9 +84,8 @@ class ChApi ChProximityContainerSPH : public ChProximityContainer {
 
     /// The collision system will call BeginAddProximities() before adding
     /// all pairs (for example with AddProximity() or similar). Instead of
-    /// simply deleting all list of the previous pairs, this optimized implementation
-    /// rewinds the link iterator to begin and tries to reuse previous pairs objects
-    /// until possible, to avoid too much allocation/deallocation.
+    /// simply deleting all the previous pairs, this optimized implementation
+    /// rewinds the pair counter and reuses the storage of the previous pairs.
     virtual void BeginAddProximities() override;
 
     /// Add a proximity SPH data between two collision models, if possible.
@@ -93,9 +93,9 @@ class ChApi ChProximityContainerSPH : public ChProximityContainer {
                               collision::ChCollisionModel* modB   ///< get contact model 2
                               ) override;
 
-    /// The collision system will call BeginAddContact() after adding
-    /// all contacts (for example with AddContact() or similar). This optimized version
-    /// purges the end of the list of contacts that were not reused (if any).
+    /// The collision system will call EndAddProximities() after adding
+    /// all pairs (for example with AddProximity() or similar). This optimized version
+    /// purges the end of the array of pairs that were not reused (if any).
     virtual void EndAddProximities() override;
 
     /// Scans all the proximity pairs and, for each pair, executes the OnReportProximity()
@@ -13,6 +13,7 @@
 // =============================================================================
 
 #include "chrono/physics/ChShaftsMotorAngle.h"
+#include "chrono/physics/ChSystemSnapshot.h"
 
 namespace chrono {
 
@@ -152,6 +153,16 @@ void ChShaftsMotorAngle::ConstraintsFetch_react(double factor) {
 
 //////// FILE I/O
 
+void ChShaftsMotorAngle::SnapshotOut(ChSnapshotBuffer& buffer) {
+    ChShaftsMotorBase::SnapshotOut(buffer);
+    buffer.WriteObject(f_rot);
+}
+
+void ChShaftsMotorAngle::SnapshotIn(ChSnapshotBuffer& buffer) {
+    ChShaftsMotorBase::SnapshotIn(buffer);
+    buffer.ReadObject(f_rot);
+}
+
 void ChShaftsMotorAngle::ArchiveOut(ChArchiveOut& marchive) {
     // version number
     marchive.VersionWrite<ChShaftsMotorAngle>();
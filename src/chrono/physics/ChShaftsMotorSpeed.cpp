@@ -13,6 +13,7 @@
 // =============================================================================
 
 #include "chrono/physics/ChShaftsMotorSpeed.h"
+#include "chrono/physics/ChSystemSnapshot.h"
 
 namespace chrono {
 
@@ -274,6 +275,16 @@ void ChShaftsMotorSpeed::ConstraintsFetch_react(double factor) {
 
 //////// FILE I/O
 
+void ChShaftsMotorSpeed::SnapshotOut(ChSnapshotBuffer& buffer) {
+    ChShaftsMotorBase::SnapshotOut(buffer);
+    buffer.WriteObject(f_speed);
+}
+
+void ChShaftsMotorSpeed::SnapshotIn(ChSnapshotBuffer& buffer) {
+    ChShaftsMotorBase::SnapshotIn(buffer);
+    buffer.ReadObject(f_speed);
+}
+
 void ChShaftsMotorSpeed::ArchiveOut(ChArchiveOut& marchive) {
     // version number
     marchive.VersionWrite<ChShaftsMotorSpeed>();
@@ -173,6 +173,12 @@ class ChApi ChShaftsMotorSpeed : public ChShaftsMotorBase {
     // SERIALIZATION
     //
 
+    /// Append to the buffer the internal data of the motor function.
+    virtual void SnapshotOut(ChSnapshotBuffer& buffer) override;
+
+    /// Restore the internal data stored by SnapshotOut().
+    virtual void SnapshotIn(ChSnapshotBuffer& buffer) override;
+
     /// Method to allow serialization of transient data to archives.
     virtual void ArchiveOut(ChArchiveOut& marchive) override;
 
@@ -13,6 +13,7 @@
 // =============================================================================
 
 #include "chrono/physics/ChShaftsMotorTorque.h"
+#include "chrono/physics/ChSystemSnapshot.h"
 
 namespace chrono {
 
@@ -64,6 +65,16 @@ void ChShaftsMotorTorque::VariablesFbLoadForces(double factor) {
 
 //////// FILE I/O
 
+void ChShaftsMotorTorque::SnapshotOut(ChSnapshotBuffer& buffer) {
+    ChShaftsMotorBase::SnapshotOut(buffer);
+    buffer.WriteObject(f_torque);
+}
+
+void ChShaftsMotorTorque::SnapshotIn(ChSnapshotBuffer& buffer) {
+    ChShaftsMotorBase::SnapshotIn(buffer);
+    buffer.ReadObject(f_torque);
+}
+
 void ChShaftsMotorTorque::ArchiveOut(ChArchiveOut& marchive) {
     // version number
     marchive.VersionWrite<ChShaftsMotorTorque>();
@@ -13,6 +13,7 @@
 // =============================================================================
 
 #include <algorithm>
+#include <limits>
 
 #include "chrono/collision/ChCollisionSystemBullet.h"
 #ifdef CHRONO_COLLISION
@@ -60,6 +61,9 @@ ChSystem::ChSystem()
       tol_force(-1),
       maxiter(6),
       use_sleeping(false),
+      sleep_energy(std::numeric_limits<double>::infinity()),
+      wake_energy(0),
+      sleep_island_count(0),
       min_bounce_speed(0.15),
       max_penetration_recovery_speed(0.6),
       stepcount(0),
@@ -72,6 +76,11 @@ ChSystem::ChSystem()
       nthreads_chrono(ChOMP::GetNumProcs()),
       nthreads_eigen(1),
       nthreads_collision(1),
+      deterministic_ordering(true),
+      incremental_injection(true),
+      injected_descriptor(nullptr),
+      injected_topology(0),
+      injected_nvariables(0),
       last_err(false),
       applied_forces_current(false) {
     assembly.system = this;
@@ -112,6 +121,11 @@ ChSystem::ChSystem(const ChSystem& other) {
     nthreads_chrono = other.nthreads_chrono;
     nthreads_eigen = other.nthreads_eigen;
     nthreads_collision = other.nthreads_collision;
+    deterministic_ordering = other.deterministic_ordering;
+    incremental_injection = other.incremental_injection;
+    injected_descriptor = nullptr;
+    injected_topology = 0;
+    injected_nvariables = 0;
     is_initialized = false;
     is_updated = false;
     applied_forces_current = false;
@@ -127,6 +141,9 @@ ChSystem::ChSystem(const ChSystem& other) {
     max_penetration_recovery_speed = other.max_penetration_recovery_speed;
     SetSolverType(other.GetSolverType());
     use_sleeping = other.use_sleeping;
+    sleep_energy = other.sleep_energy;
+    wake_energy = other.wake_energy;
+    sleep_island_count = 0;
 
     ncontacts = other.ncontacts;
 
@@ -482,136 +499,192 @@ void ChSystem::SetTimestepperType(ChTimestepper::Type type) {
     }
 }
 
+void ChSystem::SetSleepingThresholds(double sleep_energy_threshold, double wake_energy_threshold) {
+    sleep_energy = sleep_energy_threshold;
+    wake_energy = wake_energy_threshold;
+}
+
 bool ChSystem::ManageSleepingBodies() {
     if (!GetUseSleeping())
-        return 0;
+        return false;
 
-    // STEP 1:
-    // See if some body could change from no sleep to sleep
+    auto& bodylist = assembly.bodylist;
+    int nbodies = (int)bodylist.size();
 
-    for (auto& body : assembly.bodylist) {
-        // mark as 'could sleep' candidate
-        body->TrySleeping();
+    // STEP 1:
+    // Refresh the body indices if bodies were added or removed (sleeping islands are carried over).
+
+    bool changed_list = (int)sleep_bodies.size() != nbodies;
+    for (int i = 0; i < nbodies && !changed_list; i++)
+        changed_list = sleep_bodies[i] != bodylist[i].get();
+
+    if (changed_list) {
+        std::vector<int> islands(nbodies, -1);
+        for (int i = 0; i < nbodies; i++) {
+            auto old = sleep_indices.find(bodylist[i].get());
+            if (old != sleep_indices.end() && bodylist[i]->GetSleeping())
+                islands[i] = sleep_islands[old->second];
+        }
+        sleep_islands.swap(islands);
+        sleep_bodies.resize(nbodies);
+        sleep_indices.clear();
+        for (int i = 0; i < nbodies; i++) {
+            sleep_bodies[i] = bodylist[i].get();
+            sleep_indices[bodylist[i].get()] = i;
+        }
     }
 
     // STEP 2:
-    // See if some sleeping or potential sleeping body is touching a non sleeping one; if so, set to no sleep.
+    // See which bodies could change from no sleep to sleep and evaluate the kinetic energy of awake bodies.
+
+    std::vector<int> parent(nbodies);
+    std::vector<double> energy(nbodies, 0.0);
+    std::vector<double> mass(nbodies, 0.0);
+    for (int i = 0; i < nbodies; i++) {
+        parent[i] = i;
+        ChBody* body = sleep_bodies[i];
+        body->TrySleeping();
+        if (body->IsActive()) {
+            ChVector<> wvel = body->GetWvel_loc();
+            energy[i] = 0.5 * body->GetMass() * body->GetPos_dt().Length2() +
+                        0.5 * wvel.Dot(body->GetInertia() * wvel);
+            mass[i] = body->GetMass();
+        }
+    }
 
-    // Make this class for iterating through contacts
-    class _wakeup_reporter_class : public ChContactContainer::ReportContactCallback {
-      public:
-        // Callback, used to report contact points already added to the container.
-        // If returns false, the contact scanning will be stopped.
-        virtual bool OnReportContact(
-            const ChVector<>& pA,             // get contact pA
-            const ChVector<>& pB,             // get contact pB
-            const ChMatrix33<>& plane_coord,  // get contact plane coordsystem (A column 'X' is contact normal)
-            const double& distance,           // get contact distance
-            const double& eff_radius,         // effective radius of curvature at contact
-            const ChVector<>& react_forces,   // get react.forces (if already computed). In coordsystem 'plane_coord'
-            const ChVector<>& react_torques,  // get react.torques, if rolling friction (if already computed).
-            ChContactable* contactobjA,  // get model A (note: some containers may not support it and could be zero!)
-            ChContactable* contactobjB   // get model B (note: some containers may not support it and could be zero!)
-            ) override {
-            if (!(contactobjA && contactobjB))
-                return true;
-            ChBody* b1 = dynamic_cast<ChBody*>(contactobjA);
-            ChBody* b2 = dynamic_cast<ChBody*>(contactobjB);
-            if (!(b1 && b2))
-                return true;
-            bool sleep1 = b1->GetSleeping();
-            bool sleep2 = b2->GetSleeping();
-            bool could_sleep1 = b1->BFlagGet(ChBody::BodyFlag::COULDSLEEP);
-            bool could_sleep2 = b2->BFlagGet(ChBody::BodyFlag::COULDSLEEP);
-            bool ground1 = b1->GetBodyFixed();
-            bool ground2 = b2->GetBodyFixed();
-            if (sleep1 && !(sleep2 || could_sleep2) && !ground2) {
-                b1->SetSleeping(false);
-                need_Setup_A = true;
-            }
-            if (sleep2 && !(sleep1 || could_sleep1) && !ground1) {
-                b2->SetSleeping(false);
-                need_Setup_A = true;
-            }
-            if (could_sleep1 && !(sleep2 || could_sleep2) && !ground2) {
-                b1->BFlagSet(ChBody::BodyFlag::COULDSLEEP, false);
-            }
-            if (could_sleep2 && !(sleep1 || could_sleep1) && !ground1) {
-                b2->BFlagSet(ChBody::BodyFlag::COULDSLEEP, false);
-            }
-            someone_sleeps = someone_sleeps ||sleep1 || sleep2;
+    // STEP 3:
+    // Partition the bodies in islands connected through links and contacts (fixed bodies do not connect islands).
 
-            return true;  // to continue scanning contacts
+    auto find = [&parent](int i) {
+        while (parent[i] != i) {
+            parent[i] = parent[parent[i]];
+            i = parent[i];
         }
-
-        // Data
-        bool someone_sleeps;
-        bool need_Setup_A;
+        return i;
+    };
+    auto join = [&](ChPhysicsItem* itemA, ChPhysicsItem* itemB) {
+        auto a = sleep_indices.find(itemA);
+        auto b = sleep_indices.find(itemB);
+        if (a == sleep_indices.end() || b == sleep_indices.end())
+            return;
+        if (sleep_bodies[a->second]->GetBodyFixed() || sleep_bodies[b->second]->GetBodyFixed())
+            return;
+        int ra = find(a->second);
+        int rb = find(b->second);
+        if (ra != rb)
+            parent[rb] = ra;
     };
 
-    auto my_waker = chrono_types::make_shared<_wakeup_reporter_class>();
-    my_waker->need_Setup_A = false;
+    // bodies that went to sleep together stay in the same island
+    std::unordered_map<int, int> island_roots;
+    for (int i = 0; i < nbodies; i++) {
+        if (sleep_islands[i] < 0)
+            continue;
+        auto root = island_roots.insert(std::make_pair(sleep_islands[i], i)).first;
+        join(sleep_bodies[root->second], sleep_bodies[i]);
+    }
 
-    bool need_Setup_L = false;
+    // links
+    for (auto& link : assembly.linklist) {
+        if (!link->IsActive() || !link->IsRequiringWaking())
+            continue;
+        if (auto Lpointer = std::dynamic_pointer_cast<ChLink>(link)) {
+            ChBody* b1 = dynamic_cast<ChBody*>(Lpointer->GetBody1());
+            ChBody* b2 = dynamic_cast<ChBody*>(Lpointer->GetBody2());
+            if (b1 && b2)
+                join(b1, b2);
+        }
+    }
 
-    for (int i = 0; i < 1; i++)  //***TO DO*** reconfigurable number of wakeup cycles
-    {
-        my_waker->someone_sleeps = false;
-
-        // scan all links and wake connected bodies
-        for (auto& link : assembly.linklist) {
-            if (auto Lpointer = std::dynamic_pointer_cast<ChLink>(link)) {
-                if (Lpointer->IsRequiringWaking()) {
-                    ChBody* b1 = dynamic_cast<ChBody*>(Lpointer->GetBody1());
-                    ChBody* b2 = dynamic_cast<ChBody*>(Lpointer->GetBody2());
-                    if (b1 && b2) {
-                        bool sleep1 = b1->GetSleeping();
-                        bool sleep2 = b2->GetSleeping();
-                        bool could_sleep1 = b1->BFlagGet(ChBody::BodyFlag::COULDSLEEP);
-                        bool could_sleep2 = b2->BFlagGet(ChBody::BodyFlag::COULDSLEEP);
-                        if (sleep1 && !(sleep2 || could_sleep2)) {
-                            b1->SetSleeping(false);
-                            need_Setup_L = true;
-                        }
-                        if (sleep2 && !(sleep1 || could_sleep1)) {
-                            b2->SetSleeping(false);
-                            need_Setup_L = true;
-                        }
-                        if (could_sleep1 && !(sleep2 || could_sleep2)) {
-                            b1->BFlagSet(ChBody::BodyFlag::COULDSLEEP, false);
-                        }
-                        if (could_sleep2 && !(sleep1 || could_sleep1)) {
-                            b2->BFlagSet(ChBody::BodyFlag::COULDSLEEP, false);
-                        }
-                    }
-                }
-            }
+    // contacts
+    class _island_reporter_class : public ChContactContainer::ReportContactCallback {
+      public:
+        _island_reporter_class(std::function<void(ChPhysicsItem*, ChPhysicsItem*)> join) : m_join(join) {}
+
+        virtual bool OnReportContact(const ChVector<>& pA,
+                                     const ChVector<>& pB,
+                                     const ChMatrix33<>& plane_coord,
+                                     const double& distance,
+                                     const double& eff_radius,
+                                     const ChVector<>& react_forces,
+                                     const ChVector<>& react_torques,
+                                     ChContactable* contactobjA,
+                                     ChContactable* contactobjB) override {
+            if (contactobjA && contactobjB)
+                m_join(contactobjA->GetPhysicsItem(), contactobjB->GetPhysicsItem());
+            return true;  // to continue scanning contacts
         }
 
-        // scan all contacts and wake neighboring bodies
-        contact_container->ReportAllContacts(my_waker);
+        std::function<void(ChPhysicsItem*, ChPhysicsItem*)> m_join;
+    };
 
-        // bailout wakeup cycle prematurely, if all bodies are not sleeping
-        if (!my_waker->someone_sleeps)
-            break;
+    contact_container->ReportAllContacts(chrono_types::make_shared<_island_reporter_class>(join));
+
+    // STEP 4:
+    // Collect the state of each island. An island wakes up if it contains an awake body that cannot sleep and whose
+    // kinetic energy is above the wake threshold. An island goes to sleep if all its awake bodies could sleep and its
+    // kinetic energy is below the sleep threshold.
+
+    std::vector<char> has_awake(nbodies, false);
+    std::vector<char> has_restless(nbodies, false);
+    std::vector<char> has_waking(nbodies, false);
+    std::vector<double> island_energy(nbodies, 0.0);
+    std::vector<double> island_mass(nbodies, 0.0);
+    for (int i = 0; i < nbodies; i++) {
+        ChBody* body = sleep_bodies[i];
+        if (!body->IsActive())
+            continue;
+        int r = find(i);
+        has_awake[r] = true;
+        island_energy[r] += energy[i];
+        island_mass[r] += mass[i];
+        if (!body->BFlagGet(ChBody::BodyFlag::COULDSLEEP)) {
+            has_restless[r] = true;
+            if (energy[i] > wake_energy * mass[i])
+                has_waking[r] = true;
+        }
     }
 
-    /// If some body still must change from no sleep-> sleep, do it
-    int need_Setup_B = 0;
-    for (auto& body : assembly.bodylist) {
-        if (body->BFlagGet(ChBody::BodyFlag::COULDSLEEP)) {
-            body->SetSleeping(true);
-            ++need_Setup_B;
+    // STEP 5:
+    // Change the sleeping state of whole islands, as needed.
+    // The thresholds are on kinetic energy per unit mass. An island with zero total mass (e.g., made only of massless
+    // bodies) has no kinetic energy and is always eligible for sleeping.
+
+    auto below_sleep_threshold = [this](double island_energy, double island_mass) {
+        if (island_mass <= 0)
+            return true;
+        return island_energy < sleep_energy * island_mass;
+    };
+
+    bool changed = false;
+    std::unordered_map<int, int> new_islands;
+    for (int i = 0; i < nbodies; i++) {
+        ChBody* body = sleep_bodies[i];
+        if (body->GetBodyFixed())
+            continue;
+        int r = find(i);
+        if (has_waking[r]) {
+            if (body->GetSleeping()) {
+                body->SetSleeping(false);
+                body->sleep_starttime = float(ch_time);
+                changed = true;
+            }
+            sleep_islands[i] = -1;
+        } else if (has_awake[r] && !has_restless[r] && below_sleep_threshold(island_energy[r], island_mass[r])) {
+            if (!body->GetSleeping()) {
+                body->SetSleeping(true);
+                changed = true;
+            }
+            auto tag = new_islands.insert(std::make_pair(r, sleep_island_count));
+            if (tag.second)
+                sleep_island_count++;
+            sleep_islands[i] = tag.first->second;
+        } else if (!body->GetSleeping()) {
+            sleep_islands[i] = -1;
         }
     }
 
-    // if some body has been activated/deactivated because of sleep state changes,
-    // the offsets and DOF counts must be updated:
-    if (my_waker->need_Setup_A || need_Setup_B || need_Setup_L) {
-        Setup();
-        return true;
-    }
-    return false;
+    return changed;
 }
 
 // -----------------------------------------------------------------------------
@@ -619,11 +692,77 @@ bool ChSystem::ManageSleepingBodies() {
 // -----------------------------------------------------------------------------
 
 void ChSystem::DescriptorPrepareInject(ChSystemDescriptor& mdescriptor) {
+    // Variables of bodies, shafts, links, and meshes are injected first and only change with the assembly topology,
+    // so they can be kept from the previous injection. Constraints (whose activation may change from step to step
+    // also in links), Kblocks (which some items only provide depending on their settings, e.g. stiff springs or
+    // loads with Jacobians), other physics items, and contacts are always injected again.
+    if (incremental_injection && injected_descriptor == &mdescriptor &&
+        injected_topology == assembly.GetTopologyHash() &&
+        injected_nvariables <= mdescriptor.GetVariablesList().size()) {
+        mdescriptor.BeginInsertion(0, injected_nvariables, 0);
+
+        for (auto& body : assembly.bodylist)
+            body->InjectConstraints(mdescriptor);
+        for (auto& shaft : assembly.shaftlist)
+            shaft->InjectConstraints(mdescriptor);
+        for (auto& link : assembly.linklist)
+            link->InjectConstraints(mdescriptor);
+        for (auto& mesh : assembly.meshlist)
+            mesh->InjectConstraints(mdescriptor);
+        for (auto& body : assembly.bodylist)
+            body->InjectKRMmatrices(mdescriptor);
+        for (auto& shaft : assembly.shaftlist)
+            shaft->InjectKRMmatrices(mdescriptor);
+        for (auto& link : assembly.linklist)
+            link->InjectKRMmatrices(mdescriptor);
+        for (auto& mesh : assembly.meshlist)
+            mesh->InjectKRMmatrices(mdescriptor);
+        for (auto& item : assembly.otherphysicslist) {
+            item->InjectConstraints(mdescriptor);
+            item->InjectVariables(mdescriptor);
+            item->InjectKRMmatrices(mdescriptor);
+        }
+        contact_container->InjectConstraints(mdescriptor);
+        contact_container->InjectVariables(mdescriptor);
+        contact_container->InjectKRMmatrices(mdescriptor);
+
+        mdescriptor.EndInsertion();
+        return;
+    }
+
     mdescriptor.BeginInsertion();  // This resets the vectors of constr. and var. pointers.
 
     InjectConstraints(mdescriptor);
-    InjectVariables(mdescriptor);
-    InjectKRMmatrices(mdescriptor);
+
+    // Inject variables of the assembly items that are kept by subsequent incremental injections
+    for (auto& body : assembly.bodylist)
+        body->InjectVariables(mdescriptor);
+    for (auto& shaft : assembly.shaftlist)
+        shaft->InjectVariables(mdescriptor);
+    for (auto& link : assembly.linklist)
+        link->InjectVariables(mdescriptor);
+    for (auto& mesh : assembly.meshlist)
+        mesh->InjectVariables(mdescriptor);
+
+    injected_descriptor = &mdescriptor;
+    injected_topology = assembly.GetTopologyHash();
+    injected_nvariables = mdescriptor.GetVariablesList().size();
+
+    // Inject the remaining items
+    for (auto& body : assembly.bodylist)
+        body->InjectKRMmatrices(mdescriptor);
+    for (auto& shaft : assembly.shaftlist)
+        shaft->InjectKRMmatrices(mdescriptor);
+    for (auto& link : assembly.linklist)
+        link->InjectKRMmatrices(mdescriptor);
+    for (auto& mesh : assembly.meshlist)
+        mesh->InjectKRMmatrices(mdescriptor);
+    for (auto& item : assembly.otherphysicslist) {
+        item->InjectVariables(mdescriptor);
+        item->InjectKRMmatrices(mdescriptor);
+    }
+    contact_container->InjectVariables(mdescriptor);
+    contact_container->InjectKRMmatrices(mdescriptor);
 
     mdescriptor.EndInsertion();
 }
@@ -1097,6 +1236,7 @@ bool ChSystem::StateSolveCorrection(ChStateDelta& Dv,             // result: com
     // If indicated, first perform a solver setup.
     // Return 'false' if the setup phase fails.
     if (force_setup) {
+        CH_TRACE("Solver setup");
         timer_ls_setup.start();
         bool success = GetSolver()->Setup(*descriptor);
         timer_ls_setup.stop();
@@ -1107,9 +1247,13 @@ bool ChSystem::StateSolveCorrection(ChStateDelta& Dv,             // result: com
 
     // Solve the problem
     // The solution is scattered in the provided system descriptor
-    timer_ls_solve.start();
-    GetSolver()->Solve(*descriptor);
-    timer_ls_solve.stop();
+    {
+        CH_TRACE("Solver solve");
+        timer_ls_solve.start();
+        descriptor->SetNumThreads(nthreads_chrono);
+        GetSolver()->Solve(*descriptor);
+        timer_ls_solve.stop();
+    }
 
     // Dv and L vectors  <-- sparse solver structures
     IntFromDescriptor(0, Dv, 0, L);
@@ -1560,6 +1704,11 @@ bool ChSystem::Integrate_Y() {
     if (GetContactMethod() == ChContactMethod::NSC && (ncontacts_old != 0 || ncontacts != 0))
         is_updated = false;
 
+    // Put to sleep the islands of bodies that came to rest, and wake up the sleeping islands that interact with some
+    // moving body. Changes in the sleeping state are accounted for by the Setup below.
+    if (ManageSleepingBodies())
+        is_updated = false;
+
     // Counts dofs, number of constraints, statistics, etc.
     // Note: this must be invoked at all times (regardless of the flag is_updated), as various physics items may use
     // their own Setup to perform operations at the beginning of a step.
@@ -1570,10 +1719,6 @@ bool ChSystem::Integrate_Y() {
         Update(false);
     }
 
-    // Re-wake the bodies that cannot sleep because they are in contact with
-    // some body that is not in sleep state.
-    ManageSleepingBodies();
-
     // Prepare lists of variables and constraints.
     DescriptorPrepareInject(*descriptor);
 
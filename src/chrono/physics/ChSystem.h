@@ -22,6 +22,7 @@
 #include <cstring>
 #include <iostream>
 #include <list>
+#include <unordered_map>
 
 #include "chrono/core/ChGlobal.h"
 #include "chrono/core/ChLog.h"
@@ -225,8 +226,10 @@ class ChApi ChSystem : public ChIntegrableIIorder {
 
     /// Set the number of OpenMP threads used by Chrono itself, Eigen, and the collision detection system.
     /// <pre>
-    ///   num_threads_chrono    - used in FEA (parallel evaluation of internal forces and Jacobians) and
-    ///                           in SCM deformable terrain calculations.
+    ///   num_threads_chrono    - used in FEA (parallel evaluation of internal forces and Jacobians), in SCM
+    ///                           deformable terrain calculations and, if deterministic ordering is disabled (see
+    ///                           SetDeterministicOrdering), in SMC contact force evaluation and in per-item passes
+    ///                           over large numbers of bodies, shafts, and links.
     ///   num_threads_collision - used in parallelization of collision detection (if applicable).
     ///                           If passing 0, then num_threads_collision = num_threads_chrono.
     ///   num_threads_eigen     - used in the Eigen sparse direct solvers and a few linear algebra operations.
@@ -245,6 +248,33 @@ class ChApi ChSystem : public ChIntegrableIIorder {
     int GetNumthreadsCollision() const { return nthreads_collision; }
     int GetNumthreadsEigen() const { return nthreads_eigen; }
 
+    /// Enable/disable deterministic ordering of the per-item passes over bodies, shafts, and links (default: true).
+    /// By default, all items are processed serially, in the order in which they were added to the system.
+    /// If disabled, state gather/scatter, Update, residual loading, and collision model synchronization are executed
+    /// concurrently (using num_threads_chrono threads) over large lists of bodies, shafts, and links. Results are then
+    /// only reproducible for a fixed number of threads, and everything invoked from these passes is called concurrently
+    /// and in no particular order, and must be thread-safe.
+    /// This includes ChFunction objects used by links and motors (a function shared between several items must not
+    /// keep mutable state, as ChFunction_Recorder does to cache its last lookup), force functors of ChLinkTSDA and
+    /// ChLinkRSDA, custom loaders of ChLoad objects, and Update() overrides of user-defined bodies and links.
+    /// Disable it only if these conditions are met.
+    void SetDeterministicOrdering(bool val) { deterministic_ordering = val; }
+
+    /// Return true if per-item passes are always executed serially (see SetDeterministicOrdering).
+    bool GetDeterministicOrdering() const { return deterministic_ordering; }
+
+    /// Enable/disable incremental injection of items in the system descriptor (default: true).
+    /// If enabled, the descriptor list of variables is only partially rebuilt at each step when the bodies, shafts,
+    /// links, and meshes did not change (see ChAssembly::GetTopologyHash), which is typically the case when only the
+    /// contact set changes.
+    void EnableIncrementalInjection(bool val) {
+        incremental_injection = val;
+        injected_descriptor = nullptr;
+    }
+
+    /// Return true if incremental injection of items in the system descriptor is enabled.
+    bool IsIncrementalInjectionEnabled() const { return incremental_injection; }
+
     //
     // DATABASE HANDLING
     //
@@ -476,6 +506,9 @@ class ChApi ChSystem : public ChIntegrableIIorder {
 
   protected:
     /// Pushes all ChConstraints and ChVariables contained in links, bodies, etc. into the system descriptor.
+    /// If incremental injection is enabled and the assembly topology did not change since the last call for the same
+    /// descriptor, the variables and Kblocks of bodies, shafts, links, and meshes are kept and only the remaining items
+    /// (all constraints, other physics items, and the contact container) are injected again.
     virtual void DescriptorPrepareInject(ChSystemDescriptor& mdescriptor);
 
     // Note: SetupInitial need not be typically called by a user, so it is currently marked protected
@@ -726,11 +759,26 @@ class ChApi ChSystem : public ChIntegrableIIorder {
     /// Tell if the system will put to sleep the bodies whose motion has almost come to a rest.
     bool GetUseSleeping() const { return use_sleeping; }
 
+    /// Set the kinetic energy thresholds (per unit mass) used when sleeping is enabled.
+    /// Sleeping is managed per island, i.e. per group of bodies connected through links or contacts (fixed bodies do
+    /// not connect islands). An island is put to sleep only if all its bodies satisfy their own sleeping criteria (see
+    /// ChBody::SetSleepTime, ChBody::SetSleepMinSpeed, ChBody::SetSleepMinWvel) and if its kinetic energy per unit
+    /// mass is below 'sleep_energy' (default: no limit). A sleeping island is woken up, as a whole, only if it interacts
+    /// with an awake body whose kinetic energy per unit mass exceeds 'wake_energy' (default: 0). Using a wake threshold
+    /// larger than the sleep threshold introduces hysteresis, so that islands do not oscillate between states.
+    /// An island with zero total mass is only subject to the sleeping criteria of its bodies.
+    void SetSleepingThresholds(double sleep_energy, double wake_energy);
+
+    /// Get the kinetic energy threshold (per unit mass) below which an island can be put to sleep.
+    double GetSleepEnergyThreshold() const { return sleep_energy; }
+
+    /// Get the kinetic energy threshold (per unit mass) above which a body wakes up the sleeping islands it touches.
+    double GetWakeEnergyThreshold() const { return wake_energy; }
+
   private:
-    /// Put bodies to sleep if possible. Also awakens sleeping bodies, if needed.
-    /// Returns true if some body changed from sleep to no sleep or viceversa,
-    /// returns false if nothing changed. In the former case, also performs Setup()
-    /// because the sleeping policy changed the totalDOFs and offsets.
+    /// Put islands of bodies to sleep if possible. Also awakens sleeping islands, if needed.
+    /// Returns true if some body changed from sleep to no sleep or viceversa, returns false if nothing changed.
+    /// This function does not perform a Setup(), so it must be called before the counts and offsets are updated.
     bool ManageSleepingBodies();
 
     /// Performs a single dynamical simulation step, according to
@@ -934,6 +982,13 @@ class ChApi ChSystem : public ChIntegrableIIorder {
 
     bool use_sleeping;  ///< if true, put to sleep objects that come to rest
 
+    double sleep_energy;                                    ///< kinetic energy per unit mass for islands to sleep
+    double wake_energy;                                     ///< kinetic energy per unit mass for bodies to wake others
+    int sleep_island_count;                                 ///< counter used to tag sleeping islands
+    std::vector<ChBody*> sleep_bodies;                      ///< bodies at last sleeping pass
+    std::unordered_map<ChPhysicsItem*, int> sleep_indices;  ///< index of each body in sleep_bodies
+    std::vector<int> sleep_islands;                         ///< sleeping island of each body (-1 if not sleeping)
+
     std::shared_ptr<ChSystemDescriptor> descriptor;  ///< system descriptor
     std::shared_ptr<ChSolver> solver;                ///< solver for DVI or DAE problem
 
@@ -961,6 +1016,13 @@ class ChApi ChSystem : public ChIntegrableIIorder {
     int nthreads_chrono;
     int nthreads_eigen;
     int nthreads_collision;
+    bool deterministic_ordering;  ///< if true, process assembly items serially, in order
+
+    // Incremental descriptor injection
+    bool incremental_injection;               ///< if true, only refresh the descriptor items that may have changed
+    ChSystemDescriptor* injected_descriptor;  ///< descriptor at last full injection (nullptr if none)
+    size_t injected_topology;                 ///< assembly topology at last full injection
+    size_t injected_nvariables;               ///< number of persistent variables in the injected descriptor
 
     // timers for profiling execution speed
     ChTimer timer_step;       ///< timer for integration step
@@ -990,6 +1052,7 @@ class ChApi ChSystem : public ChIntegrableIIorder {
     friend class ChContactContainerSMC;
 
     friend class ChVisualSystem;
+    friend class ChSystemSnapshot;
 
     friend class modal::ChModalAssembly;
 };
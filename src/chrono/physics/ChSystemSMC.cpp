@@ -17,10 +17,13 @@
 //
 // =============================================================================
 
+#include <cmath>
 #include <limits>
+#include <typeinfo>
 
 #include "chrono/physics/ChSystemSMC.h"
 #include "chrono/physics/ChContactContainerSMC.h"
+#include "chrono/physics/ChContactSMC.h"
 
 #include "chrono/solver/ChSystemDescriptor.h"
 #include "chrono/solver/ChIterativeSolverLS.h"
@@ -32,6 +35,237 @@ namespace chrono {
 // Register into the object factory, to enable run-time dynamic creation and persistence
 CH_FACTORY_REGISTER(ChSystemSMC)
 
+// -----------------------------------------------------------------------------
+// Default contact force kernels.
+// The force models are template parameters, so that all model branches are resolved at compile time. Flores and
+// Perko models (not implemented) are mapped to Hooke and Constant, respectively.
+// -----------------------------------------------------------------------------
+
+template <ChSystemSMC::ContactForceModel contact_model,
+          ChSystemSMC::AdhesionForceModel adhesion_model,
+          ChSystemSMC::TangentialDisplacementModel tdispl_model,
+          bool use_mat_props>
+static inline ChVector<> ContactForce(const ChSystemSMC::ContactForceInput& in,
+                                      double dT,
+                                      double char_vel,
+                                      double min_slip_vel) {
+    const ChMaterialCompositeSMC& mat = *in.mat;
+    double delta = in.delta;
+
+    // Set contact force to zero if no penetration.
+    if (delta <= 0)
+        return ChVector<>(0, 0, 0);
+
+    // Relative velocity at contact
+    ChVector<> relvel = in.vel2 - in.vel1;
+    double relvel_n_mag = relvel.Dot(in.normal_dir);
+    ChVector<> relvel_n = relvel_n_mag * in.normal_dir;
+    ChVector<> relvel_t = relvel - relvel_n;
+    double relvel_t_mag = relvel_t.Length();
+
+    // Calculate effective mass
+    double eff_mass = in.mass1 * in.mass2 / (in.mass1 + in.mass2);
+
+    // Calculate stiffness and viscous damping coefficients.
+    // All models use the following formulas for normal and tangential forces:
+    //     Fn = kn * delta_n - gn * v_n
+    //     Ft = kt * delta_t - gt * v_t
+    double kn = 0;
+    double kt = 0;
+    double gn = 0;
+    double gt = 0;
+
+    double eps = std::numeric_limits<double>::epsilon();
+
+    if (contact_model == ChSystemSMC::Hooke) {
+        if (use_mat_props) {
+            double tmp_k = (16.0 / 15) * std::sqrt(in.eff_radius) * mat.E_eff;
+            double v2 = char_vel * char_vel;
+            double loge = (mat.cr_eff < eps) ? std::log(eps) : std::log(mat.cr_eff);
+            loge = (mat.cr_eff > 1 - eps) ? std::log(1 - eps) : loge;
+            double tmp_g = 1 + std::pow(CH_C_PI / loge, 2);
+            kn = tmp_k * std::pow(eff_mass * v2 / tmp_k, 1.0 / 5);
+            kt = kn;
+            gn = std::sqrt(4 * eff_mass * kn / tmp_g);
+            gt = gn;
+        } else {
+            kn = mat.kn;
+            kt = mat.kt;
+            gn = eff_mass * mat.gn;
+            gt = eff_mass * mat.gt;
+        }
+    } else if (contact_model == ChSystemSMC::Hertz) {
+        if (use_mat_props) {
+            double sqrt_Rd = std::sqrt(in.eff_radius * delta);
+            double Sn = 2 * mat.E_eff * sqrt_Rd;
+            double St = 8 * mat.G_eff * sqrt_Rd;
+            double loge = (mat.cr_eff < eps) ? std::log(eps) : std::log(mat.cr_eff);
+            double beta = loge / std::sqrt(loge * loge + CH_C_PI * CH_C_PI);
+            kn = (2.0 / 3) * Sn;
+            kt = St;
+            gn = -2 * std::sqrt(5.0 / 6) * beta * std::sqrt(Sn * eff_mass);
+            gt = -2 * std::sqrt(5.0 / 6) * beta * std::sqrt(St * eff_mass);
+        } else {
+            double tmp = in.eff_radius * std::sqrt(delta);
+            kn = tmp * mat.kn;
+            kt = tmp * mat.kt;
+            gn = tmp * eff_mass * mat.gn;
+            gt = tmp * eff_mass * mat.gt;
+        }
+    } else if (contact_model == ChSystemSMC::PlainCoulomb) {
+        if (use_mat_props) {
+            double sqrt_Rd = std::sqrt(delta);
+            double Sn = 2 * mat.E_eff * sqrt_Rd;
+            double loge = (mat.cr_eff < eps) ? std::log(eps) : std::log(mat.cr_eff);
+            double beta = loge / std::sqrt(loge * loge + CH_C_PI * CH_C_PI);
+            kn = (2.0 / 3) * Sn;
+            gn = -2 * std::sqrt(5.0 / 6) * beta * std::sqrt(Sn * eff_mass);
+        } else {
+            double tmp = std::sqrt(delta);
+            kn = tmp * mat.kn;
+            gn = tmp * mat.gn;
+        }
+
+        double forceN = kn * delta - gn * relvel_n_mag;
+        if (forceN < 0)
+            forceN = 0;
+        double forceT = mat.mu_eff * std::tanh(5.0 * relvel_t_mag) * forceN;
+        if (adhesion_model == ChSystemSMC::AdhesionForceModel::DMT)
+            forceN -= mat.adhesionMultDMT_eff * std::sqrt(in.eff_radius);
+        else
+            forceN -= mat.adhesion_eff;
+
+        ChVector<> force = forceN * in.normal_dir;
+        if (relvel_t_mag >= min_slip_vel)
+            force -= (forceT / relvel_t_mag) * relvel_t;
+
+        return force;
+    }
+
+    if (tdispl_model == ChSystemSMC::MultiStep) {
+        // Tangential displacement accumulated since the contact was created, rotated onto the current tangent plane
+        ChVector<> delta_t(0, 0, 0);
+        if (in.tdispl) {
+            delta_t = ChVector<>(in.tdispl[0], in.tdispl[1], in.tdispl[2]);
+            double mag = delta_t.Length();
+            delta_t -= delta_t.Dot(in.normal_dir) * in.normal_dir;
+            double mag_t = delta_t.Length();
+            if (mag_t > eps)
+                delta_t *= mag / mag_t;
+        }
+        delta_t += relvel_t * dT;
+
+        double forceN = kn * delta - gn * relvel_n_mag;
+        ChVector<> forceT = -kt * delta_t - gt * relvel_t;
+
+        // No contact force if the shapes are separating fast enough; the history is also reset.
+        if (forceN < 0) {
+            forceN = 0;
+            forceT = VNULL;
+            delta_t = VNULL;
+        }
+
+        // Include adhesion force
+        if (adhesion_model == ChSystemSMC::AdhesionForceModel::DMT)
+            forceN -= mat.adhesionMultDMT_eff * std::sqrt(in.eff_radius);
+        else
+            forceN -= mat.adhesion_eff;
+
+        // Coulomb law. When sliding, the displacement is set to the value consistent with the friction force.
+        double forceT_max = mat.mu_eff * std::abs(forceN);
+        double forceT_mag = forceT.Length();
+        if (forceT_mag > forceT_max) {
+            forceT *= forceT_max / forceT_mag;
+            if (kt > eps)
+                delta_t = (forceT + gt * relvel_t) * (-1 / kt);
+        }
+
+        if (in.tdispl_out) {
+            in.tdispl_out[0] = (float)delta_t.x();
+            in.tdispl_out[1] = (float)delta_t.y();
+            in.tdispl_out[2] = (float)delta_t.z();
+        }
+
+        return forceN * in.normal_dir + forceT;
+    }
+
+    // Tangential displacement (magnitude)
+    double delta_t = (tdispl_model == ChSystemSMC::OneStep) ? relvel_t_mag * dT : 0;
+
+    // Calculate the magnitudes of the normal and tangential contact forces
+    double forceN = kn * delta - gn * relvel_n_mag;
+    double forceT = kt * delta_t + gt * relvel_t_mag;
+
+    // If the resulting normal contact force is negative, the two shapes are moving
+    // away from each other so fast that no contact force is generated.
+    if (forceN < 0) {
+        forceN = 0;
+        forceT = 0;
+    }
+
+    // Include adhesion force
+    if (adhesion_model == ChSystemSMC::AdhesionForceModel::DMT)
+        forceN -= mat.adhesionMultDMT_eff * std::sqrt(in.eff_radius);
+    else
+        forceN -= mat.adhesion_eff;
+
+    // Coulomb law
+    forceT = std::min<double>(forceT, mat.mu_eff * std::abs(forceN));
+
+    // Accumulate normal and tangential forces
+    ChVector<> force = forceN * in.normal_dir;
+    if (relvel_t_mag >= min_slip_vel)
+        force -= (forceT / relvel_t_mag) * relvel_t;
+
+    return force;
+}
+
+template <ChSystemSMC::ContactForceModel contact_model,
+          ChSystemSMC::AdhesionForceModel adhesion_model,
+          ChSystemSMC::TangentialDisplacementModel tdispl_model,
+          bool use_mat_props>
+static void ContactForceKernel(const ChSystemSMC& sys,
+                               const ChSystemSMC::ContactForceInput* input,
+                               ChVector<>* force,
+                               int n) {
+    double dT = sys.GetStep();
+    double char_vel = sys.GetCharacteristicImpactVelocity();
+    double min_slip_vel = sys.GetSlipVelocityThreshold();
+    for (int i = 0; i < n; i++)
+        force[i] = ContactForce<contact_model, adhesion_model, tdispl_model, use_mat_props>(input[i], dT, char_vel,
+                                                                                           min_slip_vel);
+}
+
+template <ChSystemSMC::ContactForceModel contact_model,
+          ChSystemSMC::AdhesionForceModel adhesion_model,
+          ChSystemSMC::TangentialDisplacementModel tdispl_model>
+static ChSystemSMC::ContactForceKernel SelectContactForceKernel(bool use_mat_props) {
+    return use_mat_props ? &ContactForceKernel<contact_model, adhesion_model, tdispl_model, true>
+                         : &ContactForceKernel<contact_model, adhesion_model, tdispl_model, false>;
+}
+
+template <ChSystemSMC::ContactForceModel contact_model, ChSystemSMC::AdhesionForceModel adhesion_model>
+static ChSystemSMC::ContactForceKernel SelectContactForceKernel(ChSystemSMC::TangentialDisplacementModel tdispl_model,
+                                                                bool use_mat_props) {
+    switch (tdispl_model) {
+        case ChSystemSMC::None:
+            return SelectContactForceKernel<contact_model, adhesion_model, ChSystemSMC::None>(use_mat_props);
+        case ChSystemSMC::MultiStep:
+            return SelectContactForceKernel<contact_model, adhesion_model, ChSystemSMC::MultiStep>(use_mat_props);
+        default:
+            return SelectContactForceKernel<contact_model, adhesion_model, ChSystemSMC::OneStep>(use_mat_props);
+    }
+}
+
+template <ChSystemSMC::ContactForceModel contact_model>
+static ChSystemSMC::ContactForceKernel SelectContactForceKernel(bool dmt,
+                                                                ChSystemSMC::TangentialDisplacementModel tdispl_model,
+                                                                bool use_mat_props) {
+    if (dmt)
+        return SelectContactForceKernel<contact_model, ChSystemSMC::DMT>(tdispl_model, use_mat_props);
+    return SelectContactForceKernel<contact_model, ChSystemSMC::Constant>(tdispl_model, use_mat_props);
+}
+
 ChSystemSMC::ChSystemSMC(bool use_material_properties)
     : ChSystem(),
       m_use_mat_props(use_material_properties),
@@ -39,7 +273,9 @@ ChSystemSMC::ChSystemSMC(bool use_material_properties)
       m_adhesion_model(AdhesionForceModel::Constant),
       m_tdispl_model(OneStep),
       m_stiff_contact(false),
-      m_force_algo(new ChDefaultContactForceSMC) {
+      m_parallel_contacts(true),
+      m_force_algo(new ChDefaultContactForceSMC),
+      m_default_force_algo(true) {
     descriptor = chrono_types::make_shared<ChSystemDescriptor>();
 
     SetSolverType(ChSolver::Type::PSOR);
@@ -58,9 +294,23 @@ ChSystemSMC::ChSystemSMC(bool use_material_properties)
 
     m_minSlipVelocity = 1e-4;
     m_characteristicVelocity = 1;
+
+    UpdateContactForceKernel();
 }
 
-ChSystemSMC::ChSystemSMC(const ChSystemSMC& other) : ChSystem(other) {}
+ChSystemSMC::ChSystemSMC(const ChSystemSMC& other)
+    : ChSystem(other),
+      m_use_mat_props(other.m_use_mat_props),
+      m_contact_model(other.m_contact_model),
+      m_adhesion_model(other.m_adhesion_model),
+      m_tdispl_model(other.m_tdispl_model),
+      m_stiff_contact(other.m_stiff_contact),
+      m_minSlipVelocity(other.m_minSlipVelocity),
+      m_characteristicVelocity(other.m_characteristicVelocity),
+      m_parallel_contacts(other.m_parallel_contacts),
+      m_force_algo(other.m_force_algo),
+      m_default_force_algo(other.m_default_force_algo),
+      m_force_kernel(other.m_force_kernel) {}
 
 void ChSystemSMC::SetContactContainer(std::shared_ptr<ChContactContainer> container) {
     if (std::dynamic_pointer_cast<ChContactContainerSMC>(container))
@@ -73,6 +323,22 @@ void ChSystemSMC::SetSlipVelocityThreshold(double vel) {
 
 void ChSystemSMC::SetContactForceAlgorithm(std::unique_ptr<ChContactForceSMC>&& algorithm) {
     m_force_algo = std::move(algorithm);
+    m_default_force_algo = m_force_algo && typeid(*m_force_algo) == typeid(ChDefaultContactForceSMC);
+}
+
+void ChSystemSMC::UpdateContactForceKernel() {
+    bool dmt = (m_adhesion_model == DMT);
+    switch (m_contact_model) {
+        case Hertz:
+            m_force_kernel = SelectContactForceKernel<Hertz>(dmt, m_tdispl_model, m_use_mat_props);
+            break;
+        case PlainCoulomb:
+            m_force_kernel = SelectContactForceKernel<PlainCoulomb>(dmt, m_tdispl_model, m_use_mat_props);
+            break;
+        default:
+            m_force_kernel = SelectContactForceKernel<Hooke>(dmt, m_tdispl_model, m_use_mat_props);
+            break;
+    }
 }
 
 // Trick to avoid putting the following mapper macro inside the class definition in .h file:
@@ -139,6 +405,8 @@ void ChSystemSMC::ArchiveIn(ChArchiveIn& marchive) {
     marchive >> CHNVP(mtangential_mapper(m_tdispl_model), "tangential_model");
     //***TODO*** complete...
 
+    UpdateContactForceKernel();
+
     // Recompute statistics, offsets, etc.
     this->Setup();
 }
@@ -72,23 +72,38 @@ class ChApi ChSystemSMC : public ChSystem {
     /// Enable/disable using physical contact material properties.
     /// If true, contact coefficients are estimated from physical material properties.
     /// Otherwise, explicit values of stiffness and damping coefficients are used.
-    void UseMaterialProperties(bool val) { m_use_mat_props = val; }
+    void UseMaterialProperties(bool val) {
+        m_use_mat_props = val;
+        UpdateContactForceKernel();
+    }
     /// Return true if contact coefficients are estimated from physical material properties.
     bool UsingMaterialProperties() const { return m_use_mat_props; }
 
     /// Set the normal contact force model.
-    void SetContactForceModel(ContactForceModel model) { m_contact_model = model; }
+    void SetContactForceModel(ContactForceModel model) {
+        m_contact_model = model;
+        UpdateContactForceKernel();
+    }
     /// Get the current normal contact force model.
     ContactForceModel GetContactForceModel() const { return m_contact_model; }
 
     /// Set the adhesion force model.
-    void SetAdhesionForceModel(AdhesionForceModel model) { m_adhesion_model = model; }
+    void SetAdhesionForceModel(AdhesionForceModel model) {
+        m_adhesion_model = model;
+        UpdateContactForceKernel();
+    }
     /// Get the current adhesion force model.
     AdhesionForceModel GetAdhesionForceModel() const { return m_adhesion_model; }
 
     /// Set the tangential displacement model.
-    /// Note that currently MultiStep falls back to OneStep.
-    void SetTangentialDisplacementModel(TangentialDisplacementModel model) { m_tdispl_model = model; }
+    /// With MultiStep, the tangential displacement of each contact is accumulated from the step the contact was
+    /// created, which resolves stick-slip transitions. The displacement history is kept in the persistent contact data
+    /// of the collision system (Bullet manifold points) or, if not available, in the contact container.
+    /// Only the default contact force algorithm uses this history.
+    void SetTangentialDisplacementModel(TangentialDisplacementModel model) {
+        m_tdispl_model = model;
+        UpdateContactForceKernel();
+    }
     /// Get the current tangential displacement model.
     TangentialDisplacementModel GetTangentialDisplacementModel() const { return m_tdispl_model; }
 
@@ -107,9 +122,19 @@ class ChApi ChSystemSMC : public ChSystem {
     void SetCharacteristicImpactVelocity(double vel) { m_characteristicVelocity = vel; }
     double GetCharacteristicImpactVelocity() const { return m_characteristicVelocity; }
 
+    /// Enable/disable parallel processing of SMC contacts (default: true).
+    /// If enabled, contact forces are evaluated, accumulated, and loaded into the residual using the number of threads
+    /// set through SetNumThreads (num_threads_chrono). Partial sums are merged in thread order, so results are
+    /// reproducible for a given number of threads, but may differ in the last bits if the number of threads changes.
+    /// This setting is independent of ChSystem::SetDeterministicOrdering, as no user code is called concurrently: a
+    /// custom force algorithm (see SetContactForceAlgorithm) is always evaluated serially.
+    void SetParallelContacts(bool val) { m_parallel_contacts = val; }
+    bool GetParallelContacts() const { return m_parallel_contacts; }
+
     /// Base class for contact force calculation.
     /// A user can override thie default implementation by attaching a custom derived class; see
-    /// SetContactForceAlgorithm.
+    /// SetContactForceAlgorithm. A custom algorithm is always called serially, in contact order, so it need not be
+    /// thread-safe.
     class ChApi ChContactForceSMC {
       public:
         virtual ~ChContactForceSMC() {}
@@ -137,6 +162,36 @@ class ChApi ChSystemSMC : public ChSystem {
     /// Accessor for the current SMC contact force calculation.
     const ChContactForceSMC& GetContactForceAlgorithm() const { return *m_force_algo; }
 
+    /// Return true if the default SMC contact force calculation is used (see ChDefaultContactForceSMC).
+    bool UsingDefaultContactForceAlgorithm() const { return m_default_force_algo; }
+
+    /// Input data for the default SMC contact force calculation of a single contact.
+    struct ContactForceInput {
+        ChVector<> normal_dir;              ///< normal contact direction (expressed in global frame)
+        ChVector<> vel1;                    ///< velocity of contact point on obj1 (expressed in global frame)
+        ChVector<> vel2;                    ///< velocity of contact point on obj2 (expressed in global frame)
+        const ChMaterialCompositeSMC* mat;  ///< composite material for contact pair
+        const float* tdispl;                ///< tangential displacement at the previous step (MultiStep; may be null)
+        float* tdispl_out;                  ///< updated tangential displacement (MultiStep; null if not stored)
+        double delta;                       ///< overlap in normal direction
+        double eff_radius;                  ///< effective radius of curvature at contact
+        double mass1;                       ///< mass of obj1
+        double mass2;                       ///< mass of obj2
+    };
+
+    /// Function calculating the contact forces of an array of contacts.
+    typedef void (*ContactForceKernel)(const ChSystemSMC& sys, const ContactForceInput* input, ChVector<>* force, int n);
+
+    /// Calculate the contact forces of an array of contacts with the default SMC algorithm.
+    /// The force models are resolved when they are set in this system, so that each call runs a kernel specialized
+    /// for the current models, with no per-contact branching on the model types.
+    void CalculateContactForces(const ContactForceInput* input,  ///< input data of each contact
+                                ChVector<>* force,               ///< output contact forces (on obj2)
+                                int n                            ///< number of contacts
+    ) const {
+        m_force_kernel(*this, input, force, n);
+    }
+
     /// Method to allow serialization of transient data to archives.
     virtual void ArchiveOut(ChArchiveOut& marchive) override;
 
@@ -144,6 +199,10 @@ class ChApi ChSystemSMC : public ChSystem {
     virtual void ArchiveIn(ChArchiveIn& marchive) override;
 
   private:
+
+    /// Select the contact force kernel for the current force models.
+    void UpdateContactForceKernel();
+
     bool m_use_mat_props;                        ///< if true, derive contact parameters from mat. props.
     ContactForceModel m_contact_model;           ///< type of the contact force model
     AdhesionForceModel m_adhesion_model;         ///< type of the adhesion force model
@@ -151,7 +210,10 @@ class ChApi ChSystemSMC : public ChSystem {
     bool m_stiff_contact;                        ///< flag indicating stiff contacts (triggers Jacobian calculation)
     double m_minSlipVelocity;                    ///< slip velocity below which no tangential forces are generated
     double m_characteristicVelocity;             ///< characteristic impact velocity (Hooke model)
-    std::unique_ptr<ChContactForceSMC> m_force_algo;  /// contact force calculation
+    bool m_parallel_contacts;                    ///< process contacts using num_threads_chrono threads
+    std::shared_ptr<ChContactForceSMC> m_force_algo;  ///< contact force calculation (shared with copies)
+    bool m_default_force_algo;                        ///< true if m_force_algo is a ChDefaultContactForceSMC
+    ContactForceKernel m_force_kernel;                ///< default contact force kernel for the current models
 };
 
 CH_CLASS_VERSION(ChSystemSMC, 0)
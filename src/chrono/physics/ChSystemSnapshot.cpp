@@ -0,0 +1,257 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cstdint>
+
+#include "chrono/collision/ChCollisionModel.h"
+#include "chrono/fea/ChMesh.h"
+#include "chrono/physics/ChSystem.h"
+#include "chrono/physics/ChSystemSnapshot.h"
+
+namespace chrono {
+
+// Snapshot header: magic number ("CHSS") and format version
+static const uint32_t snapshot_magic = 0x53534843;
+static const uint32_t snapshot_version = 4;
+
+// Hash of the structure of the assembly: number of items in each list, and number of states of each item. This does not
+// depend on the addresses of the items nor on their active flags, so that a snapshot can be restored in an identical
+// system created in another process, whatever the bodies put to sleep since it was taken. The number of constraints is
+// not included, as it changes when a link is disabled; it is stored with the reactions of each item instead.
+template <class T>
+static void HashList(uint64_t& hash, const std::vector<std::shared_ptr<T>>& list) {
+    auto mix = [&hash](uint64_t val) {
+        hash ^= val;
+        hash *= 0x100000001b3ULL;
+    };
+    mix(list.size());
+    for (auto& item : list) {
+        mix(item->GetDOF());
+        mix(item->GetDOF_w());
+    }
+}
+
+static uint64_t StructureHash(const ChAssembly& assembly) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    HashList(hash, assembly.Get_bodylist());
+    for (auto& body : assembly.Get_bodylist()) {
+        // Collision models and shapes are used as keys of the contact data (see RegisterKeys)
+        auto model = body->GetCollisionModel();
+        hash ^= model ? (uint64_t)model->GetNumShapes() + 1 : 0;
+        hash *= 0x100000001b3ULL;
+    }
+    HashList(hash, assembly.Get_shaftlist());
+    HashList(hash, assembly.Get_meshlist());
+    HashList(hash, assembly.Get_linklist());
+    HashList(hash, assembly.Get_otherphysicslist());
+    return hash;
+}
+
+// Largest numbers of states and constraints of the items in a list
+template <class T>
+static void MaxSizes(const std::vector<std::shared_ptr<T>>& list, int& nx, int& nv, int& nL) {
+    for (auto& item : list) {
+        nx = std::max(nx, item->GetDOF());
+        nv = std::max(nv, item->GetDOF_w());
+        nL = std::max(nL, item->GetDOC());
+    }
+}
+
+template <class Titem>
+void ChSystemSnapshot::SaveList(const std::vector<std::shared_ptr<Titem>>& list, bool always) {
+    for (auto& list_item : list) {
+        // Access the state functions through the base class (some are not public in derived classes)
+        ChPhysicsItem* item = list_item.get();
+        bool stored = always || item->IsActive();
+        m_buffer.Write((uint8_t)stored);
+        if (!stored)
+            continue;
+
+        // Each item writes its states at the beginning of the scratch vectors
+        int nx = item->GetDOF();
+        int nv = item->GetDOF_w();
+        double T;
+        item->IntStateGather(0, m_x, 0, m_v, T);
+        item->IntStateGatherAcceleration(0, m_a);
+        m_buffer.Write(m_x.data(), nx);
+        m_buffer.Write(m_v.data(), nv);
+        m_buffer.Write(m_a.data(), nv);
+
+        // Reactions are only available for active items. Their number is stored, as the active state and the number of
+        // constraints of the item may differ at restore time (they are not part of the structure hash).
+        uint32_t nL = item->IsActive() ? (uint32_t)item->GetDOC() : 0;
+        m_buffer.Write(nL);
+        if (nL > 0) {
+            item->IntStateGatherReactions(0, m_L);
+            m_buffer.Write(m_L.data(), nL);
+        }
+    }
+}
+
+template <class Titem>
+void ChSystemSnapshot::RestoreList(const std::vector<std::shared_ptr<Titem>>& list, double time) {
+    for (auto& list_item : list) {
+        ChPhysicsItem* item = list_item.get();
+        if (m_buffer.Read<uint8_t>() == 0) {
+            item->Update(time, true);
+            continue;
+        }
+
+        int nx = item->GetDOF();
+        int nv = item->GetDOF_w();
+        m_buffer.Read(m_x.data(), nx);
+        m_buffer.Read(m_v.data(), nv);
+        m_buffer.Read(m_a.data(), nv);
+        item->IntStateScatter(0, m_x, 0, m_v, time, true);
+        item->IntStateScatterAcceleration(0, m_a);
+        int nL = (int)m_buffer.Read<uint32_t>();
+        if (nL > 0) {
+            if (m_L.size() < nL)
+                m_L.resize(nL);
+            m_buffer.Read(m_L.data(), nL);
+            if (item->IsActive() && item->GetDOC() == nL)
+                item->IntStateScatterReactions(0, m_L);
+        }
+    }
+}
+
+void ChSystemSnapshot::RegisterKeys(ChSystem& sys) {
+    m_buffer.ClearKeys();
+    for (auto& body : sys.assembly.Get_bodylist()) {
+        auto model = body->GetCollisionModel();
+        if (!model)
+            continue;
+        m_buffer.AddKey(model.get());
+        for (auto& shape : model->GetShapes())
+            m_buffer.AddKey(shape.get());
+    }
+}
+
+void ChSystemSnapshot::ResizeScratch(ChSystem& sys) {
+    const ChAssembly& assembly = sys.GetAssembly();
+    int nx = 0;
+    int nv = 0;
+    int nL = 0;
+    MaxSizes(assembly.Get_bodylist(), nx, nv, nL);
+    MaxSizes(assembly.Get_shaftlist(), nx, nv, nL);
+    MaxSizes(assembly.Get_meshlist(), nx, nv, nL);
+    MaxSizes(assembly.Get_linklist(), nx, nv, nL);
+    MaxSizes(assembly.Get_otherphysicslist(), nx, nv, nL);
+
+    // Only reallocate if needed
+    if (m_x.size() < nx)
+        m_x.setZero(nx, &sys);
+    if (m_v.size() < nv)
+        m_v.setZero(nv, &sys);
+    if (m_a.size() < nv)
+        m_a.setZero(nv, &sys);
+    if (m_L.size() < nL)
+        m_L.setZero(nL);
+}
+
+void ChSystemSnapshot::Save(ChSystem& sys) {
+    m_buffer.Clear();
+    m_buffer.Write(snapshot_magic);
+    m_buffer.Write(snapshot_version);
+    m_buffer.Write(StructureHash(sys.assembly));
+    m_buffer.Write(sys.GetChTime());
+    m_buffer.Write((uint64_t)sys.stepcount);
+
+    // Internal data of the physics items, not included in the state vectors
+    RegisterKeys(sys);
+    sys.assembly.SnapshotOut(m_buffer);
+    sys.contact_container->SnapshotOut(m_buffer);
+
+    // States of the items. Bodies and meshes are always stored (as in ChAssembly::IntStateGather), other items only if
+    // active. These are stored item by item (rather than as the system state vectors), so that the
+    // system does not need to be set up and inactive bodies are included. Only the reactions of the assembly items
+    // are stored: contacts are regenerated at the next step and recover their reactions from the contact container
+    // data.
+    ResizeScratch(sys);
+    SaveList(sys.assembly.Get_bodylist(), true);
+    SaveList(sys.assembly.Get_shaftlist(), false);
+    SaveList(sys.assembly.Get_meshlist(), true);
+    SaveList(sys.assembly.Get_linklist(), false);
+    SaveList(sys.assembly.Get_otherphysicslist(), false);
+}
+
+void ChSystemSnapshot::Restore(ChSystem& sys) {
+    if (IsEmpty())
+        throw ChException("Cannot restore an empty snapshot.");
+
+    m_buffer.Rewind();
+    if (m_buffer.Read<uint32_t>() != snapshot_magic)
+        throw ChException("Invalid snapshot data.");
+    if (m_buffer.Read<uint32_t>() != snapshot_version)
+        throw ChException("Unsupported snapshot version.");
+    if (m_buffer.Read<uint64_t>() != StructureHash(sys.assembly))
+        throw ChException("The system structure does not match the snapshot.");
+    double T = m_buffer.Read<double>();
+    uint64_t stepcount = m_buffer.Read<uint64_t>();
+
+    // Internal data of the physics items. This may change the set of active items (e.g. sleeping bodies), so it must
+    // be restored before the system offsets are recomputed.
+    RegisterKeys(sys);
+    sys.assembly.SnapshotIn(m_buffer);
+    sys.contact_container->SnapshotIn(m_buffer);
+
+    sys.Setup();
+
+    // Bodies and meshes must be restored before links, which use them in their update (see ChAssembly::IntStateScatter)
+    ResizeScratch(sys);
+    RestoreList(sys.assembly.Get_bodylist(), T);
+    RestoreList(sys.assembly.Get_shaftlist(), T);
+    RestoreList(sys.assembly.Get_meshlist(), T);
+    RestoreList(sys.assembly.Get_linklist(), T);
+    RestoreList(sys.assembly.Get_otherphysicslist(), T);
+    sys.assembly.SetChTime(T);
+    sys.contact_container->Update(T, true);
+
+    sys.ch_time = T;
+    sys.stepcount = (size_t)stepcount;
+}
+
+void ChSystemSnapshot::Write(std::ostream& stream) const {
+    uint64_t size = m_buffer.GetSize();
+    stream.write(reinterpret_cast<const char*>(&size), sizeof(size));
+    stream.write(m_buffer.GetData().data(), (std::streamsize)size);
+    if (!stream)
+        throw ChException("Error writing snapshot to stream.");
+}
+
+void ChSystemSnapshot::Read(std::istream& stream) {
+    uint64_t size = 0;
+    stream.read(reinterpret_cast<char*>(&size), sizeof(size));
+    if (!stream)
+        throw ChException("Error reading snapshot from stream.");
+
+    auto& data = m_buffer.GetData();
+    data.resize((size_t)size);
+    stream.read(data.data(), (std::streamsize)size);
+    if (!stream || size < 2 * sizeof(uint32_t)) {
+        m_buffer.Clear();
+        throw ChException("Error reading snapshot from stream.");
+    }
+    m_buffer.Rewind();
+
+    // Validate the header right away, so that a bad stream is reported here rather than at restore time
+    uint32_t magic = m_buffer.Read<uint32_t>();
+    uint32_t version = m_buffer.Read<uint32_t>();
+    m_buffer.Rewind();
+    if (magic != snapshot_magic || version != snapshot_version) {
+        m_buffer.Clear();
+        throw ChException("Invalid or unsupported snapshot data.");
+    }
+}
+
+}  // end namespace chrono
@@ -0,0 +1,212 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#ifndef CH_SYSTEM_SNAPSHOT_H
+#define CH_SYSTEM_SNAPSHOT_H
+
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "chrono/core/ChApiCE.h"
+#include "chrono/core/ChException.h"
+#include "chrono/timestepper/ChState.h"
+
+namespace chrono {
+
+// Forward references
+class ChSystem;
+
+/// Raw binary buffer used to store a snapshot of a system.
+/// Values are appended and read back in the same order, with no type information; only trivially copyable types can
+/// be stored. Reading past the end of the buffer throws a ChException.
+/// Pointers must not be stored, since a snapshot can be restored in another system. Objects registered as keys (e.g.,
+/// collision models and shapes) can instead be stored by their index, see GetKeyIndex() and GetKey().
+class ChApi ChSnapshotBuffer {
+  public:
+    ChSnapshotBuffer() : m_pos(0) {}
+
+    /// Append a value to the buffer.
+    template <typename T>
+    void Write(const T& val) {
+        Write(&val, 1);
+    }
+
+    /// Append an array of n values to the buffer.
+    template <typename T>
+    void Write(const T* vals, size_t n) {
+        static_assert(std::is_trivially_copyable<T>::value, "Snapshot values must be trivially copyable");
+        const char* bytes = reinterpret_cast<const char*>(vals);
+        m_data.insert(m_data.end(), bytes, bytes + n * sizeof(T));
+    }
+
+    /// Read the next value from the buffer.
+    template <typename T>
+    T Read() {
+        T val;
+        Read(&val, 1);
+        return val;
+    }
+
+    /// Read the next n values from the buffer.
+    template <typename T>
+    void Read(T* vals, size_t n) {
+        static_assert(std::is_trivially_copyable<T>::value, "Snapshot values must be trivially copyable");
+        size_t size = n * sizeof(T);
+        if (m_pos + size > m_data.size())
+            throw ChException("Snapshot buffer overrun: snapshot data is corrupted or does not match the system.");
+        std::memcpy(vals, m_data.data() + m_pos, size);
+        m_pos += size;
+    }
+
+    /// Append the internal data of an object used by a physics item (e.g., a motion function), which may be null.
+    /// The data is preceded by its size, so that a different object at restore time is detected by ReadObject().
+    template <class T>
+    void WriteObject(const std::shared_ptr<T>& obj) {
+        size_t start = m_data.size();
+        Write((uint64_t)0);
+        if (obj)
+            obj->SnapshotOut(*this);
+        uint64_t size = m_data.size() - start - sizeof(uint64_t);
+        std::memcpy(m_data.data() + start, &size, sizeof(size));
+    }
+
+    /// Restore the internal data of an object, as stored by WriteObject().
+    /// Throw a ChException if the data does not match the object.
+    template <class T>
+    void ReadObject(const std::shared_ptr<T>& obj) {
+        uint64_t size = Read<uint64_t>();
+        size_t start = m_pos;
+        if (obj)
+            obj->SnapshotIn(*this);
+        if (m_pos - start != size)
+            throw ChException("Snapshot data of an object does not match the system.");
+    }
+
+    /// Move the read position back to the beginning of the buffer.
+    void Rewind() { m_pos = 0; }
+
+    /// Discard all data (the allocated memory is kept for reuse).
+    void Clear() {
+        m_data.clear();
+        m_pos = 0;
+    }
+
+    /// Register an object as a key, with an index given by the registration order.
+    void AddKey(const void* key) {
+        m_key_index.emplace(key, m_keys.size());
+        m_keys.push_back(key);
+    }
+
+    /// Remove all registered keys.
+    void ClearKeys() {
+        m_keys.clear();
+        m_key_index.clear();
+    }
+
+    /// Get the index of a registered key, or NoKey if the object is not registered.
+    uint64_t GetKeyIndex(const void* key) const {
+        auto it = m_key_index.find(key);
+        return it == m_key_index.end() ? NoKey : it->second;
+    }
+
+    /// Get the key with the given index, or nullptr if the index is not valid.
+    const void* GetKey(uint64_t index) const { return index < m_keys.size() ? m_keys[index] : nullptr; }
+
+    /// Index of objects not registered as keys.
+    static const uint64_t NoKey = ~(uint64_t)0;
+
+    /// Get the size of the stored data, in bytes.
+    size_t GetSize() const { return m_data.size(); }
+
+    /// Access the stored data.
+    std::vector<char>& GetData() { return m_data; }
+    const std::vector<char>& GetData() const { return m_data; }
+
+  private:
+    std::vector<char> m_data;  ///< stored bytes
+    size_t m_pos;              ///< current read position
+
+    std::vector<const void*> m_keys;                        ///< registered keys
+    std::unordered_map<const void*, uint64_t> m_key_index;  ///< index of each registered key
+};
+
+/// Binary snapshot of the complete state of a system, for rolling back or branching a simulation.
+/// A snapshot stores the states of the physics items (positions, velocities, accelerations, and the reactions of the
+/// links, which are also used to warm start the solver at the next step), the simulation time and step count, plus
+/// the internal data of physics items which is not part of the state vectors (see ChPhysicsItem::SnapshotOut), such
+/// as the sleeping state of bodies, the persistent contact reactions of the NSC contact container, and the internal
+/// data of the functions driving motors, actuators, and imposed motions (see ChFunction::SnapshotOut).
+/// A snapshot can be restored in any system with the same structure as the system it was taken from, i.e. with the
+/// same items, in the same order, with the same numbers of states. This is checked with a hash of the structure of the
+/// system (not of the item addresses), so snapshots written to a stream can be read and restored in an identical system
+/// built by another process. The reactions of an item are only restored if the item is active and has the same number
+/// of constraints as when the snapshot was taken. Current contacts are not stored: they are regenerated by the
+/// collision detection at the next step, and inherit the persistent data saved with the snapshot.
+/// Snapshots reuse their memory, so that saving and restoring repeatedly does not allocate.
+class ChApi ChSystemSnapshot {
+  public:
+    ChSystemSnapshot() {}
+
+    /// Store the current state of the given system, overwriting the previous contents of this snapshot.
+    /// The system is not modified. Items added since the last step should be set up first (see ChSystem::Setup).
+    void Save(ChSystem& sys);
+
+    /// Restore the given system to the stored state.
+    /// Throw a ChException if the structure of the system does not match the one of the snapshot.
+    void Restore(ChSystem& sys);
+
+    /// Return true if this snapshot contains no data.
+    bool IsEmpty() const { return m_buffer.GetSize() == 0; }
+
+    /// Get the size of the snapshot data, in bytes.
+    size_t GetSize() const { return m_buffer.GetSize(); }
+
+    /// Write the snapshot data to a binary stream.
+    void Write(std::ostream& stream) const;
+
+    /// Read snapshot data from a binary stream, as written by Write().
+    /// Throw a ChException if the stream does not contain a valid snapshot.
+    void Read(std::istream& stream);
+
+  private:
+    /// Store the states of the items in the given list.
+    /// If always is false, the states of inactive items are not stored.
+    template <class Titem>
+    void SaveList(const std::vector<std::shared_ptr<Titem>>& list, bool always);
+
+    /// Restore the states of the items in the given list, as stored by SaveList().
+    template <class Titem>
+    void RestoreList(const std::vector<std::shared_ptr<Titem>>& list, double time);
+
+    /// Register the collision models and shapes of the bodies as keys of the snapshot buffer.
+    void RegisterKeys(ChSystem& sys);
+
+    /// Make the scratch vectors large enough for the states and reactions of any item of the system.
+    void ResizeScratch(ChSystem& sys);
+
+    ChSnapshotBuffer m_buffer;  ///< snapshot data
+
+    // Scratch vectors, kept to avoid reallocations
+    ChState m_x;
+    ChStateDelta m_v;
+    ChStateDelta m_a;
+    ChVectorDynamic<> m_L;
+};
+
+}  // end namespace chrono
+
+#endif
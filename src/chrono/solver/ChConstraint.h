@@ -21,6 +21,8 @@
 
 namespace chrono {
 
+class ChVariables;
+
 /// Modes for constraint
 enum eChConstraintMode {
     CONSTRAINT_FREE = 0,        ///< the constraint does not enforce anything
@@ -280,6 +282,11 @@ class ChApi ChConstraint {
     /// Same as Build_Cq, but puts the _transposed_ jacobian row as a column.
     virtual void Build_CqT(ChSparseMatrix& storage, int inscol) = 0;
 
+    /// Append to 'vars' the variables referenced by this constraint.
+    /// Return false if this information is not available, in which case the constraint is assumed to couple all
+    /// variables in the system (e.g., when partitioning the problem in independent islands).
+    virtual bool AppendVariables(std::vector<ChVariables*>& vars) { return false; }
+
     /// Set offset in global q vector (set automatically by ChSystemDescriptor)
     void SetOffset(int moff) { offset = moff; }
 
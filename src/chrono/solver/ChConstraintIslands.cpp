@@ -0,0 +1,119 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#include "chrono/solver/ChConstraintIslands.h"
+
+namespace chrono {
+
+int ChConstraintIslands::FindRoot(int i) {
+    while (parent[i] != i) {
+        parent[i] = parent[parent[i]];  // path halving
+        i = parent[i];
+    }
+    return i;
+}
+
+int ChConstraintIslands::Build(ChSystemDescriptor& sysd) {
+    std::vector<ChConstraint*>& mconstraints = sysd.GetConstraintsList();
+    std::vector<ChVariables*>& mvariables = sysd.GetVariablesList();
+
+    int nv = (int)mvariables.size();
+    int nc = (int)mconstraints.size();
+    int n_q = sysd.CountActiveVariables();
+
+    // Map the offsets of active variables to their position in the descriptor
+    var_index.assign(n_q, -1);
+    for (int iv = 0; iv < nv; iv++) {
+        if (mvariables[iv]->IsActive() && mvariables[iv]->Get_ndof() > 0)
+            var_index[mvariables[iv]->GetOffset()] = iv;
+    }
+
+    parent.resize(nv);
+    for (int iv = 0; iv < nv; iv++)
+        parent[iv] = iv;
+
+    // Merge the sets of all active variables referenced by each constraint
+    constraint_root.assign(nc, -1);
+    bool coupled = false;
+    for (int ic = 0; ic < nc && !coupled; ic++) {
+        cvars.clear();
+        if (!mconstraints[ic]->AppendVariables(cvars)) {
+            coupled = true;
+            break;
+        }
+        int root = -1;
+        for (auto var : cvars) {
+            if (!var || !var->IsActive())
+                continue;
+            int offset = var->GetOffset();
+            if (offset < 0 || offset >= n_q || var_index[offset] < 0 || mvariables[var_index[offset]] != var) {
+                // variable not in this descriptor
+                coupled = true;
+                break;
+            }
+            int r = FindRoot(var_index[offset]);
+            if (root < 0)
+                root = r;
+            else if (r != root)
+                parent[r] = root;
+        }
+        constraint_root[ic] = root;
+    }
+
+    // If the coupling cannot be determined, treat the whole problem as one island
+    if (coupled) {
+        num_islands = 1;
+        if (islands.empty())
+            islands.resize(1);
+        islands[0].constraints = mconstraints;
+        islands[0].variables = mvariables;
+        return num_islands;
+    }
+
+    // Number the islands in order of their first active variable
+    num_islands = 0;
+    island_index.assign(nv, -1);
+    auto new_island = [this]() {
+        if ((int)islands.size() <= num_islands)
+            islands.emplace_back();
+        islands[num_islands].constraints.clear();
+        islands[num_islands].variables.clear();
+        return num_islands++;
+    };
+
+    for (int iv = 0; iv < nv; iv++) {
+        if (!mvariables[iv]->IsActive())
+            continue;
+        int r = FindRoot(iv);
+        if (island_index[r] < 0)
+            island_index[r] = new_island();
+        islands[island_index[r]].variables.push_back(mvariables[iv]);
+    }
+
+    int free_island = -1;
+    for (int ic = 0; ic < nc; ic++) {
+        int island;
+        if (constraint_root[ic] < 0) {
+            // constraint acting only on inactive variables
+            if (free_island < 0)
+                free_island = new_island();
+            island = free_island;
+        } else {
+            island = island_index[FindRoot(constraint_root[ic])];
+        }
+        islands[island].constraints.push_back(mconstraints[ic]);
+    }
+
+    return num_islands;
+}
+
+}  // end namespace chrono
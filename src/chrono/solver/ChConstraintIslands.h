@@ -0,0 +1,74 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#ifndef CH_CONSTRAINT_ISLANDS_H
+#define CH_CONSTRAINT_ISLANDS_H
+
+#include <vector>
+
+#include "chrono/solver/ChSystemDescriptor.h"
+
+namespace chrono {
+
+/// @addtogroup chrono_solver
+/// @{
+
+/// Partition of the problem in a ChSystemDescriptor into independent islands.
+/// An island is a set of active variables connected (directly or indirectly) by constraints, together with all the
+/// constraints acting on them. Since no constraint couples variables in different islands, each island can be solved
+/// as a separate problem. Inactive variables (e.g., those of fixed bodies) do not connect islands. Constraints that
+/// act only on inactive variables are collected in a separate island with no variables.
+/// Constraints and variables retain, within each island, the order they have in the descriptor (in particular, the
+/// consecutive N,U,V constraints of a frictional contact always end up in the same island).
+class ChApi ChConstraintIslands {
+  public:
+    /// Constraints and variables in one island.
+    struct Island {
+        std::vector<ChConstraint*> constraints;
+        std::vector<ChVariables*> variables;
+    };
+
+    ChConstraintIslands() : num_islands(0) {}
+
+    /// Copying does not transfer the partition (which is transient data, rebuilt at each solve).
+    ChConstraintIslands(const ChConstraintIslands& other) : num_islands(0) {}
+    ChConstraintIslands& operator=(const ChConstraintIslands& other) { return *this; }
+
+    /// Partition the problem in the given descriptor and return the number of islands.
+    /// The variable offsets in the descriptor must be up to date. If some constraint cannot report the variables it
+    /// acts upon, the whole problem is returned as a single island.
+    int Build(ChSystemDescriptor& sysd);
+
+    /// Return the number of islands found at the last call to Build().
+    int GetNumIslands() const { return num_islands; }
+
+    /// Access the i-th island found at the last call to Build().
+    const Island& GetIsland(int i) const { return islands[i]; }
+
+  private:
+    int FindRoot(int i);
+
+    int num_islands;
+    std::vector<Island> islands;  ///< island storage, reused between successive partitions
+
+    std::vector<int> parent;           ///< union-find forest over the variables in the descriptor
+    std::vector<int> var_index;        ///< index in the descriptor of the active variable at given offset
+    std::vector<int> constraint_root;  ///< representative variable of each constraint (-1 if none)
+    std::vector<int> island_index;     ///< island of each representative variable
+    std::vector<ChVariables*> cvars;   ///< scratch list of variables of a constraint
+};
+
+/// @} chrono_solver
+
+}  // end namespace chrono
+
+#endif
@@ -123,6 +123,13 @@ class ChConstraintTwoTuples : public ChConstraint {
         tuple_a.Build_CqT(storage, inscol);
         tuple_b.Build_CqT(storage, inscol);
     }
+
+    /// Append the variable objects of both tuples to 'vars'.
+    virtual bool AppendVariables(std::vector<ChVariables*>& vars) override {
+        tuple_a.AppendVariables(vars);
+        tuple_b.AppendVariables(vars);
+        return true;
+    }
 };
 
 }  // end namespace chrono
@@ -23,6 +23,7 @@ ChDirectSolverLS::ChDirectSolverLS()
     : m_lock(false),
       m_use_learner(true),
       m_force_update(true),
+      m_use_plan(true),
       m_null_pivot_detection(false),
       m_use_rhs_sparsity(false),
       m_use_perm(false),
@@ -66,6 +67,10 @@ bool ChDirectSolverLS::Setup(ChSystemDescriptor& sysd) {
         GetLog() << "  CALL reserve:   " << call_reserve << "\n";
     }
 
+    // A new sparsity pattern invalidates the assembly plan
+    if (call_learner || call_reserve || !m_lock || !m_use_plan)
+        m_plan.Reset();
+
     if (call_learner) {
         ChSparsityPatternLearner sparsity_pattern(m_dim, m_dim);
         sysd.ConvertToMatrixForm(&sparsity_pattern, nullptr);
@@ -77,8 +82,13 @@ bool ChDirectSolverLS::Setup(ChSystemDescriptor& sysd) {
         m_mat.reserve(Eigen::VectorXi::Constant(m_dim, static_cast<int>(m_dim * density)));
     }
 
-    // Let the system descriptor load the current matrix
-    sysd.ConvertToMatrixForm(&m_mat, nullptr);
+    // Load the current matrix, using the assembly plan if the sparsity pattern is locked and already compressed.
+    // Otherwise (or if the plan cannot be used) let the system descriptor load the current matrix.
+    bool assembled = false;
+    if (m_lock && m_use_plan && m_mat.rows() == m_dim)
+        assembled = m_plan.Assemble(sysd, m_mat);
+    if (!assembled)
+        sysd.ConvertToMatrixForm(&m_mat, nullptr);
 
     // Allow the matrix to be compressed
     m_mat.makeCompressed();
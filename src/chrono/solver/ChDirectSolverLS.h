@@ -18,6 +18,7 @@
 #include "chrono/core/ChMatrix.h"
 #include "chrono/core/ChTimer.h"
 #include "chrono/solver/ChSolverLS.h"
+#include "chrono/solver/ChSparseAssemblyPlan.h"
 
 #include <Eigen/SparseLU>
 
@@ -56,6 +57,11 @@ to a fully dense matrix). This value is used if the sparsity pattern learner is
 space for matrix indices and nonzeros.
 See #SetSparsityEstimate();
 
+When the sparsity pattern is locked, the matrix is assembled by default through an assembly plan (see
+ChSparseAssemblyPlan), which caches the location of all matrix elements in the compressed storage and assembles
+stiffness blocks, variables, and constraints in parallel.\n
+See #UseAssemblyPlan();
+
 <br>
 
 <div class="ce-warning">
@@ -87,6 +93,11 @@ class ChApi ChDirectSolverLS : public ChSolverLS {
     /// Disable for smaller problems where the overhead may be too large.
     void UseSparsityPatternLearner(bool val) { m_use_learner = val; }
 
+    /// Enable/disable use of a precomputed assembly plan when the sparsity pattern is locked (default: enabled).\n
+    /// The plan is recorded at the first assembly with a locked pattern and is re-recorded whenever the problem
+    /// structure changes.
+    void UseAssemblyPlan(bool val) { m_use_plan = val; }
+
     /// Force a call to the sparsity pattern learner to update sparsity pattern on the underlying matrix.\n
     /// Such a call may be needed in a situation where the sparsity pattern is locked, but a change in the problem size
     /// or structure occurred. This function has no effect if the sparsity pattern learner is disabled.
@@ -200,6 +211,9 @@ class ChApi ChDirectSolverLS : public ChSolverLS {
     bool m_lock;          ///< is the matrix sparsity pattern locked?
     bool m_use_learner;   ///< use the sparsity pattern learner?
     bool m_force_update;  ///< force a call to the sparsity pattern learner?
+    bool m_use_plan;      ///< use the assembly plan with a locked sparsity pattern?
+
+    ChSparseAssemblyPlan m_plan;  ///< cached matrix assembly plan
 
     bool m_use_perm;              ///< use of the permutation vector?
     bool m_use_rhs_sparsity;      ///< leverage right-hand side sparsity?
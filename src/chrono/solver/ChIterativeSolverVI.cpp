@@ -26,7 +26,8 @@ ChIterativeSolverVI::ChIterativeSolverVI()
       m_omega(1.0),
       m_shlambda(1.0),
       m_iterations(0),
-      record_violation_history(false) {}
+      record_violation_history(false),
+      m_use_islands(false) {}
 
 void ChIterativeSolverVI::SetOmega(double mval) {
     if (mval > 0.)
@@ -38,6 +39,16 @@ void ChIterativeSolverVI::SetSharpnessLambda(double mval) {
         m_shlambda = mval;
 }
 
+void ChIterativeSolverVI::CopySettingsTo(ChIterativeSolverVI& solver) const {
+    solver.m_max_iterations = m_max_iterations;
+    solver.m_tolerance = m_tolerance;
+    solver.m_use_precond = m_use_precond;
+    solver.m_warm_start = m_warm_start;
+    solver.m_omega = m_omega;
+    solver.m_shlambda = m_shlambda;
+    solver.verbose = verbose;
+}
+
 void ChIterativeSolverVI::AtIterationEnd(double mmaxviolation, double mdeltalambda, unsigned int iternum) {
     if (!record_violation_history)
         return;
@@ -15,8 +15,15 @@
 #ifndef CH_ITERATIVESOLVER_VI_H
 #define CH_ITERATIVESOLVER_VI_H
 
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <vector>
+
 #include "chrono/solver/ChSolverVI.h"
 #include "chrono/solver/ChIterativeSolver.h"
+#include "chrono/solver/ChConstraintIslands.h"
+#include "chrono/utils/ChOpenMP.h"
 
 namespace chrono {
 
@@ -51,6 +58,14 @@ The 'tolerance' threshold value used in the stopping criteria may have different
 individual iterative VI solver for details.
 
 Diagonal preconditioning is enabled by default, but may not supported by all iterative VI solvers.
+
+If enabled (see EnableIslands), the problem is first partitioned in independent islands of variables coupled by
+constraints, and each island is solved separately, with its own stopping criteria, by a solver with the same
+settings. The per-thread solvers and sub-problem descriptors are created at the first split solve and reused. Islands
+are processed concurrently, using the number of threads set in the system descriptor (see
+ChSystemDescriptor::SetNumThreads). This is beneficial for scenes with many independent groups of objects (e.g.,
+separate stacks or piles), since an island that converges quickly does not have to perform the same number of
+iterations as the slowest one.
 */
 class ChApi ChIterativeSolverVI : public ChIterativeSolver, public ChSolverVI {
   public:
@@ -73,6 +88,17 @@ class ChApi ChIterativeSolverVI : public ChIterativeSolver, public ChSolverVI {
     /// GetViolationHistory).
     void SetRecordViolation(bool mval) { record_violation_history = mval; }
 
+    /// Enable/disable solving independent islands of the problem separately (default: false).
+    /// Not all iterative VI solvers support islands; for those that do not, this setting is ignored.
+    /// Note that the constraint violation history is not recorded when the problem is split in islands.
+    void EnableIslands(bool mval) { m_use_islands = mval; }
+
+    /// Return true if independent islands of the problem are solved separately.
+    bool IslandsEnabled() const { return m_use_islands; }
+
+    /// Return the number of independent islands found during the last solve (if islands are enabled).
+    int GetNumIslands() const { return m_islands.GetNumIslands(); }
+
     /// Return the current value of the overrelaxation factor.
     double GetOmega() const { return m_omega; }
 
@@ -96,6 +122,10 @@ class ChApi ChIterativeSolverVI : public ChIterativeSolver, public ChSolverVI {
     /// Method to allow de-serialization of transient data from archives.
     virtual void ArchiveIn(ChArchiveIn& marchive) override;
 
+    /// Copy the settings of this solver to the given solver (of the same type), e.g. one used to solve an island.
+    /// A derived class with additional settings should override this function and call the base class version.
+    virtual void CopySettingsTo(ChIterativeSolverVI& solver) const;
+
   protected:
     /// This method MUST be called by all iterative methods INSIDE their iteration loops
     /// (at the end). If history recording is enabled, this function will store the
@@ -103,7 +133,18 @@ class ChApi ChIterativeSolverVI : public ChIterativeSolver, public ChSolverVI {
     /// Note: 'iternum' starts at 0 for the first iteration.
     void AtIterationEnd(double mmaxviolation, double mdeltalambda, unsigned int iternum);
 
-  protected:
+    /// Partition the problem in islands, if enabled.
+    /// Return true if the problem should be solved through SolveIslands (i.e., islands are enabled and more than one
+    /// island was found).
+    bool PartitionIslands(ChSystemDescriptor& sysd) { return m_use_islands && m_islands.Build(sysd) > 1; }
+
+    /// Solve each island found by PartitionIslands as a separate problem, using per-thread solvers of the given type
+    /// with the same settings as this solver.
+    /// Return the maximum of the errors reported for the islands and set the number of iterations to the maximum
+    /// number of iterations performed for any island.
+    template <class Tsolver>
+    double SolveIslands(ChSystemDescriptor& sysd);
+
     /// Indicate whether ot not the Solve() phase requires an up-to-date problem matrix.
     /// Typically, this is the case for iterative solvers (as the matrix is needed for
     /// the matrix-vector operations).
@@ -116,8 +157,80 @@ class ChApi ChIterativeSolverVI : public ChIterativeSolver, public ChSolverVI {
     bool record_violation_history;
     std::vector<double> violation_history;
     std::vector<double> dlambda_history;
+
+    bool m_use_islands;             ///< solve independent islands separately?
+    ChConstraintIslands m_islands;  ///< partition of the problem in independent islands
+
+  private:
+    /// Per-thread solvers and sub-problems used by SolveIslands.
+    /// This scratch data is not copied with the solver.
+    struct IslandWorkspace {
+        IslandWorkspace() {}
+        IslandWorkspace(const IslandWorkspace&) {}
+        IslandWorkspace& operator=(const IslandWorkspace&) { return *this; }
+
+        std::vector<std::unique_ptr<ChIterativeSolverVI>> solvers;
+        std::vector<std::unique_ptr<ChSystemDescriptor>> descriptors;
+    };
+
+    IslandWorkspace m_island_workspace;
 };
 
+template <class Tsolver>
+double ChIterativeSolverVI::SolveIslands(ChSystemDescriptor& sysd) {
+    int nislands = m_islands.GetNumIslands();
+    int nthreads = std::max(1, std::min(sysd.GetNumThreads(), nislands));
+
+    // Process larger islands first, for better load balancing
+    std::vector<int> order(nislands);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [this](int a, int b) {
+        return m_islands.GetIsland(a).constraints.size() > m_islands.GetIsland(b).constraints.size();
+    });
+
+    // One solver and one sub-problem per thread, kept between calls (only the settings are refreshed)
+    auto& solvers = m_island_workspace.solvers;
+    auto& descriptors = m_island_workspace.descriptors;
+    while ((int)solvers.size() < nthreads) {
+        solvers.push_back(std::unique_ptr<ChIterativeSolverVI>(new Tsolver));
+        descriptors.push_back(std::unique_ptr<ChSystemDescriptor>(new ChSystemDescriptor));
+    }
+    for (int t = 0; t < nthreads; t++) {
+        CopySettingsTo(*solvers[t]);
+        solvers[t]->EnableIslands(false);
+        solvers[t]->SetRecordViolation(false);
+        descriptors[t]->SetMassFactor(sysd.GetMassFactor());
+    }
+
+    std::vector<double> errors(nislands, 0.0);
+    std::vector<int> iterations(nislands, 0);
+
+#pragma omp parallel for schedule(dynamic, 1) num_threads(nthreads)
+    for (int k = 0; k < nislands; k++) {
+        int i = order[k];
+        int t = ChOMP::GetThreadNum();
+        const ChConstraintIslands::Island& island = m_islands.GetIsland(i);
+
+        // Islands do not share variables or constraints, so setting their offsets is thread safe
+        ChSystemDescriptor& descriptor = *descriptors[t];
+        descriptor.BeginInsertion();
+        for (auto constraint : island.constraints)
+            descriptor.InsertConstraint(constraint);
+        for (auto variables : island.variables)
+            descriptor.InsertVariables(variables);
+        descriptor.EndInsertion();
+
+        errors[i] = solvers[t]->Solve(descriptor);
+        iterations[i] = solvers[t]->GetIterations();
+    }
+
+    // Restore the offsets of variables and constraints in the complete problem
+    sysd.UpdateCountsAndOffsets();
+
+    m_iterations = *std::max_element(iterations.begin(), iterations.end());
+    return *std::max_element(errors.begin(), errors.end());
+}
+
 /// @} chrono_solver
 
 }  // end namespace chrono
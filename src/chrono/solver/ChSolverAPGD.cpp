@@ -72,6 +72,12 @@ double ChSolverAPGD::Res4(ChSystemDescriptor& sysd) {
 }
 
 double ChSolverAPGD::Solve(ChSystemDescriptor& sysd) {
+    // Solve independent islands separately, if enabled
+    if (PartitionIslands(sysd)) {
+        residual = SolveIslands<ChSolverAPGD>(sysd);
+        return residual;
+    }
+
     bool verbose = false;
     const std::vector<ChConstraint*>& mconstraints = sysd.GetConstraintsList();
     const std::vector<ChVariables*>& mvariables = sysd.GetVariablesList();
@@ -31,6 +31,12 @@ double ChSolverBB::Solve(ChSystemDescriptor& sysd) {
         throw ChException("ChSolverBB: Do NOT use Barzilai-Borwein solver if there are stiffness matrices.");
     }
 
+    // Solve independent islands separately, if enabled
+    if (PartitionIslands(sysd)) {
+        lastgoodres = SolveIslands<ChSolverBB>(sysd);
+        return lastgoodres;
+    }
+
     // Tuning of the spectral gradient search
     double a_min = 1e-13;
     double a_max = 1e13;
@@ -349,6 +355,13 @@ double ChSolverBB::Solve(ChSystemDescriptor& sysd) {
 //////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////
 
+void ChSolverBB::CopySettingsTo(ChIterativeSolverVI& solver) const {
+    ChIterativeSolverVI::CopySettingsTo(solver);
+    auto& bb = static_cast<ChSolverBB&>(solver);
+    bb.n_armijo = n_armijo;
+    bb.max_armijo_backtrace = max_armijo_backtrace;
+}
+
 void ChSolverBB::ArchiveOut(ChArchiveOut& marchive) {
     // version number
     marchive.VersionWrite<ChSolverBB>();
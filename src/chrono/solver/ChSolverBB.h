@@ -59,6 +59,9 @@ class ChApi ChSolverBB : public ChIterativeSolverVI {
     /// Method to allow de serialization of transient data from archives.
     virtual void ArchiveIn(ChArchiveIn& marchive) override;
 
+    /// Copy the settings of this solver, including the Armijo line search settings, to the given solver.
+    virtual void CopySettingsTo(ChIterativeSolverVI& solver) const override;
+
   private:
     int n_armijo;
     int max_armijo_backtrace;
@@ -25,6 +25,12 @@ ChSolverPJacobi::ChSolverPJacobi() : maxviolation(0) {
 }
 
 double ChSolverPJacobi::Solve(ChSystemDescriptor& sysd) {
+    // Solve independent islands separately, if enabled
+    if (PartitionIslands(sysd)) {
+        maxviolation = SolveIslands<ChSolverPJacobi>(sysd);
+        return maxviolation;
+    }
+
     std::vector<ChConstraint*>& mconstraints = sysd.GetConstraintsList();
     std::vector<ChVariables*>& mvariables = sysd.GetVariablesList();
 
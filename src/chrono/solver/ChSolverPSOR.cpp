@@ -24,6 +24,12 @@ CH_UPCASTING(ChSolverPSOR, ChIterativeSolverVI)
 ChSolverPSOR::ChSolverPSOR() : maxviolation(0) {}
 
 double ChSolverPSOR::Solve(ChSystemDescriptor& sysd) {
+    // Solve independent islands separately, if enabled
+    if (PartitionIslands(sysd)) {
+        maxviolation = SolveIslands<ChSolverPSOR>(sysd);
+        return maxviolation;
+    }
+
     std::vector<ChConstraint*>& mconstraints = sysd.GetConstraintsList();
     std::vector<ChVariables*>& mvariables = sysd.GetVariablesList();
 
@@ -23,6 +23,12 @@ CH_FACTORY_REGISTER(ChSolverPSSOR)
 ChSolverPSSOR::ChSolverPSSOR() : maxviolation(0) {}
 
 double ChSolverPSSOR::Solve(ChSystemDescriptor& sysd) {
+    // Solve independent islands separately, if enabled
+    if (PartitionIslands(sysd)) {
+        maxviolation = SolveIslands<ChSolverPSSOR>(sysd);
+        return maxviolation;
+    }
+
     std::vector<ChConstraint*>& mconstraints = sysd.GetConstraintsList();
     std::vector<ChVariables*>& mvariables = sysd.GetVariablesList();
 
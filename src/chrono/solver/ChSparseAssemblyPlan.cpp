@@ -0,0 +1,288 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cstdint>
+
+#include "chrono/solver/ChSparseAssemblyPlan.h"
+
+namespace chrono {
+
+// Matrix proxy used while recording a plan: elements are set in the target matrix (which must already contain them in
+// its sparsity pattern) and the index of each element in the value array is recorded.
+class ChSparseAssemblyRecorder : public ChSparseMatrix {
+  public:
+    ChSparseAssemblyRecorder(ChSparseMatrix& mat, std::vector<int>& index)
+        : m_outer(mat.outerIndexPtr()), m_inner(mat.innerIndexPtr()), m_values(mat.valuePtr()), m_index(index),
+          m_failed(false) {}
+
+    virtual void SetElement(int row, int col, double el, bool overwrite = true) override {
+        const int* first = m_inner + m_outer[row];
+        const int* last = m_inner + m_outer[row + 1];
+        const int* it = std::lower_bound(first, last, col);
+        if (it == last || *it != col) {
+            m_failed = true;
+            return;
+        }
+        int k = (int)(it - m_inner);
+        overwrite ? m_values[k] = el : m_values[k] += el;
+        m_index.push_back(k);
+    }
+
+    bool Failed() const { return m_failed; }
+
+  private:
+    const int* m_outer;
+    const int* m_inner;
+    double* m_values;
+    std::vector<int>& m_index;
+    bool m_failed;
+};
+
+// Matrix proxy used while replaying a plan: the i-th element set in a range of the plan is written at the recorded
+// position in the value array, regardless of its row and column indices.
+class ChSparseAssemblyScatter : public ChSparseMatrix {
+  public:
+    ChSparseAssemblyScatter(double* values, const int* index)
+        : m_values(values), m_index(index), m_next(0), m_end(0), m_overflow(false) {}
+
+    void SetRange(int begin, int end) {
+        m_next = begin;
+        m_end = end;
+        m_overflow = false;
+    }
+
+    virtual void SetElement(int row, int col, double el, bool overwrite = true) override {
+        if (m_next >= m_end) {
+            m_overflow = true;
+            return;
+        }
+        int k = m_index[m_next++];
+        overwrite ? m_values[k] = el : m_values[k] += el;
+    }
+
+    /// Return true if exactly all elements in the current range were set.
+    bool Complete() const { return !m_overflow && m_next == m_end; }
+
+  private:
+    double* m_values;
+    const int* m_index;
+    int m_next;
+    int m_end;
+    bool m_overflow;
+};
+
+// -----------------------------------------------------------------------------
+
+void ChSparseAssemblyPlan::Reset() {
+    m_valid = false;
+    m_values = nullptr;
+    m_index.clear();
+    m_var_start.clear();
+    m_kb_start.clear();
+    m_con_start.clear();
+    m_variables.clear();
+    m_var_offset.clear();
+    m_kblocks.clear();
+    m_constraints.clear();
+    m_colors.clear();
+    m_serial.clear();
+}
+
+bool ChSparseAssemblyPlan::Assemble(ChSystemDescriptor& sysd, ChSparseMatrix& mat) {
+    if (!mat.isCompressed())
+        return false;
+
+    bool result = Matches(sysd, mat) ? Replay(sysd, mat) : Record(sysd, mat);
+    if (!result)
+        Reset();
+
+    return result;
+}
+
+bool ChSparseAssemblyPlan::Matches(ChSystemDescriptor& sysd, const ChSparseMatrix& mat) const {
+    if (!m_valid || mat.rows() != m_rows || (int)mat.nonZeros() != m_nnz || mat.valuePtr() != m_values)
+        return false;
+
+    if (sysd.GetKblocksList() != m_kblocks)
+        return false;
+
+    size_t iv = 0;
+    int s_q = 0;
+    for (auto var : sysd.GetVariablesList()) {
+        if (!var->IsActive())
+            continue;
+        if (iv >= m_variables.size() || var != m_variables[iv] || s_q != m_var_offset[iv])
+            return false;
+        s_q += var->Get_ndof();
+        iv++;
+    }
+    if (iv != m_variables.size() || s_q != m_n_q)
+        return false;
+
+    size_t ic = 0;
+    for (auto constraint : sysd.GetConstraintsList()) {
+        if (!constraint->IsActive())
+            continue;
+        if (ic >= m_constraints.size() || constraint != m_constraints[ic])
+            return false;
+        ic++;
+    }
+
+    return ic == m_constraints.size();
+}
+
+bool ChSparseAssemblyPlan::Record(ChSystemDescriptor& sysd, ChSparseMatrix& mat) {
+    Reset();
+
+    std::vector<ChVariables*>& mvariables = sysd.GetVariablesList();
+    std::vector<ChKblock*>& mstiffness = sysd.GetKblocksList();
+    std::vector<ChConstraint*>& mconstraints = sysd.GetConstraintsList();
+    double c_a = sysd.GetMassFactor();
+
+    int nnz = (int)mat.nonZeros();
+    std::fill(mat.valuePtr(), mat.valuePtr() + nnz, 0.0);
+
+    ChSparseAssemblyRecorder recorder(mat, m_index);
+    m_index.reserve(nnz);
+
+    // Masses and inertias in upper-left block
+    int s_q = 0;
+    for (auto var : mvariables) {
+        if (!var->IsActive())
+            continue;
+        m_variables.push_back(var);
+        m_var_offset.push_back(s_q);
+        m_var_start.push_back((int)m_index.size());
+        var->Build_M(recorder, s_q, s_q, c_a);
+        s_q += var->Get_ndof();
+    }
+    m_var_start.push_back((int)m_index.size());
+    m_n_q = s_q;
+
+    // Stiffness blocks added to upper-left block
+    m_kblocks = mstiffness;
+    for (auto kblock : mstiffness) {
+        m_kb_start.push_back((int)m_index.size());
+        kblock->Build_K(recorder, true);
+    }
+    m_kb_start.push_back((int)m_index.size());
+
+    // Constraint Jacobians and cfm terms
+    int s_c = 0;
+    for (auto constraint : mconstraints) {
+        if (!constraint->IsActive())
+            continue;
+        m_constraints.push_back(constraint);
+        m_con_start.push_back((int)m_index.size());
+        constraint->Build_Cq(recorder, m_n_q + s_c);
+        constraint->Build_CqT(recorder, m_n_q + s_c);
+        recorder.SetElement(m_n_q + s_c, m_n_q + s_c, constraint->Get_cfm_i());
+        s_c++;
+    }
+    m_con_start.push_back((int)m_index.size());
+
+    if (recorder.Failed() || mat.rows() != m_n_q + s_c)
+        return false;
+
+    m_rows = (int)mat.rows();
+    m_nnz = nnz;
+    m_values = mat.valuePtr();
+    ColorKblocks(nnz);
+    m_valid = true;
+
+    return true;
+}
+
+void ChSparseAssemblyPlan::ColorKblocks(int nnz) {
+    // Greedy coloring: each block gets the first color not used by any block sharing one of its elements.
+    // Blocks which cannot be assigned one of the 64 available colors are assembled sequentially.
+    std::vector<uint64_t> used(nnz, 0);
+    for (int ik = 0; ik < (int)m_kblocks.size(); ik++) {
+        uint64_t mask = 0;
+        for (int e = m_kb_start[ik]; e < m_kb_start[ik + 1]; e++)
+            mask |= used[m_index[e]];
+
+        if (~mask == 0) {
+            m_serial.push_back(ik);
+            continue;
+        }
+
+        int color = 0;
+        while (mask & (uint64_t(1) << color))
+            color++;
+        if (color >= (int)m_colors.size())
+            m_colors.resize(color + 1);
+        m_colors[color].push_back(ik);
+
+        for (int e = m_kb_start[ik]; e < m_kb_start[ik + 1]; e++)
+            used[m_index[e]] |= uint64_t(1) << color;
+    }
+}
+
+bool ChSparseAssemblyPlan::Replay(ChSystemDescriptor& sysd, ChSparseMatrix& mat) {
+    double* values = mat.valuePtr();
+    std::fill(values, values + m_nnz, 0.0);
+
+    double c_a = sysd.GetMassFactor();
+    int nthreads = sysd.GetNumThreads();
+    int nv = (int)m_variables.size();
+    int nc = (int)m_constraints.size();
+    bool failed = false;
+
+#pragma omp parallel num_threads(nthreads)
+    {
+        ChSparseAssemblyScatter scatter(values, m_index.data());
+
+        // Mass matrices of different variables do not overlap
+#pragma omp for reduction(|| : failed)
+        for (int iv = 0; iv < nv; iv++) {
+            scatter.SetRange(m_var_start[iv], m_var_start[iv + 1]);
+            m_variables[iv]->Build_M(scatter, m_var_offset[iv], m_var_offset[iv], c_a);
+            failed = failed || !scatter.Complete();
+        }
+
+        // Stiffness blocks with the same color do not overlap; colors are processed one after the other
+        for (const auto& color : m_colors) {
+            int nk = (int)color.size();
+#pragma omp for reduction(|| : failed)
+            for (int i = 0; i < nk; i++) {
+                int ik = color[i];
+                scatter.SetRange(m_kb_start[ik], m_kb_start[ik + 1]);
+                m_kblocks[ik]->Build_K(scatter, true);
+                failed = failed || !scatter.Complete();
+            }
+        }
+
+        // Each constraint sets its own row and column
+#pragma omp for reduction(|| : failed)
+        for (int ic = 0; ic < nc; ic++) {
+            int row = m_n_q + ic;
+            scatter.SetRange(m_con_start[ic], m_con_start[ic + 1]);
+            m_constraints[ic]->Build_Cq(scatter, row);
+            m_constraints[ic]->Build_CqT(scatter, row);
+            scatter.SetElement(row, row, m_constraints[ic]->Get_cfm_i());
+            failed = failed || !scatter.Complete();
+        }
+    }
+
+    ChSparseAssemblyScatter scatter(values, m_index.data());
+    for (auto ik : m_serial) {
+        scatter.SetRange(m_kb_start[ik], m_kb_start[ik + 1]);
+        m_kblocks[ik]->Build_K(scatter, true);
+        failed = failed || !scatter.Complete();
+    }
+
+    return !failed;
+}
+
+}  // end namespace chrono
@@ -0,0 +1,88 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#ifndef CH_SPARSE_ASSEMBLY_PLAN_H
+#define CH_SPARSE_ASSEMBLY_PLAN_H
+
+#include <vector>
+
+#include "chrono/solver/ChSystemDescriptor.h"
+
+namespace chrono {
+
+/// @addtogroup chrono_solver
+/// @{
+
+/// Precomputed map for assembling the system matrix of a ChSystemDescriptor into a compressed sparse matrix with a
+/// fixed sparsity pattern.
+/// The plan is recorded during one assembly, by storing the position in the matrix value array of every element set
+/// by the mass matrices (ChVariables::Build_M), the stiffness blocks (ChKblock::Build_K), and the constraint Jacobians
+/// (ChConstraint::Build_Cq and Build_CqT). Subsequent assemblies of a problem with the same structure write directly
+/// into the value array, with no search in the sparsity pattern. Stiffness blocks are partitioned in groups (colors) of
+/// blocks which do not share any matrix element; blocks in the same group, as well as variables and constraints, are
+/// assembled in parallel.
+class ChApi ChSparseAssemblyPlan {
+  public:
+    ChSparseAssemblyPlan() : m_valid(false), m_rows(0), m_nnz(0), m_values(nullptr), m_n_q(0) {}
+
+    /// Discard the current plan.
+    void Reset();
+
+    /// Return true if a plan was recorded.
+    bool IsValid() const { return m_valid; }
+
+    /// Return the number of stiffness block groups assembled in parallel.
+    int GetNumColors() const { return (int)m_colors.size(); }
+
+    /// Load the system matrix of the given descriptor into the specified matrix, which must be in compressed form and
+    /// have the size of the problem. If the descriptor structure matches the current plan, the matrix is assembled
+    /// using the plan; otherwise, a new plan is recorded.
+    /// Return false if the matrix could not be assembled (e.g., because an element is not in its sparsity pattern), in
+    /// which case the plan is discarded and the caller must fall back to ChSystemDescriptor::ConvertToMatrixForm.
+    bool Assemble(ChSystemDescriptor& sysd, ChSparseMatrix& mat);
+
+  private:
+    /// Return true if the plan was recorded for the same descriptor structure and matrix storage.
+    bool Matches(ChSystemDescriptor& sysd, const ChSparseMatrix& mat) const;
+
+    /// Assemble the matrix and record the value indices of all elements.
+    bool Record(ChSystemDescriptor& sysd, ChSparseMatrix& mat);
+
+    /// Assemble the matrix using the recorded value indices.
+    bool Replay(ChSystemDescriptor& sysd, ChSparseMatrix& mat);
+
+    /// Partition the stiffness blocks in groups with no shared matrix elements.
+    void ColorKblocks(int nnz);
+
+    bool m_valid;                  ///< was a plan recorded?
+    int m_rows;                    ///< matrix size
+    int m_nnz;                     ///< number of nonzeros in matrix
+    const double* m_values;        ///< matrix value array at recording
+    int m_n_q;                     ///< number of active degrees of freedom
+    std::vector<int> m_index;      ///< value index of each element set during assembly
+    std::vector<int> m_var_start;  ///< first element of each active variable mass matrix (plus end marker)
+    std::vector<int> m_kb_start;   ///< first element of each stiffness block (plus end marker)
+    std::vector<int> m_con_start;  ///< first element of each active constraint (plus end marker)
+
+    std::vector<ChVariables*> m_variables;     ///< active variables at recording
+    std::vector<int> m_var_offset;             ///< row offsets of active variables at recording
+    std::vector<ChKblock*> m_kblocks;          ///< stiffness blocks at recording
+    std::vector<ChConstraint*> m_constraints;  ///< active constraints at recording
+    std::vector<std::vector<int>> m_colors;    ///< groups of stiffness blocks with no shared elements
+    std::vector<int> m_serial;                 ///< stiffness blocks to be assembled sequentially
+};
+
+/// @} chrono_solver
+
+}  // end namespace chrono
+
+#endif
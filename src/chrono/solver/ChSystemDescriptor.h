@@ -15,6 +15,7 @@
 #ifndef CHSYSTEMDESCRIPTOR_H
 #define CHSYSTEMDESCRIPTOR_H
 
+#include <cassert>
 #include <vector>
 
 #include "chrono/solver/ChConstraint.h"
@@ -77,6 +78,8 @@ class ChApi ChSystemDescriptor {
 
     double c_a;  // coefficient form M mass matrices in vvariables
 
+    int nthreads;  ///< number of threads available to solvers
+
   private:
     int n_q;            ///< number of active variables
     int n_c;            ///< number of active constraints
@@ -107,6 +110,19 @@ class ChApi ChSystemDescriptor {
         vstiffness.clear();
     }
 
+    /// Begin insertion of items, keeping the first items inserted at the previous insertion.
+    /// Only the given numbers of constraints, variables, and Kblocks are retained; items inserted afterwards are
+    /// appended to them. This allows refreshing only the trailing part of the descriptor (e.g., contacts) when the
+    /// items that were inserted first did not change.
+    virtual void BeginInsertion(size_t nconstraints_kept, size_t nvariables_kept, size_t nkblocks_kept) {
+        assert(nconstraints_kept <= vconstraints.size());
+        assert(nvariables_kept <= vvariables.size());
+        assert(nkblocks_kept <= vstiffness.size());
+        vconstraints.resize(nconstraints_kept);
+        vvariables.resize(nvariables_kept);
+        vstiffness.resize(nkblocks_kept);
+    }
+
     /// Insert reference to a ChConstraint object
     virtual void InsertConstraint(ChConstraint* mc) { vconstraints.push_back(mc); }
 
@@ -146,6 +162,13 @@ class ChApi ChSystemDescriptor {
     /// when performing ShurComplementProduct(), SystemProduct(), ConvertToMatrixForm(),
     virtual double GetMassFactor() { return c_a; }
 
+    /// Set the number of threads that a solver may use when processing this problem (default: 1).
+    /// This is set automatically by the owner ChSystem, based on its number of Chrono threads.
+    void SetNumThreads(int num_threads) { nthreads = (num_threads > 1) ? num_threads : 1; }
+
+    /// Get the number of threads that a solver may use when processing this problem.
+    int GetNumThreads() const { return nthreads; }
+
     // DATA <-> MATH.VECTORS FUNCTIONS
 
     /// Get a vector with all the 'fb' known terms ('forces'etc.) associated to all variables,
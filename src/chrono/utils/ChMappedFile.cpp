@@ -0,0 +1,167 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#ifdef _WIN32
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#include "chrono/core/ChException.h"
+#include "chrono/utils/ChMappedFile.h"
+
+namespace chrono {
+namespace utils {
+
+#ifdef _WIN32
+
+ChMappedFile::ChMappedFile() : m_data(nullptr), m_size(0), m_file(INVALID_HANDLE_VALUE), m_mapping(nullptr) {}
+
+void ChMappedFile::OpenRead(const std::string& filename) {
+    Close();
+    m_file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING,
+                         FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (m_file == INVALID_HANDLE_VALUE)
+        throw ChException("Cannot open file " + filename);
+    Remap();
+}
+
+void ChMappedFile::OpenWrite(const std::string& filename, size_t size) {
+    Close();
+    m_file = CreateFileA(filename.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS,
+                         FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (m_file == INVALID_HANDLE_VALUE)
+        throw ChException("Cannot create file " + filename);
+    Resize(size);
+}
+
+void ChMappedFile::Resize(size_t size) {
+    Unmap();
+    LARGE_INTEGER end;
+    end.QuadPart = (LONGLONG)size;
+    if (!SetFilePointerEx(m_file, end, nullptr, FILE_BEGIN) || !SetEndOfFile(m_file))
+        throw ChException("Cannot resize mapped file");
+    m_size = size;
+    Map(true);
+}
+
+void ChMappedFile::Remap() {
+    Unmap();
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(m_file, &size))
+        throw ChException("Cannot get size of mapped file");
+    m_size = (size_t)size.QuadPart;
+    Map(false);
+}
+
+void ChMappedFile::Map(bool writable) {
+    if (m_size == 0)
+        return;
+    m_mapping = CreateFileMappingA(m_file, nullptr, writable ? PAGE_READWRITE : PAGE_READONLY, 0, 0, nullptr);
+    if (m_mapping)
+        m_data = (char*)MapViewOfFile(m_mapping, writable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, m_size);
+    if (!m_data)
+        throw ChException("Cannot map file");
+}
+
+void ChMappedFile::Unmap() {
+    if (m_data)
+        UnmapViewOfFile(m_data);
+    if (m_mapping)
+        CloseHandle(m_mapping);
+    m_data = nullptr;
+    m_mapping = nullptr;
+}
+
+void ChMappedFile::Close() {
+    Unmap();
+    if (m_file != INVALID_HANDLE_VALUE)
+        CloseHandle(m_file);
+    m_file = INVALID_HANDLE_VALUE;
+    m_size = 0;
+}
+
+#else
+
+ChMappedFile::ChMappedFile() : m_data(nullptr), m_size(0), m_file(-1) {}
+
+void ChMappedFile::OpenRead(const std::string& filename) {
+    Close();
+    m_file = open(filename.c_str(), O_RDONLY);
+    if (m_file < 0)
+        throw ChException("Cannot open file " + filename);
+    Remap();
+}
+
+void ChMappedFile::OpenWrite(const std::string& filename, size_t size) {
+    Close();
+    m_file = open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (m_file < 0)
+        throw ChException("Cannot create file " + filename);
+    Resize(size);
+}
+
+void ChMappedFile::Resize(size_t size) {
+    Unmap();
+    if (ftruncate(m_file, (off_t)size) != 0)
+        throw ChException("Cannot resize mapped file");
+    m_size = size;
+    Map(true);
+}
+
+void ChMappedFile::Remap() {
+    Unmap();
+    struct stat info;
+    if (fstat(m_file, &info) != 0)
+        throw ChException("Cannot get size of mapped file");
+    m_size = (size_t)info.st_size;
+    Map(false);
+}
+
+void ChMappedFile::Map(bool writable) {
+    if (m_size == 0)
+        return;
+    int prot = writable ? PROT_READ | PROT_WRITE : PROT_READ;
+    void* data = mmap(nullptr, m_size, prot, MAP_SHARED, m_file, 0);
+    if (data == MAP_FAILED)
+        throw ChException("Cannot map file");
+    m_data = (char*)data;
+}
+
+void ChMappedFile::Unmap() {
+    if (m_data)
+        munmap(m_data, m_size);
+    m_data = nullptr;
+}
+
+void ChMappedFile::Close() {
+    Unmap();
+    if (m_file >= 0)
+        close(m_file);
+    m_file = -1;
+    m_size = 0;
+}
+
+#endif
+
+ChMappedFile::~ChMappedFile() {
+    Close();
+}
+
+}  // end namespace utils
+}  // end namespace chrono
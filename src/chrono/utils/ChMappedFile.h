@@ -0,0 +1,70 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#ifndef CH_MAPPED_FILE_H
+#define CH_MAPPED_FILE_H
+
+#include <string>
+
+#include "chrono/core/ChApiCE.h"
+
+namespace chrono {
+namespace utils {
+
+/// @addtogroup chrono_utils
+/// @{
+
+/// Memory-mapped file.
+class ChApi ChMappedFile {
+  public:
+    ChMappedFile();
+    ~ChMappedFile();
+
+    /// Map an existing file for reading.
+    void OpenRead(const std::string& filename);
+
+    /// Create (or truncate) a file and map it for reading and writing, with the given initial size.
+    void OpenWrite(const std::string& filename, size_t size);
+
+    /// Change the size of a file opened for writing. The mapping may be moved.
+    void Resize(size_t size);
+
+    /// Map again a file opened for reading, to include any data appended since it was opened.
+    void Remap();
+
+    /// Unmap and close the file.
+    void Close();
+
+    bool IsOpen() const { return m_data != nullptr; }
+    char* GetData() const { return m_data; }
+    size_t GetSize() const { return m_size; }
+
+  private:
+    void Map(bool writable);
+    void Unmap();
+
+    char* m_data;
+    size_t m_size;
+#ifdef _WIN32
+    void* m_file;
+    void* m_mapping;
+#else
+    int m_file;
+#endif
+};
+
+/// @} chrono_utils
+
+}  // end namespace utils
+}  // end namespace chrono
+
+#endif
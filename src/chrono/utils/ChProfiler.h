@@ -33,8 +33,10 @@ CODE MODIFIED FROM:
 #ifndef CHPROFILER_H
 #define CHPROFILER_H
 
-//To disable built-in profiling, please comment out next line
-//#define CH_NO_PROFILE 1
+// Built-in profiling is disabled, together with tracing, if CH_NO_PROFILE is defined in ChConfig.h
+// (CMake option ENABLE_PROFILING)
+#include "chrono/ChConfig.h"
+#include "chrono/utils/ChTrace.h"
 
 #ifndef CH_NO_PROFILE
 
@@ -157,10 +159,12 @@ private:
 
 
 ///ProfileSampleClass is a simple way to profile a function's scope
-///Use the BT_PROFILE macro at the start of scope to time
+///Use the CH_PROFILE macro at the start of scope to time.
+///The scope is also recorded as an event of the calling thread if tracing is enabled (see ChTrace).
+///Note that the profile hierarchy is not thread safe: use CH_TRACE in code run by worker threads.
 class  ChApi  CProfileSample {
 public:
-	CProfileSample( const char * name )
+	CProfileSample( const char * name ) : trace( name )
 	{ 
 		ChProfileManager::Start_Profile( name ); 
 	}
@@ -169,6 +173,9 @@ public:
 	{ 
 		ChProfileManager::Stop_Profile(); 
 	}
+
+private:
+	ChTraceScope trace;
 };
 
 
@@ -0,0 +1,150 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "chrono/core/ChException.h"
+#include "chrono/utils/ChTrace.h"
+
+namespace chrono {
+namespace utils {
+
+namespace {
+
+struct TraceEvent {
+    const char* name;
+    int64_t start;
+    int64_t duration;
+};
+
+struct ThreadBuffer {
+    int tid;
+    std::string name;
+    std::vector<TraceEvent> events;
+};
+
+// Buffers of all threads which recorded events. Buffers are never deleted, since threads keep a pointer to their own.
+std::mutex& RegistryMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+std::vector<std::unique_ptr<ThreadBuffer>>& Registry() {
+    static std::vector<std::unique_ptr<ThreadBuffer>> registry;
+    return registry;
+}
+
+thread_local ThreadBuffer* local_buffer = nullptr;
+
+ThreadBuffer* LocalBuffer() {
+    if (!local_buffer) {
+        std::lock_guard<std::mutex> lock(RegistryMutex());
+        auto& registry = Registry();
+        auto buffer = new ThreadBuffer;
+        buffer->tid = (int)registry.size();
+        buffer->name = "Thread " + std::to_string(buffer->tid);
+        buffer->events.reserve(1024);
+        registry.emplace_back(buffer);
+        local_buffer = buffer;
+    }
+    return local_buffer;
+}
+
+const std::chrono::steady_clock::time_point time_origin = std::chrono::steady_clock::now();
+
+// Write a string as a JSON string literal
+void WriteJSONString(FILE* file, const char* str) {
+    fputc('"', file);
+    for (const char* c = str; *c; c++) {
+        if (*c == '"' || *c == '\\')
+            fputc('\\', file);
+        if ((unsigned char)*c < 0x20)
+            fputc(' ', file);
+        else
+            fputc(*c, file);
+    }
+    fputc('"', file);
+}
+
+}  // end anonymous namespace
+
+std::atomic<bool> ChTrace::enabled(false);
+
+void ChTrace::Enable(bool val) {
+    enabled.store(val);
+}
+
+void ChTrace::SetThreadName(const std::string& name) {
+    ThreadBuffer* buffer = LocalBuffer();
+    std::lock_guard<std::mutex> lock(RegistryMutex());
+    buffer->name = name;
+}
+
+int64_t ChTrace::Now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - time_origin).count();
+}
+
+void ChTrace::Record(const char* name, int64_t start, int64_t end) {
+    LocalBuffer()->events.push_back({name, start, end - start});
+}
+
+void ChTrace::Clear() {
+    std::lock_guard<std::mutex> lock(RegistryMutex());
+    for (auto& buffer : Registry())
+        buffer->events.clear();
+}
+
+size_t ChTrace::GetNumEvents() {
+    std::lock_guard<std::mutex> lock(RegistryMutex());
+    size_t num_events = 0;
+    for (auto& buffer : Registry())
+        num_events += buffer->events.size();
+    return num_events;
+}
+
+void ChTrace::ExportChromeTrace(const std::string& filename) {
+    FILE* file = fopen(filename.c_str(), "w");
+    if (!file)
+        throw ChException("Cannot open trace file " + filename);
+
+    std::lock_guard<std::mutex> lock(RegistryMutex());
+
+    // Times are exported in microseconds, with nanosecond resolution
+    fprintf(file, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+    bool first = true;
+    for (auto& buffer : Registry()) {
+        fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%d,\"args\":{\"name\":",
+                first ? "" : ",\n", buffer->tid);
+        WriteJSONString(file, buffer->name.c_str());
+        fprintf(file, "}}");
+        first = false;
+        for (const auto& event : buffer->events) {
+            fprintf(file, ",\n{\"name\":");
+            WriteJSONString(file, event.name);
+            fprintf(file, ",\"ph\":\"X\",\"pid\":0,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}", buffer->tid,
+                    event.start * 1e-3, event.duration * 1e-3);
+        }
+    }
+    fprintf(file, "\n]}\n");
+
+    bool ok = !ferror(file);
+    fclose(file);
+    if (!ok)
+        throw ChException("Error writing trace file " + filename);
+}
+
+}  // end namespace utils
+}  // end namespace chrono
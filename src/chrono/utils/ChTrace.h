@@ -0,0 +1,109 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Thread-aware scoped instrumentation, with export to the Chrome trace event
+// format (viewable in chrome://tracing or https://ui.perfetto.dev).
+//
+// Usage:
+//    CH_TRACE("name");   // records the enclosing scope, in the calling thread
+//
+//    utils::ChTrace::Enable(true);
+//    ... run the simulation ...
+//    utils::ChTrace::ExportChromeTrace("trace.json");
+//
+// Recording is disabled by default, in which case a traced scope only costs a
+// check of a flag. Tracing is compiled out, together with CH_PROFILE, if
+// CH_NO_PROFILE is defined in ChConfig.h (CMake option ENABLE_PROFILING).
+//
+// =============================================================================
+
+#ifndef CH_TRACE_H
+#define CH_TRACE_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#include "chrono/ChConfig.h"
+#include "chrono/core/ChApiCE.h"
+
+namespace chrono {
+namespace utils {
+
+/// @addtogroup chrono_utils
+/// @{
+
+/// Recorder of timed events, with one event buffer per thread.
+/// Each thread appends events to its own buffer, without synchronization. Event names are not copied, so they must
+/// have static storage (e.g., string literals). Clear() and ExportChromeTrace() must not be called while traced code
+/// is running in other threads.
+class ChApi ChTrace {
+  public:
+    /// Enable/disable recording of events (default: disabled).
+    static void Enable(bool val);
+
+    /// Return true if events are being recorded.
+    static bool IsEnabled() { return enabled.load(std::memory_order_relaxed); }
+
+    /// Set the name of the calling thread, as shown in the exported trace.
+    static void SetThreadName(const std::string& name);
+
+    /// Return the current time, in nanoseconds since an arbitrary origin.
+    static int64_t Now();
+
+    /// Record an event in the buffer of the calling thread. Times are in nanoseconds (see Now()).
+    static void Record(const char* name, int64_t start, int64_t end);
+
+    /// Discard all recorded events.
+    static void Clear();
+
+    /// Get the total number of recorded events, in all threads.
+    static size_t GetNumEvents();
+
+    /// Write all recorded events to a JSON file in the Chrome trace event format.
+    /// Throw a ChException if the file cannot be written.
+    static void ExportChromeTrace(const std::string& filename);
+
+  private:
+    static std::atomic<bool> enabled;
+};
+
+/// Record the lifetime of this object as an event, if recording is enabled when it is created.
+class ChTraceScope {
+  public:
+    explicit ChTraceScope(const char* name) : m_name(name), m_start(ChTrace::IsEnabled() ? ChTrace::Now() : -1) {}
+
+    ~ChTraceScope() {
+        if (m_start >= 0)
+            ChTrace::Record(m_name, m_start, ChTrace::Now());
+    }
+
+  private:
+    const char* m_name;
+    int64_t m_start;
+};
+
+/// @} chrono_utils
+
+}  // end namespace utils
+}  // end namespace chrono
+
+#define CH_TRACE_CONCAT_IMPL(a, b) a##b
+#define CH_TRACE_CONCAT(a, b) CH_TRACE_CONCAT_IMPL(a, b)
+
+#ifndef CH_NO_PROFILE
+    #define CH_TRACE(name) chrono::utils::ChTraceScope CH_TRACE_CONCAT(ch_trace_, __LINE__)(name)
+#else
+    #define CH_TRACE(name)
+#endif
+
+#endif
@@ -0,0 +1,352 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+#include "chrono/core/ChException.h"
+#include "chrono/fea/ChMesh.h"
+#include "chrono/physics/ChSystem.h"
+#include "chrono/utils/ChTrajectoryOutput.h"
+
+namespace chrono {
+namespace utils {
+
+static const char trajectory_magic[8] = "CHTRAJ";
+static const uint32_t trajectory_version = 2;
+
+static_assert(sizeof(TrajectoryHeader) == 64, "Unexpected size of trajectory file header");
+static_assert(sizeof(TrajectoryItem) == 160, "Unexpected size of trajectory file item");
+
+// -----------------------------------------------------------------------------
+// ChTrajectoryWriter
+// -----------------------------------------------------------------------------
+
+ChTrajectoryWriter::ChTrajectoryWriter(unsigned int ring_size)
+    : m_sys(nullptr),
+      m_nx(0),
+      m_nv(0),
+      m_frame_doubles(0),
+      m_frames_offset(0),
+      m_ring_size(std::max(ring_size, 1u)),
+      m_num_queued(0),
+      m_num_written(0),
+      m_stop(false) {}
+
+ChTrajectoryWriter::~ChTrajectoryWriter() {
+    Close();
+}
+
+// Append table entries for the given physics items, with consecutive ranges in the frame states
+template <class T>
+static void AddItems(const std::vector<std::shared_ptr<T>>& list,
+                     TrajectoryItem::Type type,
+                     std::vector<std::shared_ptr<ChPhysicsItem>>& items,
+                     std::vector<TrajectoryItem>& table,
+                     uint64_t& nx,
+                     uint64_t& nv) {
+    for (auto& item : list) {
+        TrajectoryItem entry;
+        std::memset(&entry, 0, sizeof(entry));
+        std::strncpy(entry.name, item->GetName(), sizeof(entry.name) - 1);
+        entry.type = type;
+        entry.offset_x = nx;
+        entry.offset_w = nv;
+        entry.nx = item->GetDOF();
+        entry.nv = item->GetDOF_w();
+        nx += entry.nx;
+        nv += entry.nv;
+        items.push_back(item);
+        table.push_back(entry);
+    }
+}
+
+void ChTrajectoryWriter::Open(const std::string& filename, ChSystem& sys) {
+    Close();
+
+    sys.Setup();
+
+    m_items.clear();
+    m_table.clear();
+    m_nx = 0;
+    m_nv = 0;
+    AddItems(sys.Get_bodylist(), TrajectoryItem::BODY, m_items, m_table, m_nx, m_nv);
+    AddItems(sys.Get_shaftlist(), TrajectoryItem::SHAFT, m_items, m_table, m_nx, m_nv);
+    AddItems(sys.Get_linklist(), TrajectoryItem::LINK, m_items, m_table, m_nx, m_nv);
+    AddItems(sys.Get_meshlist(), TrajectoryItem::MESH, m_items, m_table, m_nx, m_nv);
+    AddItems(sys.Get_otherphysicslist(), TrajectoryItem::OTHER, m_items, m_table, m_nx, m_nv);
+
+    for (size_t i = 0; i < sys.Get_bodylist().size(); i++) {
+        const ChVector<>& pos = sys.Get_bodylist()[i]->GetPos();
+        const ChQuaternion<>& rot = sys.Get_bodylist()[i]->GetRot();
+        double ref_pos[7] = {pos.x(), pos.y(), pos.z(), rot.e0(), rot.e1(), rot.e2(), rot.e3()};
+        std::memcpy(m_table[i].ref_pos, ref_pos, sizeof(ref_pos));
+    }
+
+    m_frame_doubles = 1 + m_nx + m_nv;
+    uint64_t frame_size = m_frame_doubles * sizeof(double);
+    uint64_t table_end = sizeof(TrajectoryHeader) + m_table.size() * sizeof(TrajectoryItem);
+    m_frames_offset = (table_end + 63) / 64 * 64;
+
+    // Reserve room for some frames; the file is grown geometrically while writing
+    m_file.OpenWrite(filename, (size_t)(m_frames_offset + 64 * frame_size));
+
+    TrajectoryHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, trajectory_magic, sizeof(header.magic));
+    header.version = trajectory_version;
+    header.num_items = (uint32_t)m_table.size();
+    header.nx = m_nx;
+    header.nv = m_nv;
+    header.frame_size = frame_size;
+    header.frames_offset = m_frames_offset;
+    header.num_frames = 0;
+    std::memcpy(m_file.GetData(), &header, sizeof(header));
+    if (!m_table.empty())
+        std::memcpy(m_file.GetData() + sizeof(header), m_table.data(), m_table.size() * sizeof(TrajectoryItem));
+
+    m_sys = &sys;
+    m_x.setZero(m_nx, &sys);
+    m_v.setZero(m_nv, &sys);
+    m_ring.assign(m_ring_size * m_frame_doubles, 0.0);
+    m_num_queued = 0;
+    m_num_written = 0;
+    m_stop = false;
+    m_error.clear();
+    m_thread = std::thread(&ChTrajectoryWriter::WriterLoop, this);
+}
+
+// Compare the items of the given list with the next entries of the recorded item list
+template <class T>
+static bool SameItems(const std::vector<std::shared_ptr<T>>& list,
+                      const std::vector<std::shared_ptr<ChPhysicsItem>>& items,
+                      const std::vector<TrajectoryItem>& table,
+                      size_t& next) {
+    if (next + list.size() > items.size())
+        return false;
+    for (auto& item : list) {
+        if (item != items[next] || (uint64_t)item->GetDOF() != table[next].nx ||
+            (uint64_t)item->GetDOF_w() != table[next].nv)
+            return false;
+        next++;
+    }
+    return true;
+}
+
+bool ChTrajectoryWriter::CheckStructure() const {
+    size_t next = 0;
+    return SameItems(m_sys->Get_bodylist(), m_items, m_table, next) &&
+           SameItems(m_sys->Get_shaftlist(), m_items, m_table, next) &&
+           SameItems(m_sys->Get_linklist(), m_items, m_table, next) &&
+           SameItems(m_sys->Get_meshlist(), m_items, m_table, next) &&
+           SameItems(m_sys->Get_otherphysicslist(), m_items, m_table, next) && next == m_items.size();
+}
+
+void ChTrajectoryWriter::WriteFrame() {
+    if (!m_sys)
+        throw ChException("Trajectory file not open");
+    if (!CheckStructure())
+        throw ChException("The system structure changed since the trajectory file was opened");
+
+    // Wait for a free frame buffer
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_written_cv.wait(lock, [this]() { return m_num_queued - m_num_written < m_ring_size || !m_error.empty(); });
+        if (!m_error.empty())
+            throw ChException(m_error);
+    }
+
+    // Gather the state of each item in its own range. Bodies always provide their state; the ranges of other
+    // inactive items are cleared.
+    double T = m_sys->GetChTime();
+    for (size_t i = 0; i < m_items.size(); i++) {
+        const TrajectoryItem& entry = m_table[i];
+        if (entry.type == TrajectoryItem::BODY || m_items[i]->IsActive()) {
+            double Ti;
+            m_items[i]->IntStateGather((unsigned int)entry.offset_x, m_x, (unsigned int)entry.offset_w, m_v, Ti);
+        } else {
+            m_x.segment(entry.offset_x, entry.nx).setZero();
+            m_v.segment(entry.offset_w, entry.nv).setZero();
+        }
+    }
+
+    double* frame = m_ring.data() + (m_num_queued % m_ring_size) * m_frame_doubles;
+    frame[0] = T;
+    std::memcpy(frame + 1, m_x.data(), m_nx * sizeof(double));
+    std::memcpy(frame + 1 + m_nx, m_v.data(), m_nv * sizeof(double));
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_num_queued++;
+    }
+    m_queued_cv.notify_one();
+}
+
+void ChTrajectoryWriter::Flush() {
+    if (!m_sys)
+        return;
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_written_cv.wait(lock, [this]() { return m_num_written == m_num_queued || !m_error.empty(); });
+    if (!m_error.empty())
+        throw ChException(m_error);
+}
+
+void ChTrajectoryWriter::Close() {
+    if (!m_sys)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_queued_cv.notify_one();
+    m_thread.join();
+
+    // Trim the file to the frames actually written
+    try {
+        m_file.Resize((size_t)(m_frames_offset + m_num_written * m_frame_doubles * sizeof(double)));
+    } catch (const ChException&) {
+    }
+    m_file.Close();
+    m_sys = nullptr;
+    m_items.clear();
+}
+
+void ChTrajectoryWriter::WriterLoop() {
+    size_t frame_size = (size_t)(m_frame_doubles * sizeof(double));
+
+    while (true) {
+        uint64_t frame;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_queued_cv.wait(lock, [this]() { return m_num_written < m_num_queued || m_stop; });
+            if (m_num_written == m_num_queued)
+                return;
+            frame = m_num_written;
+        }
+
+        try {
+            size_t needed = (size_t)(m_frames_offset + (frame + 1) * frame_size);
+            if (needed > m_file.GetSize())
+                m_file.Resize(std::max(needed, 2 * m_file.GetSize()));
+        } catch (const ChException& e) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_error = e.what();
+            m_written_cv.notify_all();
+            return;
+        }
+
+        const double* data = m_ring.data() + (frame % m_ring_size) * m_frame_doubles;
+        std::memcpy(m_file.GetData() + m_frames_offset + frame * frame_size, data, frame_size);
+
+        // Publish the frame to concurrent readers only once its data is in place
+        std::atomic_thread_fence(std::memory_order_release);
+        reinterpret_cast<TrajectoryHeader*>(m_file.GetData())->num_frames = frame + 1;
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_num_written++;
+        }
+        m_written_cv.notify_all();
+    }
+}
+
+// -----------------------------------------------------------------------------
+// ChTrajectoryReader
+// -----------------------------------------------------------------------------
+
+void ChTrajectoryReader::Open(const std::string& filename) {
+    m_file.OpenRead(filename);
+
+    if (m_file.GetSize() < sizeof(TrajectoryHeader) ||
+        std::memcmp(Header().magic, trajectory_magic, sizeof(trajectory_magic)) != 0) {
+        m_file.Close();
+        throw ChException("Not a trajectory file: " + filename);
+    }
+    if (Header().version != trajectory_version) {
+        m_file.Close();
+        throw ChException("Unsupported trajectory file version: " + filename);
+    }
+    if (m_file.GetSize() < Header().frames_offset ||
+        Header().frames_offset < sizeof(TrajectoryHeader) + Header().num_items * sizeof(TrajectoryItem) ||
+        Header().frame_size != (1 + Header().nx + Header().nv) * sizeof(double)) {
+        m_file.Close();
+        throw ChException("Corrupted trajectory file: " + filename);
+    }
+}
+
+void ChTrajectoryReader::Refresh() {
+    m_file.Remap();
+}
+
+uint64_t ChTrajectoryReader::GetNumFrames() const {
+    uint64_t num_frames = Header().num_frames;
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    // Only count the frames within the mapped region
+    uint64_t num_mapped = (m_file.GetSize() - Header().frames_offset) / Header().frame_size;
+    return std::min(num_frames, num_mapped);
+}
+
+const TrajectoryItem& ChTrajectoryReader::GetItem(unsigned int i) const {
+    auto items = reinterpret_cast<const TrajectoryItem*>(m_file.GetData() + sizeof(TrajectoryHeader));
+    return items[i];
+}
+
+int ChTrajectoryReader::FindItem(const std::string& name) const {
+    for (unsigned int i = 0; i < GetNumItems(); i++) {
+        if (name == GetItem(i).name)
+            return (int)i;
+    }
+    return -1;
+}
+
+const double* ChTrajectoryReader::Frame(uint64_t frame) const {
+    return reinterpret_cast<const double*>(m_file.GetData() + Header().frames_offset + frame * Header().frame_size);
+}
+
+const double* ChTrajectoryReader::BodyX(uint64_t frame, unsigned int item) const {
+    const TrajectoryItem& entry = GetItem(item);
+    if (entry.nx == 0)
+        return entry.ref_pos;
+    return GetStateX(frame) + entry.offset_x;
+}
+
+ChVector<> ChTrajectoryReader::GetBodyPos(uint64_t frame, unsigned int item) const {
+    const double* x = BodyX(frame, item);
+    return ChVector<>(x[0], x[1], x[2]);
+}
+
+ChQuaternion<> ChTrajectoryReader::GetBodyRot(uint64_t frame, unsigned int item) const {
+    const double* x = BodyX(frame, item);
+    return ChQuaternion<>(x[3], x[4], x[5], x[6]);
+}
+
+ChVector<> ChTrajectoryReader::GetBodyPos_dt(uint64_t frame, unsigned int item) const {
+    const TrajectoryItem& entry = GetItem(item);
+    if (entry.nv == 0)
+        return VNULL;
+    const double* v = GetStateV(frame) + entry.offset_w;
+    return ChVector<>(v[0], v[1], v[2]);
+}
+
+ChVector<> ChTrajectoryReader::GetBodyWvel_loc(uint64_t frame, unsigned int item) const {
+    const TrajectoryItem& entry = GetItem(item);
+    if (entry.nv == 0)
+        return VNULL;
+    const double* v = GetStateV(frame) + entry.offset_w;
+    return ChVector<>(v[3], v[4], v[5]);
+}
+
+}  // end namespace utils
+}  // end namespace chrono
@@ -0,0 +1,222 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Binary trajectory output.
+//
+// A trajectory file stores the state vectors of a system at successive frames,
+// in a fixed binary layout which can be accessed in place (memory mapped)
+// without any parsing:
+//
+//   TrajectoryHeader                      (64 bytes)
+//   TrajectoryItem x num_items            (160 bytes each)
+//   padding up to 'frames_offset'
+//   frames x num_frames                   ('frame_size' bytes each)
+//
+// Each frame is an array of doubles: the time, followed by the position state
+// (nx values) and the velocity state (nv values) of all top-level physics items
+// of the system. The item table gives the offsets of the states of each item in
+// these vectors. Unlike the system state vectors (see ChSystem::StateGather),
+// every item has a fixed range, including sleeping and fixed bodies, so that
+// the layout does not change when items are activated or deactivated.
+//
+// =============================================================================
+
+#ifndef CH_TRAJECTORY_OUTPUT_H
+#define CH_TRAJECTORY_OUTPUT_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "chrono/core/ChApiCE.h"
+#include "chrono/core/ChQuaternion.h"
+#include "chrono/core/ChVector.h"
+#include "chrono/timestepper/ChState.h"
+#include "chrono/utils/ChMappedFile.h"
+
+namespace chrono {
+
+// Forward references
+class ChSystem;
+class ChPhysicsItem;
+
+namespace utils {
+
+/// @addtogroup chrono_utils
+/// @{
+
+/// Header of a binary trajectory file.
+struct TrajectoryHeader {
+    char magic[8];           ///< file signature ("CHTRAJ")
+    uint32_t version;        ///< file format version
+    uint32_t num_items;      ///< number of entries in the item table
+    uint64_t nx;             ///< size of the position state
+    uint64_t nv;             ///< size of the velocity state
+    uint64_t frame_size;     ///< size of a frame, in bytes
+    uint64_t frames_offset;  ///< start of the first frame, in bytes from the beginning of the file
+    uint64_t num_frames;     ///< number of complete frames in the file
+    uint64_t reserved;
+};
+
+/// Entry of the item table of a binary trajectory file.
+struct TrajectoryItem {
+    /// Type of physics item.
+    enum Type : uint32_t { BODY = 0, SHAFT, LINK, MESH, OTHER };
+
+    char name[64];       ///< item name (truncated, null terminated)
+    uint32_t type;       ///< item type
+    uint32_t reserved;
+    uint64_t offset_x;   ///< offset of the item in the position state
+    uint64_t offset_w;   ///< offset of the item in the velocity state
+    uint64_t nx;         ///< number of position coordinates of the item
+    uint64_t nv;         ///< number of velocity coordinates of the item
+    double ref_pos[7];   ///< body position and rotation when the file was created
+};
+
+/// Streaming writer of binary trajectory files.
+/// The state of the system is gathered at each call to WriteFrame() and queued in a ring of frame buffers; a
+/// background thread copies the queued frames into the memory-mapped output file. The simulation thread only blocks
+/// if the ring is full. The file is grown as needed and can be read while being written (see ChTrajectoryReader).
+/// The items of the system and their numbers of states must not change while writing. Items may however be
+/// activated or deactivated (e.g., bodies put to sleep, fixed, or disabled): bodies are always written with their
+/// current position and velocity, while the states of other inactive items are written as zeros.
+class ChApi ChTrajectoryWriter {
+  public:
+    /// Create a writer with the given number of frame buffers.
+    ChTrajectoryWriter(unsigned int ring_size = 32);
+
+    /// Flush all queued frames and close the file.
+    ~ChTrajectoryWriter();
+
+    /// Create the output file for the given system, and write the header and item table.
+    /// Throw a ChException on failure.
+    void Open(const std::string& filename, ChSystem& sys);
+
+    /// Queue a frame with the current state of the system.
+    /// Throw a ChException if items were added or removed, or if the number of states of an item changed, since the
+    /// file was opened.
+    void WriteFrame();
+
+    /// Wait until all queued frames have been copied to the file.
+    void Flush();
+
+    /// Flush all queued frames and close the file.
+    void Close();
+
+    /// Return true if a file is open.
+    bool IsOpen() const { return m_sys != nullptr; }
+
+    /// Get the number of frames queued so far.
+    uint64_t GetNumFrames() const { return m_num_queued; }
+
+  private:
+    void WriterLoop();
+
+    /// Return true if the system still has the items (and numbers of states) it had when the file was opened.
+    bool CheckStructure() const;
+
+    ChMappedFile m_file;
+    ChSystem* m_sys;
+    std::vector<std::shared_ptr<ChPhysicsItem>> m_items;  ///< items of the system, in item table order
+    std::vector<TrajectoryItem> m_table;                  ///< item table (offsets of the items in the frames)
+    uint64_t m_nx;
+    uint64_t m_nv;
+    uint64_t m_frame_doubles;  ///< frame size, in doubles
+    uint64_t m_frames_offset;
+
+    ChState m_x;       ///< scratch position state
+    ChStateDelta m_v;  ///< scratch velocity state
+
+    std::vector<double> m_ring;  ///< ring of frame buffers
+    unsigned int m_ring_size;
+    uint64_t m_num_queued;   ///< frames queued by the simulation thread
+    uint64_t m_num_written;  ///< frames copied to the file by the writer thread
+    bool m_stop;
+    std::string m_error;  ///< error reported by the writer thread
+    std::mutex m_mutex;
+    std::condition_variable m_queued_cv;
+    std::condition_variable m_written_cv;
+    std::thread m_thread;
+};
+
+/// Random-access reader of binary trajectory files.
+/// Frames are accessed in place in the memory-mapped file, without copying or parsing.
+class ChApi ChTrajectoryReader {
+  public:
+    ChTrajectoryReader() {}
+
+    /// Open the given trajectory file. Throw a ChException if it is not a valid trajectory file.
+    void Open(const std::string& filename);
+
+    /// Map frames appended to the file since it was opened (when reading a file still being written).
+    void Refresh();
+
+    /// Close the file.
+    void Close() { m_file.Close(); }
+
+    /// Get the number of frames available.
+    uint64_t GetNumFrames() const;
+
+    /// Get the size of the position state.
+    uint64_t GetNx() const { return Header().nx; }
+
+    /// Get the size of the velocity state.
+    uint64_t GetNv() const { return Header().nv; }
+
+    /// Get the number of entries in the item table.
+    unsigned int GetNumItems() const { return Header().num_items; }
+
+    /// Get the specified entry of the item table.
+    const TrajectoryItem& GetItem(unsigned int i) const;
+
+    /// Return the index of the first item with given name, or -1 if not found.
+    int FindItem(const std::string& name) const;
+
+    /// Get the time of the specified frame.
+    double GetTime(uint64_t frame) const { return Frame(frame)[0]; }
+
+    /// Get the position state of the specified frame (nx values).
+    const double* GetStateX(uint64_t frame) const { return Frame(frame) + 1; }
+
+    /// Get the velocity state of the specified frame (nv values).
+    const double* GetStateV(uint64_t frame) const { return Frame(frame) + 1 + Header().nx; }
+
+    /// Get the position of the specified body item at the specified frame.
+    ChVector<> GetBodyPos(uint64_t frame, unsigned int item) const;
+
+    /// Get the rotation of the specified body item at the specified frame.
+    ChQuaternion<> GetBodyRot(uint64_t frame, unsigned int item) const;
+
+    /// Get the linear velocity (absolute frame) of the specified body item at the specified frame.
+    ChVector<> GetBodyPos_dt(uint64_t frame, unsigned int item) const;
+
+    /// Get the angular velocity (local frame) of the specified body item at the specified frame.
+    ChVector<> GetBodyWvel_loc(uint64_t frame, unsigned int item) const;
+
+  private:
+    const TrajectoryHeader& Header() const { return *reinterpret_cast<const TrajectoryHeader*>(m_file.GetData()); }
+    const double* Frame(uint64_t frame) const;
+    const double* BodyX(uint64_t frame, unsigned int item) const;
+
+    ChMappedFile m_file;
+};
+
+/// @} chrono_utils
+
+}  // end namespace utils
+}  // end namespace chrono
+
+#endif
@@ -526,5 +526,45 @@ void ChCollisionSystemDistributed::GetOverlappingAABB(custom_vector<char>& activ
     }
 }
 
+void ChCollisionSystemDistributed::ExpandSelection(custom_vector<char>& selected, int axis, real split) {
+    GenerateAABB();
+
+    const auto& cd_data = ddm->data_manager->cd_data;
+    const auto& id_rigid = cd_data->shape_data.id_rigid;
+    const auto& aabb_min = cd_data->aabb_min;
+    const auto& aabb_max = cd_data->aabb_max;
+    uint num_shapes = cd_data->num_rigid_shapes;
+
+    // Union of the AABBs of the selected shapes on each side of the split plane
+    real3 box_min[2] = {real3(C_REAL_MAX), real3(C_REAL_MAX)};
+    real3 box_max[2] = {real3(-C_REAL_MAX), real3(-C_REAL_MAX)};
+    for (uint i = 0; i < num_shapes; i++) {
+        uint id = id_rigid[i];
+        if (id == UINT_MAX || !selected[id])
+            continue;
+        int side = (aabb_min[i][axis] + aabb_max[i][axis]) / 2 < split ? 0 : 1;
+        box_min[side] = Min(box_min[side], aabb_min[i]);
+        box_max[side] = Max(box_max[side], aabb_max[i]);
+    }
+
+    // Select the bodies with a shape overlapping either box (an empty box overlaps nothing)
+    for (uint i = 0; i < num_shapes; i++) {
+        uint id = id_rigid[i];
+        if (id == UINT_MAX || selected[id])
+            continue;
+        const real3& Bmin = aabb_min[i];
+        const real3& Bmax = aabb_max[i];
+        for (int side = 0; side < 2; side++) {
+            const real3& Amin = box_min[side];
+            const real3& Amax = box_max[side];
+            if ((Amin.x <= Bmax.x && Bmin.x <= Amax.x) && (Amin.y <= Bmax.y && Bmin.y <= Amax.y) &&
+                (Amin.z <= Bmax.z && Bmin.z <= Amax.z)) {
+                selected[id] = true;
+                break;
+            }
+        }
+    }
+}
+
 } /* namespace collision */
 } /* namespace chrono */
@@ -41,6 +41,12 @@ class ChCollisionSystemDistributed : public ChCollisionSystemChronoMulticore {
     /// Deactivates the body in the data manager of Chrono::Multicore and marks the space as free.
     virtual void Remove(ChCollisionModel* model) override;
 
+    /// Extend the given selection of bodies with all bodies that may be in contact with a selected body.
+    /// The shapes of the selected bodies are grouped by the side of the plane normal to 'axis' at coordinate 'split'
+    /// they are on, and any body with a shape overlapping the union of the AABBs of a group is selected. Shape AABBs
+    /// are computed from the body states currently in the data manager.
+    void ExpandSelection(custom_vector<char>& selected, int axis, real split);
+
   private:
     /// Mark bodies whose AABB is contained within the specified box.
     virtual void GetOverlappingAABB(custom_vector<char>& active_id, real3 Amin, real3 Amax) override;
@@ -14,6 +14,7 @@
 
 #include <mpi.h>
 #include <omp.h>
+#include <cassert>
 #include <climits>
 #include <forward_list>
 #include <memory>
@@ -36,7 +37,7 @@
 using namespace chrono;
 using namespace collision;
 
-ChCommDistributed::ChCommDistributed(ChSystemDistributed* my_sys) {
+ChCommDistributed::ChCommDistributed(ChSystemDistributed* my_sys) : pending(false) {
     this->my_sys = my_sys;
     this->data_manager = my_sys->data_manager;
 
@@ -88,7 +89,7 @@ ChCommDistributed::ChCommDistributed(ChSystemDistributed* my_sys) {
 ChCommDistributed::~ChCommDistributed() {}
 
 void ChCommDistributed::ProcessExchanges(int num_recv, BodyExchange* buf, int updown) {
-    if (buf->gid == UINT_MAX) {
+    if (num_recv == 0 || buf->gid == UINT_MAX) {
         return;
     }
 
@@ -134,7 +135,7 @@ void ChCommDistributed::ProcessExchanges(int num_recv, BodyExchange* buf, int up
 
 void ChCommDistributed::ProcessUpdates(int num_recv, BodyUpdate* buf) {
     // If the buffer is empty
-    if (buf->gid == UINT_MAX) {
+    if (num_recv == 0 || buf->gid == UINT_MAX) {
         return;
     }
     std::shared_ptr<ChBody> body;
@@ -166,7 +167,7 @@ void ChCommDistributed::ProcessUpdates(int num_recv, BodyUpdate* buf) {
 }
 
 void ChCommDistributed::ProcessTakes(int num_recv, uint* buf) {
-    if (buf[0] == UINT_MAX) {
+    if (num_recv == 0 || buf[0] == UINT_MAX) {
         return;
     }
     for (int i = 0; i < num_recv; i++) {
@@ -177,7 +178,7 @@ void ChCommDistributed::ProcessTakes(int num_recv, uint* buf) {
 
 // TODO might be able to do in parallel if check the number of shapes per body in a first pass
 void ChCommDistributed::ProcessShapes(int num_recv, Shape* buf) {
-    if (buf->gid == UINT_MAX) {
+    if (num_recv == 0 || buf->gid == UINT_MAX) {
         return;
     }
 
@@ -268,6 +269,13 @@ void ChCommDistributed::ProcessShapes(int num_recv, Shape* buf) {
 
 // Handle all necessary communication
 void ChCommDistributed::Exchange() {
+    BeginExchange();
+    EndExchange();
+}
+
+void ChCommDistributed::BeginExchange() {
+    assert(!pending);
+
     int my_rank = my_sys->my_rank;
     int num_ranks = my_sys->num_ranks;
     std::forward_list<int> exchanges_up;
@@ -275,24 +283,16 @@ void ChCommDistributed::Exchange() {
 
     // Saves a reference copy for consistency in the threads.
     ddm->curr_status = ddm->comm_status;
-    std::vector<BodyExchange> exchange_up_buf;
-    std::vector<BodyExchange> exchange_down_buf;
-    std::vector<BodyUpdate> update_up_buf;
-    std::vector<BodyUpdate> update_down_buf;
-    std::vector<Shape> shapes_up;
-    std::vector<Shape> shapes_down;
-    std::vector<uint> update_take_up;
-    std::vector<uint> update_take_down;
-
-    // Send Counts
-    int num_exchange_up = 0;
-    int num_exchange_down = 0;
-    int num_update_up = 0;
-    int num_update_down = 0;
-    int num_shapes_up = 0;
-    int num_shapes_down = 0;
-    int num_take_up = 0;
-    int num_take_down = 0;
+    std::vector<BodyExchange>& exchange_up_buf = send_up.exchange;
+    std::vector<BodyExchange>& exchange_down_buf = send_down.exchange;
+    std::vector<BodyUpdate>& update_up_buf = send_up.update;
+    std::vector<BodyUpdate>& update_down_buf = send_down.update;
+    std::vector<Shape>& shapes_up = send_up.shapes;
+    std::vector<Shape>& shapes_down = send_down.shapes;
+    std::vector<uint>& update_take_up = send_up.take;
+    std::vector<uint>& update_take_down = send_down.take;
+    send_up.Clear();
+    send_down.Clear();
 
 #pragma omp parallel sections
     {
@@ -314,7 +314,6 @@ void ChCommDistributed::Exchange() {
                     PackExchange(&b_ex, i);
                     exchange_up_buf.push_back(b_ex);
 
-                    num_exchange_up++;  // TODO might be able to eliminate
                     ddm->comm_status[i] = distributed::SHARED_UP;
                     exchanges_up.push_front(i);
                 }
@@ -328,7 +327,6 @@ void ChCommDistributed::Exchange() {
                     PackExchange(&b_ex, i);
                     exchange_down_buf.push_back(b_ex);
 
-                    num_exchange_down++;  // TODO might be able to eliminate
                     ddm->comm_status[i] = distributed::SHARED_DOWN;
                     exchanges_down.push_front(i);
                 }
@@ -354,14 +352,12 @@ void ChCommDistributed::Exchange() {
                     PackUpdate(&b_upd, i, distributed::UPDATE);
                     update_up_buf.push_back(b_upd);
 
-                    num_update_up++;  // TODO might be able to eliminate
                 } else if (location == distributed::GHOST_UP && curr_status == distributed::SHARED_UP) {
                     BodyUpdate b_upd = {};
                     PackUpdate(&b_upd, i, distributed::UPDATE_TRANSFER_SHARE);
                     update_up_buf.push_back(b_upd);
 
                     ddm->comm_status[i] = distributed::GHOST_UP;
-                    num_update_up++;  // TODO might be able to eliminate
                 }
 
                 // If the body has already been shared, it need only update its
@@ -371,14 +367,12 @@ void ChCommDistributed::Exchange() {
                     PackUpdate(&b_upd, i, distributed::UPDATE);
                     update_down_buf.push_back(b_upd);
 
-                    num_update_down++;  // TODO might be able to eliminate
                 } else if (location == distributed::GHOST_DOWN && curr_status == distributed::SHARED_DOWN) {
                     BodyUpdate b_upd = {};
                     PackUpdate(&b_upd, i, distributed::UPDATE_TRANSFER_SHARE);
                     update_down_buf.push_back(b_upd);
 
                     ddm->comm_status[i] = distributed::GHOST_DOWN;
-                    num_update_down++;  // TODO might be able to eliminate
                 }
                 // If is shared up/down AND
                 // If the body is no longer involved with this rank, it must be removed from
@@ -392,7 +386,6 @@ void ChCommDistributed::Exchange() {
                         BodyUpdate b_upd = {};
                         PackUpdate(&b_upd, i, distributed::FINAL_UPDATE_GIVE);
                         update_up_buf.push_back(b_upd);
-                        num_update_up++;  // TODO might be able to eliminate
                         ////up = 1;
                     } else if (location == distributed::UNOWNED_DOWN && my_rank != 0) {
                         GetLog() << "GIVE " << ddm->global_id[i] << " from rank " << my_rank << "\n";
@@ -400,7 +393,6 @@ void ChCommDistributed::Exchange() {
                         PackUpdate(&b_upd, i, distributed::FINAL_UPDATE_GIVE);
                         update_down_buf.push_back(b_upd);
 
-                        num_update_down++;  // TODO might be able to eliminate
                         ////up = -1;
                     }
 
@@ -428,13 +420,11 @@ void ChCommDistributed::Exchange() {
                         uint b_ut;
                         PackUpdateTake(&b_ut, i);
                         update_take_up.push_back(b_ut);
-                        num_take_up++;  // TODO might be able to eliminate
 
                     } else if (curr_status == distributed::SHARED_DOWN) {
                         uint b_ut;
                         PackUpdateTake(&b_ut, i);
                         update_take_down.push_back(b_ut);
-                        num_take_down++;  // TODO might be able to eliminate
                     }
                     ddm->comm_status[i] = distributed::OWNED;
                 }
@@ -442,276 +432,148 @@ void ChCommDistributed::Exchange() {
         }      // End of update take loop
     }          // End of parallel sections
 
-    // MPI_Status status_exchange_up;
-    // MPI_Status status_exchange_down;
-    // MPI_Status status_update_up;
-    // MPI_Status status_update_down;
-    // MPI_Status status_take_up;
-    // MPI_Status status_take_down;
-    // MPI_Status status_shapes_up;
-    // MPI_Status status_shapes_down;
-
-    MPI_Request rq_exchange_up;
-    MPI_Request rq_exchange_down;
-    MPI_Request rq_update_up;
-    MPI_Request rq_update_down;
-    MPI_Request rq_take_up;
-    MPI_Request rq_take_down;
-    MPI_Request rq_shapes_up;
-    MPI_Request rq_shapes_down;
-
-    MPI_Status recv_status_exchange_up;
-    MPI_Status recv_status_exchange_down;
-    MPI_Status recv_status_update_up;
-    MPI_Status recv_status_update_down;
-    MPI_Status recv_status_take_up;
-    MPI_Status recv_status_take_down;
-    MPI_Status recv_status_shapes_up;
-    MPI_Status recv_status_shapes_down;
-
-    int num_recv_exchange_up;
-    int num_recv_exchange_down;
-    int num_recv_update_up;
-    int num_recv_update_down;
-    int num_recv_take_up;
-    int num_recv_take_down;
-    int num_recv_shapes_up = 0;
-    int num_recv_shapes_down = 0;
-
-    BodyExchange* recv_exchange_down = NULL;
-    BodyExchange* recv_exchange_up = NULL;
-    BodyUpdate* recv_update_down = NULL;
-    BodyUpdate* recv_update_up = NULL;
-    uint* recv_take_down = NULL;
-    uint* recv_take_up = NULL;
-    Shape* recv_shapes_down = NULL;
-    Shape* recv_shapes_up = NULL;
-
+    // Pack the shapes of the bodies sent to create ghosts
 #pragma omp parallel sections
     {
-// Send/Recv
-#pragma omp section
-        {
-            // SENDING - TODO sequential for now
-
-            // Send empty message if there is nothing to send
-            if (num_exchange_up == 0) {
-                BodyExchange b_e = {};
-                b_e.gid = UINT_MAX;
-                exchange_up_buf.push_back(b_e);
-                num_exchange_up = 1;
-            }
-            if (num_exchange_down == 0) {
-                BodyExchange b_e = {};
-                b_e.gid = UINT_MAX;
-                exchange_down_buf.push_back(b_e);
-                num_exchange_down = 1;
-            }
-            if (num_update_up == 0) {
-                BodyUpdate b_u = {};
-                b_u.gid = UINT_MAX;
-                update_up_buf.push_back(b_u);
-                num_update_up = 1;
-            }
-            if (num_update_down == 0) {
-                BodyUpdate b_u = {};
-                b_u.gid = UINT_MAX;
-                update_down_buf.push_back(b_u);
-                num_update_down = 1;
-            }
-            if (num_take_up == 0) {
-                update_take_up.push_back(UINT_MAX);
-                num_take_up = 1;
-            }
-            if (num_take_down == 0) {
-                update_take_down.push_back(UINT_MAX);
-                num_take_down = 1;
-            }
-
-            // Send Exchanges
-            if (my_rank != num_ranks - 1) {
-                MPI_Isend(&(exchange_up_buf[0]), num_exchange_up, BodyExchangeType, my_rank + 1, 1, my_sys->world,
-                          &rq_exchange_up);
-            }
-            if (my_rank != 0) {
-                MPI_Isend(&(exchange_down_buf[0]), num_exchange_down, BodyExchangeType, my_rank - 1, 2, my_sys->world,
-                          &rq_exchange_down);
-            }
-
-            // Recv Exchanges
-            if (my_rank != 0) {
-                MPI_Probe(my_rank - 1, 1, my_sys->world, &recv_status_exchange_down);
-                MPI_Get_count(&recv_status_exchange_down, BodyExchangeType, &num_recv_exchange_down);
-                recv_exchange_down = new BodyExchange[num_recv_exchange_down];
-                MPI_Recv(recv_exchange_down, num_recv_exchange_down, BodyExchangeType, my_rank - 1, 1, my_sys->world,
-                         &recv_status_exchange_down);
-            }
-            if (my_rank != num_ranks - 1) {
-                MPI_Probe(my_rank + 1, 2, my_sys->world, &recv_status_exchange_up);
-                MPI_Get_count(&recv_status_exchange_up, BodyExchangeType, &num_recv_exchange_up);
-                recv_exchange_up = new BodyExchange[num_recv_exchange_up];
-                MPI_Recv(recv_exchange_up, num_recv_exchange_up, BodyExchangeType, my_rank + 1, 2, my_sys->world,
-                         &recv_status_exchange_up);
-            }
-
-            // Send Updates
-            if (my_rank != num_ranks - 1) {
-                MPI_Isend(&(update_up_buf[0]), num_update_up, BodyUpdateType, my_rank + 1, 3, my_sys->world,
-                          &rq_update_up);
-            }
-            if (my_rank != 0) {
-                MPI_Isend(&(update_down_buf[0]), num_update_down, BodyUpdateType, my_rank - 1, 4, my_sys->world,
-                          &rq_update_down);
-            }
-
-            // Recv Updates
-            if (my_rank != 0) {
-                MPI_Probe(my_rank - 1, 3, my_sys->world, &recv_status_update_down);
-                MPI_Get_count(&recv_status_update_down, BodyUpdateType, &num_recv_update_down);
-                recv_update_down = new BodyUpdate[num_recv_update_down];
-                MPI_Recv(recv_update_down, num_recv_update_down, BodyUpdateType, my_rank - 1, 3, my_sys->world,
-                         &recv_status_update_down);
-            }
-            if (my_rank != num_ranks - 1) {
-                MPI_Probe(my_rank + 1, 4, my_sys->world, &recv_status_update_up);
-                MPI_Get_count(&recv_status_update_up, BodyUpdateType, &num_recv_update_up);
-                recv_update_up = new BodyUpdate[num_recv_update_up];
-                MPI_Recv(recv_update_up, num_recv_update_up, BodyUpdateType, my_rank + 1, 4, my_sys->world,
-                         &recv_status_update_up);
-            }
-
-            // Send Takes
-            if (my_rank != num_ranks - 1) {
-                MPI_Isend(&(update_take_up[0]), num_take_up, MPI_UNSIGNED, my_rank + 1, 5, my_sys->world, &rq_take_up);
-            }
-            if (my_rank != 0) {
-                MPI_Isend(&(update_take_down[0]), num_take_down, MPI_UNSIGNED, my_rank - 1, 6, my_sys->world,
-                          &rq_take_down);
-            }
-
-            // Recv Takes
-            if (my_rank != 0) {
-                MPI_Probe(my_rank - 1, 5, my_sys->world, &recv_status_take_down);
-                MPI_Get_count(&recv_status_take_down, MPI_UNSIGNED, &num_recv_take_down);
-                recv_take_down = new uint[num_recv_take_down];
-                MPI_Recv(recv_take_down, num_recv_take_down, MPI_UNSIGNED, my_rank - 1, 5, my_sys->world,
-                         &recv_status_take_down);
-            }
-            if (my_rank != num_ranks - 1) {
-                MPI_Probe(my_rank + 1, 6, my_sys->world, &recv_status_take_up);
-                MPI_Get_count(&recv_status_take_up, MPI_UNSIGNED, &num_recv_take_up);
-                recv_take_up = new uint[num_recv_take_up];
-                MPI_Recv(recv_take_up, num_recv_take_up, MPI_UNSIGNED, my_rank + 1, 6, my_sys->world,
-                         &recv_status_take_up);
-            }
-
-            // Make sure all non-blocking communications are done.
-            if (my_rank != num_ranks - 1) {
-                MPI_Wait(&rq_exchange_up, MPI_STATUS_IGNORE);
-                MPI_Wait(&rq_update_up, MPI_STATUS_IGNORE);
-                MPI_Wait(&rq_take_up, MPI_STATUS_IGNORE);
-            }
-            if (my_rank != 0) {
-                MPI_Wait(&rq_exchange_down, MPI_STATUS_IGNORE);
-                MPI_Wait(&rq_update_down, MPI_STATUS_IGNORE);
-                MPI_Wait(&rq_take_down, MPI_STATUS_IGNORE);
-            }
-        }  // End of send/recv section
-
-// TODO could do in parallel if counting the spaces in the buffers in the first pass
-// Pack Shapes Up
 #pragma omp section
         {
             for (auto itr_up = exchanges_up.begin(); itr_up != exchanges_up.end(); itr_up++) {
-                num_shapes_up += PackShapes(&shapes_up, *itr_up);
-            }
-
-            if (num_shapes_up == 0) {
-                Shape shape;
-                shape.gid = UINT_MAX;
-                shapes_up.push_back(shape);
-                num_shapes_up = 1;
+                PackShapes(&shapes_up, *itr_up);
             }
-        }  // End of pack shapes up section
-
-// Pack Shapes Down
+        }
 #pragma omp section
         {
             for (auto itr_down = exchanges_down.begin(); itr_down != exchanges_down.end(); itr_down++) {
-                num_shapes_down += PackShapes(&shapes_down, *itr_down);
-            }
-            if (num_shapes_down == 0) {
-                Shape shape;
-                shape.gid = UINT_MAX;
-                shapes_down.push_back(shape);
-                num_shapes_down = 1;
+                PackShapes(&shapes_down, *itr_down);
             }
-        }  // End of pack shapes down section
-    }      // End of parallel sections
-
-    // TODO sections?
-    if (my_rank != 0)
-        ProcessExchanges(num_recv_exchange_down, recv_exchange_down, 0);
-    if (my_rank != num_ranks - 1)
-        ProcessExchanges(num_recv_exchange_up, recv_exchange_up, 1);
-
-    if (my_rank != 0)
-        ProcessUpdates(num_recv_update_down, recv_update_down);
-    if (my_rank != num_ranks - 1)
-        ProcessUpdates(num_recv_update_up, recv_update_up);
-
-    if (my_rank != 0)
-        ProcessTakes(num_recv_take_down, recv_take_down);
-    if (my_rank != num_ranks - 1)
-        ProcessTakes(num_recv_take_up, recv_take_up);
-
-    // Send Shapes
-    if (my_rank != num_ranks - 1) {
-        MPI_Isend(&(shapes_up[0]), num_shapes_up, ShapeType, my_rank + 1, 7, my_sys->world, &rq_shapes_up);
-    }
-    if (my_rank != 0) {
-        MPI_Isend(&(shapes_down[0]), num_shapes_down, ShapeType, my_rank - 1, 8, my_sys->world, &rq_shapes_down);
+        }
     }
 
-    // Recv Shapes
-    if (my_rank != 0) {
-        MPI_Probe(my_rank - 1, 7, my_sys->world, &recv_status_shapes_down);
-        MPI_Get_count(&recv_status_shapes_down, ShapeType, &num_recv_shapes_down);
-        recv_shapes_down = new Shape[num_recv_shapes_down];
-        MPI_Recv(recv_shapes_down, num_recv_shapes_down, ShapeType, my_rank - 1, 7, my_sys->world,
-                 &recv_status_shapes_down);
-    }
+    // Messages to the upper neighbor use odd tags, messages to the lower neighbor use even tags.
+    // Sends start right away. The counts received from the neighbors determine which receives are posted, so that no
+    // message is sent or received for an empty buffer.
     if (my_rank != num_ranks - 1) {
-        MPI_Probe(my_rank + 1, 8, my_sys->world, &recv_status_shapes_up);
-        MPI_Get_count(&recv_status_shapes_up, ShapeType, &num_recv_shapes_up);
-        ////GetLog() << "num_recv_shapes_up" << num_recv_shapes_up << "\n";
-        recv_shapes_up = new Shape[num_recv_shapes_up];
-        MPI_Recv(recv_shapes_up, num_recv_shapes_up, ShapeType, my_rank + 1, 8, my_sys->world, &recv_status_shapes_up);
+        PostCountRecv(recv_up, my_rank + 1, 2);
+        PostSends(send_up, my_rank + 1, 1);
+    }
+    if (my_rank != 0) {
+        PostCountRecv(recv_down, my_rank - 1, 1);
+        PostSends(send_down, my_rank - 1, 2);
     }
-
-    if (my_rank != 0)
-        ProcessShapes(num_recv_shapes_down, recv_shapes_down);
-    if (my_rank != num_ranks - 1)
-        ProcessShapes(num_recv_shapes_up, recv_shapes_up);
-
     if (my_rank != num_ranks - 1) {
-        MPI_Wait(&rq_shapes_up, MPI_STATUS_IGNORE);
+        MPI_Wait(&recv_up.requests[MSG_COUNT], MPI_STATUS_IGNORE);
+        PostRecvs(recv_up, my_rank + 1, 2);
     }
     if (my_rank != 0) {
-        MPI_Wait(&rq_shapes_down, MPI_STATUS_IGNORE);
+        MPI_Wait(&recv_down.requests[MSG_COUNT], MPI_STATUS_IGNORE);
+        PostRecvs(recv_down, my_rank - 1, 1);
     }
 
-    // Free all dynamic memory used for recving
-    delete[] recv_exchange_down;
-    delete[] recv_exchange_up;
-    delete[] recv_update_down;
-    delete[] recv_update_up;
-    delete[] recv_take_down;
-    delete[] recv_take_up;
-    delete[] recv_shapes_down;
-    delete[] recv_shapes_up;
-
-    MPI_Barrier(my_sys->world);
+    pending = true;
+}
+
+void ChCommDistributed::EndExchange() {
+    if (!pending)
+        return;
+
+    bool has_up = my_sys->my_rank != my_sys->num_ranks - 1;
+    bool has_down = my_sys->my_rank != 0;
+
+    // Wait for the message of the given kind and return the number of received items
+    auto received = [](Halo& halo, int kind) {
+        MPI_Wait(&halo.requests[kind], MPI_STATUS_IGNORE);
+        return halo.count[kind];
+    };
+
+    // Process incoming messages in order: new ghosts, updates, takes, and finally the shapes of the new ghosts.
+    // Later messages may still be in flight while earlier ones are processed.
+    if (has_down && received(recv_down, MSG_EXCHANGE) > 0)
+        ProcessExchanges(recv_down.count[MSG_EXCHANGE], recv_down.exchange.data(), 0);
+    if (has_up && received(recv_up, MSG_EXCHANGE) > 0)
+        ProcessExchanges(recv_up.count[MSG_EXCHANGE], recv_up.exchange.data(), 1);
+
+    if (has_down && received(recv_down, MSG_UPDATE) > 0)
+        ProcessUpdates(recv_down.count[MSG_UPDATE], recv_down.update.data());
+    if (has_up && received(recv_up, MSG_UPDATE) > 0)
+        ProcessUpdates(recv_up.count[MSG_UPDATE], recv_up.update.data());
+
+    if (has_down && received(recv_down, MSG_TAKE) > 0)
+        ProcessTakes(recv_down.count[MSG_TAKE], recv_down.take.data());
+    if (has_up && received(recv_up, MSG_TAKE) > 0)
+        ProcessTakes(recv_up.count[MSG_TAKE], recv_up.take.data());
+
+    if (has_down && received(recv_down, MSG_SHAPES) > 0)
+        ProcessShapes(recv_down.count[MSG_SHAPES], recv_down.shapes.data());
+    if (has_up && received(recv_up, MSG_SHAPES) > 0)
+        ProcessShapes(recv_up.count[MSG_SHAPES], recv_up.shapes.data());
+
+    // Make sure all sends completed before the send buffers are reused
+    if (has_up)
+        MPI_Waitall(MSG_COUNT + 1, send_up.requests, MPI_STATUSES_IGNORE);
+    if (has_down)
+        MPI_Waitall(MSG_COUNT + 1, send_down.requests, MPI_STATUSES_IGNORE);
+
+    pending = false;
+}
+
+void ChCommDistributed::Halo::Clear() {
+    exchange.clear();
+    update.clear();
+    take.clear();
+    shapes.clear();
+}
+
+void ChCommDistributed::PostCountRecv(Halo& halo, int rank, int tag) {
+    MPI_Irecv(halo.count, MSG_COUNT, MPI_INT, rank, tag + 2 * MSG_COUNT, my_sys->world, &halo.requests[MSG_COUNT]);
+}
+
+void ChCommDistributed::PostSends(Halo& halo, int rank, int tag) {
+    MPI_Comm world = my_sys->world;
+
+    halo.count[MSG_EXCHANGE] = (int)halo.exchange.size();
+    halo.count[MSG_UPDATE] = (int)halo.update.size();
+    halo.count[MSG_TAKE] = (int)halo.take.size();
+    halo.count[MSG_SHAPES] = (int)halo.shapes.size();
+    MPI_Isend(halo.count, MSG_COUNT, MPI_INT, rank, tag + 2 * MSG_COUNT, world, &halo.requests[MSG_COUNT]);
+
+    for (int kind = 0; kind < MSG_COUNT; kind++)
+        halo.requests[kind] = MPI_REQUEST_NULL;
+    if (halo.count[MSG_EXCHANGE] > 0)
+        MPI_Isend(halo.exchange.data(), halo.count[MSG_EXCHANGE], BodyExchangeType, rank, tag + 2 * MSG_EXCHANGE,
+                  world, &halo.requests[MSG_EXCHANGE]);
+    if (halo.count[MSG_UPDATE] > 0)
+        MPI_Isend(halo.update.data(), halo.count[MSG_UPDATE], BodyUpdateType, rank, tag + 2 * MSG_UPDATE, world,
+                  &halo.requests[MSG_UPDATE]);
+    if (halo.count[MSG_TAKE] > 0)
+        MPI_Isend(halo.take.data(), halo.count[MSG_TAKE], MPI_UNSIGNED, rank, tag + 2 * MSG_TAKE, world,
+                  &halo.requests[MSG_TAKE]);
+    if (halo.count[MSG_SHAPES] > 0)
+        MPI_Isend(halo.shapes.data(), halo.count[MSG_SHAPES], ShapeType, rank, tag + 2 * MSG_SHAPES, world,
+                  &halo.requests[MSG_SHAPES]);
+}
+
+void ChCommDistributed::PostRecvs(Halo& halo, int rank, int tag) {
+    MPI_Comm world = my_sys->world;
+
+    halo.exchange.resize(halo.count[MSG_EXCHANGE]);
+    halo.update.resize(halo.count[MSG_UPDATE]);
+    halo.take.resize(halo.count[MSG_TAKE]);
+    halo.shapes.resize(halo.count[MSG_SHAPES]);
+
+    for (int kind = 0; kind < MSG_COUNT; kind++)
+        halo.requests[kind] = MPI_REQUEST_NULL;
+    if (halo.count[MSG_EXCHANGE] > 0)
+        MPI_Irecv(halo.exchange.data(), halo.count[MSG_EXCHANGE], BodyExchangeType, rank, tag + 2 * MSG_EXCHANGE,
+                  world, &halo.requests[MSG_EXCHANGE]);
+    if (halo.count[MSG_UPDATE] > 0)
+        MPI_Irecv(halo.update.data(), halo.count[MSG_UPDATE], BodyUpdateType, rank, tag + 2 * MSG_UPDATE, world,
+                  &halo.requests[MSG_UPDATE]);
+    if (halo.count[MSG_TAKE] > 0)
+        MPI_Irecv(halo.take.data(), halo.count[MSG_TAKE], MPI_UNSIGNED, rank, tag + 2 * MSG_TAKE, world,
+                  &halo.requests[MSG_TAKE]);
+    if (halo.count[MSG_SHAPES] > 0)
+        MPI_Irecv(halo.shapes.data(), halo.count[MSG_SHAPES], ShapeType, rank, tag + 2 * MSG_SHAPES, world,
+                  &halo.requests[MSG_SHAPES]);
 }
 
 void ChCommDistributed::PackExchange(BodyExchange* buf, int index) {
@@ -15,6 +15,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "chrono/physics/ChBody.h"
 
@@ -113,8 +114,21 @@ class CH_DISTR_API ChCommDistributed {
     ///	- need to update their comm_status
     /// Sends updates via mpi to the appropriate rank
     /// Processes incoming updates from other ranks
+    /// Equivalent to BeginExchange() followed by EndExchange().
     void Exchange();
 
+    /// Pack all outgoing data and post the non-blocking sends and receives with both neighbor ranks.
+    /// Only the (small) message counts are waited for; work which does not depend on ghost bodies can be performed
+    /// before calling EndExchange(). Incoming data only modifies ghost bodies and empty body slots.
+    /// See ChSystemDistributed::SetDeferredExchange for the overlap of the exchange with the next simulation step.
+    void BeginExchange();
+
+    /// Wait for and process the incoming data posted by BeginExchange(), then complete all sends.
+    void EndExchange();
+
+    /// Return true if an exchange was started with BeginExchange() and not yet completed.
+    bool IsPending() const { return pending; }
+
   protected:
     ChSystemDistributed* my_sys;
 
@@ -130,6 +144,35 @@ class CH_DISTR_API ChCommDistributed {
     ChDistributedDataManager* ddm;
 
   private:
+    /// Kinds of messages exchanged with a neighbor rank, in processing order.
+    enum MessageKind { MSG_EXCHANGE = 0, MSG_UPDATE = 1, MSG_TAKE = 2, MSG_SHAPES = 3, MSG_COUNT = 4 };
+
+    /// Buffers, item counts, and pending requests for the messages sent to or received from one neighbor rank.
+    struct Halo {
+        std::vector<BodyExchange> exchange;
+        std::vector<BodyUpdate> update;
+        std::vector<uint> take;
+        std::vector<Shape> shapes;
+        int count[MSG_COUNT];                 ///< number of items of each kind
+        MPI_Request requests[MSG_COUNT + 1];  ///< requests for each kind, plus one for the counts
+        void Clear();
+    };
+
+    Halo send_up;    ///< outgoing data for the upper neighbor
+    Halo send_down;  ///< outgoing data for the lower neighbor
+    Halo recv_up;    ///< incoming data from the upper neighbor
+    Halo recv_down;  ///< incoming data from the lower neighbor
+    bool pending;    ///< true between BeginExchange and EndExchange
+
+    /// Post the receive of the item counts from the given rank.
+    void PostCountRecv(Halo& halo, int rank, int tag);
+
+    /// Post the sends of the item counts and of all non-empty buffers to the given rank.
+    void PostSends(Halo& halo, int rank, int tag);
+
+    /// Size the buffers from the received item counts and post the receives of all non-empty messages.
+    void PostRecvs(Halo& halo, int rank, int tag);
+
     /// Helper function for processing incoming exchange messages.
     void ProcessExchanges(int num_recv, BodyExchange* buf, int updown);
 
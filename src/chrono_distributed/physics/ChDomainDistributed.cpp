@@ -22,8 +22,10 @@
 
 #include <mpi.h>
 #include <stdlib.h>
+#include <algorithm>
 #include <iostream>
 #include <memory>
+#include <numeric>
 
 using namespace chrono;
 
@@ -69,26 +71,91 @@ void ChDomainDistributed::SetSimDomain(const ChVector<>& lo, const ChVector<>& h
 }
 
 void ChDomainDistributed::SplitDomain() {
-    // Length of this subdomain along the long axis
-    double sub_len = (boxhi[split_axis] - boxlo[split_axis]) / my_sys->num_ranks;
+    int num_ranks = my_sys->num_ranks;
+
+    // Length of each subdomain along the long axis
+    double sub_len = (boxhi[split_axis] - boxlo[split_axis]) / num_ranks;
+
+    boundaries.resize(num_ranks + 1);
+    for (int i = 0; i < num_ranks; i++)
+        boundaries[i] = boxlo[split_axis] + i * sub_len;
+    boundaries[num_ranks] = boxhi[split_axis];
 
+    UpdateSubDomain();
+    split = true;
+}
+
+void ChDomainDistributed::UpdateSubDomain() {
     for (int i = 0; i < 3; i++) {
         if (split_axis == i) {
-            sublo[i] = boxlo[i] + my_sys->my_rank * sub_len;
-            subhi[i] = sublo[i] + sub_len;
+            sublo[i] = boundaries[my_sys->my_rank];
+            subhi[i] = boundaries[my_sys->my_rank + 1];
         } else {
             sublo[i] = boxlo[i];
             subhi[i] = boxhi[i];
         }
     }
-    split = true;
 }
 
-int ChDomainDistributed::GetRank(const ChVector<double>& pos) const {
-    double sub_len = subhi[split_axis] - sublo[split_axis];
-    double pt = pos[split_axis] - boxlo[split_axis];
+bool ChDomainDistributed::Rebalance(const std::vector<double>& loads, double max_shift, double tolerance) {
+    assert(split);
+    int num_ranks = my_sys->num_ranks;
+    if (num_ranks == 1 || (int)loads.size() != num_ranks)
+        return false;
+
+    // Every sub-domain must be wider than twice the ghost layer, so that the shared and ghost layers of a rank do not
+    // overlap. Do not rebalance if the domain is too narrow for all ranks to satisfy this constraint.
+    double lo = boundaries[0];
+    double hi = boundaries[num_ranks];
+    double min_width = 2 * my_sys->GetGhostLayer();
+    if ((hi - lo) / num_ranks < min_width)
+        return false;
+
+    double total = std::accumulate(loads.begin(), loads.end(), 0.0);
+    double max_load = *std::max_element(loads.begin(), loads.end());
+    if (total <= 0 || max_load <= (1 + tolerance) * total / num_ranks)
+        return false;
+
+    // Place each interior boundary at its target fraction of the cumulative load, interpolating linearly within the
+    // current sub-domains
+    std::vector<double> new_bounds(boundaries);
+    int r = 0;
+    double cum = 0;
+    for (int k = 1; k < num_ranks; k++) {
+        double target = total * k / num_ranks;
+        while (r < num_ranks - 1 && cum + loads[r] < target) {
+            cum += loads[r];
+            r++;
+        }
+        double pos = boundaries[r + 1];
+        if (loads[r] > 0)
+            pos = boundaries[r] + (target - cum) / loads[r] * (boundaries[r + 1] - boundaries[r]);
+
+        // Limit the shift so that the comm_status transitions of bodies remain valid, and stay within the domain
+        pos = std::max(boundaries[k] - max_shift, std::min(boundaries[k] + max_shift, pos));
+        new_bounds[k] = std::max(lo, std::min(hi, pos));
+    }
+
+    // Enforce the minimum sub-domain width. Since the domain is wide enough, boundary k ends up within
+    // [lo + k * min_width, hi - (num_ranks - k) * min_width].
+    for (int k = 1; k < num_ranks; k++)
+        new_bounds[k] = std::max(new_bounds[k], new_bounds[k - 1] + min_width);
+    for (int k = num_ranks - 1; k > 0; k--)
+        new_bounds[k] = std::min(new_bounds[k], new_bounds[k + 1] - min_width);
 
-    return (int)(pt / sub_len);
+    if (new_bounds == boundaries)
+        return false;
+
+    boundaries = new_bounds;
+    UpdateSubDomain();
+    return true;
+}
+
+int ChDomainDistributed::GetRank(const ChVector<double>& pos) const {
+    // Interior boundaries are boundaries[1] ... boundaries[num_ranks - 1]
+    auto first = boundaries.begin() + 1;
+    auto last = boundaries.end() - 1;
+    return (int)(std::upper_bound(first, last, pos[split_axis]) - first);
 }
 
 distributed::COMM_STATUS ChDomainDistributed::GetRegion(double pos) const {
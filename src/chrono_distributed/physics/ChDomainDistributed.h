@@ -15,6 +15,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "chrono/core/ChVector.h"
 #include "chrono/physics/ChBody.h"
@@ -31,7 +32,11 @@ class ChSystemDistributed;
 /// @{
 
 /// This class maps sub-domains of the global simulation domain to each MPI rank.
-/// The global domain is split along the longest axis.
+/// The global domain is split in slabs along the longest axis (or the axis specified with SetSplitAxis). Initially, all
+/// slabs have equal width; the slab boundaries can later be moved to balance the load among ranks (see Rebalance).
+/// Only this single-axis decomposition is supported: each rank exchanges bodies with at most two neighbors (see
+/// ChCommDistributed), whereas a 2D or 3D decomposition also needs exchanges across the edges and corners of the
+/// sub-domains. Multi-axis decomposition is left for a separate change.
 /// Within each sub-domain, there are layers of ownership:
 ///
 ///
@@ -139,6 +144,19 @@ class CH_DISTR_API ChDomainDistributed {
     /// Returns the rank which has ownership of a body with the given position
     int GetRank(const ChVector<double>& pos) const;
 
+    /// Return the positions of the sub-domain boundaries along the split axis (num_ranks + 1 values).
+    /// Sub-domain i spans the interval between boundaries i and i+1.
+    const std::vector<double>& GetBoundaries() const { return boundaries; }
+
+    /// Move the sub-domain boundaries along the split axis to even out the specified per-rank loads.
+    /// The new boundaries are placed at equal fractions of the cumulative load, assuming the load is uniformly
+    /// distributed within each current sub-domain. Each boundary moves by at most 'max_shift', stays within the global
+    /// domain, and every sub-domain is kept wider than twice the ghost layer. Nothing is done if the largest load does
+    /// not exceed the average load by more than the fraction 'tolerance', or if the global domain is narrower than
+    /// twice the ghost layer times the number of ranks. Must be called on all ranks with the same loads.
+    /// Return true if the boundaries were changed.
+    virtual bool Rebalance(const std::vector<double>& loads, double max_shift, double tolerance);
+
     /// Returns true if the domain has been set.
     bool IsSplit() const { return split; }
 
@@ -156,10 +174,15 @@ class CH_DISTR_API ChDomainDistributed {
 
     int split_axis;  ///< Index of the dimension of the longest edge of the global domain
 
+    std::vector<double> boundaries;  ///< Positions of all sub-domain boundaries along the split axis
+
     /// Divides the domain into equal-volume, orthogonal, axis-aligned regions along
     /// the longest axis. Needs to be called right after the system is created so that
     /// bodies are added correctly.
     virtual void SplitDomain();
+
+    /// Set the bounds of this sub-domain from the current boundaries.
+    void UpdateSubDomain();
     bool split;     ///< Flag indicating that the domain has been divided into sub-domains.
     bool axis_set;  ///< Flag indicating that the splitting axis has been set.
 
@@ -12,6 +12,7 @@
 // Authors: Nic Olsen
 // =============================================================================
 
+#include <algorithm>
 #include <cstdlib>
 
 #include <mpi.h>
@@ -53,7 +54,14 @@ static void PrintNode(LocalShapeNode* node) {
 }
 
 ChSystemDistributed::ChSystemDistributed(MPI_Comm communicator, double ghostlayer, unsigned int maxobjects)
-    : ghost_layer(ghostlayer), master_rank(0), num_bodies_global(0) {
+    : ghost_layer(ghostlayer),
+      master_rank(0),
+      num_bodies_global(0),
+      deferred_exchange(false),
+      lb_interval(0),
+      lb_contact_weight(0.1),
+      lb_tolerance(0.1),
+      lb_step(0) {
     MPI_Comm_dup(communicator, &world);
     MPI_Comm_size(world, &num_ranks);
     MPI_Comm_rank(world, &my_rank);
@@ -65,6 +73,7 @@ ChSystemDistributed::ChSystemDistributed(MPI_Comm communicator, double ghostlaye
     comm = new ChCommDistributed(this);
 
     data_manager->system_timer.AddTimer("Exchange");
+    data_manager->system_timer.AddTimer("LoadBalance");
 
     // Reserve starting space
     int init = maxobjects;  // / num_ranks;
@@ -124,11 +133,26 @@ bool ChSystemDistributed::Integrate_Y() {
     assert(domain->IsSplit());
     ddm->initial_add = false;
 
+    // An exchange deferred from the previous step is completed during the collision detection
     bool ret = ChSystemMulticoreSMC::Integrate_Y();
     if (num_ranks != 1) {
+        // The boundaries must not move while an exchange is pending, so the exchange is completed right away at steps
+        // where the domain is rebalanced
+        bool rebalance = lb_interval > 0 && ++lb_step >= lb_interval;
+
         data_manager->system_timer.start("Exchange");
-        comm->Exchange();
+        if (deferred_exchange && !rebalance)
+            comm->BeginExchange();
+        else
+            comm->Exchange();
         data_manager->system_timer.stop("Exchange");
+
+        if (rebalance) {
+            data_manager->system_timer.start("LoadBalance");
+            RebalanceDomain();
+            data_manager->system_timer.stop("LoadBalance");
+            lb_step = 0;
+        }
     }
 #ifdef DistrProfile
     PrintEfficiency();
@@ -136,6 +160,149 @@ bool ChSystemDistributed::Integrate_Y() {
     return ret;
 }
 
+void ChSystemDistributed::InteriorContacts::Resize(size_t n) {
+    bids.resize(n);
+    shapeIDs.resize(n);
+    norm.resize(n);
+    cpta.resize(n);
+    cptb.resize(n);
+    dpth.resize(n);
+    erad.resize(n);
+}
+
+// Append the elements [0, n) of the source vector to the destination vector
+template <typename T>
+static void AppendContacts(std::vector<T>& dst, const std::vector<T>& src, size_t n) {
+    dst.insert(dst.end(), src.begin(), src.begin() + n);
+}
+
+void ChSystemDistributed::CollisionDetection() {
+    if (num_ranks == 1 || !comm->IsPending()) {
+        ChSystemMulticoreSMC::CollisionDetection();
+        return;
+    }
+
+    auto& cd_data = data_manager->cd_data;
+    custom_vector<char>& collide = data_manager->host_data.collide_rigid;
+
+    // Interior pass, while the exchange is in flight. Incoming messages only modify ghost bodies and empty slots, so
+    // the contacts between all other bodies can be found now.
+    uint num_bodies = data_manager->num_rigid_bodies;
+    late_bodies.assign(num_bodies, false);
+    for (uint i = 0; i < num_bodies; i++) {
+        int status = ddm->comm_status[i];
+        if (status == distributed::GHOST_UP || status == distributed::GHOST_DOWN || status == distributed::EMPTY) {
+            late_bodies[i] = true;
+            collide[i] = false;
+        }
+    }
+
+    collision_system->PreProcess();
+    collision_system->Run();
+
+    uint num_interior = cd_data->num_rigid_contacts;
+    interior.bids.swap(cd_data->bids_rigid_rigid);
+    interior.shapeIDs.swap(cd_data->contact_shapeIDs);
+    interior.norm.swap(cd_data->norm_rigid_rigid);
+    interior.cpta.swap(cd_data->cpta_rigid_rigid);
+    interior.cptb.swap(cd_data->cptb_rigid_rigid);
+    interior.dpth.swap(cd_data->dpth_rigid_rigid);
+    interior.erad.swap(cd_data->erad_rigid_rigid);
+    interior.Resize(num_interior);
+
+    // Complete the exchange, then update the system data (bodies may have been added, removed, or updated). This also
+    // resets the collide flags of all bodies.
+    data_manager->system_timer.start("Exchange");
+    comm->EndExchange();
+    data_manager->system_timer.stop("Exchange");
+
+    Setup();
+    Update();
+
+    // Boundary pass: the contacts involving bodies excluded from the interior pass (including those just received)
+    // are found among these bodies and their neighbors
+    num_bodies = data_manager->num_rigid_bodies;
+    late_bodies.resize(num_bodies, true);
+    boundary = late_bodies;
+    int axis = domain->GetSplitAxis();
+    real split = (domain->GetSubLo()[axis] + domain->GetSubHi()[axis]) / 2;
+    std::static_pointer_cast<ChCollisionSystemDistributed>(collision_system)->ExpandSelection(boundary, axis, split);
+    for (uint i = 0; i < num_bodies; i++) {
+        if (!boundary[i])
+            collide[i] = false;
+    }
+
+    collision_system->PreProcess();
+    collision_system->Run();
+
+    // Merge the contacts of both passes, discarding the boundary contacts between bodies of the interior pass
+    uint num_boundary = 0;
+    for (uint i = 0; i < cd_data->num_rigid_contacts; i++) {
+        vec2 b = cd_data->bids_rigid_rigid[i];
+        if (!late_bodies[b.x] && !late_bodies[b.y])
+            continue;
+        cd_data->bids_rigid_rigid[num_boundary] = b;
+        cd_data->contact_shapeIDs[num_boundary] = cd_data->contact_shapeIDs[i];
+        cd_data->norm_rigid_rigid[num_boundary] = cd_data->norm_rigid_rigid[i];
+        cd_data->cpta_rigid_rigid[num_boundary] = cd_data->cpta_rigid_rigid[i];
+        cd_data->cptb_rigid_rigid[num_boundary] = cd_data->cptb_rigid_rigid[i];
+        cd_data->dpth_rigid_rigid[num_boundary] = cd_data->dpth_rigid_rigid[i];
+        cd_data->erad_rigid_rigid[num_boundary] = cd_data->erad_rigid_rigid[i];
+        num_boundary++;
+    }
+
+    AppendContacts(interior.bids, cd_data->bids_rigid_rigid, num_boundary);
+    AppendContacts(interior.shapeIDs, cd_data->contact_shapeIDs, num_boundary);
+    AppendContacts(interior.norm, cd_data->norm_rigid_rigid, num_boundary);
+    AppendContacts(interior.cpta, cd_data->cpta_rigid_rigid, num_boundary);
+    AppendContacts(interior.cptb, cd_data->cptb_rigid_rigid, num_boundary);
+    AppendContacts(interior.dpth, cd_data->dpth_rigid_rigid, num_boundary);
+    AppendContacts(interior.erad, cd_data->erad_rigid_rigid, num_boundary);
+
+    cd_data->bids_rigid_rigid.swap(interior.bids);
+    cd_data->contact_shapeIDs.swap(interior.shapeIDs);
+    cd_data->norm_rigid_rigid.swap(interior.norm);
+    cd_data->cpta_rigid_rigid.swap(interior.cpta);
+    cd_data->cptb_rigid_rigid.swap(interior.cptb);
+    cd_data->dpth_rigid_rigid.swap(interior.dpth);
+    cd_data->erad_rigid_rigid.swap(interior.erad);
+    cd_data->num_rigid_contacts = num_interior + num_boundary;
+
+    // Restore the collide flags
+    for (uint i = 0; i < num_bodies; i++)
+        collide[i] = assembly.bodylist[i]->GetCollide();
+
+    collision_system->PostProcess();
+    collision_system->ReportContacts(this->contact_container.get());
+    for (size_t ic = 0; ic < collision_callbacks.size(); ic++) {
+        collision_callbacks[ic]->OnCustomCollision(this);
+    }
+}
+
+void ChSystemDistributed::SetLoadBalancing(int interval, double contact_weight, double tolerance) {
+    lb_interval = std::max(interval, 0);
+    lb_contact_weight = contact_weight;
+    lb_tolerance = tolerance;
+    lb_step = 0;
+}
+
+bool ChSystemDistributed::RebalanceDomain() {
+    // Load of this rank: bodies it integrates and contacts it processes
+    double load = 0;
+    for (uint i = 0; i < data_manager->num_rigid_bodies; i++) {
+        int status = ddm->comm_status[i];
+        if (status == distributed::OWNED || status == distributed::SHARED_UP || status == distributed::SHARED_DOWN)
+            load += 1;
+    }
+    load += lb_contact_weight * data_manager->cd_data->num_rigid_contacts;
+
+    std::vector<double> loads(num_ranks);
+    MPI_Allgather(&load, 1, MPI_DOUBLE, loads.data(), 1, MPI_DOUBLE, world);
+
+    // Limit the boundary motion so that, together with the motion of the bodies, no body skips a region
+    return domain->Rebalance(loads, 0.25 * ghost_layer, lb_tolerance);
+}
+
 void ChSystemDistributed::UpdateRigidBodies() {
     this->ChSystemMulticore::UpdateRigidBodies();
 
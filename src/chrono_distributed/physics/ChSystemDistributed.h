@@ -80,6 +80,25 @@ class CH_DISTR_API ChSystemDistributed : public ChSystemMulticoreSMC {
     /// Return the current global number of bodies in the system.
     unsigned int GetNumBodiesGlobal() const { return num_bodies_global; }
 
+    /// Enable/disable deferred completion of the inter-rank exchange (default: disabled).
+    /// If enabled, the exchange started at the end of a step is completed during the collision detection of the next
+    /// step, so that communication overlaps with any work performed between steps and with the detection of the
+    /// contacts between the bodies integrated on this rank (see CollisionDetection). Work between steps must not rely
+    /// on ghost bodies or on bodies migrating between ranks, and must not call collective functions of this system.
+    void SetDeferredExchange(bool val) { deferred_exchange = val; }
+
+    /// Enable periodic re-partitioning of the global domain based on the load of each rank (default: disabled).
+    /// Every 'interval' steps, the sub-domain boundaries are moved to even out the per-rank loads, measured as the
+    /// number of bodies integrated on a rank plus 'contact_weight' times the number of contacts it processes. Bodies
+    /// are migrated by the regular exchange at the following steps. A value interval = 0 disables load balancing.
+    /// See ChDomainDistributed::Rebalance.
+    void SetLoadBalancing(int interval, double contact_weight = 0.1, double tolerance = 0.1);
+
+    /// Re-partition the global domain based on the current load of each rank.
+    /// Each sub-domain boundary moves by at most a quarter of the ghost layer per call.
+    /// This function should be called *on all ranks*. Return true if the domain decomposition changed.
+    bool RebalanceDomain();
+
     /// Return true if pos is within this rank's sub-domain.
     bool InSub(const ChVector<double>& pos) const;
 
@@ -113,6 +132,13 @@ class CH_DISTR_API ChSystemDistributed : public ChSystemMulticoreSMC {
     /// Wraps super-class UpdateRigidBodies and adds a gid update.
     virtual void UpdateRigidBodies() override;
 
+    /// Perform the collision detection, completing a deferred exchange while it runs.
+    /// The contacts between the bodies integrated on this rank (which are not modified by incoming messages) are
+    /// found while the exchange is in flight. The exchange is then completed, the system data is updated, and the
+    /// contacts involving ghost bodies or bodies received from other ranks are found by a second pass restricted to
+    /// these bodies and to their neighbors.
+    virtual void CollisionDetection() override;
+
     /// Internal call for removing deactivating a body.
     /// Should not be called by the user.
     void RemoveBodyExchange(int index);
@@ -236,9 +262,32 @@ class CH_DISTR_API ChSystemDistributed : public ChSystemMulticoreSMC {
     /// Class for domain decomposition
     ChDomainDistributed* domain;
 
+    bool deferred_exchange;  ///< complete the exchange at the beginning of the next step?
+
+    int lb_interval;           ///< number of steps between load balancing (0 if disabled)
+    double lb_contact_weight;  ///< weight of a contact relative to a body in the load of a rank
+    double lb_tolerance;       ///< allowed load imbalance (fraction of the average load)
+    int lb_step;               ///< steps since the last load balancing
+
     /// Class for MPI communication
     ChCommDistributed* comm;
 
+    /// Contacts found before the completion of a deferred exchange (see CollisionDetection)
+    struct InteriorContacts {
+        std::vector<vec2> bids;
+        std::vector<long long> shapeIDs;
+        std::vector<real3> norm;
+        std::vector<real3> cpta;
+        std::vector<real3> cptb;
+        std::vector<real> dpth;
+        std::vector<real> erad;
+        void Resize(size_t n);
+    };
+
+    InteriorContacts interior;      ///< contacts between bodies not affected by the pending exchange
+    std::vector<char> late_bodies;  ///< bodies excluded from the collision detection until the exchange completes
+    std::vector<char> boundary;     ///< bodies included in the collision detection after the exchange completes
+
     /// Internal function for adding a body from communication. Should not be
     /// called by the user.
     void AddBodyExchange(std::shared_ptr<ChBody> newbody, distributed::COMM_STATUS status);
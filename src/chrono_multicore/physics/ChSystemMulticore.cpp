@@ -122,13 +122,7 @@ bool ChSystemMulticore::Integrate_Y() {
     data_manager->system_timer.stop("update");
 
     data_manager->system_timer.start("collision");
-    collision_system->PreProcess();
-    collision_system->Run();
-    collision_system->PostProcess();
-    collision_system->ReportContacts(this->contact_container.get());
-    for (size_t ic = 0; ic < collision_callbacks.size(); ic++) {
-        collision_callbacks[ic]->OnCustomCollision(this);
-    }
+    CollisionDetection();
     data_manager->system_timer.stop("collision");
 
     data_manager->system_timer.start("advance");
@@ -361,6 +355,17 @@ void ChSystemMulticore::Update() {
     UpdateBilaterals();
 }
 
+// Find the contacts and report them to the contact container, then invoke the custom collision callbacks.
+void ChSystemMulticore::CollisionDetection() {
+    collision_system->PreProcess();
+    collision_system->Run();
+    collision_system->PostProcess();
+    collision_system->ReportContacts(this->contact_container.get());
+    for (size_t ic = 0; ic < collision_callbacks.size(); ic++) {
+        collision_callbacks[ic]->OnCustomCollision(this);
+    }
+}
+
 //
 // Update all bodies in the system and populate system-wide state and force
 // vectors. Note that visualization assets are not updated.
@@ -73,6 +73,9 @@ class CH_MULTICORE_API ChSystemMulticore : public ChSystem {
     virtual void Update3DOFBodies();
     void RecomputeThreads();
 
+    /// Perform the collision detection for the current step and load the contacts in the contact container.
+    virtual void CollisionDetection();
+
     virtual ChBody* NewBody() override;
     virtual ChBodyAuxRef* NewBodyAuxRef() override;
 
@@ -1,6 +1,7 @@
 %{
 #include "chrono/motion_functions/ChFunction_Base.h"
 #include "chrono/motion_functions/ChFunction_BSpline.h"
+#include "chrono/motion_functions/ChFunction_Compiled.h"
 #include "chrono/motion_functions/ChFunction_Const.h"
 #include "chrono/motion_functions/ChFunction_ConstAcc.h"
 #include "chrono/motion_functions/ChFunction_Cycloidal.h"
@@ -72,6 +73,8 @@ SWIGRUNTIME PyObject* DowncastChFunction(chrono::ChFunction* out)
 			return SWIG_NewPointerObj(SWIG_as_voidptr(out), SWIGTYPE_p_chrono__ChFunction_Poly345, 0 |  0 );
 		else if ( typeid(*out)==typeid(chrono::ChFunction_Ramp) )
 			return SWIG_NewPointerObj(SWIG_as_voidptr(out), SWIGTYPE_p_chrono__ChFunction_Ramp, 0 |  0 );
+		else if ( typeid(*out)==typeid(chrono::ChFunction_Compiled) )
+			return SWIG_NewPointerObj(SWIG_as_voidptr(out), SWIGTYPE_p_chrono__ChFunction_Compiled, 0 |  0 );
 		else if ( typeid(*out)==typeid(chrono::ChFunction_Recorder) )
 			return SWIG_NewPointerObj(SWIG_as_voidptr(out), SWIGTYPE_p_chrono__ChFunction_Recorder, 0 |  0 );
 		else if ( typeid(*out)==typeid(chrono::ChFunction_Repeat) )
@@ -95,6 +98,7 @@ SWIGRUNTIME PyObject* DowncastChFunction(chrono::ChFunction* out)
 
 %shared_ptr(chrono::ChFunction)  
 %shared_ptr(chrono::ChFunction_BSpline)
+%shared_ptr(chrono::ChFunction_Compiled)
 %shared_ptr(chrono::ChFunction_Const)
 %shared_ptr(chrono::ChFunction_ConstAcc)
 %shared_ptr(chrono::ChFunction_Cycloidal)
@@ -145,6 +149,7 @@ SWIGRUNTIME PyObject* DowncastChFunction(chrono::ChFunction* out)
 // Parse the header file to generate wrappers
 %include "../../../chrono/motion_functions/ChFunction_Base.h" 
 %include "../../../chrono/motion_functions/ChFunction_BSpline.h" 
+%include "../../../chrono/motion_functions/ChFunction_Compiled.h"
 %include "../../../chrono/motion_functions/ChFunction_Const.h"
 %include "../../../chrono/motion_functions/ChFunction_ConstAcc.h"
 %include "../../../chrono/motion_functions/ChFunction_Cycloidal.h"
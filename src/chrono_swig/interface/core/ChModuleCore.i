@@ -157,6 +157,7 @@ using namespace chrono::fea;
 
 %shared_ptr(chrono::ChFunction)  
 %shared_ptr(chrono::ChFunction_BSpline)
+%shared_ptr(chrono::ChFunction_Compiled)
 %shared_ptr(chrono::ChFunction_Const)
 %shared_ptr(chrono::ChFunction_ConstAcc)
 %shared_ptr(chrono::ChFunction_Cycloidal)
@@ -567,6 +568,7 @@ using namespace chrono::fea;
 %DefSharedPtrDynamicDowncast(chrono,ChLink, ChLinkTrajectory)
 
 %DefSharedPtrDynamicDowncast(chrono,ChFunction, ChFunction_BSpline)
+%DefSharedPtrDynamicDowncast(chrono,ChFunction, ChFunction_Compiled)
 %DefSharedPtrDynamicDowncast(chrono,ChFunction, ChFunction_Const)
 %DefSharedPtrDynamicDowncast(chrono,ChFunction, ChFunction_ConstAcc)
 %DefSharedPtrDynamicDowncast(chrono,ChFunction, ChFunction_Cycloidal)
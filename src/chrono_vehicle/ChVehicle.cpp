@@ -22,6 +22,7 @@
 
 #include "chrono/physics/ChSystemNSC.h"
 #include "chrono/physics/ChSystemSMC.h"
+#include "chrono/utils/ChTrace.h"
 
 #include "chrono_vehicle/ChWorldFrame.h"
 #include "chrono_vehicle/ChVehicle.h"
@@ -146,6 +147,8 @@ void ChVehicle::InitializePowertrain(std::shared_ptr<ChPowertrainAssembly> power
 // -----------------------------------------------------------------------------
 
 void ChVehicle::Advance(double step) {
+    CH_TRACE("Vehicle advance");
+
     // Ensure the vehicle mass includes the mass of subsystems that may have been initialized after the vehicle
     if (!m_initialized) {
         InitializeInertiaProperties();
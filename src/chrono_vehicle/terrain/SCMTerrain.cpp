@@ -1026,7 +1026,7 @@ static const std::vector<ChVector2<int>> neighbors4{
     ChVector2<int>(0, 1)    // N
 };
 
-// Default implementation uses Map-Reduce for collecting ray intersection hits.
+// Default implementation casts all rays of a patch in a single batch (see ChCollisionSystem::RayHitBatch).
 // The alternative is to simultaenously load the global map of hits while ray casting (using a critical section).
 ////#define RAY_CASTING_WITH_CRITICAL_SECTION
 
@@ -1163,20 +1163,26 @@ void SCMLoader::ComputeInternalForces() {
 
 #else
 
-    // Map-reduce approach (to eliminate critical section)
+    // Batched approach: collect the rays that pass the quick rejection test and cast them all at once
 
     const int nthreads = GetSystem()->GetNumThreadsChrono();
-    std::vector<std::unordered_map<ChVector2<int>, HitRecord, CoordHash>> t_hits(nthreads);
+    std::vector<ChVector<>> ray_from;
+    std::vector<ChVector<>> ray_to;
+    std::vector<char> ray_keep;
+    std::vector<ChVector2<int>> ray_nodes;
+    std::vector<collision::ChCollisionSystem::ChRayhitResult> ray_results;
 
     // Loop through all moving patches (user-defined or default one)
     for (auto& p : m_patches) {
         m_timer_ray_testing.start();
 
-        // Loop through all vertices in the patch range
-        int num_ray_casts = 0;
-    #pragma omp parallel for num_threads(nthreads) reduction(+ : num_ray_casts)
-        for (int k = 0; k < p.m_range.size(); k++) {
-            int t_num = ChOMP::GetThreadNum();
+        // Create rays at all vertices in the patch range
+        int num_range = (int)p.m_range.size();
+        ray_from.resize(num_range);
+        ray_to.resize(num_range);
+        ray_keep.resize(num_range);
+    #pragma omp parallel for num_threads(nthreads)
+        for (int k = 0; k < num_range; k++) {
             ChVector2<int> ij = p.m_range[k];
 
             // Move from (i, j) to (x, y, z) representation in the world frame
@@ -1187,42 +1193,49 @@ void SCMLoader::ComputeInternalForces() {
             ChVector<> vertex_abs = m_plane.TransformPointLocalToParent(ChVector<>(x, y, z));
 
             // Create ray at current grid location
-            collision::ChCollisionSystem::ChRayhitResult mrayhit_result;
-            ChVector<> to = vertex_abs + m_Z * m_test_offset_up;
-            ChVector<> from = to - m_Z * m_test_offset_down;
+            ray_to[k] = vertex_abs + m_Z * m_test_offset_up;
+            ray_from[k] = ray_to[k] - m_Z * m_test_offset_down;
 
             // Ray-OBB test (quick rejection)
-            if (m_moving_patch && !RayOBBtest(p, from, m_Z))
-                continue;
+            ray_keep[k] = !m_moving_patch || RayOBBtest(p, ray_from[k], m_Z);
+        }
 
-            // Cast ray into collision system
-            GetSystem()->GetCollisionSystem()->RayHit(from, to, mrayhit_result);
+        // Keep only the rays that passed the rejection test
+        ray_nodes.clear();
+        int num_ray_casts = 0;
+        for (int k = 0; k < num_range; k++) {
+            if (!ray_keep[k])
+                continue;
+            ray_from[num_ray_casts] = ray_from[k];
+            ray_to[num_ray_casts] = ray_to[k];
+            ray_nodes.push_back(p.m_range[k]);
             num_ray_casts++;
-
-            if (mrayhit_result.hit) {
-                // Add to our map of hits to process
-                HitRecord record = {mrayhit_result.hitModel->GetContactable(), mrayhit_result.abs_hitPoint, -1};
-                t_hits[t_num].insert(std::make_pair(ij, record));
-            }
         }
+        ray_from.resize(num_ray_casts);
+        ray_to.resize(num_ray_casts);
+
+        // Cast rays into collision system, with the same number of threads as the loop above
+        GetSystem()->GetCollisionSystem()->RayHitBatch(ray_from, ray_to, ray_results, nthreads);
 
         m_timer_ray_testing.stop();
 
         m_num_ray_casts += num_ray_casts;
 
         // Sequential insertion in global hits
-        for (int t_num = 0; t_num < nthreads; t_num++) {
-            for (auto& h : t_hits[t_num]) {
-                // If this is the first hit from this node, initialize the node record
-                if (m_grid_map.find(h.first) == m_grid_map.end()) {
-                    double z = GetInitHeight(h.first);
-                    m_grid_map.insert(std::make_pair(h.first, NodeRecord(z, z, GetInitNormal(h.first))));
-                }
-                ////hits.insert(h);
+        for (int k = 0; k < num_ray_casts; k++) {
+            if (!ray_results[k].hit)
+                continue;
+            const ChVector2<int>& ij = ray_nodes[k];
+
+            // If this is the first hit from this node, initialize the node record
+            if (m_grid_map.find(ij) == m_grid_map.end()) {
+                double z = GetInitHeight(ij);
+                m_grid_map.insert(std::make_pair(ij, NodeRecord(z, z, GetInitNormal(ij))));
             }
 
-            hits.insert(t_hits[t_num].begin(), t_hits[t_num].end());
-            t_hits[t_num].clear();
+            // Add to our map of hits to process
+            HitRecord record = {ray_results[k].hitModel->GetContactable(), ray_results[k].abs_hitPoint, -1};
+            hits.insert(std::make_pair(ij, record));
         }
         m_num_ray_hits = (int)hits.size();
     }
@@ -18,6 +18,8 @@
 
 #include "chrono_vehicle/wheeled_vehicle/ChWheeledVehicle.h"
 
+#include "chrono/utils/ChTrace.h"
+
 #include "chrono_thirdparty/rapidjson/document.h"
 #include "chrono_thirdparty/rapidjson/prettywriter.h"
 #include "chrono_thirdparty/rapidjson/stringbuffer.h"
@@ -57,6 +59,8 @@ void ChWheeledVehicle::InitializeTire(std::shared_ptr<ChTire> tire,
 // to the terrain system.
 // -----------------------------------------------------------------------------
 void ChWheeledVehicle::Synchronize(double time, const DriverInputs& driver_inputs, const ChTerrain& terrain) {
+    CH_TRACE("Vehicle synchronize");
+
     double powertrain_torque = m_powertrain_assembly ? m_powertrain_assembly->GetOutputTorque()  : 0;
     double driveline_speed = m_driveline ? m_driveline->GetOutputDriveshaftSpeed() : 0;
 
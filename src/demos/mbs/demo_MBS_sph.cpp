@@ -19,7 +19,6 @@
 #include "chrono/core/ChRealtimeStep.h"
 #include "chrono/physics/ChSystemNSC.h"
 #include "chrono/physics/ChBodyEasy.h"
-#include "chrono/physics/ChProximityContainerSPH.h"
 #include "chrono/physics/ChMatterSPH.h"
 
 #include "chrono_irrlicht/ChVisualSystemIrrlicht.h"
@@ -54,7 +53,9 @@ void create_some_falling_items(ChSystemNSC& system) {
     myfluid->GetMaterial().Set_viscosity(0.5);
     myfluid->GetMaterial().Set_pressure_stiffness(300);
 
-    // Add the SPH fluid matter to the system
+    // Add the SPH fluid matter to the system.
+    // The interactions between the SPH particles are found by an internal neighbor search. If several SPH clusters
+    // must interact with each other, also add a ChProximityContainerSPH to the system.
     myfluid->SetCollide(true);
     system.Add(myfluid);
 
@@ -146,11 +147,6 @@ int main(int argc, char* argv[]) {
     vis->AddCamera(ChVector<>(0, 1, -1));
     vis->AddTypicalLights();
 
-    // IMPORTANT!
-    // This takes care of the interaction between the particles of the SPH material
-    auto my_sph_proximity = chrono_types::make_shared<ChProximityContainerSPH>();
-    sys.Add(my_sph_proximity);
-
     // Modify some setting of the physical system for the simulation, if you want
 
     sys.SetSolverMaxIterations(6);  // lower the solver iters, no needed here
@@ -0,0 +1,182 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2021 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Chrono unit test for the broadphase methods of the Chrono collision system:
+// the shape pairs reported by the one-level grid, the hierarchical grid, and
+// the dynamic AABB tree must match the pairs of overlapping shape AABBs found
+// by brute force, for shapes of very different sizes and as bodies move.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "chrono/core/ChMathematics.h"
+#include "chrono/collision/ChCollisionSystemChrono.h"
+#include "chrono/collision/chrono/ChCollisionUtils.h"
+#include "chrono/physics/ChSystemNSC.h"
+
+using namespace chrono;
+using namespace chrono::collision;
+
+// Collision system giving access to the broadphase results
+class ChCollisionSystemChronoTest : public ChCollisionSystemChrono {
+  public:
+    // Shape pairs reported by the last broadphase pass, as (lower ID, higher ID)
+    std::vector<std::pair<uint, uint>> GetBroadphasePairs() const {
+        std::vector<std::pair<uint, uint>> pairs;
+        for (uint i = 0; i < cd_data->num_possible_collisions; i++) {
+            long long pair = cd_data->pair_shapeIDs[i];
+            uint a = (uint)(pair >> 32);
+            uint b = (uint)(pair & 0xffffffff);
+            pairs.push_back(std::make_pair(std::min(a, b), std::max(a, b)));
+        }
+        std::sort(pairs.begin(), pairs.end());
+        return pairs;
+    }
+
+    // Shape pairs with overlapping AABBs, for shapes on different bodies that can interact
+    std::vector<std::pair<uint, uint>> GetBruteForcePairs() const {
+        const auto& body_id = cd_data->shape_data.id_rigid;
+        const auto& fam_data = cd_data->shape_data.fam_rigid;
+        const auto& body_active = *cd_data->state_data.active_rigid;
+        const auto& body_collide = *cd_data->state_data.collide_rigid;
+        const auto& aabb_min = cd_data->aabb_min;
+        const auto& aabb_max = cd_data->aabb_max;
+
+        std::vector<std::pair<uint, uint>> pairs;
+        for (uint a = 0; a < cd_data->num_rigid_shapes; a++) {
+            for (uint b = a + 1; b < cd_data->num_rigid_shapes; b++) {
+                uint bodyA = body_id[a];
+                uint bodyB = body_id[b];
+                if (bodyA == bodyB || !body_collide[bodyA] || !body_collide[bodyB])
+                    continue;
+                if (!body_active[bodyA] && !body_active[bodyB])
+                    continue;
+                if (!ch_utils::collide(fam_data[a], fam_data[b]))
+                    continue;
+                if (ch_utils::overlap(aabb_min[a], aabb_max[a], aabb_min[b], aabb_max[b]))
+                    pairs.push_back(std::make_pair(a, b));
+            }
+        }
+        return pairs;
+    }
+};
+
+enum class BroadphaseType { GRID, HIERARCHICAL, DYNAMIC_TREE };
+
+class BroadphaseTest : public ::testing::TestWithParam<BroadphaseType> {
+  protected:
+    void SetUp() override {
+        cd = chrono_types::make_shared<ChCollisionSystemChronoTest>();
+        switch (GetParam()) {
+            case BroadphaseType::GRID:
+                cd->SetBroadphaseGridResolution(ChVector<int>(10, 10, 10));
+                break;
+            case BroadphaseType::HIERARCHICAL:
+                cd->SetBroadphaseGridHierarchical();
+                break;
+            case BroadphaseType::DYNAMIC_TREE:
+                cd->SetBroadphaseDynamicTree(0.1);
+                break;
+        }
+        sys.SetCollisionSystem(cd);
+
+        auto mat = chrono_types::make_shared<ChMaterialSurfaceNSC>();
+
+        // Large fixed ground box
+        auto ground = chrono_types::make_shared<ChBody>(ChCollisionSystemType::CHRONO);
+        ground->SetBodyFixed(true);
+        ground->SetCollide(true);
+        ground->GetCollisionModel()->ClearModel();
+        ground->GetCollisionModel()->AddBox(mat, 10, 0.5, 10, ChVector<>(0, -0.5, 0));
+        ground->GetCollisionModel()->BuildModel();
+        sys.AddBody(ground);
+
+        // Bodies with spheres and boxes of very different sizes
+        ChSetRandomSeed(42);
+        for (int i = 0; i < 300; i++) {
+            auto body = chrono_types::make_shared<ChBody>(ChCollisionSystemType::CHRONO);
+            body->SetPos(RandomPosition());
+            body->SetRot(Q_from_AngAxis(CH_C_2PI * ChRandom(), ChVector<>(1, 1, 0).GetNormalized()));
+            body->SetCollide(true);
+            body->GetCollisionModel()->ClearModel();
+            double size = (i % 10 == 0) ? 1.0 + ChRandom() : 0.02 + 0.1 * ChRandom();
+            if (i % 2 == 0)
+                body->GetCollisionModel()->AddSphere(mat, size);
+            else
+                body->GetCollisionModel()->AddBox(mat, size, 0.5 * size, size);
+            body->GetCollisionModel()->BuildModel();
+            sys.AddBody(body);
+            bodies.push_back(body);
+        }
+
+        // Bodies in families that do not collide with each other
+        bodies[1]->GetCollisionModel()->SetFamily(2);
+        bodies[1]->GetCollisionModel()->SetFamilyMaskNoCollisionWithFamily(3);
+        bodies[3]->GetCollisionModel()->SetFamily(3);
+        bodies[3]->GetCollisionModel()->SetFamilyMaskNoCollisionWithFamily(2);
+        bodies[3]->SetPos(bodies[1]->GetPos());
+    }
+
+    static ChVector<> RandomPosition() { return ChVector<>(8 * ChRandom() - 4, 3 * ChRandom(), 8 * ChRandom() - 4); }
+
+    // Compare the broadphase results with the brute-force pairs
+    void Check() {
+        sys.Setup();
+        sys.ComputeCollisions();
+
+        auto pairs = cd->GetBroadphasePairs();
+        auto pairs_ref = cd->GetBruteForcePairs();
+        ASSERT_GT(pairs_ref.size(), 0);
+        ASSERT_EQ(pairs.size(), pairs_ref.size());
+        for (size_t i = 0; i < pairs_ref.size(); i++) {
+            ASSERT_EQ(pairs[i].first, pairs_ref[i].first);
+            ASSERT_EQ(pairs[i].second, pairs_ref[i].second);
+        }
+    }
+
+    ChSystemNSC sys;
+    std::shared_ptr<ChCollisionSystemChronoTest> cd;
+    std::vector<std::shared_ptr<ChBody>> bodies;
+};
+
+TEST_P(BroadphaseTest, pairs_vs_brute_force) {
+    Check();
+}
+
+TEST_P(BroadphaseTest, moving_bodies) {
+    Check();
+
+    // Small motions of all bodies (mostly within the fat AABBs of the dynamic tree)
+    for (int step = 0; step < 5; step++) {
+        for (auto& body : bodies)
+            body->SetPos(body->GetPos() + 0.02 * ChVector<>(ChRandom() - 0.5, ChRandom() - 0.5, ChRandom() - 0.5));
+        Check();
+    }
+
+    // Large motions of some bodies, and sleeping bodies
+    for (size_t i = 0; i < bodies.size(); i += 7)
+        bodies[i]->SetPos(RandomPosition());
+    for (size_t i = 0; i < bodies.size(); i += 11)
+        bodies[i]->SetSleeping(true);
+    Check();
+}
+
+INSTANTIATE_TEST_SUITE_P(ChBroadphase,
+                         BroadphaseTest,
+                         ::testing::Values(BroadphaseType::GRID,
+                                           BroadphaseType::HIERARCHICAL,
+                                           BroadphaseType::DYNAMIC_TREE));
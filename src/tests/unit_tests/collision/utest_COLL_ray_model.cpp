@@ -0,0 +1,160 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2021 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Chrono unit test for model-specific ray casting with the Chrono collision
+// system: hits obtained through the shape hierarchy of a collision model must
+// match a brute-force test against all shapes of the model, also after the
+// body carrying the model has moved.
+//
+// =============================================================================
+
+#include <cmath>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "chrono/core/ChMathematics.h"
+#include "chrono/collision/ChCollisionSystemChrono.h"
+#include "chrono/physics/ChSystemNSC.h"
+
+using namespace chrono;
+using namespace chrono::collision;
+
+#ifdef USE_COLLISION_DOUBLE
+const double precision = 1e-8;
+#else
+const double precision = 1e-4;
+#endif
+
+// Closest intersection of the segment [from, to] with the sphere of given center and radius.
+// Return the ray parameter in [0,1], or a negative value if there is no intersection. 'margin' returns the distance of
+// the closest approach of the line to the sphere surface (used to skip grazing rays).
+static double RaySphere(const ChVector<>& from,
+                        const ChVector<>& to,
+                        const ChVector<>& center,
+                        double radius,
+                        double& margin) {
+    ChVector<> ray = to - from;
+    ChVector<> d = from - center;
+    double a = ray.Length2();
+    double b = Vdot(d, ray);
+    double c = d.Length2() - radius * radius;
+    double disc = b * b - a * c;
+    margin = std::abs(std::sqrt(std::max(d.Length2() - b * b / a, 0.0)) - radius);
+    if (disc < 0)
+        return -1;
+    double t = (-b - std::sqrt(disc)) / a;
+    return (t >= 0 && t <= 1) ? t : -1;
+}
+
+class RayModelTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        auto cd_chrono = chrono_types::make_shared<ChCollisionSystemChrono>();
+        sys.SetCollisionSystem(cd_chrono);
+
+        auto mat = chrono_types::make_shared<ChMaterialSurfaceNSC>();
+
+        // Body with many spherical shapes
+        body = chrono_types::make_shared<ChBody>(ChCollisionSystemType::CHRONO);
+        body->SetBodyFixed(true);
+        body->SetCollide(true);
+        body->GetCollisionModel()->ClearModel();
+        ChSetRandomSeed(17);
+        for (int i = 0; i < 200; i++) {
+            ChVector<> center(4 * ChRandom() - 2, 4 * ChRandom() - 2, 4 * ChRandom() - 2);
+            double radius = 0.05 + 0.15 * ChRandom();
+            body->GetCollisionModel()->AddSphere(mat, radius, center);
+            centers.push_back(center);
+            radii.push_back(radius);
+        }
+        body->GetCollisionModel()->BuildModel();
+        sys.AddBody(body);
+
+        // Second body, in the way of some of the rays, which must be ignored by model-specific tests
+        other = chrono_types::make_shared<ChBody>(ChCollisionSystemType::CHRONO);
+        other->SetBodyFixed(true);
+        other->SetCollide(true);
+        other->GetCollisionModel()->ClearModel();
+        other->GetCollisionModel()->AddSphere(mat, 1.0);
+        other->GetCollisionModel()->BuildModel();
+        sys.AddBody(other);
+    }
+
+    // Compare model-specific ray hits with brute-force hits, for the current body position and orientation
+    void Check() {
+        sys.Setup();
+        sys.ComputeCollisions();
+        auto coll_sys = sys.GetCollisionSystem();
+
+        int num_hits = 0;
+        int num_tested = 0;
+        for (int i = 0; i < 1000; i++) {
+            // Random segment with end points outside the shapes of the model
+            ChVector<> dir(ChRandom() - 0.5, ChRandom() - 0.5, ChRandom() - 0.5);
+            dir.Normalize();
+            ChVector<> offset(2 * ChRandom() - 1, 2 * ChRandom() - 1, 2 * ChRandom() - 1);
+            ChVector<> from = body->GetPos() + offset - 6.0 * dir;
+            ChVector<> to = body->GetPos() + offset + 6.0 * dir;
+
+            // Brute-force test against all shapes of the model
+            double t_ref = 2;
+            double min_margin = 1;
+            for (size_t k = 0; k < centers.size(); k++) {
+                double margin;
+                double t = RaySphere(from, to, body->TransformPointLocalToParent(centers[k]), radii[k], margin);
+                min_margin = std::min(min_margin, margin);
+                if (t >= 0 && t < t_ref)
+                    t_ref = t;
+            }
+            if (min_margin < 10 * precision)
+                continue;
+            num_tested++;
+
+            ChCollisionSystem::ChRayhitResult result;
+            bool hit = coll_sys->RayHit(from, to, body->GetCollisionModel().get(), result);
+            ASSERT_EQ(hit, t_ref <= 1);
+            if (hit) {
+                num_hits++;
+                ASSERT_EQ(result.hitModel, body->GetCollisionModel().get());
+                ASSERT_NEAR(result.dist_factor, t_ref, precision);
+                ASSERT_NEAR((result.abs_hitPoint - (from + t_ref * (to - from))).Length(), 0, 20 * precision);
+            }
+        }
+
+        // Make sure that both hits and misses were tested
+        ASSERT_GT(num_hits, 0);
+        ASSERT_LT(num_hits, num_tested);
+    }
+
+    ChSystemNSC sys;
+    std::shared_ptr<ChBody> body;
+    std::shared_ptr<ChBody> other;
+    std::vector<ChVector<>> centers;
+    std::vector<double> radii;
+};
+
+TEST_F(RayModelTest, hierarchy_vs_brute_force) {
+    other->SetPos(ChVector<>(0, 0, 3));
+    Check();
+}
+
+TEST_F(RayModelTest, moving_body) {
+    other->SetPos(ChVector<>(0, 0, 3));
+    Check();
+
+    // The hierarchy is expressed in the body frame and remains valid after the body moves
+    body->SetPos(ChVector<>(1, -2, 0.5));
+    body->SetRot(Q_from_AngAxis(0.7, ChVector<>(1, 2, 3).GetNormalized()));
+    other->SetPos(ChVector<>(1, -2, 3.5));
+    Check();
+}
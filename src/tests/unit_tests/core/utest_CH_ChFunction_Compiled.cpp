@@ -0,0 +1,99 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for ChFunction_Recorder lookup and ChFunction_Compiled
+//
+// =============================================================================
+
+#include <cmath>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "chrono/motion_functions/ChFunction.h"
+
+using namespace chrono;
+
+TEST(ChFunctionRecorderTest, unordered_insert) {
+    ChFunction_Recorder rec;
+    double xs[] = {3, 1, 4, 0, 2, 5, 2};
+    for (double x : xs)
+        rec.AddPoint(x, 10 * x);
+
+    ASSERT_EQ(rec.GetPoints().size(), 6u);
+    for (size_t i = 1; i < rec.GetPoints().size(); i++)
+        ASSERT_LT(rec.GetPoints()[i - 1].x, rec.GetPoints()[i].x);
+
+    // Random access, backwards and forwards
+    double q[] = {4.5, 0.25, 2.5, 2.75, 1.5, 3.0, -1.0, 6.0};
+    for (double x : q) {
+        double expected = 10 * std::min(std::max(x, 0.0), 5.0);
+        ASSERT_NEAR(rec.Get_y(x), expected, 1e-12);
+    }
+}
+
+TEST(ChFunctionCompiledTest, recorder) {
+    ChFunction_Recorder rec;
+    rec.AddPoint(0.0, 1.0);
+    rec.AddPoint(0.5, 2.0);
+    rec.AddPoint(2.0, -1.0);
+    rec.AddPoint(3.0, 0.0);
+
+    ChFunction_Compiled fc(rec);
+    ASSERT_EQ(fc.GetNumSegments(), 3);
+    ASSERT_FALSE(fc.IsUniform());
+    for (double x = -0.5; x <= 3.5; x += 0.01)
+        ASSERT_NEAR(fc.Get_y(x), rec.Get_y(x), 1e-12);
+    ASSERT_NEAR(fc.Get_y_dx(1.0), -2.0, 1e-12);
+}
+
+TEST(ChFunctionCompiledTest, cubic_exact) {
+    // Hermite interpolation reproduces cubics exactly
+    ChFunction_Poly poly;
+    poly.Set_order(3);
+    poly.Set_coeff(1.0, 0);
+    poly.Set_coeff(-2.0, 1);
+    poly.Set_coeff(0.5, 2);
+    poly.Set_coeff(0.25, 3);
+
+    ChFunction_Compiled fc(poly, -1.0, 2.0, 7);
+    ASSERT_TRUE(fc.IsUniform());
+    for (double x = -1.0; x <= 2.0; x += 0.013) {
+        ASSERT_NEAR(fc.Get_y(x), poly.Get_y(x), 1e-12);
+        ASSERT_NEAR(fc.Get_y_dx(x), poly.Get_y_dx(x), 1e-10);
+        ASSERT_NEAR(fc.Get_y_dxdx(x), poly.Get_y_dxdx(x), 1e-10);
+    }
+}
+
+TEST(ChFunctionCompiledTest, tree) {
+    // y = sin(2 pi x) * (1 + 0.5 x)
+    auto sine = chrono_types::make_shared<ChFunction_Sine>(0, 1, 1);
+    auto ramp = chrono_types::make_shared<ChFunction_Ramp>(1, 0.5);
+    ChFunction_Operation op;
+    op.Set_optype(ChFunction_Operation::ChOP_MUL);
+    op.Set_fa(sine);
+    op.Set_fb(ramp);
+
+    ChFunction_Compiled fc(op, 0.0, 2.0, 400);
+
+    std::vector<double> x(1000);
+    std::vector<double> y(x.size());
+    for (size_t i = 0; i < x.size(); i++)
+        x[i] = -0.1 + 2.2 * i / (x.size() - 1);
+    fc.Get_y_array(x.data(), y.data(), x.size());
+
+    for (size_t i = 0; i < x.size(); i++) {
+        ASSERT_DOUBLE_EQ(y[i], fc.Get_y(x[i]));
+        double xc = std::min(std::max(x[i], 0.0), 2.0);
+        ASSERT_NEAR(y[i], op.Get_y(xc), 1e-6);
+    }
+}
@@ -0,0 +1,145 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Test for the sparse assembly plan: a system matrix assembled by replaying a
+// recorded plan, after all values in the problem changed, must match the
+// matrix assembled from scratch by the system descriptor.
+//
+// =============================================================================
+
+#include <memory>
+#include <vector>
+
+#include "chrono/core/ChMathematics.h"
+#include "chrono/solver/ChConstraintTwoGeneric.h"
+#include "chrono/solver/ChKblockGeneric.h"
+#include "chrono/solver/ChSparseAssemblyPlan.h"
+#include "chrono/solver/ChSystemDescriptor.h"
+#include "chrono/solver/ChVariablesGeneric.h"
+
+#include "gtest/gtest.h"
+
+using namespace chrono;
+
+// Chain of variables coupled by stiffness blocks (some of them sharing the same elements) and constraints
+class AssemblyPlanTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        for (int i = 0; i < 8; i++)
+            variables.push_back(std::make_shared<ChVariablesGeneric>(3));
+
+        for (int i = 0; i + 1 < 8; i++) {
+            kblocks.push_back(std::make_shared<ChKblockGeneric>(variables[i].get(), variables[i + 1].get()));
+            kblocks.push_back(std::make_shared<ChKblockGeneric>(variables[i].get(), variables[i + 1].get()));
+        }
+
+        for (int i = 0; i + 2 < 8; i++)
+            constraints.push_back(std::make_shared<ChConstraintTwoGeneric>(variables[i].get(), variables[i + 2].get()));
+
+        // Inactive constraint, coupling variables with no other interaction
+        constraints.push_back(std::make_shared<ChConstraintTwoGeneric>(variables[0].get(), variables[7].get()));
+        constraints.back()->SetActive(false);
+
+        sysd.BeginInsertion();
+        for (auto& var : variables)
+            sysd.InsertVariables(var.get());
+        for (auto& kblock : kblocks)
+            sysd.InsertKblock(kblock.get());
+        for (auto& constraint : constraints)
+            sysd.InsertConstraint(constraint.get());
+        sysd.EndInsertion();
+
+        Randomize();
+    }
+
+    // Set new random values in all mass matrices, stiffness blocks, and constraints
+    void Randomize() {
+        for (auto& var : variables)
+            var->GetMass().setRandom();
+        for (auto& kblock : kblocks)
+            kblock->Get_K().setRandom();
+        for (auto& constraint : constraints) {
+            constraint->Get_Cq_a().setRandom();
+            constraint->Get_Cq_b().setRandom();
+            constraint->Set_cfm_i(ChRandom());
+        }
+        sysd.SetMassFactor(0.5 + ChRandom());
+    }
+
+    // Compare the given matrix with the matrix assembled by the system descriptor
+    void Compare(const ChSparseMatrix& mat) {
+        ChSparseMatrix ref;
+        sysd.ConvertToMatrixForm(&ref, nullptr);
+
+        ASSERT_EQ(mat.rows(), ref.rows());
+        ASSERT_EQ(mat.cols(), ref.cols());
+        ChMatrixDynamic<> A = mat.toDense();
+        ChMatrixDynamic<> B = ref.toDense();
+        ASSERT_GT(B.norm(), 0);
+        ASSERT_NEAR((A - B).norm(), 0, 1e-12 * B.norm());
+    }
+
+    ChSystemDescriptor sysd;
+    std::vector<std::shared_ptr<ChVariablesGeneric>> variables;
+    std::vector<std::shared_ptr<ChKblockGeneric>> kblocks;
+    std::vector<std::shared_ptr<ChConstraintTwoGeneric>> constraints;
+};
+
+TEST_F(AssemblyPlanTest, replay) {
+    // Matrix with the sparsity pattern of the problem
+    ChSparseMatrix mat;
+    sysd.ConvertToMatrixForm(&mat, nullptr);
+    mat.makeCompressed();
+
+    // Record the plan
+    ChSparseAssemblyPlan plan;
+    ASSERT_TRUE(plan.Assemble(sysd, mat));
+    ASSERT_TRUE(plan.IsValid());
+    ASSERT_GT(plan.GetNumColors(), 1);
+    Compare(mat);
+
+    // Replay the plan after all values changed, sequentially and in parallel
+    for (int nthreads : {1, 4}) {
+        sysd.SetNumThreads(nthreads);
+        for (int i = 0; i < 3; i++) {
+            Randomize();
+            ASSERT_TRUE(plan.Assemble(sysd, mat));
+            Compare(mat);
+        }
+    }
+}
+
+TEST_F(AssemblyPlanTest, structure_change) {
+    ChSparseMatrix mat;
+    sysd.ConvertToMatrixForm(&mat, nullptr);
+    mat.makeCompressed();
+
+    ChSparseAssemblyPlan plan;
+    ASSERT_TRUE(plan.Assemble(sysd, mat));
+
+    // Same number of active constraints, but with elements not in the sparsity pattern: the plan is discarded
+    constraints[0]->SetActive(false);
+    constraints.back()->SetActive(true);
+    sysd.UpdateCountsAndOffsets();
+    Randomize();
+    ASSERT_FALSE(plan.Assemble(sysd, mat));
+    ASSERT_FALSE(plan.IsValid());
+
+    // With the new sparsity pattern, a new plan is recorded and replayed
+    sysd.ConvertToMatrixForm(&mat, nullptr);
+    mat.makeCompressed();
+    ASSERT_TRUE(plan.Assemble(sysd, mat));
+    Compare(mat);
+    Randomize();
+    ASSERT_TRUE(plan.Assemble(sysd, mat));
+    Compare(mat);
+}
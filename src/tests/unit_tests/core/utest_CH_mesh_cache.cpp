@@ -0,0 +1,99 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the binary cache of Wavefront OBJ triangle meshes
+//
+// =============================================================================
+
+#include <fstream>
+#include <map>
+
+#include "gtest/gtest.h"
+
+#include "chrono/geometry/ChTriangleMeshConnected.h"
+
+using namespace chrono;
+using namespace chrono::geometry;
+
+static void WriteBox(const std::string& filename, double size) {
+    std::ofstream obj(filename);
+    double s = size / 2;
+    for (int i = 0; i < 8; i++)
+        obj << "v " << (i & 1 ? s : -s) << " " << (i & 2 ? s : -s) << " " << (i & 4 ? s : -s) << "\n";
+    obj << "vn 0 0 1\n";
+    int faces[12][3] = {{1, 3, 2}, {2, 3, 4}, {5, 6, 7}, {6, 8, 7}, {1, 2, 5}, {2, 6, 5},
+                        {3, 7, 4}, {4, 7, 8}, {1, 5, 3}, {3, 5, 7}, {2, 4, 6}, {4, 8, 6}};
+    for (auto& f : faces)
+        obj << "f " << f[0] << "//1 " << f[1] << "//1 " << f[2] << "//1\n";
+}
+
+TEST(ChTriangleMeshConnectedTest, cache) {
+    std::string obj_file = "utest_mesh_cache_box.obj";
+    WriteBox(obj_file, 1.0);
+
+    // Reference mesh, loaded without cache
+    ChTriangleMeshConnected::SetCacheDirectory("");
+    ChTriangleMeshConnected ref;
+    ASSERT_TRUE(ref.LoadWavefrontMesh(obj_file, true, false));
+
+    // First load parses the OBJ file and writes the cache, second load reads the cache
+    ChTriangleMeshConnected::SetCacheDirectory("utest_mesh_cache");
+    ChTriangleMeshConnected mesh1;
+    ASSERT_TRUE(mesh1.LoadWavefrontMesh(obj_file, true, false));
+    ChTriangleMeshConnected mesh2;
+    ASSERT_TRUE(mesh2.LoadWavefrontMesh(obj_file, true, false));
+
+    for (auto mesh : {&mesh1, &mesh2}) {
+        ASSERT_EQ(mesh->getNumVertices(), ref.getNumVertices());
+        ASSERT_EQ(mesh->getNumNormals(), ref.getNumNormals());
+        ASSERT_EQ(mesh->getNumTriangles(), ref.getNumTriangles());
+        for (int i = 0; i < ref.getNumVertices(); i++)
+            ASSERT_TRUE(mesh->m_vertices[i] == ref.m_vertices[i]);
+        for (int i = 0; i < ref.getNumTriangles(); i++) {
+            ASSERT_TRUE(mesh->m_face_v_indices[i] == ref.m_face_v_indices[i]);
+            ASSERT_TRUE(mesh->m_face_n_indices[i] == ref.m_face_n_indices[i]);
+        }
+        ASSERT_EQ(mesh->GetFileName(), obj_file);
+    }
+
+    // Adjacency obtained from the cache must match the one computed from scratch
+    std::vector<std::array<int, 4>> tri_map_ref;
+    std::vector<std::array<int, 4>> tri_map;
+    ASSERT_EQ(ref.ComputeNeighbouringTriangleMap(tri_map_ref), mesh2.ComputeNeighbouringTriangleMap(tri_map));
+    ASSERT_TRUE(tri_map == tri_map_ref);
+
+    for (bool single_wing : {true, false}) {
+        std::map<std::pair<int, int>, std::pair<int, int>> edges_ref;
+        std::map<std::pair<int, int>, std::pair<int, int>> edges;
+        ref.ComputeWingedEdges(edges_ref, single_wing);
+        mesh2.ComputeWingedEdges(edges, single_wing);
+        ASSERT_TRUE(edges == edges_ref);
+    }
+
+    // A modified source file must not be served from the cache
+    WriteBox(obj_file, 2.0);
+    ChTriangleMeshConnected mesh3;
+    ASSERT_TRUE(mesh3.LoadWavefrontMesh(obj_file, true, false));
+    ASSERT_DOUBLE_EQ(mesh3.m_vertices[7].x(), 1.0);
+
+    // A cache file with a different key is rejected
+    ASSERT_FALSE(mesh3.LoadCacheFile("utest_mesh_cache/none.chmesh", 0));
+    std::string cache_file = "utest_mesh_cache/explicit.chmesh";
+    ASSERT_TRUE(mesh3.WriteCacheFile(cache_file, 42));
+    ChTriangleMeshConnected mesh4;
+    ASSERT_FALSE(mesh4.LoadCacheFile(cache_file, 43));
+    ASSERT_EQ(mesh4.getNumTriangles(), 0);
+    ASSERT_TRUE(mesh4.LoadCacheFile(cache_file, 42));
+    ASSERT_EQ(mesh4.getNumTriangles(), 12);
+
+    ChTriangleMeshConnected::SetCacheDirectory("");
+}
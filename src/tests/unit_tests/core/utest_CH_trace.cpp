@@ -0,0 +1,125 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Test for trace recording: events recorded in several threads must be
+// exported as a valid JSON document in the Chrome trace event format.
+//
+// =============================================================================
+
+#include <cstdio>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "chrono/utils/ChTrace.h"
+
+#include "chrono_thirdparty/rapidjson/document.h"
+#include "chrono_thirdparty/rapidjson/filereadstream.h"
+
+#include "gtest/gtest.h"
+
+using namespace chrono;
+using namespace chrono::utils;
+
+// Record nested events in the calling thread
+static void RecordEvents(int num_events) {
+    for (int i = 0; i < num_events; i++) {
+        ChTraceScope outer("outer \"scope\"");
+        {
+            ChTraceScope inner("inner\\scope");
+        }
+    }
+}
+
+TEST(ChTraceTest, chrome_trace) {
+    ChTrace::Clear();
+    ChTrace::Enable(true);
+
+    // Thread name with characters which must be escaped (or replaced) in JSON
+    ChTrace::SetThreadName("main \"thread\"\\\n");
+    RecordEvents(10);
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 3; i++)
+        threads.push_back(std::thread([i]() {
+            ChTrace::SetThreadName("worker " + std::to_string(i));
+            RecordEvents(5 + i);
+        }));
+    for (auto& thread : threads)
+        thread.join();
+
+    ChTrace::Enable(false);
+
+    // Events are not recorded while tracing is disabled
+    RecordEvents(10);
+    size_t num_events = ChTrace::GetNumEvents();
+    ASSERT_EQ(num_events, 2 * (10 + 5 + 6 + 7));
+
+    std::string filename = "utest_CH_trace.json";
+    ChTrace::ExportChromeTrace(filename);
+
+    // Parse the exported file
+    FILE* fp = fopen(filename.c_str(), "r");
+    ASSERT_TRUE(fp != nullptr);
+    char readBuffer[65536];
+    rapidjson::FileReadStream is(fp, readBuffer, sizeof(readBuffer));
+    rapidjson::Document d;
+    d.ParseStream(is);
+    fclose(fp);
+    std::remove(filename.c_str());
+
+    ASSERT_FALSE(d.HasParseError());
+    ASSERT_TRUE(d.IsObject());
+    ASSERT_TRUE(d.HasMember("traceEvents"));
+    ASSERT_TRUE(d["traceEvents"].IsArray());
+
+    // Check the events, and collect the thread names
+    std::map<int, std::string> thread_names;
+    std::map<int, int> thread_events;
+    size_t num_exported = 0;
+    for (const auto& event : d["traceEvents"].GetArray()) {
+        ASSERT_TRUE(event.IsObject());
+        ASSERT_TRUE(event["name"].IsString());
+        ASSERT_TRUE(event["ph"].IsString());
+        ASSERT_TRUE(event["tid"].IsInt());
+        int tid = event["tid"].GetInt();
+        std::string ph = event["ph"].GetString();
+        if (ph == "M") {
+            ASSERT_EQ(std::string(event["name"].GetString()), "thread_name");
+            thread_names[tid] = event["args"]["name"].GetString();
+        } else {
+            ASSERT_EQ(ph, "X");
+            std::string name = event["name"].GetString();
+            ASSERT_TRUE(name == "outer \"scope\"" || name == "inner\\scope");
+            ASSERT_TRUE(event["ts"].IsNumber());
+            ASSERT_TRUE(event["dur"].IsNumber());
+            ASSERT_GE(event["dur"].GetDouble(), 0.0);
+            ASSERT_EQ(thread_names.count(tid), 1);
+            thread_events[tid]++;
+            num_exported++;
+        }
+    }
+    ASSERT_EQ(num_exported, num_events);
+
+    // Each thread which recorded events appears with its own name
+    std::map<std::string, int> events_by_name;
+    for (const auto& te : thread_events)
+        events_by_name[thread_names[te.first]] += te.second;
+    ASSERT_EQ(events_by_name["main \"thread\"\\ "], 20);
+    ASSERT_EQ(events_by_name["worker 0"], 10);
+    ASSERT_EQ(events_by_name["worker 1"], 12);
+    ASSERT_EQ(events_by_name["worker 2"], 14);
+
+    ChTrace::Clear();
+    ASSERT_EQ(ChTrace::GetNumEvents(), 0);
+}
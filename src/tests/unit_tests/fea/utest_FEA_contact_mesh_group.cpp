@@ -0,0 +1,218 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Test for contact surface meshes using a single (grouped) collision model:
+// contacts must be reported with the collision model and shape of the triangle
+// which generated them, and must match the contacts found when each triangle
+// is added separately to the collision system.
+//
+// =============================================================================
+
+#include <cmath>
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "chrono/collision/ChCollisionModelBullet.h"
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChSystemSMC.h"
+
+#include "chrono/fea/ChContactSurfaceMesh.h"
+#include "chrono/fea/ChMesh.h"
+
+#include "gtest/gtest.h"
+
+using namespace chrono;
+using namespace chrono::collision;
+using namespace chrono::fea;
+
+// Record the collision models and shapes of all contacts
+class ContactRecorder : public ChCollisionSystem::NarrowphaseCallback {
+  public:
+    struct Contact {
+        ChCollisionModel* modelA;
+        ChCollisionModel* modelB;
+        ChCollisionShape* shapeA;
+        ChCollisionShape* shapeB;
+        ChVector<> ptA;
+        ChVector<> ptB;
+    };
+
+    virtual bool OnNarrowphase(ChCollisionInfo& cinfo) override {
+        contacts.push_back({cinfo.modelA, cinfo.modelB, cinfo.shapeA, cinfo.shapeB, cinfo.vpA, cinfo.vpB});
+        return true;
+    }
+
+    std::vector<Contact> contacts;
+};
+
+// Flat triangulated surface in the plane y = 0, with small spheres touching the centroids of some triangles
+class ContactMeshTest {
+  public:
+    ContactMeshTest(bool use_group) {
+        ChCollisionModel::SetDefaultSuggestedEnvelope(0.001);
+        ChCollisionModel::SetDefaultSuggestedMargin(0.001);
+
+        auto mat = chrono_types::make_shared<ChMaterialSurfaceSMC>();
+
+        auto mesh = chrono_types::make_shared<ChMesh>();
+        const int n = 6;
+        const double size = 0.2;
+        for (int i = 0; i <= n; i++) {
+            for (int j = 0; j <= n; j++) {
+                auto node = chrono_types::make_shared<ChNodeFEAxyz>(ChVector<>(i * size, 0, j * size));
+                node->SetFixed(true);
+                mesh->AddNode(node);
+                nodes.push_back(node);
+            }
+        }
+
+        surface = chrono_types::make_shared<ChContactSurfaceMesh>(mat);
+        mesh->AddContactSurface(surface);
+        for (int i = 0; i < n; i++) {
+            for (int j = 0; j < n; j++) {
+                auto n00 = nodes[i * (n + 1) + j];
+                auto n10 = nodes[(i + 1) * (n + 1) + j];
+                auto n01 = nodes[i * (n + 1) + j + 1];
+                auto n11 = nodes[(i + 1) * (n + 1) + j + 1];
+                surface->AddFace(n00, n01, n10, nullptr, nullptr, nullptr, true, true, true, true, true, true);
+                surface->AddFace(n11, n10, n01, nullptr, nullptr, nullptr, true, true, true, true, true, true);
+            }
+        }
+        surface->UseMeshCollisionModel(use_group);
+        sys.Add(mesh);
+
+        // Spheres touching every third triangle at its centroid
+        const auto& faces = surface->GetTriangleList();
+        for (size_t k = 0; k < faces.size(); k += 3) {
+            ChVector<> centroid =
+                (faces[k]->GetNode(0)->GetPos() + faces[k]->GetNode(1)->GetPos() + faces[k]->GetNode(2)->GetPos()) / 3;
+            auto sphere = chrono_types::make_shared<ChBodyEasySphere>(0.02, 1000, false, true, mat);
+            sphere->SetPos(centroid + ChVector<>(0, 0.019, 0));
+            sphere->SetBodyFixed(true);
+            sys.AddBody(sphere);
+            spheres.push_back(sphere);
+        }
+
+        recorder = chrono_types::make_shared<ContactRecorder>();
+        sys.GetCollisionSystem()->RegisterNarrowphaseCallback(recorder);
+
+        sys.Setup();
+        sys.Update();
+        sys.ComputeCollisions();
+    }
+
+    // Release the nodes and move them over one step: the surface is translated by a fraction of a triangle and bent,
+    // so that the spheres touch other triangles. Then run the collision detection again at the new node positions.
+    void Move() {
+        const double step = 0.01;
+        sys.Set_G_acc(ChVector<>(0, 0, 0));
+        for (auto& node : nodes) {
+            node->SetFixed(false);
+            node->SetMass(1);
+            double bend = 0.5 * std::sin(10 * node->GetPos().z());
+            node->SetPos_dt(ChVector<>(0.07, 0.0005 * bend, 0) / step);
+        }
+        sys.DoStepDynamics(step);
+
+        recorder->contacts.clear();
+        sys.ComputeCollisions();
+    }
+
+    // Pairs (sphere index, triangle index) in contact
+    std::set<std::pair<int, int>> GetContactPairs() {
+        const auto& faces = surface->GetTriangleList();
+        std::map<ChCollisionModel*, int> triangle_index;
+        for (int k = 0; k < (int)faces.size(); k++)
+            triangle_index[faces[k]->GetCollisionModel()] = k;
+        std::map<ChCollisionModel*, int> sphere_index;
+        for (int k = 0; k < (int)spheres.size(); k++)
+            sphere_index[spheres[k]->GetCollisionModel().get()] = k;
+
+        std::set<std::pair<int, int>> pairs;
+        for (auto& c : recorder->contacts) {
+            // Order the contact as (sphere, triangle)
+            if (triangle_index.count(c.modelA)) {
+                std::swap(c.modelA, c.modelB);
+                std::swap(c.shapeA, c.shapeB);
+                std::swap(c.ptA, c.ptB);
+            }
+            EXPECT_EQ(sphere_index.count(c.modelA), 1);
+            EXPECT_EQ(triangle_index.count(c.modelB), 1);
+            if (!sphere_index.count(c.modelA) || !triangle_index.count(c.modelB))
+                continue;
+
+            // The shapes belong to the reported models
+            EXPECT_EQ(c.shapeA, c.modelA->GetShape(0).get());
+            EXPECT_EQ(c.shapeB, c.modelB->GetShape(0).get());
+
+            // The contact point on the triangle lies in the reported triangle (up to the collision envelope)
+            int it = triangle_index[c.modelB];
+            ChVector<> p0 = faces[it]->GetNode(0)->GetPos();
+            ChVector<> p1 = faces[it]->GetNode(1)->GetPos();
+            ChVector<> p2 = faces[it]->GetNode(2)->GetPos();
+            ChVector<> normal = Vcross(p1 - p0, p2 - p0);
+            double area = normal.Length();
+            normal /= area;
+            EXPECT_NEAR(Vdot(c.ptB - p0, normal), 0, 0.005);
+            double b0 = Vdot(Vcross(p1 - c.ptB, p2 - c.ptB), normal) / area;
+            double b1 = Vdot(Vcross(p2 - c.ptB, p0 - c.ptB), normal) / area;
+            double b2 = 1 - b0 - b1;
+            EXPECT_GE(b0, -1e-3);
+            EXPECT_GE(b1, -1e-3);
+            EXPECT_GE(b2, -1e-3);
+
+            pairs.insert(std::make_pair(sphere_index[c.modelA], it));
+        }
+
+        return pairs;
+    }
+
+    ChSystemSMC sys;
+    std::vector<std::shared_ptr<ChNodeFEAxyz>> nodes;
+    std::shared_ptr<ChContactSurfaceMesh> surface;
+    std::vector<std::shared_ptr<ChBody>> spheres;
+    std::shared_ptr<ContactRecorder> recorder;
+};
+
+TEST(ChContactSurfaceMeshTest, grouped_collision_model) {
+    ContactMeshTest ref(false);
+    auto pairs_ref = ref.GetContactPairs();
+
+    ContactMeshTest test(true);
+    ASSERT_TRUE(test.surface->GetMeshCollisionModel() != nullptr);
+    ASSERT_EQ(test.surface->GetMeshCollisionModel()->GetNumMembers(), (int)test.surface->GetNumTriangles());
+    auto pairs = test.GetContactPairs();
+
+    // Each sphere touches at least the triangle below it
+    for (int k = 0; k < (int)test.spheres.size(); k++)
+        ASSERT_EQ(pairs.count(std::make_pair(k, 3 * k)), 1);
+
+    ASSERT_EQ(pairs, pairs_ref);
+}
+
+TEST(ChContactSurfaceMeshTest, grouped_collision_model_moving) {
+    ContactMeshTest ref(false);
+    ref.Move();
+    auto pairs_ref = ref.GetContactPairs();
+
+    // The hierarchy of the grouped model must be refitted to the new node positions
+    ContactMeshTest test(true);
+    auto pairs_initial = test.GetContactPairs();
+    test.Move();
+    auto pairs = test.GetContactPairs();
+
+    ASSERT_FALSE(pairs.empty());
+    ASSERT_NE(pairs, pairs_initial);
+    ASSERT_EQ(pairs, pairs_ref);
+}
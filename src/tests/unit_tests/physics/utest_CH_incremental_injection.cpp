@@ -0,0 +1,140 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Test for the incremental injection of items in the system descriptor.
+// The same sequence of steps, interleaved with insertion and removal of bodies
+// and links and with changes of the Kblocks provided by some items, is run
+// with and without incremental injection, and the trajectories are compared.
+//
+// =============================================================================
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "chrono/physics/ChBody.h"
+#include "chrono/physics/ChLinkLock.h"
+#include "chrono/physics/ChLinkTSDA.h"
+#include "chrono/physics/ChSystemNSC.h"
+
+using namespace chrono;
+
+class IncrementalInjectionTest {
+  public:
+    IncrementalInjectionTest(bool incremental) {
+        sys.EnableIncrementalInjection(incremental);
+        sys.Set_G_acc(ChVector<>(0, -9.81, 0));
+        sys.SetSolverType(ChSolver::Type::SPARSE_LU);
+        sys.SetTimestepperType(ChTimestepper::Type::EULER_IMPLICIT_LINEARIZED);
+
+        ground = chrono_types::make_shared<ChBody>();
+        ground->SetBodyFixed(true);
+        sys.AddBody(ground);
+
+        for (int i = 0; i < 3; i++)
+            AddPendulum(i);
+
+        spring = chrono_types::make_shared<ChLinkTSDA>();
+        spring->Initialize(bodies[0], bodies[1], true, ChVector<>(0), ChVector<>(0));
+        spring->SetSpringCoefficient(50);
+        spring->SetDampingCoefficient(2);
+        sys.AddLink(spring);
+    }
+
+    void AddPendulum(int i) {
+        auto body = chrono_types::make_shared<ChBody>();
+        body->SetPos(ChVector<>(1.0 + 0.5 * i, 0, 0.2 * i));
+        body->SetMass(1.0 + i);
+        body->SetInertiaXX(ChVector<>(0.1, 0.1, 0.1));
+        sys.AddBody(body);
+
+        auto joint = chrono_types::make_shared<ChLinkLockRevolute>();
+        joint->Initialize(ground, body, ChCoordsys<>(ChVector<>(0, 0, 0.2 * i)));
+        sys.AddLink(joint);
+
+        bodies.push_back(body);
+        joints.push_back(joint);
+    }
+
+    void RemovePendulum() {
+        sys.RemoveLink(joints.back());
+        sys.RemoveBody(bodies.back());
+        joints.pop_back();
+        bodies.pop_back();
+    }
+
+    void Advance(int nsteps, std::vector<ChVector<>>& positions) {
+        for (int i = 0; i < nsteps; i++) {
+            sys.DoStepDynamics(1e-3);
+            for (auto& body : bodies)
+                positions.push_back(body->GetPos());
+        }
+    }
+
+    ChSystemNSC sys;
+    std::shared_ptr<ChBody> ground;
+    std::vector<std::shared_ptr<ChBody>> bodies;
+    std::vector<std::shared_ptr<ChLinkLockRevolute>> joints;
+    std::shared_ptr<ChLinkTSDA> spring;
+};
+
+// Run the same scenario on a new system and record the positions of all pendulum bodies after each step.
+static std::vector<ChVector<>> RunScenario(bool incremental) {
+    std::vector<ChVector<>> positions;
+    IncrementalInjectionTest test(incremental);
+
+    test.Advance(20, positions);
+
+    // The spring starts providing a Kblock, without any change of the assembly items
+    test.spring->IsStiff(true);
+    test.Advance(20, positions);
+
+    // Remove the last pendulum, then add a new one (possibly allocated at the same addresses)
+    test.RemovePendulum();
+    test.Advance(20, positions);
+    test.AddPendulum(2);
+    test.Advance(20, positions);
+
+    // The spring stops providing a Kblock
+    test.spring->IsStiff(false);
+    test.Advance(20, positions);
+
+    // Remove and add a pendulum between two consecutive steps
+    test.RemovePendulum();
+    test.AddPendulum(3);
+    test.Advance(20, positions);
+
+    // Start over in the same system
+    test.sys.Clear();
+    test.bodies.clear();
+    test.joints.clear();
+    test.ground = chrono_types::make_shared<ChBody>();
+    test.ground->SetBodyFixed(true);
+    test.sys.AddBody(test.ground);
+    test.AddPendulum(0);
+    test.AddPendulum(1);
+    test.Advance(20, positions);
+
+    return positions;
+}
+
+TEST(ChSystemTest, incremental_injection) {
+    auto ref = RunScenario(false);
+    auto pos = RunScenario(true);
+
+    ASSERT_EQ(pos.size(), ref.size());
+    for (size_t i = 0; i < ref.size(); i++) {
+        ASSERT_NEAR(pos[i].x(), ref[i].x(), 1e-10);
+        ASSERT_NEAR(pos[i].y(), ref[i].y(), 1e-10);
+        ASSERT_NEAR(pos[i].z(), ref[i].z(), 1e-10);
+    }
+}
@@ -0,0 +1,108 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Tests for the contacts between the particles of a ChParticleCloudSoA and the
+// collision shapes of bodies:
+// - particles resting on a fixed box body
+// - a particle hitting a free spherical body (momentum conservation)
+// - the cluster cannot be added to an NSC system
+//
+// =============================================================================
+
+#include "gtest/gtest.h"
+
+#include "chrono/core/ChException.h"
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChParticleCloudSoA.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/physics/ChSystemSMC.h"
+
+using namespace chrono;
+
+TEST(ChParticleCloudSoATest, resting_on_body) {
+    ChSystemSMC sys;
+    sys.Set_G_acc(ChVector<>(0, -9.81, 0));
+
+    // Box with its top face at y = 0, with the same damped material as the particles
+    auto mat = chrono_types::make_shared<ChMaterialSurfaceSMC>();
+    mat->SetKn(1e5f);
+    mat->SetGn(1e2f);
+    auto box = chrono_types::make_shared<ChBodyEasyBox>(1, 0.2, 1, 1000, false, true, mat);
+    box->SetPos(ChVector<>(0, -0.1, 0));
+    box->SetBodyFixed(true);
+    sys.AddBody(box);
+
+    double radius = 0.05;
+    auto cloud = chrono_types::make_shared<ChParticleCloudSoA>();
+    cloud->SetMaterialSurface(mat);
+    for (int ix = 0; ix < 4; ix++)
+        for (int iz = 0; iz < 4; iz++)
+            cloud->AddParticle(ChVector<>(-0.3 + 0.2 * ix, 0.1, -0.3 + 0.2 * iz), radius);
+    sys.Add(cloud);
+
+    for (int i = 0; i < 2000; i++)
+        sys.DoStepDynamics(5e-4);
+
+    // All particles rest on the top face of the box, with a small penetration
+    double weight = 0;
+    for (unsigned int j = 0; j < cloud->GetNparticles(); j++) {
+        ASSERT_NEAR(cloud->GetPos(j).y(), radius, 1e-3);
+        ASSERT_NEAR(cloud->GetPos_dt(j).Length(), 0, 1e-3);
+        weight += cloud->GetMass(j) * 9.81;
+    }
+    ASSERT_EQ(cloud->GetNumBodyContacts(), cloud->GetNparticles());
+
+    // The particles press on the box with their weight
+    ChVector<> force = cloud->GetBodyContactForce(box.get());
+    ASSERT_NEAR(force.y(), -weight, 1e-2 * weight);
+    ASSERT_NEAR(force.x(), 0, 1e-2 * weight);
+    ASSERT_NEAR(force.z(), 0, 1e-2 * weight);
+}
+
+TEST(ChParticleCloudSoATest, momentum_exchange) {
+    ChSystemSMC sys;
+    sys.Set_G_acc(ChVector<>(0, 0, 0));
+
+    auto mat = chrono_types::make_shared<ChMaterialSurfaceSMC>();
+    auto sphere = chrono_types::make_shared<ChBodyEasySphere>(0.2, 1000, false, true, mat);
+    sys.AddBody(sphere);
+
+    // Frictionless particle material (the friction coefficient of the composite material is the smallest one)
+    auto particle_mat = chrono_types::make_shared<ChMaterialSurfaceSMC>();
+    particle_mat->SetFriction(0);
+    auto cloud = chrono_types::make_shared<ChParticleCloudSoA>();
+    cloud->SetMaterialSurface(particle_mat);
+    cloud->AddParticle(ChVector<>(-0.5, 0, 0), 0.05, ChVector<>(2, 0, 0));
+    sys.Add(cloud);
+
+    double momentum = cloud->GetMass(0) * 2;
+    for (int i = 0; i < 1000; i++)
+        sys.DoStepDynamics(2e-4);
+
+    // The particle bounced on the sphere, which was pushed along the impact direction
+    ASSERT_LT(cloud->GetPos_dt(0).x(), 2.0);
+    ASSERT_GT(sphere->GetPos_dt().x(), 0.0);
+
+    // The linear momentum of the particle and the sphere is conserved
+    ChVector<> total = cloud->GetMass(0) * cloud->GetPos_dt(0) + sphere->GetMass() * sphere->GetPos_dt();
+    ASSERT_NEAR(total.x(), momentum, 1e-6 * momentum);
+    ASSERT_NEAR(total.y(), 0, 1e-6 * momentum);
+    ASSERT_NEAR(total.z(), 0, 1e-6 * momentum);
+}
+
+TEST(ChParticleCloudSoATest, contact_method) {
+    ChSystemNSC sys;
+    auto cloud = chrono_types::make_shared<ChParticleCloudSoA>();
+    cloud->AddParticle(ChVector<>(0, 0, 0), 0.05);
+    ASSERT_THROW(sys.Add(cloud), ChException);
+    ASSERT_EQ(sys.Get_otherphysicslist().size(), 0);
+}
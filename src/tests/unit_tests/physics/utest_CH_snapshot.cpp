@@ -0,0 +1,261 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Test for system snapshots: a simulation continued after restoring a snapshot
+// must reproduce the simulation continued right after saving it, both in the
+// original system and in an identical system restored from a stream.
+//
+// =============================================================================
+
+#include <cmath>
+#include <sstream>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "chrono/core/ChException.h"
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/motion_functions/ChFunction_Setpoint.h"
+#include "chrono/physics/ChLinkLock.h"
+#include "chrono/physics/ChLinkMotorRotationAngle.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/physics/ChSystemSnapshot.h"
+
+using namespace chrono;
+
+// A stack of spheres resting on the ground, next to two pendulums, with one sleeping body
+class SnapshotTestSystem {
+  public:
+    SnapshotTestSystem() {
+        sys.Set_G_acc(ChVector<>(0, -9.81, 0));
+        sys.SetSolverMaxIterations(50);
+
+        auto mat = chrono_types::make_shared<ChMaterialSurfaceNSC>();
+        mat->SetFriction(0.4f);
+
+        auto ground = chrono_types::make_shared<ChBodyEasyBox>(20, 1, 20, 1000, false, true, mat);
+        ground->SetPos(ChVector<>(0, -0.5, 0));
+        ground->SetBodyFixed(true);
+        sys.AddBody(ground);
+
+        for (int level = 0; level < 3; level++) {
+            auto sphere = chrono_types::make_shared<ChBodyEasySphere>(0.5, 1000, false, true, mat);
+            sphere->SetPos(ChVector<>(0, 0.5 + 1.0 * level, 0.01 * level));
+            sys.AddBody(sphere);
+            bodies.push_back(sphere);
+        }
+
+        for (int i = 0; i < 2; i++) {
+            auto pendulum = chrono_types::make_shared<ChBody>();
+            pendulum->SetPos(ChVector<>(4, 3, 2.0 * i));
+            sys.AddBody(pendulum);
+            bodies.push_back(pendulum);
+
+            auto joint = chrono_types::make_shared<ChLinkLockRevolute>();
+            joint->Initialize(ground, pendulum, ChCoordsys<>(ChVector<>(3, 3, 2.0 * i)));
+            sys.AddLink(joint);
+            joints.push_back(joint);
+        }
+
+        sleeping = chrono_types::make_shared<ChBody>();
+        sleeping->SetPos(ChVector<>(-4, 2, 0));
+        sleeping->SetSleeping(true);
+        sys.AddBody(sleeping);
+        bodies.push_back(sleeping);
+    }
+
+    // Advance the simulation and record the positions and velocities of the bodies after each step
+    void Advance(int nsteps, std::vector<ChVector<>>& states) {
+        for (int i = 0; i < nsteps; i++) {
+            sys.DoStepDynamics(1e-3);
+            for (auto& body : bodies) {
+                states.push_back(body->GetPos());
+                states.push_back(body->GetPos_dt());
+            }
+        }
+    }
+
+    ChSystemNSC sys;
+    std::vector<std::shared_ptr<ChBody>> bodies;
+    std::vector<std::shared_ptr<ChLinkLockRevolute>> joints;
+    std::shared_ptr<ChBody> sleeping;
+};
+
+static void Compare(const std::vector<ChVector<>>& states, const std::vector<ChVector<>>& ref) {
+    ASSERT_EQ(states.size(), ref.size());
+    for (size_t i = 0; i < ref.size(); i++) {
+        ASSERT_NEAR(states[i].x(), ref[i].x(), 1e-12);
+        ASSERT_NEAR(states[i].y(), ref[i].y(), 1e-12);
+        ASSERT_NEAR(states[i].z(), ref[i].z(), 1e-12);
+    }
+}
+
+TEST(ChSystemSnapshotTest, save_step_restore_step) {
+    SnapshotTestSystem test;
+    std::vector<ChVector<>> unused;
+    test.Advance(100, unused);
+
+    ChSystemSnapshot snapshot;
+    snapshot.Save(test.sys);
+    double time = test.sys.GetChTime();
+
+    std::vector<ChVector<>> ref;
+    test.sleeping->SetSleeping(false);
+    test.Advance(50, ref);
+
+    snapshot.Restore(test.sys);
+    ASSERT_EQ(test.sys.GetChTime(), time);
+    ASSERT_TRUE(test.sleeping->GetSleeping());
+
+    std::vector<ChVector<>> states;
+    test.sleeping->SetSleeping(false);
+    test.Advance(50, states);
+    Compare(states, ref);
+
+    // Restore the same snapshot a second time
+    snapshot.Restore(test.sys);
+    states.clear();
+    test.sleeping->SetSleeping(false);
+    test.Advance(50, states);
+    Compare(states, ref);
+}
+
+TEST(ChSystemSnapshotTest, stream) {
+    SnapshotTestSystem test;
+    std::vector<ChVector<>> unused;
+    test.Advance(100, unused);
+
+    ChSystemSnapshot snapshot;
+    snapshot.Save(test.sys);
+    std::stringstream stream;
+    snapshot.Write(stream);
+    double time = test.sys.GetChTime();
+
+    std::vector<ChVector<>> ref;
+    test.Advance(50, ref);
+
+    // Restore in a different, but identical, system
+    SnapshotTestSystem other;
+    ChSystemSnapshot other_snapshot;
+    other_snapshot.Read(stream);
+    other_snapshot.Restore(other.sys);
+    ASSERT_EQ(other.sys.GetChTime(), time);
+
+    std::vector<ChVector<>> states;
+    other.Advance(50, states);
+    Compare(states, ref);
+}
+
+TEST(ChSystemSnapshotTest, structure) {
+    SnapshotTestSystem test;
+    std::vector<ChVector<>> unused;
+    test.Advance(10, unused);
+
+    // Saving does not set up items added since the last step
+    auto body = chrono_types::make_shared<ChBody>();
+    test.sys.AddBody(body);
+    int nbodies = test.sys.GetNbodies();
+    ChSystemSnapshot snapshot;
+    snapshot.Save(test.sys);
+    ASSERT_EQ(test.sys.GetNbodies(), nbodies);
+
+    // A snapshot cannot be restored in a system with a different structure
+    test.sys.RemoveBody(body);
+    ASSERT_THROW(snapshot.Restore(test.sys), ChException);
+    test.sys.AddBody(body);
+    snapshot.Restore(test.sys);
+}
+
+TEST(ChSystemSnapshotTest, link_activity) {
+    SnapshotTestSystem test;
+    std::vector<ChVector<>> unused;
+    test.Advance(100, unused);
+
+    ChSystemSnapshot snapshot;
+    snapshot.Save(test.sys);
+    ChVector<> pos = test.joints[1]->GetBody2()->GetPos();
+    ChVector<> force = test.joints[1]->Get_react_force();
+    ASSERT_GT(force.Length(), 0);
+    test.Advance(10, unused);
+
+    // The active state of links is not part of the structure of the system: restore with the first joint disabled,
+    // and check that the data of the following items is read back correctly
+    test.joints[0]->SetDisabled(true);
+    snapshot.Restore(test.sys);
+    ASSERT_TRUE(test.joints[1]->GetBody2()->GetPos().Equals(pos));
+    ASSERT_TRUE(test.joints[1]->Get_react_force().Equals(force));
+
+    // Save with the first joint disabled, restore with it enabled
+    snapshot.Save(test.sys);
+    test.joints[0]->SetDisabled(false);
+    test.Advance(10, unused);
+    snapshot.Restore(test.sys);
+    ASSERT_TRUE(test.joints[1]->GetBody2()->GetPos().Equals(pos));
+    ASSERT_TRUE(test.joints[1]->Get_react_force().Equals(force));
+}
+
+// A rotor driven by a motor, whose angle is set at each step through a setpoint function
+class SetpointMotorTestSystem {
+  public:
+    SetpointMotorTestSystem() {
+        auto ground = chrono_types::make_shared<ChBody>();
+        ground->SetBodyFixed(true);
+        sys.AddBody(ground);
+
+        rotor = chrono_types::make_shared<ChBody>();
+        rotor->SetPos(ChVector<>(1, 0, 0));
+        sys.AddBody(rotor);
+
+        setpoint = chrono_types::make_shared<ChFunction_Setpoint>();
+        auto motor = chrono_types::make_shared<ChLinkMotorRotationAngle>();
+        motor->Initialize(rotor, ground, ChFrame<>());
+        motor->SetAngleFunction(setpoint);
+        sys.AddLink(motor);
+    }
+
+    // Set the angle at the end of each step (the setpoint derivatives are computed by backward differences), then
+    // advance the simulation and record the rotor position and velocity
+    void Advance(int nsteps, std::vector<ChVector<>>& states) {
+        for (int i = 0; i < nsteps; i++) {
+            double t = sys.GetChTime() + 1e-3;
+            setpoint->SetSetpoint(std::sin(2 * t) + t * t, t);
+            sys.DoStepDynamics(1e-3);
+            states.push_back(rotor->GetPos());
+            states.push_back(rotor->GetPos_dt());
+        }
+    }
+
+    ChSystemNSC sys;
+    std::shared_ptr<ChBody> rotor;
+    std::shared_ptr<ChFunction_Setpoint> setpoint;
+};
+
+TEST(ChSystemSnapshotTest, setpoint_motor) {
+    SetpointMotorTestSystem test;
+    std::vector<ChVector<>> unused;
+    test.Advance(100, unused);
+
+    ChSystemSnapshot snapshot;
+    snapshot.Save(test.sys);
+    double y_dx = test.setpoint->Get_y_dx(0);
+
+    std::vector<ChVector<>> ref;
+    test.Advance(50, ref);
+
+    // The internal data of the setpoint function (including the values used for differentiation) is restored
+    snapshot.Restore(test.sys);
+    ASSERT_EQ(test.setpoint->Get_y_dx(0), y_dx);
+
+    std::vector<ChVector<>> states;
+    test.Advance(50, states);
+    Compare(states, ref);
+}
@@ -0,0 +1,99 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Test for the solution of independent constraint islands by the iterative VI
+// solvers. Several separate stacks of spheres resting on a fixed ground are
+// simulated with and without splitting the problem in islands.
+//
+// =============================================================================
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/solver/ChIterativeSolverVI.h"
+
+using namespace chrono;
+
+// Simulate the stacks with the given solver and return the final positions of all spheres.
+static std::vector<ChVector<>> Simulate(ChSolver::Type solver_type,
+                                        bool islands,
+                                        int max_iterations,
+                                        double tolerance,
+                                        int& nislands) {
+    ChSystemNSC sys;
+    sys.SetSolverType(solver_type);
+    sys.SetSolverMaxIterations(max_iterations);
+    auto solver = std::static_pointer_cast<ChIterativeSolverVI>(sys.GetSolver());
+    solver->SetTolerance(tolerance);
+    solver->EnableIslands(islands);
+
+    auto mat = chrono_types::make_shared<ChMaterialSurfaceNSC>();
+    mat->SetFriction(0.4f);
+
+    auto ground = chrono_types::make_shared<ChBodyEasyBox>(20, 1, 20, 1000, false, true, mat);
+    ground->SetPos(ChVector<>(0, -0.5, 0));
+    ground->SetBodyFixed(true);
+    sys.AddBody(ground);
+
+    std::vector<std::shared_ptr<ChBody>> spheres;
+    for (int stack = 0; stack < 4; stack++) {
+        for (int level = 0; level < 3; level++) {
+            auto sphere = chrono_types::make_shared<ChBodyEasySphere>(0.5, 1000, false, true, mat);
+            sphere->SetPos(ChVector<>(3.0 * stack - 4.5, 0.5 + 1.0 * level, 0.01 * level * stack));
+            sys.AddBody(sphere);
+            spheres.push_back(sphere);
+        }
+    }
+
+    nislands = 0;
+    for (int i = 0; i < 200; i++) {
+        sys.DoStepDynamics(1e-3);
+        nislands = std::max(nislands, solver->GetNumIslands());
+    }
+
+    std::vector<ChVector<>> positions;
+    for (auto& sphere : spheres)
+        positions.push_back(sphere->GetPos());
+    return positions;
+}
+
+static void Compare(ChSolver::Type solver_type, int max_iterations, double tolerance, double pos_tolerance) {
+    int nislands_ref;
+    int nislands;
+    auto ref = Simulate(solver_type, false, max_iterations, tolerance, nislands_ref);
+    auto pos = Simulate(solver_type, true, max_iterations, tolerance, nislands);
+
+    ASSERT_EQ(nislands, 4);
+    ASSERT_EQ(pos.size(), ref.size());
+    for (size_t i = 0; i < ref.size(); i++) {
+        ASSERT_NEAR(pos[i].x(), ref[i].x(), pos_tolerance);
+        ASSERT_NEAR(pos[i].y(), ref[i].y(), pos_tolerance);
+        ASSERT_NEAR(pos[i].z(), ref[i].z(), pos_tolerance);
+    }
+}
+
+// With a zero tolerance, PSOR performs the same iterations on each island as on the complete problem
+TEST(ChIterativeSolverVITest, islands_PSOR) {
+    Compare(ChSolver::Type::PSOR, 100, 0.0, 1e-10);
+}
+
+// APGD step sizes depend on the complete problem, so islands follow different iterates and agree only once converged
+TEST(ChIterativeSolverVITest, islands_APGD) {
+    Compare(ChSolver::Type::APGD, 1000, 1e-10, 1e-5);
+}
+
+TEST(ChIterativeSolverVITest, islands_BB) {
+    Compare(ChSolver::Type::BARZILAIBORWEIN, 100, 1e-8, 1e-6);
+}
@@ -0,0 +1,133 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Test for the search of interacting SPH nodes: the densities and forces
+// computed with the internal neighbor lists of ChMatterSPH must match those
+// computed with the pairs of a ChProximityContainerSPH. Pairs of nodes of
+// different clusters are only provided by the proximity container.
+//
+// =============================================================================
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "chrono/core/ChMathematics.h"
+#include "chrono/physics/ChMatterSPH.h"
+#include "chrono/physics/ChProximityContainerSPH.h"
+#include "chrono/physics/ChSystemNSC.h"
+
+using namespace chrono;
+
+// Create a cluster of SPH nodes in a box centered at the given position
+static std::shared_ptr<ChMatterSPH> AddCluster(ChSystem& sys, const ChVector<>& center, bool neighbor_search) {
+    auto matter = chrono_types::make_shared<ChMatterSPH>();
+    ChSetRandomSeed(123);
+    matter->FillBox(ChVector<>(0.3, 0.3, 0.3), 0.03, 1000, ChCoordsys<>(center, QUNIT), true, 1.5, 0.3);
+    matter->GetMaterial().Set_viscosity(0.5);
+    matter->GetMaterial().Set_pressure_stiffness(300);
+    matter->SetNeighborSearch(neighbor_search);
+    matter->SetCollide(true);
+    sys.Add(matter);
+
+    // Nonzero velocities, to exercise the viscous forces
+    for (unsigned int j = 0; j < matter->GetNnodes(); j++) {
+        auto node = std::dynamic_pointer_cast<ChNodeSPH>(matter->GetNode(j));
+        node->SetPos_dt(ChVector<>(ChRandom() - 0.5, ChRandom() - 0.5, ChRandom() - 0.5));
+    }
+
+    return matter;
+}
+
+// Compute the SPH densities and forces of the nodes of the given cluster
+static void ComputeForces(ChSystem& sys,
+                          std::shared_ptr<ChMatterSPH> matter,
+                          std::vector<double>& density,
+                          std::vector<ChVector<>>& force) {
+    sys.Setup();
+    sys.Update();
+    sys.ComputeCollisions();
+
+    ChVectorDynamic<> R(sys.GetNcoords_w());
+    R.setZero();
+    matter->IntLoadResidual_F(matter->GetOffset_w(), R, 1.0);
+
+    density.clear();
+    force.clear();
+    for (unsigned int j = 0; j < matter->GetNnodes(); j++) {
+        auto node = std::dynamic_pointer_cast<ChNodeSPH>(matter->GetNode(j));
+        density.push_back(node->density);
+        force.push_back(node->UserForce);
+    }
+}
+
+TEST(ChMatterSPHTest, neighbor_list_vs_proximity) {
+    // Reference: pairs provided by the collision system
+    ChSystemNSC sys_ref;
+    auto matter_ref = AddCluster(sys_ref, VNULL, false);
+    sys_ref.Add(chrono_types::make_shared<ChProximityContainerSPH>());
+    std::vector<double> density_ref;
+    std::vector<ChVector<>> force_ref;
+    ComputeForces(sys_ref, matter_ref, density_ref, force_ref);
+
+    // Internal neighbor search
+    ChSystemNSC sys;
+    auto matter = AddCluster(sys, VNULL, true);
+    std::vector<double> density;
+    std::vector<ChVector<>> force;
+    ComputeForces(sys, matter, density, force);
+
+    ASSERT_EQ(density.size(), density_ref.size());
+    double max_density = 0;
+    double max_force = 0;
+    for (size_t i = 0; i < density_ref.size(); i++) {
+        max_density = std::max(max_density, density_ref[i]);
+        max_force = std::max(max_force, force_ref[i].Length());
+    }
+    ASSERT_GT(max_density, 0);
+    ASSERT_GT(max_force, 0);
+
+    for (size_t i = 0; i < density_ref.size(); i++) {
+        ASSERT_NEAR(density[i], density_ref[i], 1e-10 * max_density);
+        ASSERT_NEAR(force[i].x(), force_ref[i].x(), 1e-10 * max_force);
+        ASSERT_NEAR(force[i].y(), force_ref[i].y(), 1e-10 * max_force);
+        ASSERT_NEAR(force[i].z(), force_ref[i].z(), 1e-10 * max_force);
+    }
+}
+
+TEST(ChMatterSPHTest, multiple_clusters) {
+    // Density of the nodes of a single cluster
+    ChSystemNSC sys_single;
+    auto matter_single = AddCluster(sys_single, VNULL, true);
+    std::vector<double> density_single;
+    std::vector<ChVector<>> force_single;
+    ComputeForces(sys_single, matter_single, density_single, force_single);
+
+    // Two adjacent clusters, with a proximity container: the container is used by default, and nodes near the other
+    // cluster get a higher density
+    ChSystemNSC sys;
+    auto matter = AddCluster(sys, VNULL, true);
+    AddCluster(sys, ChVector<>(0.3, 0, 0), true);
+    sys.Add(chrono_types::make_shared<ChProximityContainerSPH>());
+    std::vector<double> density;
+    std::vector<ChVector<>> force;
+    ComputeForces(sys, matter, density, force);
+
+    ASSERT_EQ(density.size(), density_single.size());
+    int num_higher = 0;
+    for (size_t i = 0; i < density.size(); i++) {
+        ASSERT_GE(density[i], density_single[i] - 1e-10 * density_single[i]);
+        if (density[i] > density_single[i] * (1 + 1e-6))
+            num_higher++;
+    }
+    ASSERT_GT(num_higher, 0);
+}
@@ -0,0 +1,141 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Round-trip test for binary trajectory files: frames written during a
+// simulation in which bodies are fixed, released and put to sleep are read
+// back and compared with the states recorded during the simulation.
+//
+// =============================================================================
+
+#include <cstdio>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "chrono/core/ChException.h"
+#include "chrono/physics/ChBody.h"
+#include "chrono/physics/ChLinkLock.h"
+#include "chrono/physics/ChShaft.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/utils/ChTrajectoryOutput.h"
+
+using namespace chrono;
+using namespace chrono::utils;
+
+TEST(ChTrajectoryOutputTest, round_trip) {
+    const std::string filename = "utest_CH_trajectory_output.bin";
+
+    ChSystemNSC sys;
+    sys.Set_G_acc(ChVector<>(0, -9.81, 0));
+
+    auto ground = chrono_types::make_shared<ChBody>();
+    ground->SetName("ground");
+    ground->SetBodyFixed(true);
+    sys.AddBody(ground);
+
+    auto pendulum = chrono_types::make_shared<ChBody>();
+    pendulum->SetName("pendulum");
+    pendulum->SetPos(ChVector<>(1, 0, 0));
+    sys.AddBody(pendulum);
+
+    auto joint = chrono_types::make_shared<ChLinkLockRevolute>();
+    joint->Initialize(ground, pendulum, ChCoordsys<>(VNULL));
+    sys.AddLink(joint);
+
+    auto falling = chrono_types::make_shared<ChBody>();
+    falling->SetName("falling");
+    falling->SetPos(ChVector<>(0, 2, 0));
+    falling->SetWvel_loc(ChVector<>(0, 1, 0));
+    sys.AddBody(falling);
+
+    auto shaft = chrono_types::make_shared<ChShaft>();
+    shaft->SetName("shaft");
+    shaft->SetPos_dt(3);
+    sys.Add(shaft);
+
+    ChTrajectoryWriter writer(4);
+    writer.Open(filename, sys);
+
+    std::vector<std::shared_ptr<ChBody>> bodies = {ground, pendulum, falling};
+    std::vector<double> times;
+    std::vector<ChVector<>> pos;
+    std::vector<ChQuaternion<>> rot;
+    std::vector<ChVector<>> vel;
+    std::vector<double> shaft_pos;
+
+    for (int i = 0; i < 100; i++) {
+        // Change the activity of some items while writing
+        if (i == 20)
+            falling->SetBodyFixed(true);
+        if (i == 40)
+            falling->SetBodyFixed(false);
+        if (i == 60) {
+            pendulum->SetSleeping(true);
+            shaft->SetShaftFixed(true);
+        }
+        if (i == 80) {
+            pendulum->SetSleeping(false);
+            shaft->SetShaftFixed(false);
+        }
+
+        sys.DoStepDynamics(1e-3);
+        writer.WriteFrame();
+
+        times.push_back(sys.GetChTime());
+        for (auto& body : bodies) {
+            pos.push_back(body->GetPos());
+            rot.push_back(body->GetRot());
+            vel.push_back(body->GetPos_dt());
+        }
+        shaft_pos.push_back(shaft->IsActive() ? shaft->GetPos() : 0.0);
+    }
+
+    // Adding an item changes the structure of the system
+    auto extra = chrono_types::make_shared<ChBody>();
+    sys.AddBody(extra);
+    ASSERT_THROW(writer.WriteFrame(), ChException);
+    sys.RemoveBody(extra);
+
+    writer.Close();
+
+    ChTrajectoryReader reader;
+    reader.Open(filename);
+    ASSERT_EQ(reader.GetNumFrames(), times.size());
+
+    int ibody[3];
+    for (int j = 0; j < 3; j++) {
+        ibody[j] = reader.FindItem(bodies[j]->GetName());
+        ASSERT_GE(ibody[j], 0);
+        ASSERT_EQ(reader.GetItem(ibody[j]).type, TrajectoryItem::BODY);
+    }
+    int ishaft = reader.FindItem("shaft");
+    ASSERT_GE(ishaft, 0);
+    ASSERT_EQ(reader.GetItem(ishaft).nx, 1u);
+
+    for (uint64_t f = 0; f < reader.GetNumFrames(); f++) {
+        ASSERT_DOUBLE_EQ(reader.GetTime(f), times[f]);
+        for (int j = 0; j < 3; j++) {
+            size_t k = 3 * f + j;
+            ASSERT_TRUE(reader.GetBodyPos(f, ibody[j]).Equals(pos[k]));
+            ASSERT_TRUE(reader.GetBodyRot(f, ibody[j]).Equals(rot[k]));
+            ASSERT_TRUE(reader.GetBodyPos_dt(f, ibody[j]).Equals(vel[k]));
+        }
+        ASSERT_DOUBLE_EQ(reader.GetStateX(f)[reader.GetItem(ishaft).offset_x], shaft_pos[f]);
+    }
+
+    // The fixed body did not move while fixed, and moved afterwards
+    ASSERT_TRUE(reader.GetBodyPos(25, ibody[2]).Equals(reader.GetBodyPos(35, ibody[2])));
+    ASSERT_FALSE(reader.GetBodyPos(45, ibody[2]).Equals(reader.GetBodyPos(55, ibody[2])));
+
+    reader.Close();
+    std::remove(filename.c_str());
+}